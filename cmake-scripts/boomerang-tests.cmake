@@ -16,6 +16,10 @@ if (BOOMERANG_BUILD_UNIT_TESTS)
 
     add_definitions(-DBOOMERANG_TEST_BASE="${BOOMERANG_OUTPUT_DIR}/")
     add_subdirectory(${CMAKE_SOURCE_DIR}/tests/unit-tests)
+
+    if (BOOMERANG_BUILD_BENCHMARKS)
+        add_subdirectory(${CMAKE_SOURCE_DIR}/tests/benchmarks)
+    endif (BOOMERANG_BUILD_BENCHMARKS)
 endif (BOOMERANG_BUILD_UNIT_TESTS)
 
 
@@ -2,3 +2,5 @@
 int _IO_putc(char c) PREFER int putchar(1);
 int __xstat(int __ver, const char  *__filename, struct stat *__stat_buf) PREFER int stat(2, 3);
 int __isoc99_scanf(const char *format, ...) PREFER int scanf(1);
+void _Unwind_SjLj_Register(void *fc);
+void _Unwind_SjLj_Unregister(void *fc);
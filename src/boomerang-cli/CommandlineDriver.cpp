@@ -11,10 +11,13 @@
 
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/CFGDotWriter.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
+#include <QFile>
+#include <QSet>
 #include <QTextStream>
 
 #include <iostream>
@@ -42,6 +45,7 @@ static void help()
 "Usage:\n"
 "  boomerang-cli [ switches ] [ -- ] program\n"
 "  boomerang-cli -i [ command_file ]\n"
+"  boomerang-cli [ switches ] --batch <file>\n"
 "  boomerang-cli ( -h | --help | --version )\n"
 "\n"
 "\n"
@@ -52,12 +56,27 @@ static void help()
 "Decoding/decompilation options\n"
 "  --decode-only    : Decode only, do not decompile\n"
 "  --ssl <file>     : Use <file> as SSL specification file\n"
+"  --ssl-cache      : Cache expanded SSL specification files in the user's cache directory\n"
 "  -e <addr>        : Decode or decompile the procedure beginning at addr, and callees\n"
 "  -E <addr>        : Equivalent to -nc -e <addr>\n"
 "  -ic              : Decode through type 0 Indirect Calls\n"
+"  --sweep          : Find additional procedures by a linear sweep of code sections\n"
+"                     (useful for stripped binaries)\n"
+"  --debug-info     : Use procedures, signatures and types from the debug information\n"
+"                     of the input file\n"
 "  -S <min>         : Stop decompilation after specified number of minutes\n"
+"  --proc-time-limit <sec>\n"
+"                   : Decompile procedures taking longer than <sec> seconds\n"
+"                     with a degraded pipeline (low-level code)\n"
+"  --proc-work-limit <n>\n"
+"                   : Decompile procedures needing more than <n> work units\n"
+"                     (statements processed by all passes) with a degraded pipeline\n"
 "  -t               : Trace (print address of) every instruction decoded\n"
 "  -a               : Assume ABI compliance\n"
+"  -j <n>           : Use <n> threads for global type analysis (0: one per CPU core,\n"
+"                     default 1)\n"
+"  --meet-call-types: Meet the types of arguments and parameters, and of results and\n"
+"                     returns, at call sites during global type analysis (off by default)\n"
 "\n"
 "Output\n"
 "  --version        : Print version information and exit\n"
@@ -69,10 +88,14 @@ static void help()
 "  -gd <dot_file>   : Generate a dotty graph of the program's CFG(s)\n"
 "  -gc              : Generate a call graph to callgraph.dot\n"
 "  -gs              : Generate a symbol file (symbols.h). Implies --decode-only.\n"
+"  --mem-report <n> : Print IR memory usage and the <n> largest procs after each\n"
+"                     decompilation phase\n"
 "\n"
 "Misc.\n"
 "  -i [<file>]      : Interactive mode; execute commands from <file>, if present\n"
 "  -P <path>        : Path to Boomerang files, defaults to the path to the Boomerang executable\n"
+"  --batch <file>   : Decompile all binaries listed in <file> (one per line, - for stdin)\n"
+"                     in a single process\n"
 "  --               : Terminates argument processing\n"
 "\n"
 "Debug\n"
@@ -186,6 +209,22 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             m_project->getSettings()->stopBeforeDecompile = true;
             continue;
         }
+        else if (arg == "--sweep") {
+            m_project->getSettings()->sweepForFunctions = true;
+            continue;
+        }
+        else if (arg == "--meet-call-types") {
+            m_project->getSettings()->meetCallSiteTypes = true;
+            continue;
+        }
+        else if (arg == "--debug-info") {
+            m_project->getSettings()->useDebugInfo = true;
+            continue;
+        }
+        else if (arg == "--ssl-cache") {
+            m_project->getSettings()->useSSLCache = true;
+            continue;
+        }
         else if (arg == "--ssl") {
             if (++i == args.size()) {
                 help();
@@ -224,6 +263,15 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             m_project->getSettings()->setOutputDirectory(wd.path() + "/./output/");
             continue;
         }
+        else if (arg == "--batch") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_batchFile = args[i];
+            continue;
+        }
         else if (arg == "-ic") {
             m_project->getSettings()->decodeThruIndCall = true;
             continue;
@@ -363,6 +411,40 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
 
             continue;
         }
+        else if (arg == "--mem-report") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted                          = false;
+            m_project->getSettings()->memReportTopN = args[i].toInt(&converted, 0);
+
+            if (!converted || m_project->getSettings()->memReportTopN < 0) {
+                std::cerr << "'--mem-report': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "-j") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted                       = false;
+            m_project->getSettings()->numThreads = args[i].toInt(&converted, 0);
+
+            if (!converted || m_project->getSettings()->numThreads < 0) {
+                std::cerr << "'-j': Bad argument '" << args[i].toStdString() << "' (try --help)."
+                          << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
         else if (arg == "-S") {
             if (++i == args.size()) {
                 help();
@@ -380,6 +462,30 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
 
             continue;
         }
+        else if (arg == "--proc-time-limit" || arg == "--proc-work-limit") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted     = false;
+            const qint64 limit = args[i].toLongLong(&converted, 0);
+
+            if (!converted || limit < 0) {
+                std::cerr << "'" << arg.toStdString() << "': Bad argument '"
+                          << args[i].toStdString() << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            if (arg == "--proc-time-limit") {
+                m_project->getSettings()->procTimeLimit = limit * 1000;
+            }
+            else {
+                m_project->getSettings()->procWorkLimit = limit;
+            }
+
+            continue;
+        }
         else if (arg == "--") {
             if (i + 2 != args.size()) {
                 help();
@@ -435,7 +541,7 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
     if (interactiveMode) {
         return interactiveMain();
     }
-    else if (binaryPath == "") {
+    else if (binaryPath == "" && m_batchFile.isEmpty()) {
         help();
         return 1;
     }
@@ -443,7 +549,6 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
     if (minsToStopAfter > 0) {
         LOG_MSG("Stopping decompile after %1 minutes", minsToStopAfter);
         m_kill_timer.setSingleShot(true);
-        m_kill_timer.start(1000 * 60 * minsToStopAfter);
     }
 
     m_pathToBinary = binaryPath;
@@ -490,6 +595,10 @@ int CommandlineDriver::decompile()
         m_project->getSettings()->getOutputDirectory().absolutePath());
     m_project->loadPlugins();
 
+    if (!m_batchFile.isEmpty()) {
+        return runBatch();
+    }
+
     QDir wd       = m_project->getSettings()->getWorkingDirectory();
     QFileInfo inf = QFileInfo(wd.absoluteFilePath(m_pathToBinary));
 
@@ -497,6 +606,69 @@ int CommandlineDriver::decompile()
 }
 
 
+int CommandlineDriver::runBatch()
+{
+    QFile batchFile(m_batchFile);
+    const bool isOpen = (m_batchFile == "-") ? batchFile.open(stdin, QFile::ReadOnly)
+                                             : batchFile.open(QFile::ReadOnly | QFile::Text);
+
+    if (!isOpen) {
+        LOG_ERROR("Cannot open batch file '%1'", m_batchFile);
+        return 1;
+    }
+
+    Settings *settings   = m_project->getSettings();
+    const QDir wd        = settings->getWorkingDirectory();
+    const QString outDir = settings->getOutputDirectory().absolutePath();
+
+    int numJobs   = 0;
+    int numFailed = 0;
+
+    // Names of the output directories of all jobs so far
+    QSet<QString> usedNames;
+
+    // Read the jobs one by one, so the list can be fed to a running process via stdin
+    QTextStream strm(&batchFile);
+    while (!strm.atEnd()) {
+        const QString line = strm.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QFileInfo inf = QFileInfo(wd.absoluteFilePath(line));
+        const QString name  = inf.completeBaseName();
+
+        // Binaries with the same name (e.g. a/hello and b/hello) must not overwrite
+        // each other's output
+        QString dirName = name;
+        for (int i = 2; usedNames.contains(dirName); i++) {
+            dirName = QString("%1-%2").arg(name).arg(i);
+        }
+
+        usedNames.insert(dirName);
+        settings->setOutputDirectory(outDir + "/" + dirName + "/");
+        QDir().mkpath(settings->getOutputDirectory().absolutePath());
+
+        LOG_MSG("Decompiling '%1'", inf.absoluteFilePath());
+        numJobs++;
+
+        if (decompile(inf.absoluteFilePath(), name) != 0) {
+            LOG_ERROR("Decompiling '%1' failed", inf.absoluteFilePath());
+            numFailed++;
+        }
+
+        // Types named by this binary (e.g. by its symbol file) must not leak into the next one.
+        // Library catalogs register their named types again when they are read.
+        m_project->unloadBinaryFile();
+        Type::clearNamedTypes();
+    }
+
+    settings->setOutputDirectory(outDir + "/");
+    LOG_MSG("Decompiled %1 of %2 binaries", numJobs - numFailed, numJobs);
+    return numFailed == 0 ? 0 : 1;
+}
+
+
 void CommandlineDriver::onCompilationTimeout()
 {
     LOG_WARN("Compilation timed out, Boomerang will now exit");
@@ -527,6 +699,11 @@ int CommandlineDriver::decompile(const QString &fname, const QString &pname)
     time_t start;
     time(&start);
 
+    if (minsToStopAfter > 0) {
+        // In batch mode, every binary gets the full time
+        m_kill_timer.start(1000 * 60 * minsToStopAfter);
+    }
+
     if (!loadAndDecode(fname, pname)) {
         return 1;
     }
@@ -70,6 +70,19 @@ private:
      */
     int decompile(const QString &fname, const QString &pname);
 
+    /**
+     * Decompile all binaries listed in the batch file one after another.
+     * The project (and with it the loaded plugins, decoder dictionaries
+     * and library signatures) is reused for all binaries.
+     * The output of each binary is written to a subdirectory of the output directory
+     * named after the binary. If several binaries have the same name, a number is appended
+     * to the names of the subdirectories of all but the first one (e.g. hello-2).
+     * The time limit (-S) applies to each binary separately.
+     *
+     * \returns Zero if all binaries were decompiled successfully, nonzero otherwise.
+     */
+    int runBatch();
+
 public slots:
     void onCompilationTimeout();
 
@@ -80,4 +93,5 @@ private:
     QTimer m_kill_timer;
     int minsToStopAfter = 0;
     QString m_pathToBinary;
+    QString m_batchFile; ///< List of binaries to decompile; "-" for stdin
 };
@@ -12,12 +12,15 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ifc/ICodeGenerator.h"
 #include "boomerang/util/CFGDotWriter.h"
 #include "boomerang/util/CallGraphDotWriter.h"
 #include "boomerang/util/DFGWriter.h"
+#include "boomerang/util/IRMemoryReport.h"
 #include "boomerang/util/UseGraphWriter.h"
 
 #include <QFile>
@@ -28,6 +31,26 @@
 #include <iostream>
 
 
+static void printStringEntry(OStream &os, const BinaryStringIndex::Entry &entry)
+{
+    const bool wide = entry.encoding == StringEncoding::UTF16LE;
+    QString text;
+
+    for (uint32_t i = 0; i < entry.length; i++) {
+        const char c = entry.data[wide ? 2 * i : i];
+        switch (c) {
+        case '\n': text += "\\n"; break;
+        case '\r': text += "\\r"; break;
+        case '\t': text += "\\t"; break;
+        case '"': text += "\\\""; break;
+        default: text += QChar::fromLatin1(c); break;
+        }
+    }
+
+    os << entry.addr << (wide ? " L\"" : " \"") << text << "\"\n";
+}
+
+
 Console::Console(Project *project)
     : m_project(project)
 {
@@ -250,8 +273,10 @@ CommandStatus Console::handleDecompile(const QStringList &args)
             procSet.insert(userProc);
         }
 
+        // Callees are only summarized, so requesting a single proc does not
+        // decompile (almost) the whole program
         for (UserProc *userProc : procSet) {
-            userProc->decompileRecursive();
+            m_project->decompileProc(userProc);
         }
 
         return CommandStatus::Success;
@@ -669,6 +694,68 @@ CommandStatus Console::handleInfo(const QStringList &args)
 
         return CommandStatus::Success;
     }
+    else if (args[0] == "memory") {
+        int topN = 10;
+
+        if (args.size() > 1) {
+            bool converted = false;
+            topN           = args[1].toInt(&converted, 0);
+
+            if (!converted || topN < 0) {
+                std::cerr << "Bad number of procedures '" << args[1].toStdString() << "'"
+                          << std::endl;
+                return CommandStatus::ParseError;
+            }
+        }
+
+        IRMemoryReport report(prog);
+        report.collect();
+
+        OStream outStream(stdout);
+        report.print(outStream, topN);
+        outStream << "\n";
+
+        return CommandStatus::Success;
+    }
+    else if (args[0] == "strings") {
+        const BinaryFile *binaryFile = prog->getBinaryFile();
+        if (!binaryFile) {
+            std::cerr << "No binary file loaded!" << std::endl;
+            return CommandStatus::Failure;
+        }
+
+        const BinaryStringIndex &strings = binaryFile->getImage()->getStringIndex();
+        OStream outStream(stdout);
+
+        if (args.size() > 1) {
+            bool converted     = false;
+            const Address addr = Address(args[1].toULongLong(&converted, 0));
+
+            if (!converted) {
+                std::cerr << "Bad address '" << args[1].toStdString() << "'" << std::endl;
+                return CommandStatus::ParseError;
+            }
+
+            for (StringEncoding enc : { StringEncoding::ASCII, StringEncoding::UTF16LE }) {
+                const BinaryStringIndex::Entry *entry = strings.find(addr, enc);
+                if (entry) {
+                    printStringEntry(outStream, *entry);
+                }
+            }
+
+            return CommandStatus::Success;
+        }
+
+        for (StringEncoding enc : { StringEncoding::ASCII, StringEncoding::UTF16LE }) {
+            for (auto it = strings.begin(enc); it != strings.end(enc); ++it) {
+                printStringEntry(outStream, *it);
+            }
+        }
+
+        outStream << strings.getNumStrings(StringEncoding::ASCII) << " ASCII strings, "
+                  << strings.getNumStrings(StringEncoding::UTF16LE) << " UTF-16 strings\n";
+        return CommandStatus::Success;
+    }
     else {
         std::cerr << "Unknown argument " << args[0].toStdString() << " for command 'info'"
                   << std::endl;
@@ -876,6 +963,10 @@ CommandStatus Console::handleHelp(const QStringList &args)
            "  info prog                          : Print information about the program.\n"
            "  info module <module>               : Print information about a module.\n"
            "  info proc <proc>                   : Print information about a proc.\n"
+           "  info memory [<n>]                  : Print IR memory usage and the <n> largest "
+           "procs.\n"
+           "  info strings [<addr>]              : Print all string literals or the string at "
+           "<addr>.\n"
            "  move proc <proc> <module>          : Moves the specified proc to the specified "
            "module.\n"
            "  move module <module> <parent>      : Moves the specified module to the specified "
@@ -129,6 +129,19 @@ void Decompiler::decompile()
 }
 
 
+void Decompiler::decompileProc(const QString &name)
+{
+    Function *proc = m_project.getProg()->getFunctionByName(name);
+
+    if (!proc || proc->isLib()) {
+        return;
+    }
+
+    m_project.decompileProc(static_cast<UserProc *>(proc));
+    emit procDecompileCompleted(name);
+}
+
+
 void Decompiler::moduleAndChildrenUpdated(Module *root)
 {
     emit moduleCreated(root->getName());
@@ -55,6 +55,7 @@ signals: // Decompiler -> ui
     void loadCompleted();
     void decodeCompleted();
     void decompileCompleted();
+    void procDecompileCompleted(const QString &procName);
     void generateCodeCompleted();
 
     void procDiscovered(const QString &callerName, const QString &procName);
@@ -77,6 +78,7 @@ public slots: // ui -> Decompiler
     void loadInputFile(const QString &inputFile, const QString &outputPath);
     void decode();
     void decompile();
+    void decompileProc(const QString &name); ///< Decompile a single proc on demand
     void generateCode();
 
     void stopWaiting();
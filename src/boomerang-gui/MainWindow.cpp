@@ -54,6 +54,8 @@ MainWindow::MainWindow(QWidget *_parent)
     connect(m_decompiler, &Decompiler::decompileCompleted, this, &MainWindow::decompileComplete);
     connect(m_decompiler, &Decompiler::generateCodeCompleted, this,
             &MainWindow::generateCodeComplete);
+    connect(m_decompiler, &Decompiler::procDecompileCompleted, this,
+            [this](const QString &name) { showRTLEditor(name); });
     connect(m_decompiler, &Decompiler::procDiscovered, this, &MainWindow::showConsideringProc);
     connect(m_decompiler, &Decompiler::procDecompileStarted, this,
             &MainWindow::showDecompilingProc);
@@ -77,6 +79,8 @@ MainWindow::MainWindow(QWidget *_parent)
             SLOT(addEntryPoint(Address, const QString &)));
     connect(this, SIGNAL(entryPointRemoved(Address)), m_decompiler,
             SLOT(removeEntryPoint(Address)));
+    connect(this, SIGNAL(procDecompileRequested(const QString &)), m_decompiler,
+            SLOT(decompileProc(const QString &)));
 
     ui->tblUserProcs->horizontalHeader()->disconnect(SIGNAL(sectionClicked(int)));
     connect(ui->tblUserProcs->horizontalHeader(), &QHeaderView::sectionClicked, this,
@@ -704,7 +708,15 @@ void MainWindow::showRTLEditor(const QString &name)
 void MainWindow::on_tblUserProcs_cellDoubleClicked(int row, int column)
 {
     Q_UNUSED(column);
-    showRTLEditor(ui->tblUserProcs->item(row, 1)->text());
+    const QString name = ui->tblUserProcs->item(row, 1)->text();
+
+    if (ui->stackedWidget->currentIndex() == 2) {
+        // Decoded, but not decompiled yet: Decompile just this proc
+        emit procDecompileRequested(name);
+    }
+    else {
+        showRTLEditor(name);
+    }
 }
 
 
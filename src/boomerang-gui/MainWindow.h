@@ -46,6 +46,7 @@ signals:
     void librarySignaturesOutdated();
     void entryPointAdded(Address entryAddr, const QString &name);
     void entryPointRemoved(Address entryAddr);
+    void procDecompileRequested(const QString &name);
 
 public slots:
     void loadComplete();
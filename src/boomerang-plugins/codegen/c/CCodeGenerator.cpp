@@ -113,6 +113,9 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
             print(module.get());
         }
     }
+
+    // Modules of the next program might be allocated at the same addresses
+    m_writer.clear();
 }
 
 
@@ -324,7 +327,7 @@ void CCodeGenerator::addIndCallStatement(const SharedExp &exp, const StatementLi
     QStringList arg_strings;
     QString arg_tgt;
 
-    for (SharedStmt ss : args) {
+    for (const SharedStmt &ss : args) {
         OStream arg_str(&arg_tgt);
         SharedExp arg = ss->as<Assign>()->getRight();
         appendExp(arg_str, arg, OpPrec::Comma);
@@ -452,8 +455,7 @@ void CCodeGenerator::generateCode(UserProc *proc)
     }
 
     // Start generating "real" code
-    std::list<const IRFragment *> followSet, gotoSet;
-    generateCode(proc->getEntryFragment(), nullptr, followSet, gotoSet, proc);
+    generateCode(proc->getEntryFragment());
 
     addProcEnd();
 
@@ -2108,31 +2110,109 @@ void CCodeGenerator::closeParen(OStream &str, OpPrec outer, OpPrec inner)
 }
 
 
-void CCodeGenerator::generateCode(const IRFragment *frag, const IRFragment *latch,
-                                  std::list<const IRFragment *> &followSet,
-                                  std::list<const IRFragment *> &gotoSet, UserProc *proc)
+void CCodeGenerator::FragStack::reset(std::size_t numFrags)
+{
+    m_stack.clear();
+    m_count.assign(numFrags, 0);
+}
+
+
+void CCodeGenerator::FragStack::push(const IRFragment *frag, FragIndex idx)
+{
+    m_stack.push_back({ frag, idx });
+    if (idx < m_count.size()) {
+        m_count[idx]++;
+    }
+}
+
+
+void CCodeGenerator::FragStack::pop()
 {
+    const FragIndex idx = m_stack.back().second;
+    if (idx < m_count.size()) {
+        m_count[idx]--;
+    }
+
+    m_stack.pop_back();
+}
+
+
+void CCodeGenerator::generateCode(const IRFragment *entry)
+{
+    m_followSet.reset(m_analyzer.getNumFragments());
+    m_gotoSet.reset(m_analyzer.getNumFragments());
+
+    m_genStack.clear();
+    m_genStack.emplace_back(GenStep::Visit, entry, nullptr);
+
+    while (!m_genStack.empty()) {
+        // Note: The frame is invalidated when a new frame is pushed.
+        GenFrame &frame = m_genStack.back();
+
+        switch (frame.step) {
+        case GenStep::Visit: generateCode_Visit(frame); break;
+        case GenStep::Loop: generateCode_Loop(frame); break;
+        case GenStep::LoopBodyDone: generateCode_LoopEnd(frame); break;
+        case GenStep::Branch: generateCode_Branch(frame); break;
+        case GenStep::BranchThenDone: generateCode_BranchThenDone(frame); break;
+        case GenStep::BranchElseDone:
+            // generate the closing bracket
+            addIfElseCondEnd();
+            generateCode_BranchFollow(frame);
+            break;
+        case GenStep::BranchCaseDone: generateCode_BranchCases(frame); break;
+        case GenStep::Seq: generateCode_Seq(frame); break;
+        case GenStep::SeqOtherDone:
+            addIfCondEnd();
+            generateCode_SeqSucc(frame);
+            break;
+        }
+    }
+}
+
+
+void CCodeGenerator::pushFrame(const IRFragment *frag, const IRFragment *latch)
+{
+    m_genStack.emplace_back(GenStep::Visit, frag, latch);
+}
+
+
+void CCodeGenerator::replaceFrame(const IRFragment *frag, const IRFragment *latch)
+{
+    m_genStack.back() = GenFrame(GenStep::Visit, frag, latch);
+}
+
+
+void CCodeGenerator::generateCode_Visit(GenFrame &frame)
+{
+    const IRFragment *frag  = frame.frag;
+    const IRFragment *latch = frame.latch;
+
     // If this is the follow for the most nested enclosing conditional, then don't generate
     // anything. Otherwise if it is in the follow set generate a goto to the follow
-    const IRFragment *enclFollow = followSet.empty() ? nullptr : followSet.back();
+    const IRFragment *enclFollow = m_followSet.empty() ? nullptr : m_followSet.top();
+    const FragIndex fragIdx      = m_analyzer.fragToIdx(frag);
 
-    if (Util::isContained(gotoSet, frag) && !m_analyzer.isLatchNode(frag) &&
+    if (m_gotoSet.contains(fragIdx) && !m_analyzer.isLatchNode(frag) &&
         ((latch && m_analyzer.getLoopHead(latch) &&
           (frag == m_analyzer.getLoopFollow(m_analyzer.getLoopHead(latch)))) ||
          !isAllParentsGenerated(frag))) {
         emitGotoAndLabel(frag, frag);
+        m_genStack.pop_back();
         return;
     }
-    else if (Util::isContained(followSet, frag)) {
+    else if (m_followSet.contains(fragIdx)) {
         if (frag != enclFollow) {
             emitGotoAndLabel(frag, frag);
         }
 
+        m_genStack.pop_back();
         return;
     }
 
     if (isGenerated(frag)) {
         // this should only occur for a loop over a single block
+        m_genStack.pop_back();
         return;
     }
     else {
@@ -2171,36 +2251,40 @@ void CCodeGenerator::generateCode(const IRFragment *frag, const IRFragment *latc
         //             emitGotoAndLabel(this, bb);
         //         }
         writeFragment(frag);
+        m_genStack.pop_back();
         return;
     }
 
     switch (m_analyzer.getStructType(frag)) {
     case StructType::Loop:
-    case StructType::LoopCond: generateCode_Loop(frag, gotoSet, proc, latch, followSet); break;
+    case StructType::LoopCond: frame.step = GenStep::Loop; break;
 
     case StructType::Cond: // if-else / case
-        generateCode_Branch(frag, gotoSet, proc, latch, followSet);
+        frame.step = GenStep::Branch;
         break;
 
-    case StructType::Seq: generateCode_Seq(frag, gotoSet, proc, latch, followSet); break;
+    case StructType::Seq: frame.step = GenStep::Seq; break;
 
     default:
         LOG_ERROR("Unhandled structuring type %1",
                   static_cast<int>(m_analyzer.getStructType(frag)));
+        m_genStack.pop_back();
     }
 }
 
 
-void CCodeGenerator::generateCode_Loop(const IRFragment *frag,
-                                       std::list<const IRFragment *> &gotoSet, UserProc *proc,
-                                       const IRFragment *latch,
-                                       std::list<const IRFragment *> &followSet)
+void CCodeGenerator::generateCode_Loop(GenFrame &frame)
 {
+    const IRFragment *frag = frame.frag;
+
     // add the follow of the loop (if it exists) to the follow set
     if (m_analyzer.getLoopFollow(frag)) {
-        followSet.push_back(m_analyzer.getLoopFollow(frag));
+        m_followSet.push(m_analyzer.getLoopFollow(frag),
+                         m_analyzer.fragToIdx(m_analyzer.getLoopFollow(frag)));
     }
 
+    frame.step = GenStep::LoopBodyDone;
+
     if (m_analyzer.getLoopType(frag) == LoopType::PreTested) {
         assert(m_analyzer.getLatchNode(frag)->getNumSuccessors() == 1);
 
@@ -2220,20 +2304,7 @@ void CCodeGenerator::generateCode_Loop(const IRFragment *frag,
         const IRFragment *loopBody = (frag->getSuccessor(BELSE) == m_analyzer.getLoopFollow(frag))
                                          ? frag->getSuccessor(BTHEN)
                                          : frag->getSuccessor(BELSE);
-        generateCode(loopBody, m_analyzer.getLatchNode(frag), followSet, gotoSet, proc);
-
-        // if code has not been generated for the latch node, generate it now
-        if (!isGenerated(m_analyzer.getLatchNode(frag))) {
-            m_generatedFrags.insert(m_analyzer.getLatchNode(frag));
-            writeFragment(m_analyzer.getLatchNode(frag));
-        }
-
-        // rewrite the body of the block (excluding the predicate) at the next nesting level after
-        // making sure another label won't be generated
-        writeFragment(frag);
-
-        // write the loop tail
-        addPretestedLoopEnd();
+        pushFrame(loopBody, m_analyzer.getLatchNode(frag));
     }
     else {
         // write the loop header
@@ -2247,74 +2318,96 @@ void CCodeGenerator::generateCode_Loop(const IRFragment *frag,
         // if this is also a conditional header, then generate code for the conditional. Otherwise
         // generate code for the loop body.
         if (m_analyzer.getStructType(frag) == StructType::LoopCond) {
-            // set the necessary flags so that generateCode can successfully be called again on this
+            // set the necessary flags so that code can successfully be generated again for this
             // node
             m_analyzer.setStructType(frag, StructType::Cond);
             m_analyzer.setTravType(frag, TravType::Untraversed);
             m_generatedFrags.erase(frag);
-            generateCode(frag, m_analyzer.getLatchNode(frag), followSet, gotoSet, proc);
+            pushFrame(frag, m_analyzer.getLatchNode(frag));
         }
         else {
             writeFragment(frag);
 
             // write the code for the body of the loop
-            generateCode(frag->getSuccessor(0), m_analyzer.getLatchNode(frag), followSet, gotoSet,
-                         proc);
+            pushFrame(frag->getSuccessor(0), m_analyzer.getLatchNode(frag));
         }
+    }
+}
 
-        if (m_analyzer.getLoopType(frag) == LoopType::PostTested) {
-            // if code has not been generated for the latch node, generate it now
-            if (!isGenerated(m_analyzer.getLatchNode(frag))) {
-                m_generatedFrags.insert(m_analyzer.getLatchNode(frag));
-                writeFragment(m_analyzer.getLatchNode(frag));
-            }
 
-            const IRFragment *myLatch = m_analyzer.getLatchNode(frag);
-            const IRFragment *myHead  = m_analyzer.getLoopHead(myLatch);
-            assert(myLatch->isType(FragType::Twoway));
+void CCodeGenerator::generateCode_LoopEnd(GenFrame &frame)
+{
+    const IRFragment *frag = frame.frag;
 
-            SharedExp cond = myLatch->getCond();
-            if (myLatch->getSuccessor(BELSE) == myHead) {
-                addPostTestedLoopEnd(Unary::get(opLNot, cond)->simplify());
-            }
-            else {
-                addPostTestedLoopEnd(cond->simplify());
-            }
+    if (m_analyzer.getLoopType(frag) == LoopType::PreTested) {
+        // if code has not been generated for the latch node, generate it now
+        if (!isGenerated(m_analyzer.getLatchNode(frag))) {
+            m_generatedFrags.insert(m_analyzer.getLatchNode(frag));
+            writeFragment(m_analyzer.getLatchNode(frag));
         }
-        else {
-            assert(m_analyzer.getLoopType(frag) == LoopType::Endless);
 
-            // if code has not been generated for the latch node, generate it now
-            if (!isGenerated(m_analyzer.getLatchNode(frag))) {
-                m_generatedFrags.insert(m_analyzer.getLatchNode(frag));
-                writeFragment(m_analyzer.getLatchNode(frag));
-            }
+        // rewrite the body of the block (excluding the predicate) at the next nesting level after
+        // making sure another label won't be generated
+        writeFragment(frag);
+
+        // write the loop tail
+        addPretestedLoopEnd();
+    }
+    else if (m_analyzer.getLoopType(frag) == LoopType::PostTested) {
+        // if code has not been generated for the latch node, generate it now
+        if (!isGenerated(m_analyzer.getLatchNode(frag))) {
+            m_generatedFrags.insert(m_analyzer.getLatchNode(frag));
+            writeFragment(m_analyzer.getLatchNode(frag));
+        }
+
+        const IRFragment *myLatch = m_analyzer.getLatchNode(frag);
+        const IRFragment *myHead  = m_analyzer.getLoopHead(myLatch);
+        assert(myLatch->isType(FragType::Twoway));
 
-            // write the closing bracket for an endless loop
-            addEndlessLoopEnd();
+        SharedExp cond = myLatch->getCond();
+        if (myLatch->getSuccessor(BELSE) == myHead) {
+            addPostTestedLoopEnd(Unary::get(opLNot, cond)->simplify());
         }
+        else {
+            addPostTestedLoopEnd(cond->simplify());
+        }
+    }
+    else {
+        assert(m_analyzer.getLoopType(frag) == LoopType::Endless);
+
+        // if code has not been generated for the latch node, generate it now
+        if (!isGenerated(m_analyzer.getLatchNode(frag))) {
+            m_generatedFrags.insert(m_analyzer.getLatchNode(frag));
+            writeFragment(m_analyzer.getLatchNode(frag));
+        }
+
+        // write the closing bracket for an endless loop
+        addEndlessLoopEnd();
     }
 
     // write the code for the follow of the loop (if it exists)
     if (m_analyzer.getLoopFollow(frag)) {
         // remove the follow from the follow set
-        followSet.pop_back();
+        m_followSet.pop();
 
         if (!isGenerated(m_analyzer.getLoopFollow(frag))) {
-            generateCode(m_analyzer.getLoopFollow(frag), latch, followSet, gotoSet, proc);
+            replaceFrame(m_analyzer.getLoopFollow(frag), frame.latch);
+            return;
         }
         else {
             emitGotoAndLabel(frag, m_analyzer.getLoopFollow(frag));
         }
     }
+
+    m_genStack.pop_back();
 }
 
 
-void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
-                                         std::list<const IRFragment *> &gotoSet, UserProc *proc,
-                                         const IRFragment *latch,
-                                         std::list<const IRFragment *> &followSet)
+void CCodeGenerator::generateCode_Branch(GenFrame &frame)
 {
+    const IRFragment *frag  = frame.frag;
+    const IRFragment *latch = frame.latch;
+
     // reset this back to LoopCond if it was originally of this type
     if (m_analyzer.getLatchNode(frag) != nullptr) {
         m_analyzer.setStructType(frag, StructType::LoopCond);
@@ -2322,15 +2415,16 @@ void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
 
     // for 2 way conditional headers that are effectively jumps into
     // or out of a loop or case body, we will need a new follow node
-    const IRFragment *tmpCondFollow = nullptr;
+    frame.succ = nullptr;
 
     // keep track of how many nodes were added to the goto set so that
     // the correct number are removed
-    int gotoTotal = 0;
+    frame.gotoTotal = 0;
 
     // add the follow to the follow set if this is a case header
     if (m_analyzer.getCondType(frag) == CondType::Case) {
-        followSet.push_back(m_analyzer.getCondFollow(frag));
+        m_followSet.push(m_analyzer.getCondFollow(frag),
+                         m_analyzer.fragToIdx(m_analyzer.getCondFollow(frag)));
     }
     else if (m_analyzer.getCondFollow(frag) != nullptr) {
         // For a structured two conditional header,
@@ -2338,7 +2432,8 @@ void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
         // myLoopHead = (sType == LoopCond ? this : loopHead);
 
         if (m_analyzer.getUnstructType(frag) == UnstructType::Structured) {
-            followSet.push_back(m_analyzer.getCondFollow(frag));
+            m_followSet.push(m_analyzer.getCondFollow(frag),
+                             m_analyzer.fragToIdx(m_analyzer.getCondFollow(frag)));
         }
 
         // Otherwise, for a jump into/outof a loop body, the follow is added to the goto set.
@@ -2351,28 +2446,30 @@ void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
                                                         StructType::LoopCond
                                                     ? frag
                                                     : m_analyzer.getLoopHead(frag));
-                gotoSet.push_back(m_analyzer.getCondFollow(frag));
-                gotoTotal++;
+                const IRFragment *follow     = m_analyzer.getCondFollow(frag);
+
+                m_gotoSet.push(follow, m_analyzer.fragToIdx(follow));
+                frame.gotoTotal++;
 
                 // also add the current latch node, and the loop header of the follow if they exist
                 if (latch) {
-                    gotoSet.push_back(latch);
-                    gotoTotal++;
+                    m_gotoSet.push(latch, m_analyzer.fragToIdx(latch));
+                    frame.gotoTotal++;
                 }
 
-                if (m_analyzer.getLoopHead(m_analyzer.getCondFollow(frag)) &&
-                    m_analyzer.getLoopHead(m_analyzer.getCondFollow(frag)) != myLoopHead) {
-                    gotoSet.push_back(m_analyzer.getLoopHead(m_analyzer.getCondFollow(frag)));
-                    gotoTotal++;
+                const IRFragment *follLoopHead = m_analyzer.getLoopHead(follow);
+                if (follLoopHead && follLoopHead != myLoopHead) {
+                    m_gotoSet.push(follLoopHead, m_analyzer.fragToIdx(follLoopHead));
+                    frame.gotoTotal++;
                 }
             }
 
-            tmpCondFollow = frag->getSuccessor(
+            frame.succ = frag->getSuccessor(
                 (m_analyzer.getCondType(frag) == CondType::IfThen) ? BELSE : BTHEN);
 
             // for a jump into a case, the temp follow is added to the follow set
             if (m_analyzer.getUnstructType(frag) == UnstructType::JumpIntoCase) {
-                followSet.push_back(tmpCondFollow);
+                m_followSet.push(frame.succ, m_analyzer.fragToIdx(frame.succ));
             }
         }
     }
@@ -2419,6 +2516,8 @@ void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
             (m_analyzer.getCondType(frag) == CondType::IfElse) ? BELSE : BTHEN);
         assert(succ != nullptr);
 
+        frame.step = GenStep::BranchThenDone;
+
         // emit a goto statement if the first clause has already been
         // generated or it is the follow of this node's enclosing loop
         if (isGenerated(succ) || (m_analyzer.getLoopHead(frag) &&
@@ -2426,79 +2525,109 @@ void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
             emitGotoAndLabel(frag, succ);
         }
         else {
-            generateCode(succ, latch, followSet, gotoSet, proc);
+            pushFrame(succ, latch);
         }
+    }
+    else {
+        // case header
 
-        // generate the else clause if necessary
-        if (m_analyzer.getCondType(frag) == CondType::IfThenElse) {
-            // generate the 'else' keyword and matching brackets
-            addIfElseCondOption();
+        if (psi) {
+            // first, determine the optimal fall-through ordering
+            const std::list<std::pair<SharedExp, const IRFragment *>>
+                switchDests = computeOptimalCaseOrdering(frag, psi);
 
-            succ = frag->getSuccessor(BELSE);
+            frame.switchDests.assign(switchDests.begin(), switchDests.end());
+        }
 
-            // emit a goto statement if the second clause has already
-            // been generated
-            if (isGenerated(succ)) {
-                emitGotoAndLabel(frag, succ);
-            }
-            else {
-                generateCode(succ, latch, followSet, gotoSet, proc);
-            }
+        frame.nextCase = 0;
+        frame.step     = GenStep::BranchCaseDone;
+    }
+}
 
-            // generate the closing bracket
-            addIfElseCondEnd();
+
+void CCodeGenerator::generateCode_BranchThenDone(GenFrame &frame)
+{
+    const IRFragment *frag = frame.frag;
+
+    // generate the else clause if necessary
+    if (m_analyzer.getCondType(frag) == CondType::IfThenElse) {
+        // generate the 'else' keyword and matching brackets
+        addIfElseCondOption();
+
+        const IRFragment *succ = frag->getSuccessor(BELSE);
+        frame.step             = GenStep::BranchElseDone;
+
+        // emit a goto statement if the second clause has already
+        // been generated
+        if (isGenerated(succ)) {
+            emitGotoAndLabel(frag, succ);
         }
         else {
-            // generate the closing bracket
-            addIfCondEnd();
+            pushFrame(succ, frame.latch);
         }
     }
     else {
-        // case header
+        // generate the closing bracket
+        addIfCondEnd();
+        generateCode_BranchFollow(frame);
+    }
+}
 
-        if (psi) {
-            // first, determine the optimal fall-through ordering
-            std::list<std::pair<SharedExp, const IRFragment *>>
-                switchDests = computeOptimalCaseOrdering(frag, psi);
 
-            for (auto it = switchDests.begin(); it != switchDests.end(); ++it) {
-                SharedExp caseValue    = it->first;
-                const IRFragment *succ = it->second;
+void CCodeGenerator::generateCode_BranchCases(GenFrame &frame)
+{
+    const IRFragment *frag = frame.frag;
 
-                addCaseCondOption(caseValue);
-                if (std::next(it) != switchDests.end() && std::next(it)->second == succ) {
-                    // multiple case values; generate the BB only for the last case value
-                    continue;
-                }
+    while (frame.nextCase < frame.switchDests.size()) {
+        SharedExp caseValue    = frame.switchDests[frame.nextCase].first;
+        const IRFragment *succ = frame.switchDests[frame.nextCase].second;
+        frame.nextCase++;
 
-                if (isGenerated(succ)) {
-                    emitGotoAndLabel(frag, succ);
-                }
-                else {
-                    generateCode(succ, latch, followSet, gotoSet, proc);
-                }
-            }
+        addCaseCondOption(caseValue);
+        if (frame.nextCase < frame.switchDests.size() &&
+            frame.switchDests[frame.nextCase].second == succ) {
+            // multiple case values; generate the BB only for the last case value
+            continue;
         }
 
-        // generate the closing bracket
-        addCaseCondEnd();
+        if (isGenerated(succ)) {
+            emitGotoAndLabel(frag, succ);
+        }
+        else {
+            // continue with the next case option when the code for this one has been generated
+            pushFrame(succ, frame.latch);
+            return;
+        }
     }
 
+    // generate the closing bracket
+    addCaseCondEnd();
+    generateCode_BranchFollow(frame);
+}
+
+
+void CCodeGenerator::generateCode_BranchFollow(GenFrame &frame)
+{
+    const IRFragment *frag = frame.frag;
+
     // do all the follow stuff if this conditional had one
     if (m_analyzer.getCondFollow(frag)) {
         // remove the original follow from the follow set if it was
         // added by this header
         if ((m_analyzer.getUnstructType(frag) == UnstructType::Structured) ||
             (m_analyzer.getUnstructType(frag) == UnstructType::JumpIntoCase)) {
-            assert(gotoTotal == 0);
-            followSet.resize(followSet.size() - 1);
+            assert(frame.gotoTotal == 0);
+            m_followSet.pop();
         }
         else { // remove all the nodes added to the goto set
-            gotoSet.resize(std::max((int)gotoSet.size() - gotoTotal, 0));
+            for (int i = 0; i < frame.gotoTotal && !m_gotoSet.empty(); i++) {
+                m_gotoSet.pop();
+            }
         }
 
         // do the code generation (or goto emitting) for the new conditional follow if it exists,
         // otherwise do it for the original follow
+        const IRFragment *tmpCondFollow = frame.succ;
         if (!tmpCondFollow) {
             tmpCondFollow = m_analyzer.getCondFollow(frag);
         }
@@ -2507,17 +2636,19 @@ void CCodeGenerator::generateCode_Branch(const IRFragment *frag,
             emitGotoAndLabel(frag, tmpCondFollow);
         }
         else {
-            generateCode(tmpCondFollow, latch, followSet, gotoSet, proc);
+            replaceFrame(tmpCondFollow, frame.latch);
+            return;
         }
     }
+
+    m_genStack.pop_back();
 }
 
 
-void CCodeGenerator::generateCode_Seq(const IRFragment *frag,
-                                      std::list<const IRFragment *> &gotoSet, UserProc *proc,
-                                      const IRFragment *latch,
-                                      std::list<const IRFragment *> &followSet)
+void CCodeGenerator::generateCode_Seq(GenFrame &frame)
 {
+    const IRFragment *frag = frame.frag;
+
     // generate code for the body of this block
     writeFragment(frag);
 
@@ -2526,13 +2657,14 @@ void CCodeGenerator::generateCode_Seq(const IRFragment *frag,
     if (frag->isType(FragType::Ret)) {
         // This should be emitted now, like a normal statement
         // addReturnStatement(getReturnVal());
+        m_genStack.pop_back();
         return;
     }
 
     // return if this doesn't have any out edges (emit a warning)
     if (frag->getNumSuccessors() == 0) {
         LOG_WARN("No out edge for fragment at address %1, in proc %2", frag->getLowAddr(),
-                 proc->getName());
+                 m_proc->getName());
 
         if (frag->isType(FragType::CompJump)) {
             assert(!frag->getRTLs()->empty());
@@ -2548,18 +2680,20 @@ void CCodeGenerator::generateCode_Seq(const IRFragment *frag,
             }
         }
 
+        m_genStack.pop_back();
         return;
     }
 
-    const IRFragment *succ = frag->getSuccessor(0);
+    frame.succ = frag->getSuccessor(0);
 
     if (frag->getNumSuccessors() > 1) {
         const IRFragment *other = frag->getSuccessor(1);
         LOG_MSG("Found seq with more than one outedge!");
         std::shared_ptr<Const> constDest = std::dynamic_pointer_cast<Const>(frag->getDest());
 
-        if (constDest && constDest->isIntConst() && (constDest->getAddr() == succ->getLowAddr())) {
-            std::swap(other, succ);
+        if (constDest && constDest->isIntConst() &&
+            (constDest->getAddr() == frame.succ->getLowAddr())) {
+            std::swap(other, frame.succ);
             LOG_MSG("Taken branch is first out edge");
         }
 
@@ -2567,21 +2701,31 @@ void CCodeGenerator::generateCode_Seq(const IRFragment *frag,
 
         if (cond) {
             addIfCondHeader(frag->getCond());
+            frame.step = GenStep::SeqOtherDone;
 
             if (isGenerated(other)) {
                 emitGotoAndLabel(frag, other);
             }
             else {
-                generateCode(other, latch, followSet, gotoSet, proc);
+                pushFrame(other, frame.latch);
             }
 
-            addIfCondEnd();
+            return;
         }
         else {
             LOG_ERROR("Last statement is not a cond, don't know what to do with this.");
         }
     }
 
+    generateCode_SeqSucc(frame);
+}
+
+
+void CCodeGenerator::generateCode_SeqSucc(GenFrame &frame)
+{
+    const IRFragment *frag = frame.frag;
+    const IRFragment *succ = frame.succ;
+
     // Generate code for its successor if
     //  - it hasn't already been visited and
     //  - is in the same loop/case and
@@ -2592,11 +2736,12 @@ void CCodeGenerator::generateCode_Seq(const IRFragment *frag,
         emitGotoAndLabel(frag, succ);
     }
     else if (m_analyzer.getLoopHead(succ) != m_analyzer.getLoopHead(frag) &&
-             (!isAllParentsGenerated(succ) || Util::isContained(followSet, succ))) {
+             (!isAllParentsGenerated(succ) ||
+              m_followSet.contains(m_analyzer.fragToIdx(succ)))) {
         emitGotoAndLabel(frag, succ);
     }
-    else if (latch && m_analyzer.getLoopHead(latch) &&
-             (m_analyzer.getLoopFollow(m_analyzer.getLoopHead(latch)) == succ)) {
+    else if (frame.latch && m_analyzer.getLoopHead(frame.latch) &&
+             (m_analyzer.getLoopFollow(m_analyzer.getLoopHead(frame.latch)) == succ)) {
         emitGotoAndLabel(frag, succ);
     }
     else if (m_analyzer.getCaseHead(succ) && m_analyzer.getCaseHead(frag) &&
@@ -2613,9 +2758,12 @@ void CCodeGenerator::generateCode_Seq(const IRFragment *frag,
         else if ((m_analyzer.getCaseHead(frag) == nullptr) ||
                  (m_analyzer.getCaseHead(frag) != m_analyzer.getCaseHead(succ)) ||
                  !m_analyzer.isCaseOption(succ)) {
-            generateCode(succ, latch, followSet, gotoSet, proc);
+            replaceFrame(succ, frame.latch);
+            return;
         }
     }
+
+    m_genStack.pop_back();
 }
 
 
@@ -24,6 +24,7 @@
 #include <list>
 #include <map>
 #include <unordered_set>
+#include <vector>
 
 
 class IRFragment;
@@ -280,18 +281,84 @@ private:
     void closeParen(OStream &str, OpPrec outer, OpPrec inner);
 
 
-    void generateCode(const IRFragment *frag, const IRFragment *latch,
-                      std::list<const IRFragment *> &followSet,
-                      std::list<const IRFragment *> &gotoSet, UserProc *proc);
-    void generateCode_Loop(const IRFragment *frag, std::list<const IRFragment *> &gotoSet,
-                           UserProc *proc, const IRFragment *latch,
-                           std::list<const IRFragment *> &followSet);
-    void generateCode_Branch(const IRFragment *frag, std::list<const IRFragment *> &gotoSet,
-                             UserProc *proc, const IRFragment *latch,
-                             std::list<const IRFragment *> &followSet);
-    void generateCode_Seq(const IRFragment *frag, std::list<const IRFragment *> &gotoSet,
-                          UserProc *proc, const IRFragment *latch,
-                          std::list<const IRFragment *> &followSet);
+    /// Steps of the code generation for a single fragment.
+    enum class GenStep : uint8_t
+    {
+        Visit,          ///< Decide how to generate code for the fragment
+        Loop,           ///< Loop header
+        LoopBodyDone,   ///< The body of the loop has been generated
+        Branch,         ///< Conditional header
+        BranchThenDone, ///< The first clause of the conditional has been generated
+        BranchElseDone, ///< The else clause of the conditional has been generated
+        BranchCaseDone, ///< The body of a case option has been generated
+        Seq,            ///< Sequential fragment
+        SeqOtherDone    ///< The second out edge of a sequential node has been generated
+    };
+
+    /// Code generation state of a single fragment. Replaces the stack frame
+    /// of the formerly recursive code generation functions.
+    struct GenFrame
+    {
+        GenFrame(GenStep _step, const IRFragment *_frag, const IRFragment *_latch)
+            : step(_step)
+            , frag(_frag)
+            , latch(_latch)
+        {
+        }
+
+        GenStep step;
+        const IRFragment *frag;  ///< The fragment to generate code for
+        const IRFragment *latch; ///< Latch node of the most nested enclosing loop
+
+        /// Successor of a sequential fragment, or temporary follow of a conditional header
+        const IRFragment *succ = nullptr;
+        int gotoTotal          = 0; ///< Number of fragments added to the goto set
+
+        /// Case options of a switch in the order they are emitted
+        std::vector<std::pair<SharedExp, const IRFragment *>> switchDests;
+        std::size_t nextCase = 0; ///< Index of the next case option to emit
+    };
+
+    /// Stack of fragments with constant time membership test.
+    /// A fragment can be on the stack more than once.
+    class FragStack
+    {
+    public:
+        /// Remove all fragments and prepare for a CFG with \p numFrags fragments.
+        void reset(std::size_t numFrags);
+
+        void push(const IRFragment *frag, FragIndex idx);
+        void pop();
+
+        bool contains(FragIndex idx) const { return idx < m_count.size() && m_count[idx] > 0; }
+        bool empty() const { return m_stack.empty(); }
+        std::size_t size() const { return m_stack.size(); }
+        const IRFragment *top() const { return m_stack.back().first; }
+
+    private:
+        std::vector<std::pair<const IRFragment *, FragIndex>> m_stack;
+        std::vector<int> m_count; ///< Number of times each fragment is on the stack
+    };
+
+    /// Generate code for all fragments of the current procedure reachable from \p entry.
+    /// The fragments are traversed using an explicit stack of GenFrames.
+    void generateCode(const IRFragment *entry);
+
+    /// Generate code for \p frag after the current step of the topmost frame is done.
+    void pushFrame(const IRFragment *frag, const IRFragment *latch);
+
+    /// Generate code for \p frag instead of continuing the topmost frame.
+    void replaceFrame(const IRFragment *frag, const IRFragment *latch);
+
+    void generateCode_Visit(GenFrame &frame);
+    void generateCode_Loop(GenFrame &frame);
+    void generateCode_LoopEnd(GenFrame &frame);
+    void generateCode_Branch(GenFrame &frame);
+    void generateCode_BranchThenDone(GenFrame &frame);
+    void generateCode_BranchCases(GenFrame &frame);
+    void generateCode_BranchFollow(GenFrame &frame);
+    void generateCode_Seq(GenFrame &frame);
+    void generateCode_SeqSucc(GenFrame &frame);
 
     /// Emits a goto statement (at the correct indentation level) with the destination label for
     /// dest. Also places the label just before the destination code if it isn't already there. If
@@ -337,6 +404,10 @@ private:
     std::unordered_set<Address::value_type> m_usedLabels;
     std::unordered_set<const IRFragment *> m_generatedFrags;
 
+    std::vector<GenFrame> m_genStack; ///< Code generation state of all fragments in progress
+    FragStack m_followSet;            ///< Follows of all enclosing structures
+    FragStack m_gotoSet;              ///< Fragments that can only be reached with a goto
+
     UserProc *m_proc = nullptr;
     ControlFlowAnalyzer m_analyzer;
 
@@ -60,3 +60,9 @@ bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
     it->second << lines.join('\n') << '\n';
     return true;
 }
+
+
+void CodeWriter::clear()
+{
+    m_dests.clear();
+}
@@ -65,6 +65,9 @@ public:
 public:
     bool writeCode(const Module *module, const QStringList &lines);
 
+    /// Close all output files.
+    void clear();
+
 private:
     WriteDestMap m_dests;
 };
@@ -13,6 +13,8 @@
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+
 
 // index of the "then" branch of conditional jumps
 #define BTHEN 0
@@ -30,6 +32,8 @@ void ControlFlowAnalyzer::structureCFG(ProcCFG *cfg)
 {
     m_cfg = cfg;
 
+    buildGraph();
+
     if (m_cfg->findRetFragment() == nullptr) {
         return;
     }
@@ -45,22 +49,99 @@ void ControlFlowAnalyzer::structureCFG(ProcCFG *cfg)
 }
 
 
+FragIndex ControlFlowAnalyzer::fragToIdx(const IRFragment *frag) const
+{
+    auto it = m_indices.find(frag);
+    return it != m_indices.end() ? it->second : INDEX_INVALID;
+}
+
+
+FragIndex ControlFlowAnalyzer::getOrCreateIdx(const IRFragment *frag)
+{
+    auto it = m_indices.find(frag);
+    if (it != m_indices.end()) {
+        return it->second;
+    }
+
+    const FragIndex idx = m_frags.size();
+    m_indices[frag]     = idx;
+    m_frags.push_back(frag);
+    m_info.emplace_back();
+    return idx;
+}
+
+
+void ControlFlowAnalyzer::buildGraph()
+{
+    m_frags.clear();
+    m_indices.clear();
+    m_info.clear();
+    m_succBegin.clear();
+    m_succs.clear();
+    m_predBegin.clear();
+    m_preds.clear();
+    m_postOrdering.clear();
+    m_revPostOrdering.clear();
+
+    m_indices.reserve(m_cfg->getNumFragments());
+    m_frags.reserve(m_cfg->getNumFragments());
+    m_info.reserve(m_cfg->getNumFragments());
+
+    for (const IRFragment *frag : *m_cfg) {
+        getOrCreateIdx(frag);
+    }
+
+    // Fragments that are not part of the CFG but are connected to it
+    // are numbered while building the edge lists.
+    for (FragIndex n = 0; n < m_frags.size(); ++n) {
+        const IRFragment *frag = m_frags[n];
+
+        m_succBegin.push_back(m_succs.size());
+        m_predBegin.push_back(m_preds.size());
+
+        for (const IRFragment *succ : frag->getSuccessors()) {
+            m_succs.push_back(getOrCreateIdx(succ));
+        }
+
+        for (const IRFragment *pred : frag->getPredecessors()) {
+            m_preds.push_back(getOrCreateIdx(pred));
+        }
+    }
+
+    m_succBegin.push_back(m_succs.size());
+    m_predBegin.push_back(m_preds.size());
+}
+
+
+std::size_t ControlFlowAnalyzer::getNumSuccessors(FragIndex idx) const
+{
+    if (idx + 1 >= m_succBegin.size()) {
+        return 0; // not part of the graph
+    }
+
+    return m_succBegin[idx + 1] - m_succBegin[idx];
+}
+
+
+bool ControlFlowAnalyzer::isType(FragIndex idx, FragType type) const
+{
+    return m_frags[idx]->isType(type);
+}
+
+
 void ControlFlowAnalyzer::setTimeStamps()
 {
     // set the parenthesis for the nodes as well as setting the post-order ordering between the
     // nodes
-    int time = 1;
-    m_postOrdering.clear();
-
-    updateLoopStamps(findEntryFragment(), time);
+    const FragIndex entry = fragToIdx(m_cfg->getEntryFragment());
+    assert(entry != INDEX_INVALID);
+    updateLoopStamps(entry);
 
     // set the reverse parenthesis for the nodes
-    time = 1;
-    updateRevLoopStamps(findEntryFragment(), time);
+    updateRevLoopStamps(entry);
 
-    IRFragment *retNode = findExitFragment();
-    assert(retNode);
-    m_revPostOrdering.clear();
+    const FragIndex retNode = fragToIdx(m_cfg->findRetFragment());
+    assert(retNode != INDEX_INVALID);
     updateRevOrder(retNode);
 }
 
@@ -69,52 +150,57 @@ void ControlFlowAnalyzer::updateImmedPDom()
 {
     // traverse the nodes in order (i.e from the bottom up)
     for (int i = m_revPostOrdering.size() - 1; i >= 0; i--) {
-        const IRFragment *frag = m_revPostOrdering[i];
+        const FragIndex frag = m_revPostOrdering[i];
 
-        for (IRFragment *succ : frag->getSuccessors()) {
+        for (std::size_t j = m_succBegin[frag]; j < m_succBegin[frag + 1]; ++j) {
+            const FragIndex succ = m_succs[j];
             if (getRevOrd(succ) > getRevOrd(frag)) {
-                setImmPDom(frag, findCommonPDom(getImmPDom(frag), succ));
+                m_info[frag].m_immPDom = findCommonPDom(m_info[frag].m_immPDom, succ);
             }
         }
     }
 
     // make a second pass but consider the original CFG ordering this time
-    for (const IRFragment *frag : m_postOrdering) {
-        if (frag->getNumSuccessors() <= 1) {
+    for (const FragIndex frag : m_postOrdering) {
+        if (getNumSuccessors(frag) <= 1) {
             continue;
         }
 
-        for (auto &succ : frag->getSuccessors()) {
-            IRFragment *succNode = succ;
-            setImmPDom(frag, findCommonPDom(getImmPDom(frag), succNode));
+        for (std::size_t j = m_succBegin[frag]; j < m_succBegin[frag + 1]; ++j) {
+            m_info[frag].m_immPDom = findCommonPDom(m_info[frag].m_immPDom, m_succs[j]);
         }
     }
 
     // one final pass to fix up nodes involved in a loop
-    for (const IRFragment *frag : m_postOrdering) {
-        if (frag->getNumSuccessors() > 1) {
-            for (const IRFragment *succ : frag->getSuccessors()) {
-                if (isBackEdge(frag, succ) && (frag->getNumSuccessors() > 1) && getImmPDom(succ) &&
-                    (getPostOrdering(getImmPDom(succ)) < getPostOrdering(getImmPDom(frag)))) {
-                    setImmPDom(frag, findCommonPDom(getImmPDom(succ), getImmPDom(frag)));
-                }
-                else {
-                    setImmPDom(frag, findCommonPDom(getImmPDom(frag), succ));
-                }
+    for (const FragIndex frag : m_postOrdering) {
+        if (getNumSuccessors(frag) <= 1) {
+            continue;
+        }
+
+        for (std::size_t j = m_succBegin[frag]; j < m_succBegin[frag + 1]; ++j) {
+            const FragIndex succ        = m_succs[j];
+            const FragIndex succImmPDom = m_info[succ].m_immPDom;
+            FragIndex &immPDom          = m_info[frag].m_immPDom;
+
+            if (isBackEdge(frag, succ) && succImmPDom != INDEX_INVALID &&
+                (getPostOrdering(succImmPDom) < getPostOrdering(immPDom))) {
+                immPDom = findCommonPDom(succImmPDom, immPDom);
+            }
+            else {
+                immPDom = findCommonPDom(immPDom, succ);
             }
         }
     }
 }
 
 
-const IRFragment *ControlFlowAnalyzer::findCommonPDom(const IRFragment *currImmPDom,
-                                                      const IRFragment *succImmPDom)
+FragIndex ControlFlowAnalyzer::findCommonPDom(FragIndex currImmPDom, FragIndex succImmPDom) const
 {
-    if (!currImmPDom) {
+    if (currImmPDom == INDEX_INVALID) {
         return succImmPDom;
     }
 
-    if (!succImmPDom) {
+    if (succImmPDom == INDEX_INVALID) {
         return currImmPDom;
     }
 
@@ -122,26 +208,27 @@ const IRFragment *ControlFlowAnalyzer::findCommonPDom(const IRFragment *currImmP
         return currImmPDom; // ordering hasn't been done
     }
 
-    const IRFragment *oldCurImmPDom  = currImmPDom;
-    const IRFragment *oldSuccImmPDom = succImmPDom;
+    const FragIndex oldCurImmPDom  = currImmPDom;
+    const FragIndex oldSuccImmPDom = succImmPDom;
 
     int giveup = 0;
 #define GIVEUP 10000
 
-    while (giveup < GIVEUP && currImmPDom && succImmPDom && (currImmPDom != succImmPDom)) {
+    while (giveup < GIVEUP && currImmPDom != INDEX_INVALID && succImmPDom != INDEX_INVALID &&
+           (currImmPDom != succImmPDom)) {
         if (getRevOrd(currImmPDom) > getRevOrd(succImmPDom)) {
-            succImmPDom = getImmPDom(succImmPDom);
+            succImmPDom = getInfo(succImmPDom).m_immPDom;
         }
         else {
-            currImmPDom = getImmPDom(currImmPDom);
+            currImmPDom = getInfo(currImmPDom).m_immPDom;
         }
 
         giveup++;
     }
 
     if (giveup >= GIVEUP) {
-        LOG_VERBOSE("Failed to find commonPDom for %1 and %2", oldCurImmPDom->getLowAddr(),
-                    oldSuccImmPDom->getLowAddr());
+        LOG_VERBOSE("Failed to find commonPDom for %1 and %2", m_frags[oldCurImmPDom]->getLowAddr(),
+                    m_frags[oldSuccImmPDom]->getLowAddr());
 
         return oldCurImmPDom; // no change
     }
@@ -153,21 +240,21 @@ const IRFragment *ControlFlowAnalyzer::findCommonPDom(const IRFragment *currImmP
 void ControlFlowAnalyzer::structConds()
 {
     // Process the nodes in order
-    for (const IRFragment *currNode : m_postOrdering) {
-        if (currNode->getNumSuccessors() <= 1) {
+    for (const FragIndex currNode : m_postOrdering) {
+        if (getNumSuccessors(currNode) <= 1) {
             // not an if/case condition
             continue;
         }
 
         // if the current conditional header is a two way node and has a back edge,
         // then it won't have a follow
-        if (hasBackEdge(currNode) && currNode->isType(FragType::Twoway)) {
+        if (hasBackEdge(currNode) && isType(currNode, FragType::Twoway)) {
             setStructType(currNode, StructType::Cond);
             continue;
         }
 
         // set the follow of a node to be its immediate post dominator
-        setCondFollow(currNode, getImmPDom(currNode));
+        m_info[currNode].m_condFollow = m_info[currNode].m_immPDom;
 
         // set the structured type of this node
         setStructType(currNode, StructType::Cond);
@@ -175,32 +262,35 @@ void ControlFlowAnalyzer::structConds()
         // if this is an nway header, then we have to tag each of the nodes within the body of
         // the nway subgraph
         if (getCondType(currNode) == CondType::Case) {
-            setCaseHead(currNode, currNode, getCondFollow(currNode));
+            setCaseHead(currNode, m_info[currNode].m_condFollow);
         }
     }
 }
 
 
-void ControlFlowAnalyzer::determineLoopType(const IRFragment *header, bool *&loopNodes)
+void ControlFlowAnalyzer::determineLoopType(FragIndex header)
 {
-    assert(getLatchNode(header));
+    const FragIndex latch = m_info[header].m_latchNode;
+    assert(latch != INDEX_INVALID);
 
     // if the latch node is a two way node then this must be a post tested loop
-    if (getLatchNode(header)->isType(FragType::Twoway)) {
+    if (isType(latch, FragType::Twoway)) {
         setLoopType(header, LoopType::PostTested);
 
         // if the head of the loop is a two way node and the loop spans more than one block  then it
         // must also be a conditional header
-        if (header->isType(FragType::Twoway) && (header != getLatchNode(header))) {
+        if (isType(header, FragType::Twoway) && (header != latch)) {
             setStructType(header, StructType::LoopCond);
         }
     }
     // otherwise it is either a pretested or endless loop
-    else if (header->isType(FragType::Twoway)) {
+    else if (isType(header, FragType::Twoway)) {
         // if the header is a two way node then it must have a conditional follow (since it can't
         // have any backedges leading from it). If this follow is within the loop then this must be
         // an endless loop
-        if (getCondFollow(header) && loopNodes[getPostOrdering(getCondFollow(header))]) {
+        const FragIndex condFollow = m_info[header].m_condFollow;
+
+        if (condFollow != INDEX_INVALID && isInCurrentLoop(condFollow)) {
             setLoopType(header, LoopType::Endless);
 
             // retain the fact that this is also a conditional header
@@ -217,41 +307,42 @@ void ControlFlowAnalyzer::determineLoopType(const IRFragment *header, bool *&loo
 }
 
 
-void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNodes)
+void ControlFlowAnalyzer::findLoopFollow(FragIndex header)
 {
-    assert(getStructType(header) == StructType::Loop ||
-           getStructType(header) == StructType::LoopCond);
+    assert(m_info[header].m_structuringType == StructType::Loop ||
+           m_info[header].m_structuringType == StructType::LoopCond);
     const LoopType loopType = getLoopType(header);
-    const IRFragment *latch = getLatchNode(header);
+    const FragIndex latch   = m_info[header].m_latchNode;
 
     if (loopType == LoopType::PreTested) {
         // if the 'while' loop's true child is within the loop, then its false child is the loop
         // follow
-        if (loopNodes[getPostOrdering(header->getSuccessor(BTHEN))]) {
-            setLoopFollow(header, header->getSuccessor(BELSE));
+        if (isInCurrentLoop(getSuccessor(header, BTHEN))) {
+            m_info[header].m_loopFollow = getSuccessor(header, BELSE);
         }
         else {
-            setLoopFollow(header, header->getSuccessor(BTHEN));
+            m_info[header].m_loopFollow = getSuccessor(header, BTHEN);
         }
     }
     else if (loopType == LoopType::PostTested) {
         // the follow of a post tested ('repeat') loop is the node on the end of the non-back edge
         // from the latch node
-        if (latch->getSuccessor(BELSE) == header) {
-            setLoopFollow(header, latch->getSuccessor(BTHEN));
+        if (getSuccessor(latch, BELSE) == header) {
+            m_info[header].m_loopFollow = getSuccessor(latch, BTHEN);
         }
         else {
-            setLoopFollow(header, latch->getSuccessor(BELSE));
+            m_info[header].m_loopFollow = getSuccessor(latch, BELSE);
         }
     }
     else {
         // endless loop
-        const IRFragment *follow = nullptr;
+        FragIndex follow = INDEX_INVALID;
 
         // traverse the ordering array between the header and latch nodes.
-        // IRFragment * latch = header->getLatchNode(); initialized at function start
         for (int i = getPostOrdering(header) - 1; i > getPostOrdering(latch); i--) {
-            const IRFragment *&desc = m_postOrdering[i];
+            const FragIndex desc           = m_postOrdering[i];
+            const FragStructInfo &descInfo = m_info[desc];
+
             // the follow for an endless loop will have the following
             // properties:
             //   i) it will have a parent that is a conditional header inside the loop whose follow
@@ -259,13 +350,13 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
             //  ii) it will be outside the loop according to its loop stamp pair
             // iii) have the highest ordering of all suitable follows (i.e. highest in the graph)
 
-            if ((getStructType(desc) == StructType::Cond) && getCondFollow(desc) &&
-                (getLoopHead(desc) == header)) {
-                if (loopNodes[getPostOrdering(getCondFollow(desc))]) {
+            if ((descInfo.m_structuringType == StructType::Cond) &&
+                descInfo.m_condFollow != INDEX_INVALID && (descInfo.m_loopHead == header)) {
+                if (isInCurrentLoop(descInfo.m_condFollow)) {
                     // if the conditional's follow is in the same loop AND is lower in the loop,
                     // jump to this follow
-                    if (getPostOrdering(desc) > getPostOrdering(getCondFollow(desc))) {
-                        i = getPostOrdering(getCondFollow(desc));
+                    if (getPostOrdering(desc) > getPostOrdering(descInfo.m_condFollow)) {
+                        i = getPostOrdering(descInfo.m_condFollow);
                     }
                     else {
                         // otherwise there is a backward jump somewhere to a node earlier in this
@@ -277,20 +368,23 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
                 else {
                     // otherwise find the child (if any) of the conditional header that isn't inside
                     // the same loop
-                    const IRFragment *succ = desc->getSuccessor(BTHEN);
+                    FragIndex succ = getSuccessor(desc, BTHEN);
 
-                    if (loopNodes[getPostOrdering(succ)]) {
-                        if (!loopNodes[getPostOrdering(desc->getSuccessor(BELSE))]) {
-                            succ = desc->getSuccessor(BELSE);
+                    if (isInCurrentLoop(succ)) {
+                        if (!isInCurrentLoop(getSuccessor(desc, BELSE))) {
+                            succ = getSuccessor(desc, BELSE);
                         }
                         else {
-                            succ = nullptr;
+                            succ = INDEX_INVALID;
                         }
                     }
 
                     // if a potential follow was found, compare its ordering with the currently
                     // found follow
-                    if (succ && (!follow || (getPostOrdering(succ) > getPostOrdering(follow)))) {
+                    const bool isHigher = follow == INDEX_INVALID ||
+                                          getPostOrdering(succ) > getPostOrdering(follow);
+
+                    if (succ != INDEX_INVALID && isHigher) {
                         follow = succ;
                     }
                 }
@@ -299,14 +393,14 @@ void ControlFlowAnalyzer::findLoopFollow(const IRFragment *header, bool *&loopNo
 
         // if a follow was found, assign it to be the follow of the loop under
         // investigation
-        if (follow) {
-            setLoopFollow(header, follow);
+        if (follow != INDEX_INVALID) {
+            m_info[header].m_loopFollow = follow;
         }
     }
 }
 
 
-void ControlFlowAnalyzer::tagNodesInLoop(const IRFragment *header, bool *&loopNodes)
+void ControlFlowAnalyzer::tagNodesInLoop(FragIndex header)
 {
     // Traverse the ordering structure from the header to the latch node tagging the nodes
     // determined to be within the loop. These are nodes that satisfy the following:
@@ -318,15 +412,15 @@ void ControlFlowAnalyzer::tagNodesInLoop(const IRFragment *header, bool *&loopNo
     //    OR
     //  iii) curNode is the latch node
 
-    const IRFragment *latch = getLatchNode(header);
-    assert(latch);
+    const FragIndex latch = m_info[header].m_latchNode;
+    assert(latch != INDEX_INVALID);
 
     for (int i = getPostOrdering(header) - 1; i >= getPostOrdering(latch); i--) {
         if (isFragInLoop(m_postOrdering[i], header, latch)) {
             // update the membership map to reflect that this node is within the loop
-            loopNodes[i] = true;
+            m_loopNodes[i] = true;
 
-            setLoopHead(m_postOrdering[i], header);
+            m_info[m_postOrdering[i]].m_loopHead = header;
         }
     }
 }
@@ -334,9 +428,13 @@ void ControlFlowAnalyzer::tagNodesInLoop(const IRFragment *header, bool *&loopNo
 
 void ControlFlowAnalyzer::structLoops()
 {
+    m_loopNodes.assign(m_postOrdering.size(), false);
+
     for (int i = m_postOrdering.size() - 1; i >= 0; i--) {
-        const IRFragment *currFrag = m_postOrdering[i]; // the current node under investigation
-        const IRFragment *latch    = nullptr;           // the latching node of the loop
+        const FragIndex currFrag = m_postOrdering[i]; // the current node under investigation
+        FragIndex latch          = INDEX_INVALID;     // the latching node of the loop
+
+        const FragStructInfo &currInfo = m_info[currFrag];
 
         // If the current node has at least one back edge into it, it is a loop header. If there are
         // numerous back edges into the header, determine which one comes form the proper latching
@@ -349,34 +447,33 @@ void ControlFlowAnalyzer::structLoops()
         //    vi) has a lower ordering than all other suitable candiates
         // If no nodes meet the above criteria, then the current node is not a loop header
 
-        for (const IRFragment *pred : currFrag->getPredecessors()) {
-            if ((getCaseHead(pred) == getCaseHead(currFrag)) &&                      // ii)
-                (getLoopHead(pred) == getLoopHead(currFrag)) &&                      // iii)
-                (!latch || (getPostOrdering(latch) > getPostOrdering(pred))) &&      // vi)
-                !(getLoopHead(pred) && (getLatchNode(getLoopHead(pred)) == pred)) && // v)
-                isBackEdge(pred, currFrag)) {                                        // i)
+        for (std::size_t j = m_predBegin[currFrag]; j < m_predBegin[currFrag + 1]; ++j) {
+            const FragIndex pred           = m_preds[j];
+            const FragStructInfo &predInfo = m_info[pred];
+
+            const bool isEnclosingLatch = predInfo.m_loopHead != INDEX_INVALID &&
+                                          m_info[predInfo.m_loopHead].m_latchNode == pred;
+
+            if ((predInfo.m_caseHead == currInfo.m_caseHead) &&                        // ii)
+                (predInfo.m_loopHead == currInfo.m_loopHead) &&                        // iii)
+                (latch == INDEX_INVALID || getPostOrdering(latch) > getPostOrdering(pred)) && // vi)
+                !isEnclosingLatch &&                                                   // v)
+                isBackEdge(pred, currFrag)) {                                          // i)
                 latch = pred;
             }
         }
 
         // if a latching node was found for the current node then it is a loop header.
-        if (!latch) {
+        if (latch == INDEX_INVALID) {
             continue;
         }
 
-        // define the map that maps each node to whether or not it is within the current loop
-        bool *loopNodes = new bool[m_postOrdering.size()];
-
-        for (unsigned int j = 0; j < m_postOrdering.size(); j++) {
-            loopNodes[j] = false;
-        }
-
-        setLatchNode(currFrag, latch);
+        m_info[currFrag].m_latchNode = latch;
 
         // the latching node may already have been structured as a conditional header. If it is
         // not also the loop header (i.e. the loop is over more than one block) then reset it to
         // be a sequential node otherwise it will be correctly set as a loop header only later
-        if ((latch != currFrag) && (getStructType(latch) == StructType::Cond)) {
+        if ((latch != currFrag) && (m_info[latch].m_structuringType == StructType::Cond)) {
             setStructType(latch, StructType::Seq);
         }
 
@@ -384,53 +481,61 @@ void ControlFlowAnalyzer::structLoops()
         setStructType(currFrag, StructType::Loop);
 
         // tag the members of this loop
-        tagNodesInLoop(currFrag, loopNodes);
+        tagNodesInLoop(currFrag);
 
         // calculate the type of this loop
-        determineLoopType(currFrag, loopNodes);
+        determineLoopType(currFrag);
 
         // calculate the follow node of this loop
-        findLoopFollow(currFrag, loopNodes);
+        findLoopFollow(currFrag);
 
-        delete[] loopNodes;
+        // reset the membership map; only the nodes between the header and the latch were tagged
+        const int first = std::max(getPostOrdering(latch), 0);
+        const int last  = getPostOrdering(currFrag);
+        if (first < last) {
+            std::fill(m_loopNodes.begin() + first, m_loopNodes.begin() + last, false);
+        }
     }
 }
 
 
 void ControlFlowAnalyzer::checkConds()
 {
-    for (const IRFragment *currNode : m_postOrdering) {
+    for (const FragIndex currNode : m_postOrdering) {
+        const FragStructInfo &currInfo = m_info[currNode];
+
         // consider only conditional headers that have a follow and aren't case headers
-        if (((getStructType(currNode) == StructType::Cond) ||
-             (getStructType(currNode) == StructType::LoopCond)) &&
-            getCondFollow(currNode) && (getCondType(currNode) != CondType::Case)) {
+        if (((currInfo.m_structuringType == StructType::Cond) ||
+             (currInfo.m_structuringType == StructType::LoopCond)) &&
+            currInfo.m_condFollow != INDEX_INVALID && (getCondType(currNode) != CondType::Case)) {
             // define convenient aliases for the relevant loop and case heads and the out edges
-            const IRFragment *myLoopHead = (getStructType(currNode) == StructType::LoopCond)
-                                               ? currNode
-                                               : getLoopHead(currNode);
-            const IRFragment *follLoopHead = getLoopHead(getCondFollow(currNode));
-            const IRFragment *fragThen     = currNode->getSuccessor(BTHEN);
-            const IRFragment *fragElse     = currNode->getSuccessor(BELSE);
+            const FragIndex myLoopHead = (currInfo.m_structuringType == StructType::LoopCond)
+                                             ? currNode
+                                             : currInfo.m_loopHead;
+            const FragIndex follLoopHead = getInfo(currInfo.m_condFollow).m_loopHead;
+            const FragIndex fragThen     = getSuccessor(currNode, BTHEN);
+            const FragIndex fragElse     = getSuccessor(currNode, BELSE);
 
             // analyse whether this is a jump into/outof a loop
             if (myLoopHead != follLoopHead) {
                 // we want to find the branch that the latch node is on for a jump out of a loop
-                if (myLoopHead) {
+                if (myLoopHead != INDEX_INVALID) {
                     // this is a jump out of a loop (break or return)
-                    if (getLoopHead(fragThen) != nullptr) {
+                    if (getInfo(fragThen).m_loopHead != INDEX_INVALID) {
                         // the "else" branch jumps out of the loop. (e.g. "if (!foo) break;")
                         setUnstructType(currNode, UnstructType::JumpInOutLoop);
                         setCondType(currNode, CondType::IfElse);
                     }
                     else {
-                        assert(getLoopHead(fragElse) != nullptr);
+                        assert(getInfo(fragElse).m_loopHead != INDEX_INVALID);
                         // the "then" branch jumps out of the loop
                         setUnstructType(currNode, UnstructType::JumpInOutLoop);
                         setCondType(currNode, CondType::IfThen);
                     }
                 }
 
-                if ((getUnstructType(currNode) == UnstructType::Structured) && follLoopHead) {
+                if ((getUnstructType(currNode) == UnstructType::Structured) &&
+                    follLoopHead != INDEX_INVALID) {
                     // find the branch that the loop head is on for a jump into a loop body. If a
                     // branch has already been found, then it will match this one anyway
 
@@ -449,20 +554,21 @@ void ControlFlowAnalyzer::checkConds()
 
             // this is a jump into a case body if either of its children don't have the same same
             // case header as itself
-            if ((getUnstructType(currNode) == UnstructType::Structured) &&
-                ((getCaseHead(currNode) != getCaseHead(fragThen)) ||
-                 (getCaseHead(currNode) != getCaseHead(fragElse)))) {
-                const IRFragment *myCaseHead   = getCaseHead(currNode);
-                const IRFragment *thenCaseHead = getCaseHead(fragThen);
-                const IRFragment *elseCaseHead = getCaseHead(fragElse);
+            const FragIndex myCaseHead   = currInfo.m_caseHead;
+            const FragIndex thenCaseHead = getInfo(fragThen).m_caseHead;
+            const FragIndex elseCaseHead = getInfo(fragElse).m_caseHead;
 
+            if ((getUnstructType(currNode) == UnstructType::Structured) &&
+                ((myCaseHead != thenCaseHead) || (myCaseHead != elseCaseHead))) {
                 if ((thenCaseHead == myCaseHead) &&
-                    (!myCaseHead || (elseCaseHead != getCondFollow(myCaseHead)))) {
+                    (myCaseHead == INDEX_INVALID ||
+                     (elseCaseHead != m_info[myCaseHead].m_condFollow))) {
                     setUnstructType(currNode, UnstructType::JumpIntoCase);
                     setCondType(currNode, CondType::IfElse);
                 }
                 else if ((elseCaseHead == myCaseHead) &&
-                         (!myCaseHead || (thenCaseHead != getCondFollow(myCaseHead)))) {
+                         (myCaseHead == INDEX_INVALID ||
+                          (thenCaseHead != m_info[myCaseHead].m_condFollow))) {
                     setUnstructType(currNode, UnstructType::JumpIntoCase);
                     setCondType(currNode, CondType::IfThen);
                 }
@@ -472,18 +578,18 @@ void ControlFlowAnalyzer::checkConds()
         // for 2 way conditional headers that don't have a follow (i.e. are the source of a back
         // edge) and haven't been structured as latching nodes, set their follow to be the non-back
         // edge child.
-        if ((getStructType(currNode) == StructType::Cond) && !getCondFollow(currNode) &&
-            (getCondType(currNode) != CondType::Case) &&
+        if ((currInfo.m_structuringType == StructType::Cond) &&
+            currInfo.m_condFollow == INDEX_INVALID && (getCondType(currNode) != CondType::Case) &&
             (getUnstructType(currNode) == UnstructType::Structured)) {
             // latching nodes will already have been reset to Seq structured type
             if (hasBackEdge(currNode)) {
-                if (isBackEdge(currNode, currNode->getSuccessor(BTHEN))) {
+                if (isBackEdge(currNode, getSuccessor(currNode, BTHEN))) {
                     setCondType(currNode, CondType::IfThen);
-                    setCondFollow(currNode, currNode->getSuccessor(BELSE));
+                    m_info[currNode].m_condFollow = getSuccessor(currNode, BELSE);
                 }
                 else {
                     setCondType(currNode, CondType::IfElse);
-                    setCondFollow(currNode, currNode->getSuccessor(BTHEN));
+                    m_info[currNode].m_condFollow = getSuccessor(currNode, BTHEN);
                 }
             }
         }
@@ -491,7 +597,7 @@ void ControlFlowAnalyzer::checkConds()
 }
 
 
-bool ControlFlowAnalyzer::isBackEdge(const IRFragment *source, const IRFragment *dest) const
+bool ControlFlowAnalyzer::isBackEdge(FragIndex source, FragIndex dest) const
 {
     return dest == source || isAncestorOf(dest, source);
 }
@@ -499,12 +605,13 @@ bool ControlFlowAnalyzer::isBackEdge(const IRFragment *source, const IRFragment
 
 bool ControlFlowAnalyzer::isCaseOption(const IRFragment *frag) const
 {
-    if (!getCaseHead(frag)) {
+    const IRFragment *caseHead = getCaseHead(frag);
+    if (!caseHead) {
         return false;
     }
 
-    for (int i = 0; i < getCaseHead(frag)->getNumSuccessors() - 1; i++) {
-        if (getCaseHead(frag)->getSuccessor(i) == frag) {
+    for (int i = 0; i < caseHead->getNumSuccessors() - 1; i++) {
+        if (caseHead->getSuccessor(i) == frag) {
             return true;
         }
     }
@@ -513,139 +620,217 @@ bool ControlFlowAnalyzer::isCaseOption(const IRFragment *frag) const
 }
 
 
-bool ControlFlowAnalyzer::isAncestorOf(const IRFragment *frag, const IRFragment *other) const
+bool ControlFlowAnalyzer::isAncestorOf(FragIndex frag, FragIndex other) const
 {
-    return (m_info[frag].m_preOrderID < m_info[other].m_preOrderID &&
-            m_info[frag].m_postOrderID > m_info[other].m_postOrderID) ||
-           (m_info[frag].m_revPreOrderID < m_info[other].m_revPreOrderID &&
-            m_info[frag].m_revPostOrderID > m_info[other].m_revPostOrderID);
+    const FragStructInfo &fragInfo  = getInfo(frag);
+    const FragStructInfo &otherInfo = getInfo(other);
+
+    return (fragInfo.m_preOrderID < otherInfo.m_preOrderID &&
+            fragInfo.m_postOrderID > otherInfo.m_postOrderID) ||
+           (fragInfo.m_revPreOrderID < otherInfo.m_revPreOrderID &&
+            fragInfo.m_revPostOrderID > otherInfo.m_revPostOrderID);
 }
 
 
-void ControlFlowAnalyzer::updateLoopStamps(const IRFragment *frag, int &time)
+void ControlFlowAnalyzer::updateLoopStamps(FragIndex entry)
 {
+    // Iterative depth first search. The stack holds the current path from the entry fragment
+    // together with the position of the next successor to visit for each fragment on the path.
+    int time = 1;
+    m_stack.clear();
+
     // timestamp the current node with the current time
     // and set its traversed flag
-    setTravType(frag, TravType::DFS_LNum);
-    m_info[frag].m_preOrderID = time;
-
-    // recurse on unvisited children and set inedges for all children
-    for (const IRFragment *succ : frag->getSuccessors()) {
-        // set the in edge from this child to its parent (the current node)
-        // (not done here, might be a problem)
-        // outEdges[i]->inEdges.Add(this);
+    m_info[entry].m_travType   = TravType::DFS_LNum;
+    m_info[entry].m_preOrderID = time;
+    m_stack.push_back({ entry, m_succBegin[entry] });
+
+    while (!m_stack.empty()) {
+        const FragIndex frag = m_stack.back().first;
+        std::size_t &pos     = m_stack.back().second;
+
+        if (pos < m_succBegin[frag + 1]) {
+            const FragIndex succ = m_succs[pos++];
+
+            // visit this child if it hasn't already been visited
+            if (m_info[succ].m_travType != TravType::DFS_LNum) {
+                m_info[succ].m_travType   = TravType::DFS_LNum;
+                m_info[succ].m_preOrderID = ++time;
+                m_stack.push_back({ succ, m_succBegin[succ] });
+            }
 
-        // recurse on this child if it hasn't already been visited
-        if (getTravType(succ) != TravType::DFS_LNum) {
-            updateLoopStamps(succ, ++time);
+            continue;
         }
-    }
 
-    // set the the second loopStamp value
-    m_info[frag].m_postOrderID = ++time;
+        // set the the second loopStamp value
+        m_info[frag].m_postOrderID = ++time;
 
-    // add this node to the ordering structure as well as recording its position within the ordering
-    m_info[frag].m_postOrderIndex = static_cast<int>(m_postOrdering.size());
-    m_postOrdering.push_back(frag);
+        // add this node to the ordering structure as well as recording its position within the
+        // ordering
+        m_info[frag].m_postOrderIndex = static_cast<int>(m_postOrdering.size());
+        m_postOrdering.push_back(frag);
+        m_stack.pop_back();
+    }
 }
 
 
-void ControlFlowAnalyzer::updateRevLoopStamps(const IRFragment *frag, int &time)
+void ControlFlowAnalyzer::updateRevLoopStamps(FragIndex entry)
 {
+    // Same as updateLoopStamps, but successors are visited in reverse order.
+    // The position is the number of successors that are still to be visited.
+    int time = 1;
+    m_stack.clear();
+
     // timestamp the current node with the current time and set its traversed flag
-    setTravType(frag, TravType::DFS_RNum);
-    m_info[frag].m_revPreOrderID = time;
+    m_info[entry].m_travType      = TravType::DFS_RNum;
+    m_info[entry].m_revPreOrderID = time;
+    m_stack.push_back({ entry, getNumSuccessors(entry) });
+
+    while (!m_stack.empty()) {
+        const FragIndex frag = m_stack.back().first;
+        std::size_t &pos     = m_stack.back().second;
+
+        if (pos > 0) {
+            const FragIndex succ = m_succs[m_succBegin[frag] + --pos];
+
+            // visit this child if it hasn't already been visited
+            if (m_info[succ].m_travType != TravType::DFS_RNum) {
+                m_info[succ].m_travType      = TravType::DFS_RNum;
+                m_info[succ].m_revPreOrderID = ++time;
+                m_stack.push_back({ succ, getNumSuccessors(succ) });
+            }
 
-    // recurse on the unvisited children in reverse order
-    for (int i = frag->getNumSuccessors() - 1; i >= 0; i--) {
-        // recurse on this child if it hasn't already been visited
-        if (getTravType(frag->getSuccessor(i)) != TravType::DFS_RNum) {
-            updateRevLoopStamps(frag->getSuccessor(i), ++time);
+            continue;
         }
-    }
 
-    m_info[frag].m_revPostOrderID = ++time;
+        m_info[frag].m_revPostOrderID = ++time;
+        m_stack.pop_back();
+    }
 }
 
 
-void ControlFlowAnalyzer::updateRevOrder(const IRFragment *frag)
+void ControlFlowAnalyzer::updateRevOrder(FragIndex exit)
 {
+    m_stack.clear();
+
     // Set this node as having been traversed during the post domimator DFS ordering traversal
-    setTravType(frag, TravType::DFS_PDom);
+    m_info[exit].m_travType = TravType::DFS_PDom;
+    m_stack.push_back({ exit, m_predBegin[exit] });
 
-    // recurse on unvisited children
-    for (const IRFragment *pred : frag->getPredecessors()) {
-        if (getTravType(pred) != TravType::DFS_PDom) {
-            updateRevOrder(pred);
+    while (!m_stack.empty()) {
+        const FragIndex frag = m_stack.back().first;
+        std::size_t &pos     = m_stack.back().second;
+
+        if (pos < m_predBegin[frag + 1]) {
+            const FragIndex pred = m_preds[pos++];
+
+            // visit unvisited predecessors
+            if (m_info[pred].m_travType != TravType::DFS_PDom) {
+                m_info[pred].m_travType = TravType::DFS_PDom;
+                m_stack.push_back({ pred, m_predBegin[pred] });
+            }
+
+            continue;
         }
-    }
 
-    // add this node to the ordering structure and record the post dom. order of this node as its
-    // index within this ordering structure
-    m_info[frag].m_revPostOrderIndex = static_cast<int>(m_revPostOrdering.size());
-    m_revPostOrdering.push_back(frag);
+        // add this node to the ordering structure and record the post dom. order of this node as
+        // its index within this ordering structure
+        m_info[frag].m_revPostOrderIndex = static_cast<int>(m_revPostOrdering.size());
+        m_revPostOrdering.push_back(frag);
+        m_stack.pop_back();
+    }
 }
 
 
-void ControlFlowAnalyzer::setCaseHead(const IRFragment *frag, const IRFragment *head,
-                                      const IRFragment *follow)
+void ControlFlowAnalyzer::setCaseHead(FragIndex head, FragIndex follow)
 {
-    assert(!getCaseHead(frag));
-
-    setTravType(frag, TravType::DFS_Case);
-
-    // don't tag this node if it is the case header under investigation
-    if (frag != head) {
-        m_info[frag].m_caseHead = head;
-    }
+    // Tag a node as being part of the case body and mark it as traversed.
+    auto tagNode = [this, head](FragIndex frag) {
+        assert(m_info[frag].m_caseHead == INDEX_INVALID);
+
+        m_info[frag].m_travType = TravType::DFS_Case;
+
+        // don't tag this node if it is the case header under investigation
+        if (frag != head) {
+            m_info[frag].m_caseHead = head;
+        }
+    };
+
+    // Iterative depth first search; the position is the index of the next successor to visit.
+    m_stack.clear();
+    tagNode(head);
+    m_stack.push_back({ head, 0 });
+
+    while (!m_stack.empty()) {
+        const FragIndex frag = m_stack.back().first;
+        std::size_t &pos     = m_stack.back().second;
+        FragIndex next       = INDEX_INVALID;
+
+        // if this is a nested case header, then it's member nodes
+        // will already have been tagged so skip straight to its follow
+        if (isType(frag, FragType::Nway) && (frag != head)) {
+            if (pos++ > 0) {
+                m_stack.pop_back();
+                continue;
+            }
 
-    // if this is a nested case header, then it's member nodes
-    // will already have been tagged so skip straight to its follow
-    if (frag->isType(FragType::Nway) && (frag != head)) {
-        if (getCondFollow(frag) && (getTravType(getCondFollow(frag)) != TravType::DFS_Case) &&
-            (getCondFollow(frag) != follow)) {
-            setCaseHead(frag, head, follow);
+            const FragIndex condFollow = m_info[frag].m_condFollow;
+            if (condFollow != INDEX_INVALID &&
+                (m_info[condFollow].m_travType != TravType::DFS_Case) && (condFollow != follow)) {
+                next = condFollow;
+            }
         }
-    }
-    else {
-        // traverse each child of this node that:
-        //   i) isn't on a back-edge,
-        //  ii) hasn't already been traversed in a case tagging traversal and,
-        // iii) isn't the follow node.
-        for (IRFragment *succ : frag->getSuccessors()) {
-            if (!isBackEdge(frag, succ) && (getTravType(succ) != TravType::DFS_Case) &&
+        else if (pos < getNumSuccessors(frag)) {
+            // traverse each child of this node that:
+            //   i) isn't on a back-edge,
+            //  ii) hasn't already been traversed in a case tagging traversal and,
+            // iii) isn't the follow node.
+            const FragIndex succ = getSuccessor(frag, pos++);
+
+            if (!isBackEdge(frag, succ) && (m_info[succ].m_travType != TravType::DFS_Case) &&
                 (succ != follow)) {
-                setCaseHead(succ, head, follow);
+                next = succ;
             }
         }
+        else {
+            m_stack.pop_back();
+            continue;
+        }
+
+        if (next != INDEX_INVALID) {
+            tagNode(next);
+            m_stack.push_back({ next, 0 });
+        }
     }
 }
 
 
-void ControlFlowAnalyzer::setStructType(const IRFragment *frag, StructType structType)
+void ControlFlowAnalyzer::setStructType(FragIndex frag, StructType structType)
 {
+    FragStructInfo &info = m_info[frag];
+
     // if this is a conditional header, determine exactly which type of conditional header it is
     // (i.e. switch, if-then, if-then-else etc.)
     if (structType == StructType::Cond) {
-        if (frag->isType(FragType::Nway)) {
-            m_info[frag].m_conditionHeaderType = CondType::Case;
+        if (isType(frag, FragType::Nway)) {
+            info.m_conditionHeaderType = CondType::Case;
         }
-        else if (getCondFollow(frag) == frag->getSuccessor(BELSE)) {
-            m_info[frag].m_conditionHeaderType = CondType::IfThen;
+        else if (info.m_condFollow == getSuccessor(frag, BELSE)) {
+            info.m_conditionHeaderType = CondType::IfThen;
         }
-        else if (getCondFollow(frag) == frag->getSuccessor(BTHEN)) {
-            m_info[frag].m_conditionHeaderType = CondType::IfElse;
+        else if (info.m_condFollow == getSuccessor(frag, BTHEN)) {
+            info.m_conditionHeaderType = CondType::IfElse;
         }
         else {
-            m_info[frag].m_conditionHeaderType = CondType::IfThenElse;
+            info.m_conditionHeaderType = CondType::IfThenElse;
         }
     }
 
-    m_info[frag].m_structuringType = structType;
+    info.m_structuringType = structType;
 }
 
 
-void ControlFlowAnalyzer::setUnstructType(const IRFragment *frag, UnstructType unstructType)
+void ControlFlowAnalyzer::setUnstructType(FragIndex frag, UnstructType unstructType)
 {
     assert((m_info[frag].m_structuringType == StructType::Cond ||
             m_info[frag].m_structuringType == StructType::LoopCond) &&
@@ -654,99 +839,100 @@ void ControlFlowAnalyzer::setUnstructType(const IRFragment *frag, UnstructType u
 }
 
 
-UnstructType ControlFlowAnalyzer::getUnstructType(const IRFragment *frag) const
+UnstructType ControlFlowAnalyzer::getUnstructType(FragIndex frag) const
 {
-    assert((m_info[frag].m_structuringType == StructType::Cond ||
-            m_info[frag].m_structuringType == StructType::LoopCond));
+    assert((getInfo(frag).m_structuringType == StructType::Cond ||
+            getInfo(frag).m_structuringType == StructType::LoopCond));
     // fails when cenerating code for switches; not sure if actually needed TODO
     // assert(m_conditionHeaderType != CondType::Case);
 
-    return m_info[frag].m_unstructuredType;
+    return getInfo(frag).m_unstructuredType;
 }
 
 
-void ControlFlowAnalyzer::setLoopType(const IRFragment *frag, LoopType l)
+void ControlFlowAnalyzer::setLoopType(FragIndex frag, LoopType l)
 {
-    assert(getStructType(frag) == StructType::Loop || getStructType(frag) == StructType::LoopCond);
+    assert(m_info[frag].m_structuringType == StructType::Loop ||
+           m_info[frag].m_structuringType == StructType::LoopCond);
     m_info[frag].m_loopHeaderType = l;
 
     // set the structured class (back to) just Loop if the loop type is PreTested OR it's PostTested
     // and is a single block loop
     if ((m_info[frag].m_loopHeaderType == LoopType::PreTested) ||
-        ((m_info[frag].m_loopHeaderType == LoopType::PostTested) && (frag == getLatchNode(frag)))) {
+        ((m_info[frag].m_loopHeaderType == LoopType::PostTested) &&
+         (frag == m_info[frag].m_latchNode))) {
         setStructType(frag, StructType::Loop);
     }
 }
 
 
-LoopType ControlFlowAnalyzer::getLoopType(const IRFragment *frag) const
+LoopType ControlFlowAnalyzer::getLoopType(FragIndex frag) const
 {
-    assert(getStructType(frag) == StructType::Loop || getStructType(frag) == StructType::LoopCond);
-    return m_info[frag].m_loopHeaderType;
+    assert(getInfo(frag).m_structuringType == StructType::Loop ||
+           getInfo(frag).m_structuringType == StructType::LoopCond);
+    return getInfo(frag).m_loopHeaderType;
 }
 
 
-void ControlFlowAnalyzer::setCondType(const IRFragment *frag, CondType condType)
+void ControlFlowAnalyzer::setCondType(FragIndex frag, CondType condType)
 {
-    assert(getStructType(frag) == StructType::Cond || getStructType(frag) == StructType::LoopCond);
+    assert(m_info[frag].m_structuringType == StructType::Cond ||
+           m_info[frag].m_structuringType == StructType::LoopCond);
     m_info[frag].m_conditionHeaderType = condType;
 }
 
 
-CondType ControlFlowAnalyzer::getCondType(const IRFragment *frag) const
+CondType ControlFlowAnalyzer::getCondType(FragIndex frag) const
 {
-    assert(getStructType(frag) == StructType::Cond || getStructType(frag) == StructType::LoopCond);
-    return m_info[frag].m_conditionHeaderType;
+    assert(getInfo(frag).m_structuringType == StructType::Cond ||
+           getInfo(frag).m_structuringType == StructType::LoopCond);
+    return getInfo(frag).m_conditionHeaderType;
 }
 
 
-bool ControlFlowAnalyzer::isFragInLoop(const IRFragment *frag, const IRFragment *header,
-                                       const IRFragment *latch) const
+bool ControlFlowAnalyzer::isFragInLoop(FragIndex frag, FragIndex header, FragIndex latch) const
 {
-    assert(getLatchNode(header) == latch);
-    assert(header == latch || ((m_info[header].m_preOrderID > m_info[latch].m_preOrderID &&
-                                m_info[latch].m_postOrderID > m_info[header].m_postOrderID) ||
-                               (m_info[header].m_preOrderID < m_info[latch].m_preOrderID &&
-                                m_info[latch].m_postOrderID < m_info[header].m_postOrderID)));
+    const FragStructInfo &fragInfo   = m_info[frag];
+    const FragStructInfo &headerInfo = m_info[header];
+    const FragStructInfo &latchInfo  = m_info[latch];
+
+    assert(headerInfo.m_latchNode == latch);
+    assert(header == latch || ((headerInfo.m_preOrderID > latchInfo.m_preOrderID &&
+                                latchInfo.m_postOrderID > headerInfo.m_postOrderID) ||
+                               (headerInfo.m_preOrderID < latchInfo.m_preOrderID &&
+                                latchInfo.m_postOrderID < headerInfo.m_postOrderID)));
 
     // this node is in the loop if it is the latch node OR
     // this node is within the header and the latch is within this when using the forward loop
     // stamps OR this node is within the header and the latch is within this when using the reverse
     // loop stamps
     return frag == latch ||
-           (m_info[header].m_preOrderID < m_info[frag].m_preOrderID &&
-            m_info[frag].m_postOrderID < m_info[header].m_postOrderID &&
-            m_info[frag].m_preOrderID < m_info[latch].m_preOrderID &&
-            m_info[latch].m_postOrderID < m_info[frag].m_postOrderID) ||
-           (m_info[header].m_revPreOrderID < m_info[frag].m_revPreOrderID &&
-            m_info[frag].m_revPostOrderID < m_info[header].m_revPostOrderID &&
-            m_info[frag].m_revPreOrderID < m_info[latch].m_revPreOrderID &&
-            m_info[latch].m_revPostOrderID < m_info[frag].m_revPostOrderID);
+           (headerInfo.m_preOrderID < fragInfo.m_preOrderID &&
+            fragInfo.m_postOrderID < headerInfo.m_postOrderID &&
+            fragInfo.m_preOrderID < latchInfo.m_preOrderID &&
+            latchInfo.m_postOrderID < fragInfo.m_postOrderID) ||
+           (headerInfo.m_revPreOrderID < fragInfo.m_revPreOrderID &&
+            fragInfo.m_revPostOrderID < headerInfo.m_revPostOrderID &&
+            fragInfo.m_revPreOrderID < latchInfo.m_revPreOrderID &&
+            latchInfo.m_revPostOrderID < fragInfo.m_revPostOrderID);
 }
 
 
-bool ControlFlowAnalyzer::hasBackEdge(const IRFragment *frag) const
+bool ControlFlowAnalyzer::hasBackEdge(FragIndex frag) const
 {
-    return std::any_of(frag->getSuccessors().begin(), frag->getSuccessors().end(),
-                       [this, frag](const IRFragment *succ) { return isBackEdge(frag, succ); });
-}
-
-
-void ControlFlowAnalyzer::unTraverse()
-{
-    for (auto &elem : m_info) {
-        elem.second.m_travType = TravType::Untraversed;
+    for (std::size_t j = m_succBegin[frag]; j < m_succBegin[frag + 1]; ++j) {
+        if (isBackEdge(frag, m_succs[j])) {
+            return true;
+        }
     }
-}
 
-
-IRFragment *ControlFlowAnalyzer::findEntryFragment() const
-{
-    return m_cfg->getEntryFragment();
+    return false;
 }
 
 
-IRFragment *ControlFlowAnalyzer::findExitFragment() const
+void ControlFlowAnalyzer::unTraverse()
 {
-    return m_cfg->findRetFragment();
+    for (FragStructInfo &info : m_info) {
+        info.m_travType = TravType::Untraversed;
+    }
 }
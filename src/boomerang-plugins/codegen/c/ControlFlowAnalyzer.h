@@ -10,12 +10,15 @@
 #pragma once
 
 
+#include "boomerang/db/DominatorTree.h"
+
 #include <unordered_map>
 #include <vector>
 
 
 class ProcCFG;
 class IRFragment;
+enum class FragType;
 
 
 /// an enumerated type for the class of stucture determined for a node
@@ -86,6 +89,7 @@ enum class StructFragType : uint8_t
 
 
 /// Holds all information about control Flow Structure.
+/// Other fragments are referenced by their index in the ControlFlowAnalyzer.
 struct FragStructInfo
 {
     /// Control flow analysis stuff, lifted from Doug Simon's honours thesis.
@@ -116,18 +120,23 @@ struct FragStructInfo
     LoopType m_loopHeaderType      = LoopType::Invalid; ///< the loop type of a loop header
 
     // analysis information
-    const IRFragment *m_immPDom    = nullptr; ///< immediate post dominator
-    const IRFragment *m_loopHead   = nullptr; ///< head of the most nested enclosing loop
-    const IRFragment *m_caseHead   = nullptr; ///< head of the most nested enclosing case
-    const IRFragment *m_condFollow = nullptr; ///< follow of a conditional header
-    const IRFragment *m_loopFollow = nullptr; ///< follow of a loop header
-    const IRFragment *m_latchNode  = nullptr; ///< latching node of a loop header
+    FragIndex m_immPDom    = INDEX_INVALID; ///< immediate post dominator
+    FragIndex m_loopHead   = INDEX_INVALID; ///< head of the most nested enclosing loop
+    FragIndex m_caseHead   = INDEX_INVALID; ///< head of the most nested enclosing case
+    FragIndex m_condFollow = INDEX_INVALID; ///< follow of a conditional header
+    FragIndex m_loopFollow = INDEX_INVALID; ///< follow of a loop header
+    FragIndex m_latchNode  = INDEX_INVALID; ///< latching node of a loop header
 };
 
 
 /**
  * Control flow analysis stuff, lifted from Doug Simon's honours thesis.
  * Analyzes the control flow of a CFG and tags loop constructs etc.
+ *
+ * All fragments of the CFG are numbered densely when the CFG is structured;
+ * the structuring information and the edges of the CFG are kept in flat arrays
+ * indexed by fragment index. All traversals use an explicit stack, so the depth
+ * of the CFG is not limited by the size of the call stack.
  */
 class ControlFlowAnalyzer
 {
@@ -135,108 +144,150 @@ public:
     ControlFlowAnalyzer();
 
 public:
-    /// Structures the control flow graph
+    /// Structures the control flow graph.
+    /// Discards all structuring information of previously structured CFGs.
     void structureCFG(ProcCFG *cfg);
 
     /// establish if \p source has a back edge to \p dest
-    bool isBackEdge(const IRFragment *source, const IRFragment *dest) const;
+    bool isBackEdge(const IRFragment *source, const IRFragment *dest) const
+    {
+        return dest == source || isAncestorOf(fragToIdx(dest), fragToIdx(source));
+    }
 
 public:
     inline bool isLatchNode(const IRFragment *frag) const
     {
-        const IRFragment *loopHead = getLoopHead(frag);
-        if (!loopHead) {
+        const FragIndex loopHead = getInfo(fragToIdx(frag)).m_loopHead;
+        if (loopHead == INDEX_INVALID) {
             return false;
         }
 
-        return getLatchNode(loopHead) == frag;
+        return idxToFrag(getInfo(loopHead).m_latchNode) == frag;
     }
 
     inline const IRFragment *getLatchNode(const IRFragment *frag) const
     {
-        return m_info[frag].m_latchNode;
+        return idxToFrag(getInfo(fragToIdx(frag)).m_latchNode);
     }
 
     inline const IRFragment *getLoopHead(const IRFragment *frag) const
     {
-        return m_info[frag].m_loopHead;
+        return idxToFrag(getInfo(fragToIdx(frag)).m_loopHead);
     }
 
     inline const IRFragment *getLoopFollow(const IRFragment *frag) const
     {
-        return m_info[frag].m_loopFollow;
+        return idxToFrag(getInfo(fragToIdx(frag)).m_loopFollow);
     }
 
     inline const IRFragment *getCondFollow(const IRFragment *frag) const
     {
-        return m_info[frag].m_condFollow;
+        return idxToFrag(getInfo(fragToIdx(frag)).m_condFollow);
     }
 
     inline const IRFragment *getCaseHead(const IRFragment *frag) const
     {
-        return m_info[frag].m_caseHead;
+        return idxToFrag(getInfo(fragToIdx(frag)).m_caseHead);
+    }
+
+    TravType getTravType(const IRFragment *frag) const
+    {
+        return getInfo(fragToIdx(frag)).m_travType;
     }
 
-    TravType getTravType(const IRFragment *frag) const { return m_info[frag].m_travType; }
     StructType getStructType(const IRFragment *frag) const
     {
-        return m_info[frag].m_structuringType;
+        return getInfo(fragToIdx(frag)).m_structuringType;
     }
-    CondType getCondType(const IRFragment *frag) const;
-    UnstructType getUnstructType(const IRFragment *frag) const;
-    LoopType getLoopType(const IRFragment *frag) const;
 
-    void setTravType(const IRFragment *frag, TravType type) { m_info[frag].m_travType = type; }
-    void setStructType(const IRFragment *frag, StructType s);
+    CondType getCondType(const IRFragment *frag) const { return getCondType(fragToIdx(frag)); }
+    UnstructType getUnstructType(const IRFragment *frag) const
+    {
+        return getUnstructType(fragToIdx(frag));
+    }
 
-    bool isCaseOption(const IRFragment *frag) const;
+    LoopType getLoopType(const IRFragment *frag) const { return getLoopType(fragToIdx(frag)); }
 
-private:
-    void updateLoopStamps(const IRFragment *frag, int &time);
-    void updateRevLoopStamps(const IRFragment *frag, int &time);
-    void updateRevOrder(const IRFragment *frag);
+    void setTravType(const IRFragment *frag, TravType type)
+    {
+        m_info[getOrCreateIdx(frag)].m_travType = type;
+    }
 
-    void setLoopHead(const IRFragment *frag, const IRFragment *head)
+    void setStructType(const IRFragment *frag, StructType s)
     {
-        m_info[frag].m_loopHead = head;
+        setStructType(getOrCreateIdx(frag), s);
     }
-    void setLatchNode(const IRFragment *frag, const IRFragment *latch)
+
+    bool isCaseOption(const IRFragment *frag) const;
+
+public:
+    /// \returns the number of fragments known to the analyzer.
+    std::size_t getNumFragments() const { return m_frags.size(); }
+
+    /// \returns the index of \p frag, or INDEX_INVALID if \p frag is not known.
+    FragIndex fragToIdx(const IRFragment *frag) const;
+
+    /// \returns the fragment with index \p idx, or nullptr if \p idx is invalid.
+    const IRFragment *idxToFrag(FragIndex idx) const
     {
-        m_info[frag].m_latchNode = latch;
+        return idx < m_frags.size() ? m_frags[idx] : nullptr;
     }
 
-    void setCaseHead(const IRFragment *frag, const IRFragment *head, const IRFragment *follow);
+private:
+    /// Number all fragments of the CFG and build the successor and predecessor lists.
+    void buildGraph();
 
-    void setUnstructType(const IRFragment *frag, UnstructType unstructType);
-    void setLoopType(const IRFragment *frag, LoopType loopType);
-    void setCondType(const IRFragment *frag, CondType condType);
+    /// \returns the index of \p frag, numbering it if it is not known yet.
+    FragIndex getOrCreateIdx(const IRFragment *frag);
 
-    void setLoopFollow(const IRFragment *frag, const IRFragment *follow)
+    /// \returns the structuring information of fragment \p idx.
+    /// Invalid indices have the default structuring information.
+    const FragStructInfo &getInfo(FragIndex idx) const
     {
-        m_info[frag].m_loopFollow = follow;
+        return idx < m_info.size() ? m_info[idx] : m_noInfo;
     }
 
-    void setCondFollow(const IRFragment *frag, const IRFragment *follow)
+    std::size_t getNumSuccessors(FragIndex idx) const;
+
+    /// \returns the \p i-th successor of \p idx, or INDEX_INVALID if it does not exist.
+    FragIndex getSuccessor(FragIndex idx, std::size_t i) const
     {
-        m_info[frag].m_condFollow = follow;
+        return i < getNumSuccessors(idx) ? m_succs[m_succBegin[idx] + i] : INDEX_INVALID;
     }
 
+    bool isType(FragIndex idx, FragType type) const;
+
+    bool isBackEdge(FragIndex source, FragIndex dest) const;
+
+    void updateLoopStamps(FragIndex entry);
+    void updateRevLoopStamps(FragIndex entry);
+    void updateRevOrder(FragIndex exit);
+
+    void setCaseHead(FragIndex head, FragIndex follow);
+    void setStructType(FragIndex frag, StructType s);
+    void setUnstructType(FragIndex frag, UnstructType unstructType);
+    void setLoopType(FragIndex frag, LoopType loopType);
+    void setCondType(FragIndex frag, CondType condType);
+
+    CondType getCondType(FragIndex frag) const;
+    UnstructType getUnstructType(FragIndex frag) const;
+    LoopType getLoopType(FragIndex frag) const;
+
     /// establish if this fragment is the source of any back edges leading FROM it
-    bool hasBackEdge(const IRFragment *frag) const;
+    bool hasBackEdge(FragIndex frag) const;
 
     /// \returns true if \p frag is an ancestor of \p other
-    bool isAncestorOf(const IRFragment *frag, const IRFragment *other) const;
-    bool isFragInLoop(const IRFragment *frag, const IRFragment *header,
-                      const IRFragment *latch) const;
+    bool isAncestorOf(FragIndex frag, FragIndex other) const;
+    bool isFragInLoop(FragIndex frag, FragIndex header, FragIndex latch) const;
 
-    int getPostOrdering(const IRFragment *frag) const { return m_info[frag].m_postOrderIndex; }
-    int getRevOrd(const IRFragment *frag) const { return m_info[frag].m_revPostOrderIndex; }
+    int getPostOrdering(FragIndex frag) const { return getInfo(frag).m_postOrderIndex; }
+    int getRevOrd(FragIndex frag) const { return getInfo(frag).m_revPostOrderIndex; }
 
-    const IRFragment *getImmPDom(const IRFragment *frag) const { return m_info[frag].m_immPDom; }
-
-    void setImmPDom(const IRFragment *frag, const IRFragment *immPDom)
+    /// \returns true if \p frag is a member of the loop that is currently being structured.
+    bool isInCurrentLoop(FragIndex frag) const
     {
-        m_info[frag].m_immPDom = immPDom;
+        const int ord = getPostOrdering(frag);
+        return ord >= 0 && m_loopNodes[ord];
     }
 
     void unTraverse();
@@ -269,37 +320,48 @@ private:
 
     /// Finds the common post dominator of the current immediate post dominator and its successor's
     /// immediate post dominator
-    const IRFragment *findCommonPDom(const IRFragment *curImmPDom, const IRFragment *succImmPDom);
+    FragIndex findCommonPDom(FragIndex curImmPDom, FragIndex succImmPDom) const;
 
     /// \pre  The loop induced by (head,latch) has already had all its member nodes tagged
     /// \post The type of loop has been deduced
-    void determineLoopType(const IRFragment *header, bool *&loopNodes);
+    void determineLoopType(FragIndex header);
 
     /// \pre  The loop headed by header has been induced and all it's member nodes have been tagged
     /// \post The follow of the loop has been determined.
-    void findLoopFollow(const IRFragment *header, bool *&loopNodes);
+    void findLoopFollow(FragIndex header);
 
     /// \pre header has been detected as a loop header and has the details of the
     ///        latching node
     /// \post the nodes within the loop have been tagged
-    void tagNodesInLoop(const IRFragment *header, bool *&loopNodes);
-
-    IRFragment *findEntryFragment() const;
-    IRFragment *findExitFragment() const;
+    void tagNodesInLoop(FragIndex header);
 
 private:
     ProcCFG *m_cfg = nullptr;
 
+    std::vector<const IRFragment *> m_frags;                     ///< Maps index -> IRFragment
+    std::unordered_map<const IRFragment *, FragIndex> m_indices; ///< Maps IRFragment -> index
+    std::vector<FragStructInfo> m_info;                          ///< Indexed by fragment index
+    FragStructInfo m_noInfo; ///< Information of fragments that are not known
+
+    /// Successors and predecessors of fragment n are stored in m_succs[m_succBegin[n]] to
+    /// m_succs[m_succBegin[n+1]-1] (and likewise for predecessors), in the order of the CFG.
+    std::vector<std::size_t> m_succBegin;
+    std::vector<FragIndex> m_succs;
+    std::vector<std::size_t> m_predBegin;
+    std::vector<FragIndex> m_preds;
+
     /// Post Ordering according to a DFS starting at the entry fragment.
-    std::vector<const IRFragment *> m_postOrdering;
+    std::vector<FragIndex> m_postOrdering;
 
     /// Post Ordering according to a DFS starting at the exit fragment (usually the return
     /// fragment). Note that this is not the reverse of m_postOrdering for functions containing
     /// calls to noreturn functions or infinite loops.
-    std::vector<const IRFragment *> m_revPostOrdering;
+    std::vector<FragIndex> m_revPostOrdering;
 
-private:
-    /// mutable to allow using the map in const methods (might create entries).
-    /// DO NOT change FragStructInfo in const methods!
-    mutable std::unordered_map<const IRFragment *, FragStructInfo> m_info;
+    /// Maps the post ordering index of each fragment to whether or not it is within
+    /// the loop that is currently being structured.
+    std::vector<bool> m_loopNodes;
+
+    /// Explicit stack of (fragment, position of the next edge to visit) for traversals
+    std::vector<std::pair<FragIndex, std::size_t>> m_stack;
 };
@@ -39,7 +39,7 @@ CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode
         realSSLFileName = settings->getDataDirectory().absoluteFilePath(sslFileName);
     }
 
-    if (!m_dict.readSSLFile(realSSLFileName)) {
+    if (!m_dict.readSSLFile(realSSLFileName, settings->useSSLCache)) {
         LOG_ERROR("Cannot read SSL file '%1'", realSSLFileName);
         throw std::runtime_error("Cannot read SSL file");
     }
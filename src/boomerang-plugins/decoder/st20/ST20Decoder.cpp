@@ -76,7 +76,7 @@ ST20Decoder::ST20Decoder(Project *project)
         realSSLFileName = settings->getDataDirectory().absoluteFilePath("ssl/st20.ssl");
     }
 
-    if (!m_rtlDict.readSSLFile(realSSLFileName)) {
+    if (!m_rtlDict.readSSLFile(realSSLFileName, settings->useSSLCache)) {
         LOG_ERROR("Cannot read SSL file '%1'", realSSLFileName);
         throw std::runtime_error("Cannot read SSL file");
     }
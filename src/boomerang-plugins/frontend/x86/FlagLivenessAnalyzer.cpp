@@ -0,0 +1,198 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FlagLivenessAnalyzer.h"
+
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/log/Log.h"
+#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtExpVisitor.h"
+
+#include <deque>
+
+
+/// Finds all uses of integer and floating point flags in an expression.
+class FlagUseFinder : public ExpVisitor
+{
+public:
+    bool visit(const std::shared_ptr<Terminal> &exp) override
+    {
+        switch (exp->getOper()) {
+        case opFlags:
+        case opZF:
+        case opCF:
+        case opNF:
+        case opOF: m_usesIntFlags = true; break;
+        case opFflags:
+        case opFZF:
+        case opFLF: m_usesFloatFlags = true; break;
+        default: break;
+        }
+
+        return true;
+    }
+
+public:
+    bool m_usesIntFlags   = false;
+    bool m_usesFloatFlags = false;
+};
+
+
+FlagLivenessAnalyzer::FlagLivenessAnalyzer(UserProc *proc)
+    : m_proc(proc)
+{
+}
+
+
+int FlagLivenessAnalyzer::removeDeadFlagDefs()
+{
+    calculateLiveness();
+
+    int numRemoved = 0;
+    for (IRFragment *frag : *m_proc->getCFG()) {
+        transfer(frag, getLiveOut(frag), &numRemoved);
+    }
+
+    m_liveIn.clear();
+    return numRemoved;
+}
+
+
+void FlagLivenessAnalyzer::calculateLiveness()
+{
+    m_liveIn.clear();
+
+    // Visit fragments bottom-up first, so most fragments are only visited once.
+    std::deque<IRFragment *> workList;
+    for (auto it = m_proc->getCFG()->rbegin(); it != m_proc->getCFG()->rend(); ++it) {
+        m_liveIn[*it] = FLAGS_NONE;
+        workList.push_back(*it);
+    }
+
+    while (!workList.empty()) {
+        IRFragment *frag = workList.front();
+        workList.pop_front();
+
+        const FlagSet liveIn = transfer(frag, getLiveOut(frag), nullptr);
+        if (liveIn == m_liveIn[frag]) {
+            continue;
+        }
+
+        m_liveIn[frag] = liveIn;
+        for (IRFragment *pred : frag->getPredecessors()) {
+            workList.push_back(pred);
+        }
+    }
+}
+
+
+FlagLivenessAnalyzer::FlagSet FlagLivenessAnalyzer::getLiveOut(const IRFragment *frag) const
+{
+    if (frag->isType(FragType::CompJump) || frag->isType(FragType::Nway)) {
+        // Not all successors might be known yet
+        return FLAGS_ALL;
+    }
+    else if (frag->getNumSuccessors() == 0) {
+        // Flags are never returned from or passed to procedures.
+        const bool isExit = frag->isType(FragType::Ret) || frag->isType(FragType::Call);
+        return isExit ? FLAGS_NONE : FLAGS_ALL;
+    }
+
+    FlagSet liveOut = FLAGS_NONE;
+    for (const IRFragment *succ : frag->getSuccessors()) {
+        auto it = m_liveIn.find(succ);
+        liveOut |= (it != m_liveIn.end()) ? it->second : FLAGS_ALL;
+    }
+
+    return liveOut;
+}
+
+
+FlagLivenessAnalyzer::FlagSet FlagLivenessAnalyzer::transfer(IRFragment *frag, FlagSet liveOut,
+                                                             int *numRemoved)
+{
+    FlagSet live = liveOut;
+    if (!frag->getRTLs()) {
+        return live;
+    }
+
+    for (auto rtlIt = frag->getRTLs()->rbegin(); rtlIt != frag->getRTLs()->rend(); ++rtlIt) {
+        RTL *rtl = rtlIt->get();
+
+        for (RTL::iterator it = rtl->end(); it != rtl->begin();) {
+            --it;
+
+            const FlagSet defined = getDefinedFlags(*it);
+            if (defined != FLAGS_NONE && (defined & live) == FLAGS_NONE && (*it)->isFlagAssign()) {
+                // Dead flag definition; its uses do not make other flags live.
+                if (numRemoved) {
+                    it = rtl->erase(it);
+                    (*numRemoved)++;
+                }
+
+                continue;
+            }
+
+            live = static_cast<FlagSet>((live & ~defined) | getUsedFlags(*it));
+        }
+    }
+
+    return live;
+}
+
+
+FlagLivenessAnalyzer::FlagSet FlagLivenessAnalyzer::getDefinedFlags(const SharedConstStmt &stmt)
+{
+    if (!stmt->isAssign()) {
+        return FLAGS_NONE;
+    }
+
+    const std::shared_ptr<const Assign> asgn = stmt->as<Assign>();
+    if (asgn->getGuard()) {
+        return FLAGS_NONE; // conditional definition
+    }
+
+    switch (asgn->getLeft()->getOper()) {
+    case opFlags: return FLAGS_INT;
+    case opFflags: return FLAGS_FLOAT;
+    default: return FLAGS_NONE;
+    }
+}
+
+
+FlagLivenessAnalyzer::FlagSet FlagLivenessAnalyzer::getUsedFlags(const SharedStmt &stmt)
+{
+    FlagUseFinder finder;
+
+    if (stmt->isAssign()) {
+        // Locations used by the left hand side of an assignment
+        // (e.g. the address of a memof, or a partial write to the flags)
+        const std::shared_ptr<Assign> asgn = stmt->as<Assign>();
+        if (!asgn->getLeft()->isFlags() && !asgn->getLeft()->isMainFlag()) {
+            asgn->getLeft()->acceptVisitor(&finder);
+        }
+
+        asgn->getRight()->acceptVisitor(&finder);
+        if (asgn->getGuard()) {
+            asgn->getGuard()->acceptVisitor(&finder);
+        }
+    }
+    else {
+        StmtExpVisitor visitor(&finder);
+        stmt->accept(&visitor);
+    }
+
+    return static_cast<FlagSet>((finder.m_usesIntFlags ? FLAGS_INT : FLAGS_NONE) |
+                                (finder.m_usesFloatFlags ? FLAGS_FLOAT : FLAGS_NONE));
+}
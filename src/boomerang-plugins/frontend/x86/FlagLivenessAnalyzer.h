@@ -0,0 +1,75 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/Types.h"
+
+#include <unordered_map>
+
+
+class IRFragment;
+class UserProc;
+
+
+/**
+ * Removes dead flag definitions (e.g. %flags := SUBFLAGS32(...)) from the lifted RTLs
+ * of a procedure. A flag definition is dead if the flags are redefined on all paths
+ * before they are used by a branch, a BoolAssign or an instruction reading the flags.
+ *
+ * Nearly all flag definitions emitted for arithmetic instructions are dead.
+ * Removing them before the procedure is converted to SSA form keeps them out of
+ * all early data flow passes.
+ *
+ * Integer flags (%flags) and floating point flags (%fflags) are tracked separately.
+ * Only unguarded flag calls are removed; other definitions of the flags
+ * (e.g. by popf) only end the live range of the flags.
+ */
+class FlagLivenessAnalyzer
+{
+    typedef uint8 FlagSet;
+
+    static constexpr FlagSet FLAGS_NONE  = 0;
+    static constexpr FlagSet FLAGS_INT   = 1 << 0;
+    static constexpr FlagSet FLAGS_FLOAT = 1 << 1;
+    static constexpr FlagSet FLAGS_ALL   = FLAGS_INT | FLAGS_FLOAT;
+
+public:
+    FlagLivenessAnalyzer(UserProc *proc);
+
+public:
+    /// Remove all dead flag definitions in the procedure.
+    /// \returns the number of removed flag definitions.
+    int removeDeadFlagDefs();
+
+private:
+    /// Calculate the flags that are live on entry to each fragment.
+    void calculateLiveness();
+
+    /// \returns the flags live on exit from \p frag.
+    FlagSet getLiveOut(const IRFragment *frag) const;
+
+    /// Propagate \p liveOut backwards through \p frag.
+    /// If \p numRemoved is not null, dead flag definitions are removed from the fragment
+    /// and counted in \p numRemoved.
+    /// \returns the flags live on entry to \p frag.
+    FlagSet transfer(IRFragment *frag, FlagSet liveOut, int *numRemoved);
+
+    /// \returns the flags defined unconditionally by \p stmt.
+    static FlagSet getDefinedFlags(const SharedConstStmt &stmt);
+
+    /// \returns the flags read by \p stmt.
+    static FlagSet getUsedFlags(const SharedStmt &stmt);
+
+private:
+    UserProc *m_proc;
+    std::unordered_map<const IRFragment *, FlagSet> m_liveIn;
+};
@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "X86FrontEnd.h"
 
+#include "FlagLivenessAnalyzer.h"
 #include "StringInstructionProcessor.h"
 
 #include "boomerang/core/Project.h"
@@ -58,6 +59,9 @@ bool X86FrontEnd::liftProcImpl(UserProc *proc)
     // Process away %rpt and %skip
     processStringInst(proc);
 
+    // Remove flag definitions that are never used
+    removeDeadFlags(proc);
+
     IRFragment::RTLIterator rit;
     StatementList::iterator sit;
     ProcCFG *procCFG = proc->getCFG();
@@ -169,6 +173,9 @@ bool X86FrontEnd::initialize(Project *project)
     }
 
     m_decoder = plugin->getIfc<IDecoder>();
+    m_overlappedRegsProcessed.clear();
+    m_floatProcessed.clear();
+
     return DefaultFrontEnd::initialize(project);
 }
 
@@ -318,6 +325,13 @@ void X86FrontEnd::processStringInst(UserProc *proc)
 }
 
 
+void X86FrontEnd::removeDeadFlags(UserProc *proc)
+{
+    const int numRemoved = FlagLivenessAnalyzer(proc).removeDeadFlagDefs();
+    LOG_VERBOSE("Removed %1 dead flag definitions in '%2'", numRemoved, proc->getName());
+}
+
+
 void X86FrontEnd::processOverlapped(UserProc *proc)
 {
     // first, lets look for any uses of the registers
@@ -325,11 +339,11 @@ void X86FrontEnd::processOverlapped(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         LocationSet locs;
         s->addUsedLocs(locs);
 
-        for (SharedExp l : locs) {
+        for (const SharedExp &l : locs) {
             if (l->isRegOfConst()) {
                 usedRegs.insert(l->access<Const, 1>()->getInt());
             }
@@ -338,7 +352,7 @@ void X86FrontEnd::processOverlapped(UserProc *proc)
 
     std::set<IRFragment *> frags;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (isOverlappedRegsProcessed(s->getFragment())) { // never redo processing
             continue;
         }
@@ -60,6 +60,11 @@ private:
      */
     void processStringInst(UserProc *proc);
 
+    /**
+     * Remove definitions of the flags that are redefined before they are used
+     */
+    void removeDeadFlags(UserProc *proc);
+
     /**
      * Process for overlapped registers
      */
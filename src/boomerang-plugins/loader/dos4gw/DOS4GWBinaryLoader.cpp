@@ -350,6 +350,12 @@ bool DOS4GWBinaryLoader::loadFromMemory(QByteArray &data)
         //        printf("relocate dword at %x to point to %x\n", src, target);
         Util::writeDWord(&m_imageBase[src], target, Endian::Little);
 
+        const Address srcAddr     = Address(READ4_LE(m_LXObjects[0].RelocBaseAddr)) + src;
+        BinarySection *srcSection = m_image->getSectionByAddr(srcAddr);
+        if (srcSection) {
+            srcSection->setFlagForRange(SectionFlag::Relocated, srcAddr, srcAddr + 4);
+        }
+
         while (buf.pos() - (READ4_LE(m_LXHeader.fixuprecordtbloffset) + lxoff) >=
                READ4_LE(fixuppagetbl[srcpage + 1])) {
             srcpage++;
@@ -0,0 +1,1164 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DwarfReader.h"
+
+#include "DwarfTypes.h"
+
+#include "boomerang/db/signature/Parameter.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/UnionType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+/// Maximum length of DW_AT_abstract_origin / DW_AT_specification chains
+const int MAX_ORIGIN_DEPTH = 8;
+
+/// Maximum nesting of types; deeper types are only possible in malformed files
+const int MAX_TYPE_DEPTH = 64;
+
+
+/// Bounds checked reader for the contents of a debug section
+class DwarfCursor
+{
+public:
+    DwarfCursor(const Byte *data, uint64 size, uint64 pos, Endian endian)
+        : m_data(data)
+        , m_size(size)
+        , m_pos(std::min(pos, size))
+        , m_endian(endian)
+        , m_error(pos > size)
+    {
+    }
+
+public:
+    bool hasError() const { return m_error; }
+    uint64 getPos() const { return m_pos; }
+    const Byte *getPtr() const { return m_data + m_pos; }
+
+    bool skip(uint64 numBytes)
+    {
+        if (numBytes > m_size - m_pos) {
+            m_pos   = m_size;
+            m_error = true;
+            return false;
+        }
+
+        m_pos += numBytes;
+        return true;
+    }
+
+    /// Read an unsigned integer of \p numBytes bytes (1, 2, 3, 4 or 8)
+    uint64 readU(int numBytes)
+    {
+        const Byte *p = getPtr();
+        if (!skip(numBytes)) {
+            return 0;
+        }
+
+        switch (numBytes) {
+        case 1: return p[0];
+        case 2: return Util::readWord(p, m_endian);
+        case 3:
+            return (m_endian == Endian::Little) ? (p[0] | (p[1] << 8) | (p[2] << 16))
+                                                : ((p[0] << 16) | (p[1] << 8) | p[2]);
+        case 4: return Util::readDWord(p, m_endian);
+        case 8: return Util::readQWord(p, m_endian);
+        }
+
+        m_error = true;
+        return 0;
+    }
+
+    uint64 readULEB128()
+    {
+        uint64 result = 0;
+        int shift     = 0;
+        Byte b;
+
+        do {
+            if (m_pos >= m_size) {
+                m_error = true;
+                return 0;
+            }
+
+            b = m_data[m_pos++];
+            if (shift < 64) {
+                result |= static_cast<uint64>(b & 0x7F) << shift;
+            }
+
+            shift += 7;
+        } while (b & 0x80);
+
+        return result;
+    }
+
+    sint64 readSLEB128()
+    {
+        sint64 result = 0;
+        int shift     = 0;
+        Byte b;
+
+        do {
+            if (m_pos >= m_size) {
+                m_error = true;
+                return 0;
+            }
+
+            b = m_data[m_pos++];
+            if (shift < 64) {
+                result |= static_cast<sint64>(b & 0x7F) << shift;
+            }
+
+            shift += 7;
+        } while (b & 0x80);
+
+        if (shift < 64 && (b & 0x40)) {
+            result |= -(static_cast<sint64>(1) << shift); // sign extend
+        }
+
+        return result;
+    }
+
+    /// Skip a NUL terminated string. \returns the length of the string.
+    uint64 skipString()
+    {
+        const void *term = std::memchr(getPtr(), 0, m_size - m_pos);
+        if (!term) {
+            m_pos   = m_size;
+            m_error = true;
+            return 0;
+        }
+
+        const uint64 len = static_cast<const Byte *>(term) - getPtr();
+        m_pos += len + 1;
+        return len;
+    }
+
+private:
+    const Byte *m_data;
+    uint64 m_size;
+    uint64 m_pos;
+    Endian m_endian;
+    bool m_error;
+};
+
+
+bool isConstantForm(uint16 form)
+{
+    switch (form) {
+    case DW_FORM_data1:
+    case DW_FORM_data2:
+    case DW_FORM_data4:
+    case DW_FORM_data8:
+    case DW_FORM_sdata:
+    case DW_FORM_udata:
+    case DW_FORM_implicit_const: return true;
+    default: return false;
+    }
+}
+
+
+bool isBlockForm(uint16 form)
+{
+    switch (form) {
+    case DW_FORM_block1:
+    case DW_FORM_block2:
+    case DW_FORM_block4:
+    case DW_FORM_block:
+    case DW_FORM_exprloc: return true;
+    default: return false;
+    }
+}
+
+
+SharedType getBaseType(uint64 encoding, Type::Size numBits)
+{
+    if (numBits == 0) {
+        return VoidType::get();
+    }
+
+    switch (encoding) {
+    case DW_ATE_boolean: return BooleanType::get();
+    case DW_ATE_float: return FloatType::get(numBits);
+    case DW_ATE_signed_char:
+        return (numBits == 8) ? SharedType(CharType::get())
+                              : IntegerType::get(numBits, Sign::Signed);
+    case DW_ATE_unsigned_char:
+        return (numBits == 8) ? SharedType(CharType::get())
+                              : IntegerType::get(numBits, Sign::Unsigned);
+    case DW_ATE_signed: return IntegerType::get(numBits, Sign::Signed);
+    case DW_ATE_unsigned:
+    case DW_ATE_address:
+    case DW_ATE_UTF: return IntegerType::get(numBits, Sign::Unsigned);
+    default: return SizeType::get(numBits); // complex and decimal types
+    }
+}
+}
+
+
+const DwarfReader::AttrValue *DwarfReader::Die::find(uint16 attr) const
+{
+    for (const auto &[a, val] : attrs) {
+        if (a == attr) {
+            return &val;
+        }
+    }
+
+    return nullptr;
+}
+
+
+DwarfReader::DwarfReader(Machine machine, Endian endian)
+    : m_machine(machine)
+    , m_endian(endian)
+{
+}
+
+
+DwarfReader::SectionType DwarfReader::getSectionType(const QString &name)
+{
+    if (name == ".debug_info") {
+        return SectionType::Info;
+    }
+    else if (name == ".debug_abbrev") {
+        return SectionType::Abbrev;
+    }
+    else if (name == ".debug_str") {
+        return SectionType::Str;
+    }
+    else if (name == ".debug_line_str") {
+        return SectionType::LineStr;
+    }
+    else if (name == ".debug_str_offsets") {
+        return SectionType::StrOffsets;
+    }
+    else if (name == ".debug_addr") {
+        return SectionType::Addr;
+    }
+
+    return SectionType::NumSections;
+}
+
+
+void DwarfReader::setSection(SectionType type, const Byte *data, std::size_t size)
+{
+    if (type != SectionType::NumSections) {
+        m_sections[static_cast<int>(type)] = { data, size };
+    }
+}
+
+
+bool DwarfReader::load()
+{
+    const Section &info = m_sections[static_cast<int>(SectionType::Info)];
+
+    if (!info.data || !m_sections[static_cast<int>(SectionType::Abbrev)].data) {
+        return false;
+    }
+
+    // Read all unit headers first, so that DIEs can refer to units by pointer
+    uint64 offset = 0;
+    while (offset < info.size) {
+        Unit unit;
+        const bool ok = readUnitHeader(offset, unit);
+
+        if (unit.end <= offset || unit.end > info.size) {
+            LOG_WARN("Invalid DWARF unit at offset %1, ignoring remaining debug information",
+                     offset);
+            break;
+        }
+
+        if (ok) {
+            m_units.push_back(unit);
+        }
+
+        offset = unit.end;
+    }
+
+    for (Unit &unit : m_units) {
+        readUnitAttributes(unit);
+        indexUnit(unit);
+    }
+
+    LOG_VERBOSE("Read DWARF debug information for %1 functions and %2 global variables "
+                "in %3 units",
+                m_functions.size(), m_globals.size(), m_units.size());
+
+    return hasDebugInfo();
+}
+
+
+bool DwarfReader::hasDebugInfo() const
+{
+    return !m_functions.empty() || !m_globals.empty();
+}
+
+
+std::vector<Address> DwarfReader::getFunctionStarts() const
+{
+    std::vector<Address> starts;
+    starts.reserve(m_functions.size());
+
+    for (const auto &[entry, function] : m_functions) {
+        Q_UNUSED(function);
+        starts.push_back(entry);
+    }
+
+    return starts;
+}
+
+
+QString DwarfReader::getFunctionName(Address entry) const
+{
+    auto it = m_functions.find(entry);
+    return (it != m_functions.end()) ? it->second.name : QString();
+}
+
+
+std::shared_ptr<Signature> DwarfReader::getSignature(Address entry) const
+{
+    auto it = m_functions.find(entry);
+    if (it == m_functions.end()) {
+        return nullptr;
+    }
+
+    Die die;
+    if (!readDieAt(it->second.dieOffset, die) || !isPrototyped(die)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Signature> sig = decodeSignature(die, it->second.name, 0);
+    if (sig) {
+        sig->setForced(true);
+    }
+
+    return sig;
+}
+
+
+SharedType DwarfReader::getGlobalType(Address addr) const
+{
+    auto it = m_globals.find(addr);
+    if (it == m_globals.end()) {
+        return nullptr;
+    }
+
+    Die die;
+    if (!readDieAt(it->second, die)) {
+        return nullptr;
+    }
+
+    SharedType ty = getTypeOf(die, 0);
+    return ty->isVoid() ? nullptr : ty;
+}
+
+
+bool DwarfReader::readUnitHeader(uint64 offset, Unit &unit)
+{
+    const Section &info = m_sections[static_cast<int>(SectionType::Info)];
+    DwarfCursor c(info.data, info.size, offset, m_endian);
+
+    unit.offset   = offset;
+    uint64 length = c.readU(4);
+
+    if (length == 0xFFFFFFFF) {
+        length          = c.readU(8);
+        unit.offsetSize = 8;
+    }
+    else if (length >= 0xFFFFFFF0) {
+        return false; // reserved
+    }
+
+    if (c.hasError() || length > info.size - c.getPos()) {
+        return false;
+    }
+
+    unit.end     = c.getPos() + length;
+    unit.version = c.readU(2);
+
+    if (unit.version < 2 || unit.version > 5) {
+        LOG_WARN("Unsupported DWARF version %1 in unit at offset %2", unit.version, offset);
+        return false;
+    }
+
+    uint64 abbrevOffset = 0;
+
+    if (unit.version >= 5) {
+        const uint8 unitType = c.readU(1);
+        unit.addrSize        = c.readU(1);
+        abbrevOffset         = c.readU(unit.offsetSize);
+
+        switch (unitType) {
+        case DW_UT_compile:
+        case DW_UT_partial: break;
+        case DW_UT_skeleton:
+        case DW_UT_split_compile: c.skip(8); break; // dwo_id
+        case DW_UT_type:
+        case DW_UT_split_type: c.skip(8 + unit.offsetSize); break; // signature and type offset
+        default: return false;
+        }
+    }
+    else {
+        abbrevOffset  = c.readU(unit.offsetSize);
+        unit.addrSize = c.readU(1);
+    }
+
+    if (c.hasError() || (unit.addrSize != 2 && unit.addrSize != 4 && unit.addrSize != 8)) {
+        return false;
+    }
+
+    unit.firstDie = c.getPos();
+    unit.abbrevs  = getAbbrevTable(abbrevOffset);
+
+    return unit.abbrevs != nullptr && unit.firstDie < unit.end;
+}
+
+
+void DwarfReader::readUnitAttributes(Unit &unit)
+{
+    Die die;
+    if (!readDie(unit, unit.firstDie, die)) {
+        return;
+    }
+
+    // The bases must be known before any string or address of the unit can be read
+    unit.language = getConstant(die, DW_AT_language, 0);
+
+    if (const AttrValue *val = die.find(DW_AT_str_offsets_base)) {
+        unit.strOffsetsBase = val->value;
+    }
+
+    const AttrValue *addrBase = die.find(DW_AT_addr_base);
+    if (!addrBase) {
+        addrBase = die.find(DW_AT_GNU_addr_base);
+    }
+
+    if (addrBase) {
+        unit.addrBase = addrBase->value;
+    }
+}
+
+
+void DwarfReader::indexUnit(const Unit &unit)
+{
+    Die die;
+    uint64 offset = unit.firstDie;
+
+    // The DIEs of a unit are stored consecutively in pre-order,
+    // so all of them can be visited without following the tree structure.
+    while (offset < unit.end) {
+        if (!readDie(unit, offset, die)) {
+            LOG_WARN("Invalid DWARF debugging information entry at offset %1", offset);
+            return;
+        }
+
+        offset = die.end;
+
+        if (die.tag == DW_TAG_subprogram) {
+            const AttrValue *lowPC = die.find(DW_AT_low_pc);
+            Address entry;
+
+            // Functions removed by the linker have a low_pc of 0
+            if (lowPC && !die.find(DW_AT_declaration) && getAddress(unit, *lowPC, entry) &&
+                !entry.isZero() && m_functions.find(entry) == m_functions.end()) {
+                m_functions[entry] = { die.offset, getName(die) };
+            }
+        }
+        else if (die.tag == DW_TAG_variable) {
+            Address addr;
+
+            if (getLocationAddress(die, addr) && m_globals.find(addr) == m_globals.end()) {
+                m_globals[addr] = die.offset;
+            }
+        }
+    }
+}
+
+
+const DwarfReader::AbbrevTable *DwarfReader::getAbbrevTable(uint64 offset)
+{
+    auto it = m_abbrevTables.find(offset);
+    if (it != m_abbrevTables.end()) {
+        return &it->second;
+    }
+
+    const Section &abbrevSection = m_sections[static_cast<int>(SectionType::Abbrev)];
+    DwarfCursor c(abbrevSection.data, abbrevSection.size, offset, m_endian);
+    AbbrevTable table;
+
+    while (!c.hasError()) {
+        const uint64 code = c.readULEB128();
+        if (code == 0) {
+            break;
+        }
+
+        Abbrev abbrev;
+        abbrev.tag         = c.readULEB128();
+        abbrev.hasChildren = c.readU(1) != 0;
+
+        while (!c.hasError()) {
+            const uint16 attr   = c.readULEB128();
+            const uint16 form   = c.readULEB128();
+            sint64 implicitCons = 0;
+
+            if (attr == 0 && form == 0) {
+                break;
+            }
+            else if (form == DW_FORM_implicit_const) {
+                implicitCons = c.readSLEB128();
+            }
+
+            abbrev.attrs.push_back({ attr, form, implicitCons });
+        }
+
+        table[code] = std::move(abbrev);
+    }
+
+    if (c.hasError()) {
+        LOG_WARN("Invalid DWARF abbreviation table at offset %1", offset);
+        return nullptr;
+    }
+
+    return &(m_abbrevTables[offset] = std::move(table));
+}
+
+
+bool DwarfReader::readDie(const Unit &unit, uint64 offset, Die &die) const
+{
+    die.attrs.clear();
+    die.offset      = offset;
+    die.unit        = &unit;
+    die.tag         = 0;
+    die.hasChildren = false;
+
+    if (offset < unit.firstDie || offset >= unit.end) {
+        return false;
+    }
+
+    const Section &info = m_sections[static_cast<int>(SectionType::Info)];
+    DwarfCursor c(info.data, unit.end, offset, m_endian);
+
+    const uint64 code = c.readULEB128();
+    if (c.hasError()) {
+        return false;
+    }
+    else if (code == 0) {
+        die.end = c.getPos();
+        return true;
+    }
+
+    auto it = unit.abbrevs->find(code);
+    if (it == unit.abbrevs->end()) {
+        return false;
+    }
+
+    const Abbrev &abbrev = it->second;
+    die.tag              = abbrev.tag;
+    die.hasChildren      = abbrev.hasChildren;
+    die.attrs.reserve(abbrev.attrs.size());
+
+    for (const AttrSpec &spec : abbrev.attrs) {
+        AttrValue val;
+        uint16 form = spec.form;
+
+        // The form of indirect attributes is stored in the DIE itself
+        while (form == DW_FORM_indirect && !c.hasError()) {
+            form = c.readULEB128();
+        }
+
+        val.form = form;
+
+        switch (form) {
+        case DW_FORM_addr: val.value = c.readU(unit.addrSize); break;
+        case DW_FORM_data1:
+        case DW_FORM_ref1:
+        case DW_FORM_flag:
+        case DW_FORM_strx1:
+        case DW_FORM_addrx1: val.value = c.readU(1); break;
+        case DW_FORM_data2:
+        case DW_FORM_ref2:
+        case DW_FORM_strx2:
+        case DW_FORM_addrx2: val.value = c.readU(2); break;
+        case DW_FORM_strx3:
+        case DW_FORM_addrx3: val.value = c.readU(3); break;
+        case DW_FORM_data4:
+        case DW_FORM_ref4:
+        case DW_FORM_ref_sup4:
+        case DW_FORM_strx4:
+        case DW_FORM_addrx4: val.value = c.readU(4); break;
+        case DW_FORM_data8:
+        case DW_FORM_ref8:
+        case DW_FORM_ref_sig8:
+        case DW_FORM_ref_sup8: val.value = c.readU(8); break;
+        case DW_FORM_sdata: val.value = static_cast<uint64>(c.readSLEB128()); break;
+        case DW_FORM_udata:
+        case DW_FORM_ref_udata:
+        case DW_FORM_strx:
+        case DW_FORM_addrx:
+        case DW_FORM_loclistx:
+        case DW_FORM_rnglistx: val.value = c.readULEB128(); break;
+        case DW_FORM_strp:
+        case DW_FORM_line_strp:
+        case DW_FORM_sec_offset:
+        case DW_FORM_strp_sup: val.value = c.readU(unit.offsetSize); break;
+        case DW_FORM_ref_addr:
+            val.value = c.readU(unit.version <= 2 ? unit.addrSize : unit.offsetSize);
+            break;
+        case DW_FORM_flag_present: val.value = 1; break;
+        case DW_FORM_implicit_const: val.value = static_cast<uint64>(spec.implicitConst); break;
+        case DW_FORM_string:
+            val.block = c.getPtr();
+            val.value = c.skipString();
+            break;
+        case DW_FORM_data16:
+            val.block = c.getPtr();
+            val.value = 16;
+            c.skip(16);
+            break;
+        case DW_FORM_block1:
+        case DW_FORM_block2:
+        case DW_FORM_block4:
+        case DW_FORM_block:
+        case DW_FORM_exprloc:
+            switch (form) {
+            case DW_FORM_block1: val.value = c.readU(1); break;
+            case DW_FORM_block2: val.value = c.readU(2); break;
+            case DW_FORM_block4: val.value = c.readU(4); break;
+            default: val.value = c.readULEB128(); break;
+            }
+
+            val.block = c.getPtr();
+            c.skip(val.value);
+            break;
+
+        default:
+            LOG_WARN("Unknown DWARF attribute form %1 at offset %2", form, offset);
+            return false;
+        }
+
+        if (c.hasError()) {
+            return false;
+        }
+
+        die.attrs.emplace_back(spec.attr, val);
+    }
+
+    die.end = c.getPos();
+    return true;
+}
+
+
+bool DwarfReader::readDieAt(uint64 offset, Die &die) const
+{
+    // find the unit containing the DIE
+    auto it = std::upper_bound(m_units.begin(), m_units.end(), offset,
+                               [](uint64 off, const Unit &unit) { return off < unit.offset; });
+
+    if (it == m_units.begin()) {
+        return false;
+    }
+
+    --it;
+    return readDie(*it, offset, die) && die.tag != 0;
+}
+
+
+std::vector<DwarfReader::Die> DwarfReader::readChildren(const Die &die) const
+{
+    std::vector<Die> children;
+    if (!die.hasChildren) {
+        return children;
+    }
+
+    uint64 offset = die.end;
+    Die child;
+
+    while (readDie(*die.unit, offset, child) && child.tag != 0) {
+        const uint64 next = getSiblingOffset(child);
+        children.push_back(child);
+
+        if (next <= offset) {
+            break;
+        }
+
+        offset = next;
+    }
+
+    return children;
+}
+
+
+uint64 DwarfReader::getSiblingOffset(const Die &die) const
+{
+    if (!die.hasChildren) {
+        return die.end;
+    }
+    else if (const AttrValue *sibling = die.find(DW_AT_sibling)) {
+        const uint64 ref = getReference(die, *sibling);
+        if (ref > die.offset) {
+            return ref;
+        }
+    }
+
+    // Skip all descendants
+    uint64 offset = die.end;
+    int depth     = 1;
+    Die d;
+
+    while (depth > 0) {
+        if (!readDie(*die.unit, offset, d)) {
+            return die.unit->end;
+        }
+        else if (d.tag == 0) {
+            depth--;
+        }
+        else if (d.hasChildren) {
+            depth++;
+        }
+
+        offset = d.end;
+    }
+
+    return offset;
+}
+
+
+const DwarfReader::AttrValue *DwarfReader::findInheritedAttr(const Die &die, uint16 attr,
+                                                             Die &owner) const
+{
+    if (die.find(attr)) {
+        owner = die;
+        return owner.find(attr);
+    }
+
+    const Die *current = &die;
+
+    for (int i = 0; i < MAX_ORIGIN_DEPTH; i++) {
+        Die origin;
+        if (!readOrigin(*current, origin)) {
+            return nullptr;
+        }
+
+        owner   = std::move(origin);
+        current = &owner;
+
+        if (const AttrValue *val = owner.find(attr)) {
+            return val;
+        }
+    }
+
+    return nullptr;
+}
+
+
+bool DwarfReader::readOrigin(const Die &die, Die &origin) const
+{
+    const AttrValue *ref = die.find(DW_AT_abstract_origin);
+    if (!ref) {
+        ref = die.find(DW_AT_specification);
+    }
+
+    return ref && readDieAt(getReference(die, *ref), origin);
+}
+
+
+QString DwarfReader::getName(const Die &die) const
+{
+    // Prefer linkage names, they are the names used by the symbol table.
+    Die owner;
+    const AttrValue *val = findInheritedAttr(die, DW_AT_linkage_name, owner);
+
+    if (!val) {
+        val = findInheritedAttr(die, DW_AT_MIPS_linkage_name, owner);
+    }
+
+    if (!val) {
+        val = findInheritedAttr(die, DW_AT_name, owner);
+    }
+
+    return val ? getString(owner, *val) : QString();
+}
+
+
+QString DwarfReader::getString(const Die &die, const AttrValue &val) const
+{
+    switch (val.form) {
+    case DW_FORM_string:
+        return QString::fromUtf8(reinterpret_cast<const char *>(val.block), val.value);
+    case DW_FORM_strp: return readStringAt(SectionType::Str, val.value);
+    case DW_FORM_line_strp: return readStringAt(SectionType::LineStr, val.value);
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4: {
+        const Unit &unit       = *die.unit;
+        const Section &offsets = m_sections[static_cast<int>(SectionType::StrOffsets)];
+        DwarfCursor c(offsets.data, offsets.size,
+                      unit.strOffsetsBase + val.value * unit.offsetSize, m_endian);
+
+        const uint64 strOffset = c.readU(unit.offsetSize);
+        return c.hasError() ? QString() : readStringAt(SectionType::Str, strOffset);
+    }
+    default: return QString();
+    }
+}
+
+
+QString DwarfReader::readStringAt(SectionType type, uint64 offset) const
+{
+    const Section &section = m_sections[static_cast<int>(type)];
+    DwarfCursor c(section.data, section.size, offset, m_endian);
+
+    const char *str  = reinterpret_cast<const char *>(c.getPtr());
+    const uint64 len = c.skipString();
+
+    return c.hasError() ? QString() : QString::fromUtf8(str, len);
+}
+
+
+bool DwarfReader::getAddress(const Unit &unit, const AttrValue &val, Address &addr) const
+{
+    switch (val.form) {
+    case DW_FORM_addr: addr = Address(val.value); return true;
+    case DW_FORM_addrx:
+    case DW_FORM_addrx1:
+    case DW_FORM_addrx2:
+    case DW_FORM_addrx3:
+    case DW_FORM_addrx4: {
+        const Section &addrSection = m_sections[static_cast<int>(SectionType::Addr)];
+        DwarfCursor c(addrSection.data, addrSection.size,
+                      unit.addrBase + val.value * unit.addrSize, m_endian);
+
+        addr = Address(c.readU(unit.addrSize));
+        return !c.hasError();
+    }
+    default: return false;
+    }
+}
+
+
+bool DwarfReader::getLocationAddress(const Die &die, Address &addr) const
+{
+    const AttrValue *loc = die.find(DW_AT_location);
+    if (!loc || !isBlockForm(loc->form) || loc->value == 0) {
+        return false;
+    }
+
+    // Only accept locations consisting of a single address,
+    // e.g. not thread local variables
+    const Unit &unit = *die.unit;
+    DwarfCursor c(loc->block, loc->value, 0, m_endian);
+
+    switch (c.readU(1)) {
+    case DW_OP_addr: addr = Address(c.readU(unit.addrSize)); break;
+    case DW_OP_addrx:
+    case DW_OP_GNU_addr_index: {
+        AttrValue index;
+        index.form  = DW_FORM_addrx;
+        index.value = c.readULEB128();
+
+        if (!getAddress(unit, index, addr)) {
+            return false;
+        }
+        break;
+    }
+    default: return false;
+    }
+
+    return !c.hasError() && c.getPos() == loc->value && !addr.isZero();
+}
+
+
+uint64 DwarfReader::getReference(const Die &die, const AttrValue &val) const
+{
+    switch (val.form) {
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata: return die.unit->offset + val.value;
+    case DW_FORM_ref_addr: return val.value;
+    default: return 0; // references to type units and supplementary files are not supported
+    }
+}
+
+
+uint64 DwarfReader::getConstant(const Die &die, uint16 attr, uint64 defaultValue) const
+{
+    const AttrValue *val = die.find(attr);
+    return (val && isConstantForm(val->form)) ? val->value : defaultValue;
+}
+
+
+SharedType DwarfReader::getType(uint64 offset, int depth) const
+{
+    auto it = m_types.find(offset);
+    if (it != m_types.end()) {
+        return it->second;
+    }
+    else if (depth > MAX_TYPE_DEPTH) {
+        return VoidType::get();
+    }
+
+    Die die;
+    if (!readDieAt(offset, die)) {
+        return VoidType::get();
+    }
+
+    SharedType ty   = decodeType(die, depth + 1);
+    m_types[offset] = ty;
+    return ty;
+}
+
+
+SharedType DwarfReader::getTypeOf(const Die &die, int depth) const
+{
+    Die owner;
+    const AttrValue *val = findInheritedAttr(die, DW_AT_type, owner);
+    const uint64 ref     = val ? getReference(owner, *val) : 0;
+
+    return (ref != 0) ? getType(ref, depth) : VoidType::get();
+}
+
+
+SharedType DwarfReader::decodeType(const Die &die, int depth) const
+{
+    const uint64 byteSize = getConstant(die, DW_AT_byte_size, 0);
+
+    switch (die.tag) {
+    case DW_TAG_base_type: return getBaseType(getConstant(die, DW_AT_encoding, 0), byteSize * 8);
+
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_reference_type: return PointerType::get(getTypeOf(die, depth));
+
+    // qualifiers and type names are not represented in the type system
+    case DW_TAG_const_type:
+    case DW_TAG_volatile_type:
+    case DW_TAG_restrict_type:
+    case DW_TAG_atomic_type:
+    case DW_TAG_typedef: return getTypeOf(die, depth);
+
+    case DW_TAG_enumeration_type: {
+        SharedType base = getTypeOf(die, depth);
+        if (base->isInteger()) {
+            return base;
+        }
+
+        return IntegerType::get(byteSize != 0 ? byteSize * 8 : 32);
+    }
+
+    case DW_TAG_structure_type:
+    case DW_TAG_class_type: return decodeCompoundType(die, depth);
+    case DW_TAG_union_type: return decodeUnionType(die, depth);
+    case DW_TAG_array_type: return decodeArrayType(die, depth);
+    case DW_TAG_subroutine_type: return FuncType::get(decodeSignature(die, "", depth));
+    case DW_TAG_unspecified_type: return VoidType::get();
+
+    default: return (byteSize != 0) ? SharedType(SizeType::get(byteSize * 8)) : VoidType::get();
+    }
+}
+
+
+SharedType DwarfReader::decodeCompoundType(const Die &die, int depth) const
+{
+    if (die.find(DW_AT_declaration)) {
+        return VoidType::get(); // incomplete type
+    }
+
+    // Register the type before decoding the members, which may point to it
+    std::shared_ptr<CompoundType> compound = CompoundType::get();
+    m_types[die.offset]                    = compound;
+
+    uint64 size = 0; // in bytes
+
+    for (const Die &member : readChildren(die)) {
+        if (member.tag != DW_TAG_member || member.find(DW_AT_declaration)) {
+            continue; // static members etc.
+        }
+
+        uint64 offset             = 0;
+        const AttrValue *location = member.find(DW_AT_data_member_location);
+
+        if (location && isConstantForm(location->form)) {
+            offset = location->value;
+        }
+        else if (location && isBlockForm(location->form)) {
+            DwarfCursor c(location->block, location->value, 0, m_endian);
+            if (c.readU(1) != DW_OP_plus_uconst) {
+                continue; // e.g. virtual base classes
+            }
+
+            offset = c.readULEB128();
+        }
+        else {
+            offset = getConstant(member, DW_AT_data_bit_offset, 0) / 8;
+        }
+
+        // Bit fields sharing a storage unit with the previous member
+        if (offset < size) {
+            continue;
+        }
+        else if (offset > size) {
+            compound->addMember(SizeType::get((offset - size) * 8), QString("pad%1").arg(size));
+        }
+
+        SharedType memberType = getTypeOf(member, depth);
+        compound->addMember(memberType, getName(member));
+        size = offset + memberType->getSizeInBytes();
+    }
+
+    const uint64 byteSize = getConstant(die, DW_AT_byte_size, 0);
+    if (byteSize > size) {
+        compound->addMember(SizeType::get((byteSize - size) * 8), QString("pad%1").arg(size));
+    }
+
+    return compound;
+}
+
+
+SharedType DwarfReader::decodeUnionType(const Die &die, int depth) const
+{
+    if (die.find(DW_AT_declaration)) {
+        return VoidType::get(); // incomplete type
+    }
+
+    std::shared_ptr<UnionType> unionTy = UnionType::get();
+    m_types[die.offset]                = unionTy;
+
+    for (const Die &member : readChildren(die)) {
+        if (member.tag == DW_TAG_member) {
+            unionTy->addType(getTypeOf(member, depth), getName(member));
+        }
+    }
+
+    if (unionTy->getNumTypes() == 0) {
+        const uint64 byteSize = getConstant(die, DW_AT_byte_size, 0);
+        m_types[die.offset]   = (byteSize != 0) ? SharedType(SizeType::get(byteSize * 8))
+                                                : VoidType::get();
+        return m_types[die.offset];
+    }
+
+    return unionTy;
+}
+
+
+SharedType DwarfReader::decodeArrayType(const Die &die, int depth) const
+{
+    std::vector<uint64> dimensions;
+
+    for (const Die &child : readChildren(die)) {
+        if (child.tag != DW_TAG_subrange_type) {
+            continue;
+        }
+
+        const AttrValue *count = child.find(DW_AT_count);
+        const AttrValue *upper = child.find(DW_AT_upper_bound);
+
+        if (count && isConstantForm(count->form)) {
+            dimensions.push_back(count->value);
+        }
+        else if (upper && isConstantForm(upper->form)) {
+            const uint64 lower = getConstant(child, DW_AT_lower_bound, 0);
+            dimensions.push_back(upper->value >= lower ? upper->value - lower + 1 : 0);
+        }
+        else {
+            dimensions.push_back(ARRAY_UNBOUNDED); // e.g. variable length arrays
+        }
+    }
+
+    SharedType ty = getTypeOf(die, depth);
+    if (dimensions.empty()) {
+        return ArrayType::get(ty);
+    }
+
+    // int a[2][3] is an array of 2 arrays of 3 ints
+    for (auto it = dimensions.rbegin(); it != dimensions.rend(); ++it) {
+        ty = ArrayType::get(ty, *it);
+    }
+
+    return ty;
+}
+
+
+std::shared_ptr<Signature> DwarfReader::decodeSignature(const Die &die, const QString &name,
+                                                        int depth) const
+{
+    // The location of parameters and returns is only known for these machines
+    if (m_machine != Machine::X86 && m_machine != Machine::PPC) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Signature> sig = Signature::instantiate(m_machine, CallConv::C, name);
+    sig->addReturn(getTypeOf(die, depth));
+
+    // Out of line instances of inlined functions may omit the parameters
+    std::vector<Die> children = readChildren(die);
+
+    const bool hasParams = std::any_of(children.begin(), children.end(), [](const Die &child) {
+        return child.tag == DW_TAG_formal_parameter || child.tag == DW_TAG_unspecified_parameters;
+    });
+
+    Die origin;
+    if (!hasParams && readOrigin(die, origin)) {
+        children = readChildren(origin);
+    }
+
+    for (const Die &child : children) {
+        if (child.tag == DW_TAG_formal_parameter) {
+            sig->addParameter(
+                std::make_shared<Parameter>(getTypeOf(child, depth), getName(child), nullptr));
+        }
+        else if (child.tag == DW_TAG_unspecified_parameters) {
+            sig->setHasEllipsis(true);
+        }
+    }
+
+    return sig;
+}
+
+
+bool DwarfReader::isPrototyped(const Die &die) const
+{
+    Die owner;
+    const AttrValue *prototyped = findInheritedAttr(die, DW_AT_prototyped, owner);
+
+    if (prototyped && prototyped->value != 0) {
+        return true;
+    }
+
+    // K&R style definitions in C do not specify the parameters of the function.
+    // In C++, all functions are prototyped, but DW_AT_prototyped is not used.
+    switch (die.unit->language) {
+    case DW_LANG_C_plus_plus:
+    case DW_LANG_C_plus_plus_03:
+    case DW_LANG_C_plus_plus_11:
+    case DW_LANG_C_plus_plus_14:
+    case DW_LANG_ObjC:
+    case DW_LANG_ObjC_plus_plus: return true;
+    default: return false;
+    }
+}
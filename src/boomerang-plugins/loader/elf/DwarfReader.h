@@ -0,0 +1,201 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/ssl/type/Type.h"
+#include "boomerang/util/Address.h"
+#include "boomerang/util/ByteUtil.h"
+
+#include <QString>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+class Signature;
+
+
+/**
+ * Reader for DWARF debugging information (versions 2 to 5) of ELF files.
+ *
+ * Loading only indexes the compilation units: The entry points and names of all functions
+ * and the addresses of all global variables are recorded together with the offsets
+ * of their debugging information entries (DIEs). Signatures and types are decoded
+ * from these offsets on demand, and decoded types are cached, so that large amounts
+ * of debugging information do not slow down loading the binary.
+ */
+class DwarfReader
+{
+public:
+    /// The debug sections read by this class
+    enum class SectionType : uint8_t
+    {
+        Info,        ///< .debug_info
+        Abbrev,      ///< .debug_abbrev
+        Str,         ///< .debug_str
+        LineStr,     ///< .debug_line_str (DWARF 5)
+        StrOffsets,  ///< .debug_str_offsets (DWARF 5)
+        Addr,        ///< .debug_addr (DWARF 5)
+        NumSections
+    };
+
+public:
+    DwarfReader(Machine machine, Endian endian);
+
+public:
+    /// \returns the type of the debug section named \p name,
+    /// or SectionType::NumSections if the section is not used by this class.
+    static SectionType getSectionType(const QString &name);
+
+    /// Set the contents of the debug section of type \p type.
+    /// The data must stay valid for the lifetime of this object.
+    void setSection(SectionType type, const Byte *data, std::size_t size);
+
+    /// Index all units of the .debug_info section. Units that cannot be read are skipped.
+    /// \returns true if any function or global variable was found.
+    bool load();
+
+    /// \returns true if any function or global variable was found.
+    bool hasDebugInfo() const;
+
+    /// \returns the entry addresses of all functions, sorted by address.
+    std::vector<Address> getFunctionStarts() const;
+
+    /// \returns the (linkage) name of the function starting at \p entry,
+    /// or the empty string if it is not known.
+    QString getFunctionName(Address entry) const;
+
+    /// \returns the signature of the function starting at \p entry,
+    /// or nullptr if the function or its prototype is not known.
+    std::shared_ptr<Signature> getSignature(Address entry) const;
+
+    /// \returns the type of the global variable starting at \p addr,
+    /// or nullptr if the variable is not known.
+    SharedType getGlobalType(Address addr) const;
+
+private:
+    struct Section
+    {
+        const Byte *data = nullptr;
+        std::size_t size = 0;
+    };
+
+    struct AttrSpec
+    {
+        uint16 attr;
+        uint16 form;
+        sint64 implicitConst; ///< Value of DW_FORM_implicit_const attributes
+    };
+
+    struct Abbrev
+    {
+        uint16 tag       = 0;
+        bool hasChildren = false;
+        std::vector<AttrSpec> attrs;
+    };
+
+    typedef std::unordered_map<uint64, Abbrev> AbbrevTable;
+
+    struct Unit
+    {
+        uint64 offset         = 0; ///< Offset of the unit header in .debug_info
+        uint64 end            = 0; ///< Offset of the first byte after the unit
+        uint64 firstDie       = 0; ///< Offset of the unit DIE
+        uint16 version        = 0;
+        uint8 addrSize        = 4;
+        uint8 offsetSize      = 4; ///< 4 for 32 bit DWARF, 8 for 64 bit DWARF
+        uint16 language       = 0;
+        uint64 strOffsetsBase = 0;
+        uint64 addrBase       = 0;
+        const AbbrevTable *abbrevs = nullptr;
+    };
+
+    struct AttrValue
+    {
+        uint16 form       = 0;
+        uint64 value      = 0;       ///< Constant, offset, index, address or block size
+        const Byte *block = nullptr; ///< Data of block and inline string forms
+    };
+
+    struct Die
+    {
+        uint64 offset    = 0; ///< Offset in .debug_info
+        uint64 end       = 0; ///< Offset of the first child or the next sibling
+        uint16 tag       = 0; ///< 0 for the null entry terminating a list of siblings
+        bool hasChildren = false;
+        const Unit *unit = nullptr;
+        std::vector<std::pair<uint16, AttrValue>> attrs;
+
+        const AttrValue *find(uint16 attr) const;
+    };
+
+    struct FunctionEntry
+    {
+        uint64 dieOffset;
+        QString name;
+    };
+
+private:
+    bool readUnitHeader(uint64 offset, Unit &unit);
+    void readUnitAttributes(Unit &unit);
+    void indexUnit(const Unit &unit);
+
+    const AbbrevTable *getAbbrevTable(uint64 offset);
+
+    bool readDie(const Unit &unit, uint64 offset, Die &die) const;
+    bool readDieAt(uint64 offset, Die &die) const;
+    std::vector<Die> readChildren(const Die &die) const;
+    uint64 getSiblingOffset(const Die &die) const;
+
+    /// \returns the attribute \p attr of \p die, or of the DIEs it refers to
+    /// by DW_AT_abstract_origin or DW_AT_specification.
+    /// \p owner is set to the DIE containing the attribute.
+    const AttrValue *findInheritedAttr(const Die &die, uint16 attr, Die &owner) const;
+
+    /// Read the DIE referred to by DW_AT_abstract_origin or DW_AT_specification of \p die.
+    bool readOrigin(const Die &die, Die &origin) const;
+
+    QString getName(const Die &die) const;
+    QString getString(const Die &die, const AttrValue &val) const;
+    QString readStringAt(SectionType type, uint64 offset) const;
+    bool getAddress(const Unit &unit, const AttrValue &val, Address &addr) const;
+    bool getLocationAddress(const Die &die, Address &addr) const;
+    uint64 getReference(const Die &die, const AttrValue &val) const;
+    uint64 getConstant(const Die &die, uint16 attr, uint64 defaultValue) const;
+
+    SharedType getType(uint64 offset, int depth) const;
+    SharedType getTypeOf(const Die &die, int depth) const;
+    SharedType decodeType(const Die &die, int depth) const;
+    SharedType decodeCompoundType(const Die &die, int depth) const;
+    SharedType decodeUnionType(const Die &die, int depth) const;
+    SharedType decodeArrayType(const Die &die, int depth) const;
+    std::shared_ptr<Signature> decodeSignature(const Die &die, const QString &name,
+                                               int depth) const;
+    bool isPrototyped(const Die &die) const;
+
+private:
+    Machine m_machine;
+    Endian m_endian;
+    std::array<Section, static_cast<int>(SectionType::NumSections)> m_sections;
+
+    std::map<uint64, AbbrevTable> m_abbrevTables; ///< by offset in .debug_abbrev
+    std::vector<Unit> m_units;                    ///< sorted by offset
+
+    std::map<Address, FunctionEntry> m_functions;
+    std::map<Address, uint64> m_globals; ///< DIE offset by address of the variable
+
+    /// Decoded types by DIE offset
+    mutable std::unordered_map<uint64, SharedType> m_types;
+};
@@ -0,0 +1,149 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+/// \file DwarfTypes.h This file contains the constants of the DWARF debugging information format
+/// that are used by the DWARF reader (versions 2 to 5).
+/// \sa http://dwarfstd.org/doc/DWARF5.pdf
+
+
+// Unit types (DWARF 5)
+#define DW_UT_compile                 0x01
+#define DW_UT_type                    0x02
+#define DW_UT_partial                 0x03
+#define DW_UT_skeleton                0x04
+#define DW_UT_split_compile           0x05
+#define DW_UT_split_type              0x06
+
+// Tags
+#define DW_TAG_array_type             0x01
+#define DW_TAG_class_type             0x02
+#define DW_TAG_enumeration_type       0x04
+#define DW_TAG_formal_parameter       0x05
+#define DW_TAG_member                 0x0D
+#define DW_TAG_pointer_type           0x0F
+#define DW_TAG_reference_type         0x10
+#define DW_TAG_compile_unit           0x11
+#define DW_TAG_structure_type         0x13
+#define DW_TAG_subroutine_type        0x15
+#define DW_TAG_typedef                0x16
+#define DW_TAG_union_type             0x17
+#define DW_TAG_unspecified_parameters 0x18
+#define DW_TAG_subrange_type          0x21
+#define DW_TAG_base_type              0x24
+#define DW_TAG_const_type             0x26
+#define DW_TAG_subprogram             0x2E
+#define DW_TAG_variable               0x34
+#define DW_TAG_volatile_type          0x35
+#define DW_TAG_restrict_type          0x37
+#define DW_TAG_unspecified_type       0x3B
+#define DW_TAG_rvalue_reference_type  0x42
+#define DW_TAG_atomic_type            0x47
+
+// Attributes
+#define DW_AT_sibling                 0x01
+#define DW_AT_location                0x02
+#define DW_AT_name                    0x03
+#define DW_AT_byte_size               0x0B
+#define DW_AT_low_pc                  0x11
+#define DW_AT_high_pc                 0x12
+#define DW_AT_language                0x13
+#define DW_AT_lower_bound             0x22
+#define DW_AT_prototyped              0x27
+#define DW_AT_upper_bound             0x2F
+#define DW_AT_abstract_origin         0x31
+#define DW_AT_count                   0x37
+#define DW_AT_data_member_location    0x38
+#define DW_AT_declaration             0x3C
+#define DW_AT_encoding                0x3E
+#define DW_AT_external                0x3F
+#define DW_AT_specification           0x47
+#define DW_AT_type                    0x49
+#define DW_AT_data_bit_offset         0x6B
+#define DW_AT_linkage_name            0x6E
+#define DW_AT_str_offsets_base        0x72
+#define DW_AT_addr_base               0x73
+#define DW_AT_MIPS_linkage_name       0x2007
+#define DW_AT_GNU_addr_base           0x2133
+
+// Attribute forms
+#define DW_FORM_addr                  0x01
+#define DW_FORM_block2                0x03
+#define DW_FORM_block4                0x04
+#define DW_FORM_data2                 0x05
+#define DW_FORM_data4                 0x06
+#define DW_FORM_data8                 0x07
+#define DW_FORM_string                0x08
+#define DW_FORM_block                 0x09
+#define DW_FORM_block1                0x0A
+#define DW_FORM_data1                 0x0B
+#define DW_FORM_flag                  0x0C
+#define DW_FORM_sdata                 0x0D
+#define DW_FORM_strp                  0x0E
+#define DW_FORM_udata                 0x0F
+#define DW_FORM_ref_addr              0x10
+#define DW_FORM_ref1                  0x11
+#define DW_FORM_ref2                  0x12
+#define DW_FORM_ref4                  0x13
+#define DW_FORM_ref8                  0x14
+#define DW_FORM_ref_udata             0x15
+#define DW_FORM_indirect              0x16
+#define DW_FORM_sec_offset            0x17
+#define DW_FORM_exprloc               0x18
+#define DW_FORM_flag_present          0x19
+#define DW_FORM_strx                  0x1A
+#define DW_FORM_addrx                 0x1B
+#define DW_FORM_ref_sup4              0x1C
+#define DW_FORM_strp_sup              0x1D
+#define DW_FORM_data16                0x1E
+#define DW_FORM_line_strp             0x1F
+#define DW_FORM_ref_sig8              0x20
+#define DW_FORM_implicit_const        0x21
+#define DW_FORM_loclistx              0x22
+#define DW_FORM_rnglistx              0x23
+#define DW_FORM_ref_sup8              0x24
+#define DW_FORM_strx1                 0x25
+#define DW_FORM_strx2                 0x26
+#define DW_FORM_strx3                 0x27
+#define DW_FORM_strx4                 0x28
+#define DW_FORM_addrx1                0x29
+#define DW_FORM_addrx2                0x2A
+#define DW_FORM_addrx3                0x2B
+#define DW_FORM_addrx4                0x2C
+
+// Location expression operations
+#define DW_OP_addr                    0x03
+#define DW_OP_plus_uconst             0x23
+#define DW_OP_addrx                   0xA1
+#define DW_OP_GNU_addr_index          0xFB
+
+// Base type encodings
+#define DW_ATE_address                0x01
+#define DW_ATE_boolean                0x02
+#define DW_ATE_float                  0x04
+#define DW_ATE_signed                 0x05
+#define DW_ATE_signed_char            0x06
+#define DW_ATE_unsigned               0x07
+#define DW_ATE_unsigned_char          0x08
+#define DW_ATE_UTF                    0x10
+
+// Source languages
+#define DW_LANG_C89                   0x0001
+#define DW_LANG_C                     0x0002
+#define DW_LANG_C_plus_plus           0x0004
+#define DW_LANG_C99                   0x000C
+#define DW_LANG_ObjC                  0x0010
+#define DW_LANG_ObjC_plus_plus        0x0011
+#define DW_LANG_C_plus_plus_03        0x0019
+#define DW_LANG_C_plus_plus_11        0x001A
+#define DW_LANG_C11                   0x001D
+#define DW_LANG_C_plus_plus_14        0x0021
+#define DW_LANG_C17                   0x002C
@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "ElfBinaryLoader.h"
 
+#include "DwarfReader.h"
 #include "ElfTypes.h"
 
 #include "boomerang/core/plugin/Plugin.h"
@@ -16,6 +17,7 @@
 #include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/signature/Signature.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
@@ -90,6 +92,7 @@ void ElfBinaryLoader::init()
     m_lastSize      = 0;
     m_importStubs   = nullptr;
     m_elfSections.clear();
+    m_dwarf.reset();
 }
 
 
@@ -328,8 +331,10 @@ bool ElfBinaryLoader::loadFromMemory(QByteArray &img)
             }
 
             if (par.sectionType == SHT_STRTAB) {
-                sect->setAttributeForRange("StringsSection", true, sect->getSourceAddr(),
-                                           sect->getSourceAddr() + sect->getSize());
+                sect->setFlagForRange(SectionFlag::Strings, lowAddr, highAddr);
+            }
+            else if (par.Name == ".plt" || par.Name == ".got.plt") {
+                sect->setFlagForRange(SectionFlag::ImportThunk, lowAddr, highAddr);
             }
         }
     }
@@ -374,6 +379,7 @@ bool ElfBinaryLoader::loadFromMemory(QByteArray &img)
     // Apply relocations; important when the input program is not compiled with -fPIC
     applyRelocations();
     markImports();
+    loadDebugInfo();
 
     return true;
 }
@@ -506,15 +512,9 @@ void ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i,
         }
     }
 
-    // try to find given symbol, if it has Value of 0, try to use the name.
-    const BinarySymbol *symbol = sym.Value.isZero() ? m_symbols->findSymbolByName(sym.Name)
-                                                    : m_symbols->findSymbolByAddress(sym.Value);
-
-    // Ensure no overwriting (except functions)
-    if (symbol != nullptr) { // TODO: if symbol already exists
-        return;
-    }
-    else if (sym.Binding == STB_WEAK && sym.Type == STT_NOTYPE) {
+    // Symbols at addresses that already have a symbol are discarded by the symbol table
+    // when it is indexed, so earlier symbols are never overwritten.
+    if (sym.Binding == STB_WEAK && sym.Type == STT_NOTYPE) {
         return;
     }
     else if (sym.Type == STT_FILE) {
@@ -530,7 +530,7 @@ void ElfBinaryLoader::processSymbol(Translated_ElfSym &sym, int e_type, int i,
     }
 
     // TODO: add more symbol information here (function/export etc. ) ?
-    BinarySymbol *new_symbol(m_symbols->createSymbol(sym.Value, sym.Name, local));
+    BinarySymbol *new_symbol(m_symbols->appendSymbol(sym.Value, sym.Name, local));
     new_symbol->setSize(elfRead4(&m_symbolSection[i].st_size));
 
     if (imported) {
@@ -583,6 +583,8 @@ void ElfBinaryLoader::addSymbolsForSection(int secIndex)
     const int numSymbols = section.Size / section.entry_size;
     QString fileName;
 
+    m_symbols->reserve(numSymbols);
+
     // Index 0 is a dummy entry
     for (int i = 1; i < numSymbols; i++) {
         Translated_ElfSym translatedSym;
@@ -842,6 +844,16 @@ void ElfBinaryLoader::elfWrite4(DWord *pi, DWord val)
 }
 
 
+void ElfBinaryLoader::markRelocated(Address addr, int size)
+{
+    BinarySection *sect = m_binaryFile->getImage()->getSectionByAddr(addr);
+
+    if (sect) {
+        sect->setFlagForRange(SectionFlag::Relocated, addr, addr + size);
+    }
+}
+
+
 void ElfBinaryLoader::applyRelocations()
 {
     int nextFakeLibAddr = -2; // See R_386_PC32 below; -1 sometimes used for main
@@ -973,6 +985,7 @@ void ElfBinaryLoader::applyRelocations()
 
                     case R_386_32: // S + A
                         elfWrite4(relocDestination, (S + A).value());
+                        markRelocated(P, 4);
                         break;
 
                     case R_386_PC32: // S + A - P
@@ -1021,6 +1034,7 @@ void ElfBinaryLoader::applyRelocations()
                         }
 
                         elfWrite4(relocDestination, (S + A - P).value());
+                        markRelocated(P, 4);
                         break;
 
                     case R_386_GLOB_DAT:
@@ -1042,6 +1056,61 @@ void ElfBinaryLoader::applyRelocations()
 }
 
 
+void ElfBinaryLoader::loadDebugInfo()
+{
+    std::unique_ptr<DwarfReader> dwarf(new DwarfReader(getMachine(), m_endian));
+
+    for (const SectionParam &par : m_elfSections) {
+        if (par.sectionType != SHT_NOBITS && par.imagePtr != HostAddress::ZERO) {
+            dwarf->setSection(DwarfReader::getSectionType(par.Name),
+                              reinterpret_cast<const Byte *>(par.imagePtr.value()), par.Size);
+        }
+    }
+
+    if (!dwarf->load()) {
+        return;
+    }
+
+    m_dwarf = std::move(dwarf);
+
+    // e.g. static functions of binaries stripped of their local symbols
+    for (Address entry : m_dwarf->getFunctionStarts()) {
+        const QString name = m_dwarf->getFunctionName(entry);
+
+        // Different units may contain static functions with the same name
+        if (!name.isEmpty() && !m_symbols->findSymbolByAddress(entry) &&
+            !m_symbols->findSymbolByName(name)) {
+            BinarySymbol *sym = m_symbols->createSymbol(entry, name, true);
+            sym->setAttribute("Function", true);
+        }
+    }
+}
+
+
+bool ElfBinaryLoader::hasDebugInfo() const
+{
+    return m_dwarf != nullptr;
+}
+
+
+std::vector<Address> ElfBinaryLoader::getDebugFunctions() const
+{
+    return m_dwarf ? m_dwarf->getFunctionStarts() : std::vector<Address>();
+}
+
+
+std::shared_ptr<Signature> ElfBinaryLoader::getDebugSignature(Address entry) const
+{
+    return m_dwarf ? m_dwarf->getSignature(entry) : nullptr;
+}
+
+
+SharedType ElfBinaryLoader::getDebugGlobalType(Address addr) const
+{
+    return m_dwarf ? m_dwarf->getGlobalType(addr) : nullptr;
+}
+
+
 bool ElfBinaryLoader::isRelocationAt(Address addr)
 {
     if (m_loadedImage == nullptr) {
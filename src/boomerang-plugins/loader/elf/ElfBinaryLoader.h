@@ -23,6 +23,7 @@ struct Elf32_Sym;
 struct Translated_ElfSym;
 class BinaryImage;
 class BinarySymbolTable;
+class DwarfReader;
 class QFile;
 class BinarySection;
 
@@ -70,6 +71,18 @@ public:
     /// \copydoc IFileLoader::isRelocationAt
     bool isRelocationAt(Address addr) override;
 
+    /// \copydoc IFileLoader::hasDebugInfo
+    bool hasDebugInfo() const override;
+
+    /// \copydoc IFileLoader::getDebugFunctions
+    std::vector<Address> getDebugFunctions() const override;
+
+    /// \copydoc IFileLoader::getDebugSignature
+    std::shared_ptr<Signature> getDebugSignature(Address entry) const override;
+
+    /// \copydoc IFileLoader::getDebugGlobalType
+    SharedType getDebugGlobalType(Address addr) const override;
+
 private:
     /// Reset internal state, except for those that keep track of which member
     /// we're up to
@@ -119,6 +132,9 @@ private:
     /// Write a 32 bit value, respecting destination endianness
     void elfWrite4(DWord *pi, DWord val);
 
+    /// Mark the \p size bytes at \p addr as patched by a relocation
+    void markRelocated(Address addr, int size);
+
     /**
      * Mark all imported symbols as such.
      * This function relies on the fact that the symbols are sorted by address,
@@ -128,6 +144,10 @@ private:
 
     void processSymbol(Translated_ElfSym &sym, int e_type, int i, const QString &currentFile = "");
 
+    /// Read the DWARF debug information, if present, and add symbols for functions
+    /// that are described by the debug information, but not by the symbol table.
+    void loadDebugInfo();
+
 private:
     size_t m_loadedImageSize = 0;       ///< Size of image in bytes
     Byte *m_loadedImage      = nullptr; ///< Pointer to the loaded image
@@ -155,6 +175,7 @@ private:
     std::unique_ptr<uint32[]> m_shInfo = nullptr;          ///< pointer to array of sh_info values
 
     std::vector<struct SectionParam> m_elfSections;
+    std::unique_ptr<DwarfReader> m_dwarf; ///< DWARF debug information, if present
     BinaryFile *m_binaryFile     = nullptr;
     BinarySymbolTable *m_symbols = nullptr;
 };
@@ -176,6 +176,8 @@ bool ExeBinaryLoader::applyRelocations(QBuffer &fp, QByteArray &data, Address lo
     /* Relocate segment constants */
     m_relocations.resize(numReloc);
 
+    BinarySection *text = m_image->getSectionByName(".text");
+
     for (int i = 0; i < numReloc; i++) {
         ExeReloc relocEntry;
         if (sizeof(ExeReloc) != fp.read(reinterpret_cast<char *>(&relocEntry), sizeof(ExeReloc))) {
@@ -196,6 +198,11 @@ bool ExeBinaryLoader::applyRelocations(QBuffer &fp, QByteArray &data, Address lo
         Byte *p                = &m_loadedImage[imageOffset];
         const SWord relocValue = Util::readWord(p, Endian::Little);
         Util::writeWord(p, loadBaseAddr.value() + relocValue, Endian::Little);
+
+        if (text) {
+            text->setFlagForRange(SectionFlag::Relocated, loadBaseAddr + imageOffset,
+                                  loadBaseAddr + imageOffset + 2);
+        }
     }
 
     Address relocStart   = loadBaseAddr + m_imageSize + sizeof(ExeHeader);
@@ -319,17 +319,17 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
                 continue;
             }
 
+            const Address sectStart = Address(BMMH(sections[s_idx].addr));
+            const Address sectEnd   = sectStart + BMMH(sections[s_idx].size);
+
             if ((0 == strcmp(sections[s_idx].sectname, "__cfstring")) ||
                 (0 == strcmp(sections[s_idx].sectname, "__cstring"))) {
-                sect->setAttributeForRange(
-                    "StringsSection", true, Address(BMMH(sections[s_idx].addr)),
-                    Address(BMMH(sections[s_idx].addr) + BMMH(sections[s_idx].size)));
+                sect->setFlagForRange(SectionFlag::Strings, sectStart, sectEnd);
             }
 
-            sect->setAttributeForRange(
-                "ReadOnly", (BMMH(sections[i].flags) & VM_PROT_WRITE) ? true : false,
-                Address(BMMH(sections[s_idx].addr)),
-                Address(BMMH(sections[s_idx].addr) + BMMH(sections[s_idx].size)));
+            if ((BMMH(sections[s_idx].flags) & SECTION_TYPE) == S_SYMBOL_STUBS) {
+                sect->setFlagForRange(SectionFlag::ImportThunk, sectStart, sectEnd);
+            }
         }
 
         DEBUG_PRINT("loaded segment %1 %2 in mem %3 in file code=%4 data=%5 readonly=%6", a.value(),
@@ -351,7 +351,7 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
                 name++;
             }
 
-            BinarySymbol *sym = Symbols->createSymbol(addr, name);
+            BinarySymbol *sym = Symbols->appendSymbol(addr, name);
             sym->setAttribute("Function", true);
             sym->setAttribute("Imported", true);
         }
@@ -377,7 +377,7 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
                 name++;
             }
 
-            Symbols->createSymbol(Address(BMMH(symbols[i].n_value)), name);
+            Symbols->appendSymbol(Address(BMMH(symbols[i].n_value)), name);
         }
     }
 
@@ -521,6 +521,8 @@ void Win32BinaryLoader::processIAT()
         DWord iatEntry   = Util::readDWord(iat, Endian::Little);
         Address paddr    = Address(READ4_LE(m_peHeader->Imagebase) + firstThunk);
 
+        const Address iatStart = paddr;
+
         while (iatEntry != 0) {
             if ((char *)iat > m_image + m_imageSize) {
                 LOG_WARN("Cannot read IAT entry: entry extends past file size");
@@ -532,7 +534,7 @@ void Win32BinaryLoader::processIAT()
                 // Dots can't be in identifiers
                 QString nodots    = QString(dllName).replace(".", "_");
                 nodots            = QString("%1_%2").arg(nodots).arg(iatEntry & ~(1 << 31));
-                BinarySymbol *sym = m_symbols->createSymbol(paddr, nodots);
+                BinarySymbol *sym = m_symbols->appendSymbol(paddr, nodots);
                 sym->setAttribute("Imported", true);
                 sym->setAttribute("Function", true);
             }
@@ -545,14 +547,14 @@ void Win32BinaryLoader::processIAT()
 
                 QString name = m_image + iatEntry + 2;
 
-                BinarySymbol *sym = m_symbols->createSymbol(paddr, name);
+                BinarySymbol *sym = m_symbols->appendSymbol(paddr, name);
                 sym->setAttribute("Imported", true);
                 sym->setAttribute("Function", true);
                 Address old_loc = Address(HostAddress(iat).value() - HostAddress(m_image).value() +
                                           READ4_LE(m_peHeader->Imagebase));
 
                 if (paddr != old_loc) { // add both possibilities
-                    BinarySymbol *symbol = m_symbols->createSymbol(old_loc, QString("old_") + name);
+                    BinarySymbol *symbol = m_symbols->appendSymbol(old_loc, QString("old_") + name);
                     symbol->setAttribute("Imported", true);
                     symbol->setAttribute("Function", true);
                 }
@@ -562,6 +564,11 @@ void Win32BinaryLoader::processIAT()
             iatEntry = READ4_LE_P(iat);
             paddr += 4;
         }
+
+        BinarySection *iatSection = m_binaryImage->getSectionByAddr(iatStart);
+        if (iatSection) {
+            iatSection->setFlagForRange(SectionFlag::ImportThunk, iatStart, paddr);
+        }
     } while ((++id)->name != 0);
 }
 
@@ -710,6 +717,13 @@ bool Win32BinaryLoader::loadFromMemory(QByteArray &arr)
 
         if (!(par.Bss || par.From.isZero())) {
             sect->addDefinedArea(par.From, par.From + par.PhysSize);
+
+            // The tail of a writable section that is not backed by file contents is BSS.
+            // Read-only tails are zero and constant, so they can still be read.
+            if (!par.ReadOnly && par.PhysSize < par.Size) {
+                sect->setFlagForRange(SectionFlag::Bss, par.From + par.PhysSize,
+                                      par.From + par.Size);
+            }
         }
     }
 
@@ -1008,161 +1022,6 @@ DWord Win32BinaryLoader::win32Read4(const void *src) const
 }
 
 
-bool Win32BinaryLoader::isStaticLinkedLibProc(Address addr) const
-{
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE hProcess = GetCurrentProcess();
-    dbghelp::IMAGEHLP_LINE64 line;
-    line.SizeOfStruct = sizeof(line);
-    line.FileName     = nullptr;
-    dbghelp::SymGetLineFromAddr64(hProcess, addr.value(), 0, &line);
-
-    if (m_hasDebugInfo && (line.FileName == nullptr) || line.FileName && (*line.FileName == 'f')) {
-        return true;
-    }
-#endif
-
-    return (isMinGWsAllocStack(addr) || isMinGWsFrameInit(addr) || isMinGWsFrameEnd(addr) ||
-            isMinGWsCleanupSetup(addr) || isMinGWsMalloc(addr));
-}
-
-
-bool Win32BinaryLoader::isMinGWsAllocStack(Address addr) const
-{
-    if (m_mingwMain) {
-        const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-        if (section) {
-            HostAddress hostAddr    = section->getHostAddr() - section->getSourceAddr() + addr;
-            unsigned char pattern[] = { 0x51, 0x89, 0xE1, 0x83, 0xC1, 0x08, 0x3D, 0x00, 0x10,
-                                        0x00, 0x00, 0x72, 0x10, 0x81, 0xE9, 0x00, 0x10, 0x00,
-                                        0x00, 0x83, 0x09, 0x00, 0x2D, 0x00, 0x10, 0x00, 0x00,
-                                        0xEB, 0xE9, 0x29, 0xC1, 0x83, 0x09, 0x00, 0x89, 0xE0,
-                                        0x89, 0xCC, 0x8B, 0x08, 0x8B, 0x40, 0x04, 0xFF, 0xE0 };
-
-            if (memcmp(hostAddr, pattern, sizeof(pattern)) == 0) {
-                return true;
-            }
-        }
-    }
-
-    return false;
-}
-
-
-bool Win32BinaryLoader::isMinGWsFrameInit(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress hostAddr = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x18, 0x89, 0x7D, 0xFC,
-                             0x8B, 0x7D, 0x08, 0x89, 0x5D, 0xF4, 0x89, 0x75, 0xF8 };
-
-    if (memcmp(hostAddr, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xD2, 0x74, 0x24, 0x8B, 0x42, 0x2C, 0x85, 0xC0, 0x78,
-                             0x3D, 0x8B, 0x42, 0x2C, 0x85, 0xC0, 0x75, 0x56, 0x8B, 0x42,
-                             0x28, 0x89, 0x07, 0x89, 0x7A, 0x28, 0x8B, 0x5D, 0xF4, 0x8B,
-                             0x75, 0xF8, 0x8B, 0x7D, 0xFC, 0x89, 0xEC, 0x5D, 0xC3 };
-    return memcmp(hostAddr + sizeof(pat1) + 6, pat2, sizeof(pat2)) == 0;
-}
-
-
-bool Win32BinaryLoader::isMinGWsFrameEnd(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = {
-        0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC, 0x14, 0x8B, 0x45, 0x08, 0x8B, 0x18
-    };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xC0, 0x74, 0x1B, 0x8B, 0x48, 0x2C, 0x85, 0xC9,
-                             0x78, 0x34, 0x8B, 0x50, 0x2C, 0x85, 0xD2, 0x75, 0x4D,
-                             0x89, 0x58, 0x28, 0x8B, 0x5D, 0xFC, 0xC9, 0xC3 };
-    return memcmp(host + sizeof(pat1) + 5, pat2, sizeof(pat2)) == 0;
-}
-
-
-bool Win32BinaryLoader::isMinGWsCleanupSetup(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC, 0x04 };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xDB, 0x75, 0x35 };
-
-    if (memcmp(host + sizeof(pat1) + 6, pat2, sizeof(pat2)) != 0) {
-        return false;
-    }
-
-    unsigned char pat3[] = { 0x83, 0xF8, 0xFF, 0x74, 0x24, 0x85, 0xC0, 0x89,
-                             0xC3, 0x74, 0x0E, 0x8D, 0x74, 0x26, 0x00 };
-    return memcmp(host + sizeof(pat1) + 6 + sizeof(pat2) + 16, pat3, sizeof(pat3)) == 0;
-}
-
-
-bool Win32BinaryLoader::isMinGWsMalloc(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x8D, 0x45, 0xF4, 0x83, 0xEC, 0x58,
-                             0x89, 0x45, 0xE0, 0x8D, 0x45, 0xC0, 0x89, 0x04, 0x24,
-                             0x89, 0x5D, 0xF4, 0x89, 0x75, 0xF8, 0x89, 0x7D, 0xFC };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x89, 0x65, 0xE8 };
-    return memcmp((host + sizeof(pat1) + 0x15), pat2, sizeof(pat2)) == 0;
-}
-
-
 Address Win32BinaryLoader::getJumpTarget(Address addr) const
 {
     Byte opcode = 0;
@@ -196,14 +196,6 @@ protected:
     SWord win32Read2(const void *src) const; ///< Read 2 bytes from native addr
     DWord win32Read4(const void *src) const; ///< Read 4 bytes from native addr
 
-public:
-    bool isStaticLinkedLibProc(Address addr) const;
-    bool isMinGWsAllocStack(Address addr) const;
-    bool isMinGWsFrameInit(Address addr) const;
-    bool isMinGWsFrameEnd(Address addr) const;
-    bool isMinGWsCleanupSetup(Address addr) const;
-    bool isMinGWsMalloc(Address addr) const;
-
 protected:
     void processIAT();
     void readDebugData(QString exename);
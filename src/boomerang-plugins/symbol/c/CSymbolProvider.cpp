@@ -11,6 +11,8 @@
 
 #include "parser/AnsiCParserDriver.h"
 
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
 #include "boomerang/core/plugin/Plugin.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbol.h"
@@ -18,11 +20,13 @@
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/Proc.h"
 #include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QDir>
 #include <QFileInfo>
-#include <QTextStream>
+
+#include <algorithm>
 
 
 CSymbolProvider::CSymbolProvider(Project *project)
@@ -33,51 +37,80 @@ CSymbolProvider::CSymbolProvider(Project *project)
 
 bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePath)
 {
-    // TODO: this is a work for generic semantics provider plugin : HeaderReader
-    QFile file(filePath);
-
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
-        LOG_ERROR("Cannot open library signature catalog `%1'", filePath);
-        return false;
-    }
+    const auto key = std::make_pair(QFileInfo(filePath).absoluteFilePath(), prog->getMachine());
+    auto it        = m_catalogs.find(key);
 
-    QTextStream is(&file);
+    if (it == m_catalogs.end()) {
+        std::unique_ptr<LibraryCatalog> catalog = std::make_unique<LibraryCatalog>();
 
-    while (!is.atEnd()) {
-        QString sigFilePath;
-        is >> sigFilePath;
-        sigFilePath = sigFilePath.mid(0, sigFilePath.indexOf('#')); // cut the line to first '#'
+        if (!readSignatureDB(*catalog, prog, filePath)) {
+            // TODO: this is a work for generic semantics provider plugin : HeaderReader
+            std::vector<SignatureDB::CatalogEntry> entries;
+            if (!SignatureDB::readCatalog(filePath, entries)) {
+                return false;
+            }
 
-        if ((sigFilePath.size() > 0) && sigFilePath.endsWith('\n')) {
-            sigFilePath = sigFilePath.mid(0, sigFilePath.size() - 1);
+            for (const SignatureDB::CatalogEntry &entry : entries) {
+                const QString sig_path = QFileInfo(filePath).absoluteDir().absoluteFilePath(
+                    entry.path);
+                if (!readLibrarySignatures(*catalog, qPrintable(sig_path), prog, entry.cc)) {
+                    return false;
+                }
+            }
         }
 
-        if (sigFilePath.isEmpty()) {
-            continue;
+        it = m_catalogs.insert({ key, std::move(catalog) }).first;
+    }
+    else {
+        // The named types might have been cleared since the catalog was read
+        // (e.g. between the binaries of a batch), so register them again.
+        for (const auto &[name, ty] : it->second->namedTypes) {
+            Type::addNamedType(name, ty->clone());
         }
+    }
 
-        CallConv cc = CallConv::C; // Most APIs are C calling convention
+    // A catalog that is read again takes precedence again
+    m_activeCatalogs.erase(
+        std::remove(m_activeCatalogs.begin(), m_activeCatalogs.end(), it->second.get()),
+        m_activeCatalogs.end());
+    m_activeCatalogs.push_back(it->second.get());
+    return true;
+}
 
-        if (sigFilePath == "windows.h") {
-            cc = CallConv::Pascal; // One exception
-        }
 
-        if (sigFilePath == "mfc.h") {
-            cc = CallConv::ThisCall; // Another exception
-        }
+void CSymbolProvider::clearLibrarySignatures()
+{
+    m_activeCatalogs.clear();
+}
 
-        const QString sig_path = QFileInfo(filePath).absoluteDir().absoluteFilePath(sigFilePath);
-        if (!readLibrarySignatures(qPrintable(sig_path), prog, cc)) {
-            return false;
-        }
+
+bool CSymbolProvider::readSignatureDB(LibraryCatalog &catalog, const Prog *prog,
+                                      const QString &filePath)
+{
+    if (!prog->getProject()) {
+        return false;
+    }
+
+    // The databases are generated by the build, so they are kept next to the plugins
+    // instead of next to the catalogs in the data directory.
+    const QDir pluginDir = prog->getProject()->getSettings()->getPluginDirectory();
+    const QDir dbDir(pluginDir.absoluteFilePath("../signatures"));
+    const QString dbPath = SignatureDB::getDatabasePath(dbDir, filePath, prog->getMachine());
+
+    std::unique_ptr<SignatureDB> db = std::make_unique<SignatureDB>();
+    if (!db->open(dbPath, filePath, prog->getMachine())) {
+        return false;
     }
 
+    LOG_VERBOSE("Reading library signatures from '%1'", dbPath);
+    catalog.namedTypes = db->getNamedTypes();
+    catalog.db         = std::move(db);
     return true;
 }
 
 
-bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const Prog *prog,
-                                            CallConv cc)
+bool CSymbolProvider::readLibrarySignatures(LibraryCatalog &catalog, const QString &signatureFile,
+                                            const Prog *prog, CallConv cc)
 {
     AnsiCParserDriver driver;
     if (driver.parse(signatureFile, prog->getMachine(), cc) != 0) {
@@ -86,10 +119,12 @@ bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const
     }
 
     for (std::shared_ptr<Signature> &signature : driver.signatures) {
-        m_librarySignatures[signature->getName()] = signature;
+        catalog.signatures[signature->getName()] = signature;
         signature->setSigFilePath(signatureFile);
     }
 
+    catalog.namedTypes.insert(catalog.namedTypes.end(), driver.typedefs.begin(),
+                              driver.typedefs.end());
     return true;
 }
 
@@ -137,8 +172,24 @@ bool CSymbolProvider::addSymbolsFromSymbolFile(Prog *prog, const QString &fname)
 
 std::shared_ptr<Signature> CSymbolProvider::getSignatureByName(const QString &functionName) const
 {
-    auto it = m_librarySignatures.find(functionName);
-    return it != m_librarySignatures.end() ? it.value() : nullptr;
+    for (auto it = m_activeCatalogs.rbegin(); it != m_activeCatalogs.rend(); ++it) {
+        LibraryCatalog *catalog = *it;
+
+        auto sigIt = catalog->signatures.find(functionName);
+        if (sigIt != catalog->signatures.end()) {
+            // Catalogs are shared by all programs; do not hand out the cached signature
+            return sigIt.value()->clone();
+        }
+        else if (catalog->db) {
+            std::shared_ptr<Signature> sig = catalog->db->getSignature(functionName);
+            if (sig) {
+                catalog->signatures[functionName] = sig;
+                return sig->clone();
+            }
+        }
+    }
+
+    return nullptr;
 }
 
 
@@ -10,20 +10,41 @@
 #pragma once
 
 
+#include "SignatureDB.h"
+
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/ifc/ISymbolProvider.h"
 
 #include <QMap>
 
+#include <map>
+#include <memory>
+#include <vector>
+
 
 class Prog;
 
 
 /// Symbol provider for reading signatures and symbols from C-like headers.
 /// (cf. also the files in data/signature/)
+/// Library catalogs are read from precompiled signature databases if they are up to date.
+/// Catalogs stay loaded when the library signatures are cleared, so reading them again
+/// for the next program is free.
 class BOOMERANG_PLUGIN_API CSymbolProvider : public ISymbolProvider
 {
+    /// Signatures of a single library catalog
+    struct LibraryCatalog
+    {
+        std::unique_ptr<SignatureDB> db; ///< Precompiled signatures, if available
+
+        /// Signatures read from the headers, or already read from \ref db
+        QMap<QString, std::shared_ptr<Signature>> signatures;
+
+        /// Named types declared by the headers, in the order they were declared
+        std::vector<SignatureDB::NamedTypeEntry> namedTypes;
+    };
+
 public:
     CSymbolProvider(Project *project);
     virtual ~CSymbolProvider() = default;
@@ -32,6 +53,9 @@ public:
     /// \copydoc ISymbolProvider::readLibraryCatalog
     bool readLibraryCatalog(const Prog *prog, const QString &fileName) override;
 
+    /// \copydoc ISymbolProvider::clearLibrarySignatures
+    void clearLibrarySignatures() override;
+
     /// \copydoc ISymbolProvider::addSymbolsFromSymbolFile
     bool addSymbolsFromSymbolFile(Prog *prog, const QString &fileName) override;
 
@@ -39,8 +63,17 @@ public:
     std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const override;
 
 private:
-    bool readLibrarySignatures(const QString &signatureFile, const Prog *prog, CallConv cc);
+    bool readLibrarySignatures(LibraryCatalog &catalog, const QString &signatureFile,
+                               const Prog *prog, CallConv cc);
+
+    /// Try to read the library catalog \p filePath from its precompiled signature database.
+    bool readSignatureDB(LibraryCatalog &catalog, const Prog *prog, const QString &filePath);
 
 private:
-    QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+    /// All catalogs read so far, by absolute path and machine
+    std::map<std::pair<QString, Machine>, std::unique_ptr<LibraryCatalog>> m_catalogs;
+
+    /// Catalogs read since the library signatures were last cleared, in the order they were read.
+    /// Signatures of catalogs read later replace signatures of catalogs read earlier.
+    std::vector<LibraryCatalog *> m_activeCatalogs;
 };
@@ -0,0 +1,662 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDB.h"
+
+#include "parser/AnsiCParserDriver.h"
+
+#include "boomerang/db/signature/CustomSignature.h"
+#include "boomerang/db/signature/Parameter.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtEndian>
+
+#include <algorithm>
+#include <map>
+
+
+static const quint32 SIGDB_MAGIC   = 0x42534442; // "BSDB"
+static const quint32 SIGDB_VERSION = 1;          ///< Increment on every change of the format
+
+/// Size of an entry of the name index (name hash, record offset)
+static const qint64 INDEX_ENTRY_SIZE = 8;
+
+static const QDataStream::Version DATASTREAM_VERSION = QDataStream::Qt_5_0;
+
+
+/// FNV-1a hash of a function name. Unlike qHash, this is stable across Qt versions.
+static quint32 hashName(const QString &name)
+{
+    quint32 hash = 2166136261u;
+
+    for (const QChar c : name) {
+        hash ^= c.unicode();
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+
+static QString getMachineName(Machine machine)
+{
+    switch (machine) {
+    case Machine::X86: return "x86";
+    case Machine::PPC: return "ppc";
+    case Machine::ST20: return "st20";
+    default: return "unknown";
+    }
+}
+
+
+static bool writeSignature(QDataStream &os, const Signature &sig, Machine machine);
+static std::shared_ptr<Signature> readSignature(QDataStream &is, Machine machine);
+
+
+static bool writeType(QDataStream &os, const SharedType &ty, Machine machine)
+{
+    os << static_cast<quint8>(ty->getId());
+
+    switch (ty->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char: return true;
+
+    case TypeClass::Integer:
+        os << static_cast<quint64>(ty->getSize())
+           << static_cast<qint8>(ty->as<IntegerType>()->getSign());
+        return true;
+
+    case TypeClass::Float:
+    case TypeClass::Size: os << static_cast<quint64>(ty->getSize()); return true;
+
+    case TypeClass::Pointer: return writeType(os, ty->as<PointerType>()->getPointsTo(), machine);
+
+    case TypeClass::Array:
+        os << static_cast<quint64>(ty->as<ArrayType>()->getLength());
+        return writeType(os, ty->as<ArrayType>()->getBaseType(), machine);
+
+    case TypeClass::Named:
+        // Do not use as<NamedType>() since it resolves the named type
+        os << std::static_pointer_cast<NamedType>(ty)->getName();
+        return true;
+
+    case TypeClass::Compound: {
+        std::shared_ptr<CompoundType> compound = ty->as<CompoundType>();
+        os << static_cast<quint32>(compound->getNumMembers());
+
+        for (int i = 0; i < compound->getNumMembers(); i++) {
+            os << compound->getMemberNameByIdx(i);
+            if (!writeType(os, compound->getMemberTypeByIdx(i), machine)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    case TypeClass::Func: {
+        const Signature *sig = ty->as<FuncType>()->getSignature();
+        os << static_cast<quint8>(sig != nullptr);
+        return !sig || writeSignature(os, *sig, machine);
+    }
+
+    case TypeClass::Union: break;
+    }
+
+    LOG_ERROR("Cannot store type '%1' in signature database", ty->getCtype());
+    return false;
+}
+
+
+static SharedType readType(QDataStream &is, Machine machine)
+{
+    quint8 id;
+    is >> id;
+
+    switch (static_cast<TypeClass>(id)) {
+    case TypeClass::Void: return VoidType::get();
+    case TypeClass::Boolean: return BooleanType::get();
+    case TypeClass::Char: return CharType::get();
+
+    case TypeClass::Integer: {
+        quint64 size;
+        qint8 sign;
+        is >> size >> sign;
+        return IntegerType::get(size, static_cast<Sign>(sign));
+    }
+
+    case TypeClass::Float: {
+        quint64 size;
+        is >> size;
+        return FloatType::get(size);
+    }
+
+    case TypeClass::Size: {
+        quint64 size;
+        is >> size;
+        return SizeType::get(size);
+    }
+
+    case TypeClass::Pointer: {
+        SharedType pointsTo = readType(is, machine);
+        return pointsTo ? PointerType::get(pointsTo) : nullptr;
+    }
+
+    case TypeClass::Array: {
+        quint64 length;
+        is >> length;
+        SharedType baseType = readType(is, machine);
+        return baseType ? ArrayType::get(baseType, length) : nullptr;
+    }
+
+    case TypeClass::Named: {
+        QString name;
+        is >> name;
+        return NamedType::get(name);
+    }
+
+    case TypeClass::Compound: {
+        quint32 numMembers;
+        is >> numMembers;
+
+        std::shared_ptr<CompoundType> compound = CompoundType::get();
+        for (quint32 i = 0; i < numMembers && is.status() == QDataStream::Ok; i++) {
+            QString name;
+            is >> name;
+
+            SharedType memberType = readType(is, machine);
+            if (!memberType) {
+                return nullptr;
+            }
+
+            compound->addMember(memberType, name);
+        }
+
+        return compound;
+    }
+
+    case TypeClass::Func: {
+        quint8 hasSignature;
+        is >> hasSignature;
+        if (!hasSignature) {
+            return FuncType::get();
+        }
+
+        std::shared_ptr<Signature> sig = readSignature(is, machine);
+        return sig ? FuncType::get(sig) : nullptr;
+    }
+
+    case TypeClass::Union: break;
+    }
+
+    return nullptr; // corrupt database
+}
+
+
+static bool writeSignature(QDataStream &os, const Signature &sig, Machine machine)
+{
+    if (dynamic_cast<const CustomSignature *>(&sig) != nullptr) {
+        LOG_ERROR("Cannot store custom signature '%1' in signature database", sig.getName());
+        return false;
+    }
+
+    // Parameters and returns added by the signature itself (e.g. 'this' for thiscall functions)
+    // are recreated when the signature is read again.
+    const CallConv cc                      = sig.getConvention();
+    const std::unique_ptr<Signature> empty = Signature::instantiate(machine, cc, sig.getName());
+    const int firstParam                   = empty->getNumParams();
+    const int firstReturn                  = empty->getNumReturns();
+
+    os << sig.getName() << static_cast<qint32>(cc);
+
+    const bool hasReturn = sig.getNumReturns() > firstReturn;
+    const SharedType returnType = hasReturn ? sig.getReturnType(firstReturn)->clone()
+                                           : VoidType::get();
+    if (!writeType(os, returnType, machine)) {
+        return false;
+    }
+
+    os << static_cast<quint32>(std::max(0, sig.getNumParams() - firstParam));
+    for (int i = firstParam; i < sig.getNumParams(); i++) {
+        os << sig.getParamName(i) << sig.getParamBoundMax(i);
+        if (!writeType(os, sig.getParamType(i), machine)) {
+            return false;
+        }
+    }
+
+    os << sig.hasEllipsis() << sig.getPreferredName();
+    return os.status() == QDataStream::Ok;
+}
+
+
+static std::shared_ptr<Signature> readSignature(QDataStream &is, Machine machine)
+{
+    QString name;
+    qint32 cc;
+    is >> name >> cc;
+
+    std::shared_ptr<Signature> sig = Signature::instantiate(machine, static_cast<CallConv>(cc),
+                                                            name);
+
+    SharedType returnType = readType(is, machine);
+    if (!returnType) {
+        return nullptr;
+    }
+
+    sig->addReturn(returnType);
+
+    quint32 numParams;
+    is >> numParams;
+
+    for (quint32 i = 0; i < numParams && is.status() == QDataStream::Ok; i++) {
+        QString paramName, boundMax;
+        is >> paramName >> boundMax;
+
+        SharedType paramType = readType(is, machine);
+        if (!paramType) {
+            return nullptr;
+        }
+
+        sig->addParameter(std::make_shared<Parameter>(paramType, paramName, nullptr, boundMax));
+    }
+
+    bool ellipsis;
+    QString preferredName;
+    is >> ellipsis >> preferredName;
+
+    sig->setHasEllipsis(ellipsis);
+    sig->setPreferredName(preferredName);
+
+    return is.status() == QDataStream::Ok ? sig : nullptr;
+}
+
+
+SignatureDB::SignatureDB()
+{
+}
+
+
+SignatureDB::~SignatureDB()
+{
+    close();
+}
+
+
+bool SignatureDB::readCatalog(const QString &catalogPath, std::vector<CatalogEntry> &entries)
+{
+    QFile file(catalogPath);
+
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        LOG_ERROR("Cannot open library signature catalog `%1'", catalogPath);
+        return false;
+    }
+
+    QTextStream is(&file);
+
+    while (!is.atEnd()) {
+        QString sigFilePath;
+        is >> sigFilePath;
+        sigFilePath = sigFilePath.mid(0, sigFilePath.indexOf('#')); // cut the line to first '#'
+
+        if ((sigFilePath.size() > 0) && sigFilePath.endsWith('\n')) {
+            sigFilePath = sigFilePath.mid(0, sigFilePath.size() - 1);
+        }
+
+        if (sigFilePath.isEmpty()) {
+            continue;
+        }
+
+        CallConv cc = CallConv::C; // Most APIs are C calling convention
+
+        if (sigFilePath == "windows.h") {
+            cc = CallConv::Pascal; // One exception
+        }
+
+        if (sigFilePath == "mfc.h") {
+            cc = CallConv::ThisCall; // Another exception
+        }
+
+        entries.push_back({ sigFilePath, cc });
+    }
+
+    return true;
+}
+
+
+QString SignatureDB::getDatabasePath(const QDir &dbDir, const QString &catalogPath,
+                                     Machine machine)
+{
+    const QFileInfo catalog(catalogPath);
+    return dbDir.absoluteFilePath(
+        QString("%1.%2.sigdb").arg(catalog.completeBaseName(), getMachineName(machine)));
+}
+
+
+bool SignatureDB::compile(const QString &catalogPath, Machine machine, const QString &dbPath)
+{
+    std::vector<CatalogEntry> entries;
+    if (!readCatalog(catalogPath, entries)) {
+        return false;
+    }
+
+    const QDir catalogDir = QFileInfo(catalogPath).absoluteDir();
+
+    // The database is out of date when the catalog or any of its headers changes
+    QStringList sources = { QFileInfo(catalogPath).fileName() };
+    for (const CatalogEntry &entry : entries) {
+        sources.append(entry.path);
+    }
+
+    // Later declarations of a function replace earlier ones, like in CSymbolProvider
+    std::map<QString, std::pair<std::shared_ptr<Signature>, quint32>> signatures;
+
+    QByteArray typeData;
+    QDataStream typeStream(&typeData, QIODevice::WriteOnly);
+    typeStream.setVersion(DATASTREAM_VERSION);
+    quint32 numTypes = 0;
+
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        const QString headerPath = catalogDir.absoluteFilePath(entries[i].path);
+
+        AnsiCParserDriver driver;
+        if (driver.parse(headerPath, machine, entries[i].cc) != 0) {
+            LOG_ERROR("Cannot read library signature file '%1'", headerPath);
+            return false;
+        }
+
+        for (const auto &[name, ty] : driver.typedefs) {
+            typeStream << name;
+            if (!writeType(typeStream, ty, machine)) {
+                return false;
+            }
+
+            numTypes++;
+        }
+
+        for (const std::shared_ptr<Signature> &sig : driver.signatures) {
+            signatures[sig->getName()] = { sig, static_cast<quint32>(i + 1) };
+        }
+    }
+
+    // Records of all signatures, and the index sorted by name hash
+    QByteArray recordData;
+    QDataStream recordStream(&recordData, QIODevice::WriteOnly);
+    recordStream.setVersion(DATASTREAM_VERSION);
+    std::vector<std::pair<quint32, quint32>> index;
+
+    for (const auto &[name, sigAndSource] : signatures) {
+        index.push_back({ hashName(name), static_cast<quint32>(recordData.size()) });
+
+        recordStream << name << sigAndSource.second;
+        if (!writeSignature(recordStream, *sigAndSource.first, machine)) {
+            return false;
+        }
+    }
+
+    std::sort(index.begin(), index.end());
+
+    QByteArray headerData;
+    QDataStream headerStream(&headerData, QIODevice::WriteOnly);
+    headerStream.setVersion(DATASTREAM_VERSION);
+
+    headerStream << SIGDB_MAGIC << SIGDB_VERSION << static_cast<quint32>(machine);
+    headerStream << static_cast<quint32>(sources.size());
+
+    for (const QString &source : sources) {
+        const QFileInfo info(catalogDir.absoluteFilePath(source));
+        headerStream << source << static_cast<qint64>(info.size())
+                     << static_cast<qint64>(info.lastModified().toMSecsSinceEpoch());
+    }
+
+    headerStream << numTypes;
+    headerStream.writeRawData(typeData.constData(), typeData.size());
+    headerStream << static_cast<quint32>(index.size());
+
+    QSaveFile dbFile(dbPath);
+    if (!dbFile.open(QFile::WriteOnly)) {
+        LOG_ERROR("Cannot create signature database '%1'", dbPath);
+        return false;
+    }
+
+    QDataStream os(&dbFile);
+    os.setVersion(DATASTREAM_VERSION);
+
+    os << static_cast<quint32>(headerData.size());
+    os.writeRawData(headerData.constData(), headerData.size());
+
+    for (const auto &[hash, offset] : index) {
+        os << hash << offset;
+    }
+
+    os.writeRawData(recordData.constData(), recordData.size());
+
+    if (os.status() != QDataStream::Ok || !dbFile.commit()) {
+        LOG_ERROR("Cannot write signature database '%1'", dbPath);
+        return false;
+    }
+
+    LOG_MSG("Wrote %1 signatures and %2 named types to '%3'", index.size(), numTypes, dbPath);
+    return true;
+}
+
+
+bool SignatureDB::open(const QString &dbPath, const QString &catalogPath, Machine machine)
+{
+    close();
+
+    m_file.setFileName(dbPath);
+    if (!m_file.open(QFile::ReadOnly)) {
+        return false; // no precompiled database
+    }
+
+    m_size = m_file.size();
+    m_data = m_size >= 4 ? m_file.map(0, m_size) : nullptr;
+
+    const qint64 headerSize = m_data ? qFromBigEndian<quint32>(m_data) : 0;
+    if (!m_data || 4 + headerSize > m_size) {
+        LOG_WARN("Signature database '%1' is corrupt", dbPath);
+        close();
+        return false;
+    }
+
+    const QByteArray headerData = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(m_data + 4), headerSize);
+    QDataStream is(headerData);
+    is.setVersion(DATASTREAM_VERSION);
+
+    quint32 magic, version, dbMachine, numSources;
+    is >> magic >> version >> dbMachine >> numSources;
+
+    if (magic != SIGDB_MAGIC || version != SIGDB_VERSION ||
+        dbMachine != static_cast<quint32>(machine)) {
+        LOG_VERBOSE("Signature database '%1' was created by a different version", dbPath);
+        close();
+        return false;
+    }
+
+    // The sources are stored relative to the catalog (see compile)
+    const QDir catalogDir = QFileInfo(catalogPath).absoluteDir();
+    for (quint32 i = 0; i < numSources && is.status() == QDataStream::Ok; i++) {
+        QString source;
+        qint64 size, lastModified;
+        is >> source >> size >> lastModified;
+
+        const QFileInfo info(catalogDir.absoluteFilePath(source));
+        if (!info.exists() || info.size() != size ||
+            info.lastModified().toMSecsSinceEpoch() != lastModified) {
+            LOG_VERBOSE("Signature database '%1' is out of date", dbPath);
+            close();
+            return false;
+        }
+
+        m_sourcePaths.append(info.absoluteFilePath());
+    }
+
+    // Read all named types before registering them, so nothing is registered
+    // if the database is corrupt
+    quint32 numTypes;
+    is >> numTypes;
+
+    std::vector<NamedTypeEntry> namedTypes;
+    for (quint32 i = 0; i < numTypes && is.status() == QDataStream::Ok; i++) {
+        QString name;
+        is >> name;
+
+        SharedType ty = readType(is, machine);
+        if (!ty) {
+            break;
+        }
+
+        namedTypes.push_back({ name, ty });
+    }
+
+    is >> m_numSignatures;
+
+    m_index   = m_data + 4 + headerSize;
+    m_records = m_index + m_numSignatures * INDEX_ENTRY_SIZE;
+
+    if (is.status() != QDataStream::Ok || namedTypes.size() != numTypes ||
+        m_records > m_data + m_size) {
+        LOG_WARN("Signature database '%1' is corrupt", dbPath);
+        close();
+        return false;
+    }
+
+    for (const auto &[name, ty] : namedTypes) {
+        Type::addNamedType(name, ty);
+    }
+
+    m_namedTypes = std::move(namedTypes);
+    m_machine    = machine;
+    return true;
+}
+
+
+void SignatureDB::close()
+{
+    if (m_data) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+    }
+
+    m_file.close();
+
+    m_data          = nullptr;
+    m_size          = 0;
+    m_machine       = Machine::INVALID;
+    m_numSignatures = 0;
+    m_index         = nullptr;
+    m_records       = nullptr;
+    m_sourcePaths.clear();
+    m_namedTypes.clear();
+}
+
+
+bool SignatureDB::contains(const QString &name) const
+{
+    return findRecord(name) >= 0;
+}
+
+
+std::shared_ptr<Signature> SignatureDB::getSignature(const QString &name) const
+{
+    const qint64 offset = findRecord(name);
+    if (offset < 0) {
+        return nullptr;
+    }
+
+    const QByteArray recordData = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(m_records + offset), m_data + m_size - m_records - offset);
+    QDataStream is(recordData);
+    is.setVersion(DATASTREAM_VERSION);
+
+    QString recordName;
+    quint32 sourceIdx;
+    is >> recordName >> sourceIdx;
+
+    std::shared_ptr<Signature> sig = readSignature(is, m_machine);
+    if (!sig || sourceIdx >= static_cast<quint32>(m_sourcePaths.size())) {
+        LOG_WARN("Cannot read signature of '%1' from signature database '%2'", name,
+                 m_file.fileName());
+        return nullptr;
+    }
+
+    sig->setSigFilePath(m_sourcePaths[sourceIdx]);
+    return sig;
+}
+
+
+qint64 SignatureDB::findRecord(const QString &name) const
+{
+    if (!m_data) {
+        return -1;
+    }
+
+    const quint32 hash = hashName(name);
+
+    // Find the first index entry with this hash
+    quint32 lo = 0;
+    quint32 hi = m_numSignatures;
+
+    while (lo < hi) {
+        const quint32 mid = lo + (hi - lo) / 2;
+        if (qFromBigEndian<quint32>(m_index + mid * INDEX_ENTRY_SIZE) < hash) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    // Different names might have the same hash
+    for (quint32 i = lo; i < m_numSignatures; i++) {
+        const uchar *entry = m_index + i * INDEX_ENTRY_SIZE;
+        if (qFromBigEndian<quint32>(entry) != hash) {
+            break;
+        }
+
+        const quint32 offset = qFromBigEndian<quint32>(entry + 4);
+        if (m_records + offset >= m_data + m_size) {
+            break; // corrupt database
+        }
+
+        const QByteArray recordData = QByteArray::fromRawData(
+            reinterpret_cast<const char *>(m_records + offset),
+            m_data + m_size - m_records - offset);
+        QDataStream is(recordData);
+        is.setVersion(DATASTREAM_VERSION);
+
+        QString recordName;
+        is >> recordName;
+
+        if (recordName == name) {
+            return offset;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,115 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/frontend/SigEnum.h"
+
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+
+class Signature;
+class Type;
+
+using SharedType = std::shared_ptr<Type>;
+
+
+/**
+ * A precompiled database of all signatures and named types declared by the headers
+ * of a library catalog (e.g. data/signatures/win32.hs) for a single machine.
+ * Databases are created offline by boomerang-sigdb, so the headers do not have to be
+ * parsed every time a binary is loaded.
+ *
+ * The database file is memory mapped. It consists of a header, an index of all signature
+ * names sorted by their hash, and a record for each signature. Named types are registered
+ * when the database is opened; signatures are only read when they are requested.
+ * Signatures are stored as the sequence of calls that created them while parsing
+ * (return type, parameter names and types), so the machine specific parts
+ * (e.g. parameter locations) are recreated exactly as if the header was parsed.
+ */
+class SignatureDB
+{
+public:
+    /// An entry of a library catalog
+    struct CatalogEntry
+    {
+        QString path; ///< Path of the header, relative to the catalog
+        CallConv cc;  ///< Calling convention of the functions declared in the header
+    };
+
+    typedef std::pair<QString, SharedType> NamedTypeEntry;
+
+public:
+    SignatureDB();
+    SignatureDB(const SignatureDB &other) = delete;
+    SignatureDB(SignatureDB &&other)      = delete;
+
+    ~SignatureDB();
+
+    SignatureDB &operator=(const SignatureDB &other) = delete;
+    SignatureDB &operator=(SignatureDB &&other) = delete;
+
+public:
+    /// Read the list of headers in the library catalog \p catalogPath.
+    static bool readCatalog(const QString &catalogPath, std::vector<CatalogEntry> &entries);
+
+    /// \returns the path of the database of the library catalog \p catalogPath for \p machine
+    /// in the directory \p dbDir, e.g. <dbDir>/win32.x86.sigdb for signatures/win32.hs
+    static QString getDatabasePath(const QDir &dbDir, const QString &catalogPath,
+                                   Machine machine);
+
+    /// Parse all headers of the library catalog \p catalogPath and write the signatures
+    /// and named types declared in them to the database \p dbPath.
+    static bool compile(const QString &catalogPath, Machine machine, const QString &dbPath);
+
+public:
+    /// Open the database \p dbPath of the library catalog \p catalogPath
+    /// and register all named types declared in it.
+    /// The database might be stored in a different directory than the catalog.
+    /// Fails if the database does not exist, if it was created for a different machine
+    /// or by a different version of Boomerang, or if the catalog or any of its headers
+    /// has changed since.
+    bool open(const QString &dbPath, const QString &catalogPath, Machine machine);
+
+    /// \returns true if the database contains the signature of function \p name.
+    bool contains(const QString &name) const;
+
+    /// Read the signature of function \p name.
+    /// \returns nullptr if the database does not contain a signature for \p name.
+    std::shared_ptr<Signature> getSignature(const QString &name) const;
+
+    /// \returns all named types declared in the database, in the order they were declared.
+    const std::vector<NamedTypeEntry> &getNamedTypes() const { return m_namedTypes; }
+
+private:
+    /// \returns the offset of the record of function \p name, or -1 if there is none.
+    qint64 findRecord(const QString &name) const;
+
+    void close();
+
+private:
+    QFile m_file;
+    const uchar *m_data = nullptr; ///< Contents of the mapped database
+    qint64 m_size       = 0;
+    Machine m_machine   = Machine::INVALID;
+
+    QStringList m_sourcePaths; ///< Absolute paths of the headers the signatures were read from
+    std::vector<NamedTypeEntry> m_namedTypes;
+
+    quint32 m_numSignatures = 0;
+    const uchar *m_index    = nullptr; ///< (name hash, record offset) pairs, sorted by hash
+    const uchar *m_records  = nullptr;
+};
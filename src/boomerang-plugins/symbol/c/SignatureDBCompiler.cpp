@@ -0,0 +1,49 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDB.h"
+
+#include "boomerang/util/log/ConsoleLogSink.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+
+#include <iostream>
+
+
+/// Compiles a library catalog (e.g. data/signatures/win32.hs) to a signature database.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    Log::getOrCreateLog().addLogSink(std::make_unique<ConsoleLogSink>());
+
+    const QStringList args = app.arguments();
+    if (args.size() != 4) {
+        std::cout << "Usage: boomerang-sigdb <x86|ppc|st20> <catalog> <database>" << std::endl;
+        return 1;
+    }
+
+    Machine machine = Machine::INVALID;
+    if (args[1] == "x86") {
+        machine = Machine::X86;
+    }
+    else if (args[1] == "ppc") {
+        machine = Machine::PPC;
+    }
+    else if (args[1] == "st20") {
+        machine = Machine::ST20;
+    }
+    else {
+        std::cerr << "Unknown machine '" << qPrintable(args[1]) << "'" << std::endl;
+        return 1;
+    }
+
+    return SignatureDB::compile(args[2], machine, args[3]) ? 0 : 1;
+}
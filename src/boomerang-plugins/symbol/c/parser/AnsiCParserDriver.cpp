@@ -40,3 +40,10 @@ int AnsiCParserDriver::parse(const QString &fileName, Machine machine, CallConv
     scanEnd();
     return res;
 }
+
+
+void AnsiCParserDriver::addTypedef(const QString &name, SharedType ty)
+{
+    Type::addNamedType(name, ty);
+    typedefs.push_back({ name, ty });
+}
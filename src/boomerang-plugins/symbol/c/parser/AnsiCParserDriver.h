@@ -32,6 +32,9 @@ public:
     /// Parse the file with name. return 0 on success.
     int parse(const QString &fileName, Machine machine, CallConv cc);
 
+    /// Add a named type to the global type list and to \ref typedefs.
+    void addTypedef(const QString &name, SharedType ty);
+
 public:
     // The token's location used by the scanner.
     AnsiC::location location;
@@ -43,6 +46,9 @@ public:
     std::list<std::shared_ptr<Symbol>> symbols;
     std::list<std::shared_ptr<SymbolRef>> refs;
 
+    /// All named types declared in the file, in declaration order.
+    std::list<std::pair<QString, SharedType>> typedefs;
+
 private:
     // Handling the scanner.
     bool scanBegin();
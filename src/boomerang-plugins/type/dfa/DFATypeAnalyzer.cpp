@@ -244,12 +244,12 @@ void DFATypeAnalyzer::visit(const std::shared_ptr<ImplicitAssign> &stmt, bool &v
 
 void DFATypeAnalyzer::visit(const std::shared_ptr<ReturnStatement> &stmt, bool &visitChildren)
 {
-    for (SharedStmt mm : stmt->getModifieds()) {
+    for (const SharedStmt &mm : stmt->getModifieds()) {
         assert(mm->isAssignment());
         visitAssignment(mm->as<Assignment>(), visitChildren);
     }
 
-    for (SharedStmt rr : stmt->getReturns()) {
+    for (const SharedStmt &rr : stmt->getReturns()) {
         assert(rr->isAssignment());
         visitAssignment(rr->as<Assignment>(), visitChildren);
     }
@@ -68,7 +68,7 @@ void DFATypeRecovery::printResults(StatementList &stmts, int iter)
 {
     LOG_VERBOSE("%1 iterations", iter);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         LOG_VERBOSE("%1", s); // Print the statement; has dest type
 
         // Now print type for each constant in this Statement
@@ -92,7 +92,7 @@ void DFATypeRecovery::printResults(StatementList &stmts, int iter)
 
             LOG_VERBOSE("  returns:");
 
-            for (SharedStmt ret : *rs) {
+            for (const SharedStmt &ret : *rs) {
                 // Intersect the callee's returns with the live locations at the call,
                 // i.e. make sure that they exist in *uc
                 std::shared_ptr<Assignment> assgn = std::dynamic_pointer_cast<Assignment>(ret);
@@ -134,7 +134,7 @@ void DFATypeRecovery::replaceArrayIndices(const SharedStmt &s)
     // We have m[idx*stride + base]
     // Rewrite it as globalN[idx] with addr(globalN) == base
     // with a global array globalN with base type size \e stride
-    for (SharedExp arrayExp : result) {
+    for (const SharedExp &arrayExp : result) {
         const Address base = arrayExp->access<Const, 1, 2>()->getAddr();
         // const int stride   = arrayExp->access<Const, 1, 1, 2>()->getInt();
         SharedExp idx = arrayExp->access<Exp, 1, 1, 1>();
@@ -256,7 +256,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
     for (iter = 1; iter <= DFA_ITER_LIMIT; ++iter) {
         ch = false;
 
-        for (SharedStmt stmt : stmts) {
+        for (const SharedStmt &stmt : stmts) {
             SharedStmt before = nullptr;
 
             if (proc->getProg()->getProject()->getSettings()->debugTA) {
@@ -300,7 +300,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
     Prog *_prog = proc->getProg();
     DataIntervalMap localsMap(proc); // map of all local variables of proc
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         // 1) constants
         std::list<std::shared_ptr<Const>> constList;
         findConstantsInStmt(s, constList);
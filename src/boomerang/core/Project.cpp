@@ -14,6 +14,7 @@
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/ProcDecompiler.h"
 #include "boomerang/decomp/ProgDecompiler.h"
 #include "boomerang/util/CallGraphDotWriter.h"
 #include "boomerang/util/ProgSymbolWriter.h"
@@ -134,6 +135,8 @@ bool Project::loadBinaryFile(const QString &filePath)
     }
 
     m_loadedBinary->getImage()->updateTextLimits();
+    m_loadedBinary->getImage()->updatePageTable();
+    m_loadedBinary->getImage()->updateStringIndex(m_loadedBinary->getFormat() == LoadFmt::PE);
 
     return createProg(m_loadedBinary.get(), QFileInfo(filePath).baseName()) != nullptr;
 }
@@ -225,6 +228,27 @@ bool Project::decompileBinaryFile()
 }
 
 
+bool Project::decompileProc(UserProc *proc)
+{
+    if (!m_prog) {
+        LOG_ERROR("Cannot decompile procedure: No binary file is loaded.");
+        return false;
+    }
+    else if (!m_fe) {
+        LOG_ERROR("Cannot decompile procedure: No suitable frontend found.");
+        return false;
+    }
+    else if (proc->isDecompiled()) {
+        return true;
+    }
+
+    LOG_MSG("Decompiling procedure '%1'...", proc->getName());
+    ProcDecompiler(true).decompileRecursive(proc);
+
+    return true;
+}
+
+
 bool Project::generateCode(Module *module)
 {
     if (!m_prog) {
@@ -305,6 +329,7 @@ void Project::loadSymbols()
     }
 
     m_prog->readDefaultLibraryCatalogues();
+    m_prog->readLibraryPatterns();
 
     for (auto &sf : getSettings()->m_symbolFiles) {
         LOG_MSG("Reading symbol file '%1'", sf);
@@ -390,6 +415,7 @@ void Project::loadPlugins()
 
 void Project::addWatcher(IWatcher *watcher)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
     m_watchers.insert(watcher);
 }
 
@@ -398,6 +424,8 @@ void Project::alertDecompileDebugPoint(UserProc *p, const QString &description)
 {
     p->debugPrintAll(description);
 
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *elem : m_watchers) {
         elem->onDecompileDebugPoint(p, qPrintable(description));
     }
@@ -406,6 +434,8 @@ void Project::alertDecompileDebugPoint(UserProc *p, const QString &description)
 
 void Project::alertFunctionCreated(Function *function)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onFunctionCreated(function);
     }
@@ -414,6 +444,8 @@ void Project::alertFunctionCreated(Function *function)
 
 void Project::alertFunctionRemoved(Function *function)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onFunctionRemoved(function);
     }
@@ -422,6 +454,8 @@ void Project::alertFunctionRemoved(Function *function)
 
 void Project::alertSignatureUpdated(Function *function)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onSignatureUpdated(function);
     }
@@ -430,6 +464,8 @@ void Project::alertSignatureUpdated(Function *function)
 
 void Project::alertInstructionDecoded(Address pc, int numBytes)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onInstructionDecoded(pc, numBytes);
     }
@@ -438,6 +474,8 @@ void Project::alertInstructionDecoded(Address pc, int numBytes)
 
 void Project::alertBadDecode(Address pc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onBadDecode(pc);
     }
@@ -446,6 +484,8 @@ void Project::alertBadDecode(Address pc)
 
 void Project::alertFunctionDecoded(Function *p, Address pc, Address last, int numBytes)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onFunctionDecoded(p, pc, last, numBytes);
     }
@@ -454,6 +494,8 @@ void Project::alertFunctionDecoded(Function *p, Address pc, Address last, int nu
 
 void Project::alertStartDecode(Address start, int numBytes)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onStartDecode(start, numBytes);
     }
@@ -462,6 +504,8 @@ void Project::alertStartDecode(Address start, int numBytes)
 
 void Project::alertEndDecode()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onEndDecode();
     }
@@ -470,6 +514,8 @@ void Project::alertEndDecode()
 
 void Project::alertStartDecompile(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onStartDecompile(proc);
     }
@@ -478,6 +524,8 @@ void Project::alertStartDecompile(UserProc *proc)
 
 void Project::alertProcStatusChanged(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onProcStatusChange(proc);
     }
@@ -486,6 +534,8 @@ void Project::alertProcStatusChanged(UserProc *proc)
 
 void Project::alertEndDecompile(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onEndDecompile(proc);
     }
@@ -494,6 +544,8 @@ void Project::alertEndDecompile(UserProc *proc)
 
 void Project::alertDiscovered(Function *function)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onFunctionDiscovered(function);
     }
@@ -502,6 +554,8 @@ void Project::alertDiscovered(Function *function)
 
 void Project::alertDecompiling(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onDecompileInProgress(proc);
     }
@@ -510,6 +564,8 @@ void Project::alertDecompiling(UserProc *proc)
 
 void Project::alertDecompilationEnd()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watchersMutex);
+
     for (IWatcher *w : m_watchers) {
         w->onDecompilationEnd();
     }
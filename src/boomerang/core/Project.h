@@ -16,6 +16,7 @@
 #include "boomerang/util/Address.h"
 
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -117,6 +118,13 @@ public:
      */
     bool decompileBinaryFile();
 
+    /**
+     * Decompile only \p proc. Its callees are only summarized (see ProcDecompiler),
+     * and no global analyses are performed. Summaries are reused by subsequent requests.
+     * \returns true on success, false if no binary is decoded or an error occurred.
+     */
+    bool decompileProc(UserProc *proc);
+
     /**
      * Generate code for \p module, or all modules if \p module is nullptr.
      * \returns true on success, false if no binary is decompiled or an error occurred.
@@ -126,6 +134,8 @@ public:
 public:
     /// Register a watcher to receive events about the decompilation.
     /// Does NOT take ownership of the pointer.
+    /// Events can be sent by several threads (see Settings::numThreads),
+    /// but they are delivered to the watchers one at a time.
     void addWatcher(IWatcher *watcher);
 
     /// Called once after a function was created.
@@ -210,6 +220,10 @@ private:
     /// The watchers which are interested in this decompilation.
     std::set<IWatcher *> m_watchers;
 
+    /// Serializes the events sent to the watchers. Recursive, since watchers may cause
+    /// further events while handling one.
+    std::recursive_mutex m_watchersMutex;
+
     std::unique_ptr<PluginManager> m_pluginManager;
 
     std::unique_ptr<BinaryFile> m_loadedBinary;
@@ -74,6 +74,7 @@ public:
     bool removeReturns     = true;
     bool decodeThruIndCall = false;
     bool decodeChildren    = true;
+    bool sweepForFunctions = false; ///< Seed procedures by a linear sweep of code sections
     bool useProof          = true;
     bool changeSignatures  = true;
     bool useTypeAnalysis   = true;
@@ -81,10 +82,28 @@ public:
     bool generateCallGraph = false;
     bool generateSymbols   = false;
     bool useGlobals        = true;
+    bool useDebugInfo      = false; ///< Use signatures and types of debug information
     bool assumeABI         = false; ///< Assume ABI compliance
-
-    QString replayFile;  ///< file with commands to execute in interactive mode
-    QString sslFileName; ///< Use this SSL file instead of one of the hard-coded ones.
+    int memReportTopN      = 0;     ///< Print IR memory of the N largest procs after each phase
+
+    /// Number of threads analysing independent procedures in parallel (global type analysis);
+    /// 0 for one thread per hardware thread
+    int numThreads = 1;
+
+    /// Meet the types at call sites after local type analysis,
+    /// and analyse procedures whose types changed again
+    bool meetCallSiteTypes = false;
+
+    /// Maximum time (in milliseconds) spent in the passes of a single procedure
+    /// before it is decompiled with a degraded pipeline; 0 for no limit
+    qint64 procTimeLimit = 0;
+    /// Maximum work (statements processed by passes) spent on a single procedure
+    /// before it is decompiled with a degraded pipeline; 0 for no limit
+    qint64 procWorkLimit = 0;
+
+    QString replayFile;       ///< file with commands to execute in interactive mode
+    QString sslFileName;      ///< Use this SSL file instead of one of the hard-coded ones.
+    bool useSSLCache = false; ///< Cache expanded SSL files in the user's cache directory
 
     /// Contains all known entrypoints for the Prog.
     std::vector<Address> m_entryPoints;
@@ -40,204 +40,20 @@ DataFlow::~DataFlow()
 }
 
 
-void DataFlow::dfs(FragIndex myIdx, FragIndex parentIdx)
-{
-    assert(myIdx != INDEX_INVALID);
-    if (m_dfnum[myIdx] >= 0) {
-        // already visited
-        return;
-    }
-
-    m_dfnum[myIdx]  = N;
-    m_vertex[N]     = myIdx;
-    m_parent[myIdx] = parentIdx;
-
-    N++;
-
-    // Recurse to successors
-    IRFragment *frag = m_frags[myIdx];
-
-    for (IRFragment *succ : frag->getSuccessors()) {
-        dfs(m_indices[succ], myIdx);
-    }
-}
-
-
 bool DataFlow::calculateDominators()
 {
-    ProcCFG *cfg               = m_proc->getCFG();
-    IRFragment *entryFrag      = cfg->getEntryFragment();
-    const std::size_t numFrags = cfg->getNumFragments();
-
-    if (!entryFrag || numFrags == 0) {
-        return false; // nothing to do
-    }
-
-    allocateData();
-    recalcSpanningTree();
-
-    assert(N >= 1);
-
-    // Process fragments in reverse pre-traversal order (i.e. return blocks first)
-    for (std::size_t i = N - 1; i >= 1; i--) {
-        FragIndex n = m_vertex[i];
-        FragIndex p = m_parent[n];
-        FragIndex s = p;
-
-        // These lines calculate the semi-dominator of n, based on the Semidominator Theorem
-        for (IRFragment *pred : m_frags[n]->getPredecessors()) {
-            if (m_indices.find(pred) == m_indices.end()) {
-                LOG_ERROR("Fragment not in indices: ", pred->toString());
-                return false;
-            }
-
-            const FragIndex v = m_indices[pred];
-            FragIndex sdash   = v;
-
-            if (isAncestorOf(v, n)) {
-                sdash = m_semi[getAncestorWithLowestSemi(v)];
-            }
-
-            if (isAncestorOf(s, sdash)) {
-                s = sdash;
-            }
-        }
-
-        m_semi[n] = s;
-
-        // Calculation of n's dominator is deferred until the path from s to n
-        // has been linked into the forest
-        m_bucket[s].insert(n);
-        link(p, n);
-
-        // for each v in bucket[p]
-        for (FragIndex v : m_bucket[p]) {
-            // Now that the path from p to v has been linked into the spanning forest,
-            // these lines calculate the dominator of v, based on the first clause of the
-            // Dominator Theorem, or else defer the calculation until y's dominator is known.
-            const FragIndex y = getAncestorWithLowestSemi(v);
-
-            if (m_semi[y] == m_semi[v]) {
-                m_idom[v] = p; // Success!
-            }
-            else {
-                m_samedom[v] = y; // Defer
-            }
-        }
-
-        m_bucket[p].clear();
-    }
-
-    for (std::size_t i = 1; i < N - 1; i++) {
-        // Now all the deferred dominator calculations, based on the second clause of the Dominator
-        // Theorem, are performed.
-        FragIndex n = m_vertex[i];
+    ProcCFG *cfg = m_proc->getCFG();
 
-        if (m_samedom[n] != INDEX_INVALID) {
-            m_idom[n] = m_idom[m_samedom[n]]; // Deferred success!
-        }
+    if (!m_domTree.calculate(cfg)) {
+        return false;
     }
 
-    const FragIndex entryIndex = fragToIdx(entryFrag);
-    assert(entryIndex != INDEX_INVALID);
-
-    // the entry fragment is always executed.
-    m_idom[entryIndex] = entryIndex;
-    m_semi[entryIndex] = entryIndex;
-
-    computeDF(entryIndex); // Finally, compute the dominance frontiers
+    // Phi functions are placed from scratch every time the dominators are requested.
+    resetPhiData();
     return true;
 }
 
 
-FragIndex DataFlow::getAncestorWithLowestSemi(FragIndex v)
-{
-    assert(v != INDEX_INVALID);
-
-    const FragIndex a = m_ancestor[v];
-    if (a != INDEX_INVALID && m_ancestor[a] != INDEX_INVALID) {
-        const FragIndex b = getAncestorWithLowestSemi(a);
-        m_ancestor[v]     = m_ancestor[a];
-
-        if (isAncestorOf(m_semi[m_best[v]], m_semi[b])) {
-            m_best[v] = b;
-        }
-    }
-
-    return m_best[v];
-}
-
-
-void DataFlow::link(FragIndex p, FragIndex n)
-{
-    assert(n != INDEX_INVALID);
-
-    m_ancestor[n] = p;
-    m_best[n]     = n;
-}
-
-
-bool DataFlow::doesDominate(FragIndex n, FragIndex w)
-{
-    assert(n != INDEX_INVALID);
-    assert(w != INDEX_INVALID);
-
-    while (w != INDEX_INVALID && m_idom[w] != w) {
-        if (m_idom[w] == n) {
-            return true;
-        }
-
-        w = m_idom[w]; // Move up the dominator tree
-    }
-
-    return false;
-}
-
-
-void DataFlow::computeDF(FragIndex n)
-{
-    assert(n != INDEX_INVALID);
-
-    std::set<FragIndex> S;
-    // This loop computes DF_local[n]
-    // for each node y in succ(n)
-    IRFragment *frag = m_frags[n];
-
-    for (IRFragment *succ : frag->getSuccessors()) {
-        FragIndex y = m_indices[succ];
-
-        if (m_idom[y] != n) {
-            S.insert(y);
-        }
-    }
-
-    // for each child c of n in the dominator tree
-    // Note: this is a linear search!
-    const size_t sz = m_idom.size(); // ? Was ancestor.size()
-
-    for (FragIndex c = FragIndex(0); c < sz; ++c) {
-        if (m_idom[c] != n) {
-            continue;
-        }
-        else if (c != n) { // do not calculate DF for entry fragment again
-            computeDF(c);
-        }
-
-        /* This loop computes DF_up[c] */
-        // for each element w of DF[c]
-        std::set<FragIndex> &s = m_DF[c];
-
-        for (FragIndex w : s) {
-            if (n == w || !doesDominate(n, w)) {
-                S.insert(w);
-            }
-        }
-    }
-
-    m_DF[n] = S;
-}
-
-
 bool DataFlow::canRename(SharedConstExp exp) const
 {
     if (exp->isSubscript()) {
@@ -275,52 +91,26 @@ bool DataFlow::canRename(SharedConstExp exp) const
 
 bool DataFlow::placePhiFunctions()
 {
-    // First free some memory no longer needed
-    m_dfnum.resize(0);
-    m_semi.resize(0);
-    m_ancestor.resize(0);
-    m_samedom.resize(0);
-    m_vertex.resize(0);
-    m_parent.resize(0);
-    m_best.resize(0);
-    m_bucket.resize(0);
-    m_defsites.clear();
-    m_defallsites.clear();
-
-    for (ExSet &exps : m_definedAt) {
-        for (auto iter = exps.begin(); iter != exps.end();) {
-            if (m_A_phi.find(*iter) == m_A_phi.end()) {
-                iter = exps.erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
-    }
-
-    m_definedAt.clear(); // and A_orig,
-    m_defStmts.clear();  // and the map from variable to defining Stmt
-
     for (IRFragment *frag : *m_proc->getCFG()) {
         frag->clearPhis();
     }
 
     // Set the sizes of needed vectors
-    const std::size_t numIndices = m_indices.size();
-    const std::size_t numFrags   = m_proc->getCFG()->getNumFragments();
-    assert(numIndices == numFrags);
-    Q_UNUSED(numIndices);
+    const std::size_t numFrags = m_proc->getCFG()->getNumFragments();
+    assert(m_domTree.getNumNodes() == numFrags);
 
-    m_definedAt.resize(numFrags);
+    m_defsites.clear();
+    m_defallsites.clear();
+    m_defStmts.clear();
 
     const bool assumeABICompliance = m_proc->getProg()->getProject()->getSettings()->assumeABI;
 
-    // We need to create m_definedAt[n] for all n
+    // We need to create m_defsites[a] for all a
     // Recreate each call because propagation and other changes make old data invalid
     for (FragIndex n{ 0 }; n < numFrags; ++n) {
         IRFragment::RTLIterator rit;
         StatementList::iterator sit;
-        IRFragment *frag = m_frags[n];
+        IRFragment *frag = idxToFrag(n);
 
         for (SharedStmt stmt = frag->getFirstStmt(rit, sit); stmt;
              stmt            = frag->getNextStmt(rit, sit)) {
@@ -329,61 +119,76 @@ bool DataFlow::placePhiFunctions()
 
             // If this is a childless call, then this block defines every variable
             if (stmt->isCall() && stmt->as<CallStatement>()->isChildless()) {
-                m_defallsites.insert(n);
+                if (m_defallsites.empty() || m_defallsites.back() != n) {
+                    m_defallsites.push_back(n);
+                }
             }
 
             for (const SharedExp &exp : locationSet) {
                 if (canRename(exp)) {
-                    m_definedAt[n].insert(exp->clone());
-                    m_defStmts[exp] = stmt;
+                    const LocIndex loc = m_locations.insert(exp);
+                    addSite(m_defsites, loc, n);
+
+                    if (m_defStmts.size() <= loc) {
+                        m_defStmts.resize(loc + 1);
+                    }
+
+                    m_defStmts[loc] = stmt;
                 }
             }
         }
     }
 
-    for (FragIndex n{ 0 }; n < numFrags; ++n) {
-        for (const SharedExp &a : m_definedAt[n]) {
-            m_defsites[a].insert(n);
+    bool change = false;
+    std::vector<FragIndex> W;
+    std::vector<bool> inW(numFrags, false);
+
+    // For each variable a defined anywhere, in the order of the locations
+    for (const auto &[a, loc] : m_locations) {
+        if (loc >= m_defsites.size() || m_defsites[loc].empty()) {
+            continue; // not defined anywhere
         }
-    }
 
-    bool change = false;
+        // Those variables that are defined everywhere (i.e. in defallsites)
+        // need to be defined at every defsite, too
+        const std::vector<bool> &definedAt = m_defsites[loc];
+        W.clear();
 
-    // Those variables that are defined everywhere (i.e. in defallsites)
-    // need to be defined at every defsite, too
-    for (FragIndex defallsite : m_defallsites) {
-        for (auto &[exp, defsites] : m_defsites) {
-            Q_UNUSED(exp);
-            defsites.insert(defallsite);
+        for (FragIndex n{ 0 }; n < numFrags; ++n) {
+            if (definedAt[n]) {
+                W.push_back(n);
+                inW[n] = true;
+            }
         }
-    }
 
-    // For each variable a defined anywhere
-    for (auto &[a, defsites] : m_defsites) {
-        std::set<FragIndex> W = defsites;
+        for (FragIndex n : m_defallsites) {
+            if (!inW[n]) {
+                W.push_back(n);
+                inW[n] = true;
+            }
+        }
 
         while (!W.empty()) {
-            // Pop first node from W
-            const FragIndex n = *W.begin();
-            W.erase(W.begin());
+            // Pop a node from W
+            const FragIndex n = W.back();
+            W.pop_back();
+            inW[n] = false;
 
-            for (FragIndex y : m_DF[n]) {
+            for (FragIndex y : getDF(n)) {
                 // phi function already created for y?
-                if (m_A_phi[a].find(y) != m_A_phi[a].end()) {
+                if (!addSite(m_A_phi, loc, y)) {
                     continue;
                 }
 
                 // Insert trivial phi function for a at top of block y: a := phi()
                 change = true;
-                m_frags[y]->addPhi(a->clone());
-
-                // A_phi[a] <- A_phi[a] U {y}
-                m_A_phi[a].insert(y);
+                idxToFrag(y)->addPhi(a->clone());
 
                 // if a !elementof A_orig[y]
-                if (!m_definedAt[y].contains(a)) {
+                if (!definedAt[y] && !inW[y]) {
                     // W <- W U {y}
-                    W.insert(y);
+                    W.push_back(y);
+                    inW[y] = true;
                 }
             }
         }
@@ -393,97 +198,99 @@ bool DataFlow::placePhiFunctions()
 }
 
 
+std::set<FragIndex> DataFlow::getA_phi(const SharedExp &e) const
+{
+    std::set<FragIndex> result;
+    const LocIndex loc = m_locations.find(e);
+
+    if (loc == LOC_INVALID || loc >= m_A_phi.size()) {
+        return result;
+    }
+
+    for (FragIndex n{ 0 }; n < m_A_phi[loc].size(); ++n) {
+        if (m_A_phi[loc][n]) {
+            result.insert(n);
+        }
+    }
+
+    return result;
+}
+
+
 void DataFlow::convertImplicits()
 {
     ProcCFG *cfg = m_proc->getCFG();
 
-    // Convert statements in A_phi from m[...]{-} to m[...]{0}
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> A_phi_copy = m_A_phi; // Object copy
+    // Convert locations from m[...]{-} to m[...]{0}
     ImplicitConverter ic(cfg);
-    m_A_phi.clear();
+    LocationTable oldLocations                 = std::move(m_locations);
+    std::vector<std::vector<bool>> oldA_phi    = std::move(m_A_phi);
+    std::vector<std::vector<bool>> oldDefsites = std::move(m_defsites);
+    std::vector<SharedStmt> oldDefStmts        = std::move(m_defStmts);
 
-    for (auto &[exp, set] : A_phi_copy) {
-        SharedExp e = exp->clone()->acceptModifier(&ic);
-        m_A_phi[e]  = set; // Copy the set (doesn't have to be deep)
-    }
-
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> defsites_copy = m_defsites; // Object copy
+    m_locations.clear();
+    m_A_phi.clear();
     m_defsites.clear();
+    m_defStmts.clear();
 
-    for (auto &[exp, set] : defsites_copy) {
-        SharedExp e   = exp->clone()->acceptModifier(&ic);
-        m_defsites[e] = set; // Copy the set (doesn't have to be deep)
-    }
-
-    std::vector<ExSet> definedAtCopy = m_definedAt;
-    m_definedAt.clear();
+    for (LocIndex oldLoc = 0; oldLoc < oldLocations.size(); ++oldLoc) {
+        SharedExp e        = oldLocations.getLocation(oldLoc)->clone()->acceptModifier(&ic);
+        const LocIndex loc = m_locations.insert(e);
 
-    for (ExSet &se : definedAtCopy) {
-        ExSet se_new;
+        // Locations that are the same after conversion share their fragments
+        if (oldLoc < oldA_phi.size()) {
+            for (FragIndex n{ 0 }; n < oldA_phi[oldLoc].size(); ++n) {
+                if (oldA_phi[oldLoc][n]) {
+                    addSite(m_A_phi, loc, n);
+                }
+            }
+        }
 
-        for (const SharedExp &ee : se) {
-            SharedExp e = ee->clone()->acceptModifier(&ic);
-            se_new.insert(e);
+        if (oldLoc < oldDefsites.size()) {
+            for (FragIndex n{ 0 }; n < oldDefsites[oldLoc].size(); ++n) {
+                if (oldDefsites[oldLoc][n]) {
+                    addSite(m_defsites, loc, n);
+                }
+            }
         }
 
-        // Copy the set (doesn't have to be a deep copy)
-        m_definedAt.insert(m_definedAt.end(), se_new);
+        if (oldLoc < oldDefStmts.size() && oldDefStmts[oldLoc]) {
+            if (m_defStmts.size() <= loc) {
+                m_defStmts.resize(loc + 1);
+            }
+
+            m_defStmts[loc] = oldDefStmts[oldLoc];
+        }
     }
 }
 
 
-void DataFlow::allocateData()
+void DataFlow::resetPhiData()
 {
-    ProcCFG *cfg               = m_proc->getCFG();
-    const std::size_t numFrags = cfg->getNumFragments();
-
-    m_frags.assign(numFrags, nullptr);
-    m_indices.clear();
-
-    m_dfnum.assign(numFrags, -1);
-    m_semi.assign(numFrags, INDEX_INVALID);
-    m_ancestor.assign(numFrags, INDEX_INVALID);
-    m_idom.assign(numFrags, INDEX_INVALID);
-    m_samedom.assign(numFrags, INDEX_INVALID);
-    m_vertex.assign(numFrags, INDEX_INVALID);
-    m_parent.assign(numFrags, INDEX_INVALID);
-    m_best.assign(numFrags, INDEX_INVALID);
-    m_bucket.assign(numFrags, {});
-    m_DF.assign(numFrags, {});
-    m_definedAt.assign(numFrags, {});
-
+    m_locations.clear();
     m_A_phi.clear();
     m_defsites.clear();
     m_defallsites.clear();
     m_defStmts.clear();
-
-    // Set up the fragment and indices vectors.
-    // Do this here because sometimes a fragment can be unreachable
-    // (so relying on in-edges doesn't work)
-    std::size_t i = 0;
-    for (IRFragment *frag : *cfg) {
-        m_frags[i++] = frag;
-    }
-
-    for (std::size_t j = 0; j < numFrags; j++) {
-        m_indices[m_frags[j]] = j;
-    }
 }
 
 
-void DataFlow::recalcSpanningTree()
+bool DataFlow::addSite(std::vector<std::vector<bool>> &sites, LocIndex loc, FragIndex frag)
 {
-    IRFragment *entryFrag = m_proc->getEntryFragment();
-    assert(entryFrag != nullptr);
-    const FragIndex entryIndex = fragToIdx(entryFrag);
-    assert(entryIndex != INDEX_INVALID);
+    if (sites.size() <= loc) {
+        sites.resize(loc + 1);
+    }
 
-    N = 0;
-    dfs(entryIndex, INDEX_INVALID);
-}
+    std::vector<bool> &fragSet = sites[loc];
+    if (fragSet.empty()) {
+        fragSet.resize(m_domTree.getNumNodes(), false);
+    }
 
+    assert(frag < fragSet.size());
+    if (fragSet[frag]) {
+        return false;
+    }
 
-bool DataFlow::isAncestorOf(FragIndex n, FragIndex parent) const
-{
-    return m_dfnum[parent] < m_dfnum[n];
+    fragSet[frag] = true;
+    return true;
 }
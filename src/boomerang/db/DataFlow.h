@@ -10,19 +10,18 @@
 #pragma once
 
 
+#include "boomerang/db/DominatorTree.h"
+#include "boomerang/db/LocationTable.h"
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/util/LocationSet.h"
 
-#include <map>
-#include <unordered_map>
+#include <set>
+#include <vector>
 
 
 class IRFragment;
 class PhiAssign;
 
-typedef std::size_t FragIndex;
-static constexpr const FragIndex INDEX_INVALID = FragIndex(-1);
-
 
 /**
  * Dominator frontier code largely as per Appel 2002
@@ -30,8 +29,6 @@ static constexpr const FragIndex INDEX_INVALID = FragIndex(-1);
  */
 class BOOMERANG_API DataFlow
 {
-    using ExSet = ExpSet<Exp>;
-
 public:
     DataFlow(UserProc *proc);
     DataFlow(const DataFlow &other) = delete;
@@ -44,9 +41,9 @@ public:
 
 public:
     /**
-     * Calculate dominators for every node n using Lengauer-Tarjan with path compression.
-     * Essentially Algorithm 19.9 of Appel's
-     * "Modern compiler implementation in Java" 2nd ed 2002
+     * Calculate dominators and dominance frontiers for every node n.
+     * The dominators are only recalculated if the CFG has changed since the last call.
+     * \sa DominatorTree
      */
     bool calculateDominators();
 
@@ -79,7 +76,7 @@ public:
     std::set<const IRFragment *> getDominanceFrontier(const IRFragment *frag) const
     {
         std::set<const IRFragment *> ret;
-        for (FragIndex idx : m_DF.at(fragToIdx(frag))) {
+        for (FragIndex idx : getDF(fragToIdx(frag))) {
             ret.insert(idxToFrag(idx));
         }
 
@@ -87,93 +84,66 @@ public:
     }
 
 public:
-    const IRFragment *idxToFrag(FragIndex node) const { return m_frags.at(node); }
-    IRFragment *idxToFrag(FragIndex node) { return m_frags.at(node); }
-
-    FragIndex fragToIdx(const IRFragment *frag) const
-    {
-        return m_indices.at(const_cast<IRFragment *>(frag));
-    }
-
-    std::set<FragIndex> &getDF(FragIndex node) { return m_DF[node]; }
-    FragIndex getIdom(FragIndex node) const { return m_idom[node]; }
-    FragIndex getSemi(FragIndex node) const { return m_semi[node]; }
-    std::set<FragIndex> &getA_phi(SharedExp e) { return m_A_phi[e]; }
+    const IRFragment *idxToFrag(FragIndex node) const { return m_domTree.idxToFrag(node); }
+    IRFragment *idxToFrag(FragIndex node) { return m_domTree.idxToFrag(node); }
 
-private:
-    void recalcSpanningTree();
+    FragIndex fragToIdx(const IRFragment *frag) const { return m_domTree.fragToIdx(frag); }
 
-    /// depth first search
-    /// \param myIdx index of the current fragment
-    /// \param parentIdx index of the parent of the current fragment
-    void dfs(FragIndex myIdx, FragIndex parentIdx);
+    const std::vector<FragIndex> &getDF(FragIndex node) const { return m_domTree.getDF(node); }
+    FragIndex getIdom(FragIndex node) const { return m_domTree.getIdom(node); }
+    FragIndex getSemi(FragIndex node) const { return m_domTree.getSemi(node); }
 
-    /// Basically algorithm 19.10b of Appel 2002 (uses path compression for O(log N) amortised time
-    /// per operation (overall O(N log N))
-    FragIndex getAncestorWithLowestSemi(FragIndex v);
+    /// \returns the fragments that got a phi function for \p e
+    std::set<FragIndex> getA_phi(const SharedExp &e) const;
 
-    void link(FragIndex p, FragIndex n);
+    /// \returns the dense indices of all locations of the procedure that were renamed
+    /// or got a phi function. The indices stay valid until the dominators are recalculated.
+    LocationTable &getLocationTable() { return m_locations; }
+    const LocationTable &getLocationTable() const { return m_locations; }
 
-    void computeDF(FragIndex n);
+    /// \returns all fragments immediately dominated by \p node, sorted by index.
+    const std::vector<FragIndex> &getDominatedChildren(FragIndex node) const
+    {
+        return m_domTree.getChildren(node);
+    }
 
-    /// \return true if \p n dominates \p w.
-    bool doesDominate(FragIndex n, FragIndex w);
+    const DominatorTree &getDominatorTree() const { return m_domTree; }
 
+private:
     bool canRenameLocalsParams() const { return renameLocalsAndParams; }
 
-    void clearA_phi() { m_A_phi.clear(); }
-
 private:
-    void allocateData();
+    /// Reset all data needed for placing phi functions.
+    void resetPhiData();
 
-    bool isAncestorOf(FragIndex n, FragIndex parent) const;
+    /// Set bit \p frag of the set of fragments for location \p loc in \p sites
+    /// \returns false if the bit was set already.
+    bool addSite(std::vector<std::vector<bool>> &sites, LocIndex loc, FragIndex frag);
 
 private:
     UserProc *m_proc = nullptr;
 
     /* Dominance Frontier Data */
-
-    // These first two are not from Appel; they map fragments to indices and back
-    std::vector<IRFragment *> m_frags;                     ///< Maps index -> IRFragment
-    std::unordered_map<IRFragment *, FragIndex> m_indices; ///< Maps IRFragment -> index
-
-    /// Calculating the dominance frontier
-
-    /// Order number of fragment n during a depth first search.
-    /// If there is a path from a to b in the ProcCFG, then a is an ancestor of b
-    /// if dfnum[a] < dfnum[b]. If fragment a has not yet been visited, m_dfnum[a] will be -1.
-    std::vector<int> m_dfnum;
-
-    std::vector<FragIndex>
-        m_ancestor;                ///< Immediate unique ancestor in the depth first spanning tree
-    std::vector<FragIndex> m_semi; ///< Semi-dominator of n
-    std::vector<FragIndex> m_idom; ///< Immediate dominator
-
-    std::vector<FragIndex> m_samedom;          ///< ? To do with deferring
-    std::vector<FragIndex> m_vertex;           ///< ?
-    std::vector<FragIndex> m_parent;           ///< Parent in the dominator tree?
-    std::vector<FragIndex> m_best;             ///< Improves ancestorWithLowestSemi
-    std::vector<std::set<FragIndex>> m_bucket; ///< Deferred calculation?
-    std::vector<std::set<FragIndex>> m_DF;     ///< Dominance frontier for every node n
-    std::size_t N = 0;                         ///< Current node number in algorithm
+    DominatorTree m_domTree;
 
     /*
      * Inserting phi-functions
+     * All per-location data is indexed by the index of the location in m_locations;
+     * sets of fragments are bit sets indexed by FragIndex.
      */
-    /// Array of sets of locations defined in fragment n
-    std::vector<ExSet> m_definedAt; // was: m_A_orig
+    LocationTable m_locations;
 
-    /// For a given expression e, stores the fragments needing a phi for e
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> m_A_phi;
+    /// For a given location, the fragments needing a phi for the location
+    std::vector<std::vector<bool>> m_A_phi;
 
-    /// For a given expression e, stores the fragments where e is defined
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> m_defsites;
+    /// For a given location, the fragments where the location is defined (was: A_orig)
+    std::vector<std::vector<bool>> m_defsites;
 
-    /// Set of block numbers defining all variables
-    std::set<FragIndex> m_defallsites;
+    /// Fragments defining all variables
+    std::vector<FragIndex> m_defallsites;
 
     /// A Boomerang requirement: Statements defining particular subscripted locations
-    std::map<SharedExp, SharedStmt, lessExpStar> m_defStmts;
+    std::vector<SharedStmt> m_defStmts;
 
     /**
      * Initially false, meaning that locals and parameters are not renamed and hence not propagated.
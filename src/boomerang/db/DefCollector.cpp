@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "DefCollector.h"
 
+#include "boomerang/db/LocationTable.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/util/Util.h"
 
@@ -69,17 +70,18 @@ SharedExp DefCollector::findDefFor(const SharedExp &e) const
 }
 
 
-void DefCollector::updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> &Stacks,
-                              UserProc *proc)
+void DefCollector::updateDefs(const LocationTable &locations,
+                              const std::vector<std::vector<SharedStmt>> &stacks, UserProc *proc)
 {
-    for (auto &Stack : Stacks) {
-        if (Stack.second.empty()) {
+    for (LocIndex loc = 0; loc < stacks.size(); ++loc) {
+        if (stacks[loc].empty()) {
             continue; // This variable's definition doesn't reach here
         }
 
         // Create an assignment of the form loc := loc{def}
-        auto re = RefExp::get(Stack.first->clone(), Stack.second.top());
-        std::shared_ptr<Assign> as(new Assign(Stack.first->clone(), re));
+        const SharedExp &var = locations.getLocation(loc);
+        auto re              = RefExp::get(var->clone(), stacks[loc].back());
+        std::shared_ptr<Assign> as(new Assign(var->clone(), re));
         as->setProc(proc); // Simplify sometimes needs this
         collectDef(as);
     }
@@ -11,12 +11,13 @@
 
 
 #include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/StatementSet.h"
 
-#include <map>
-#include <stack>
+#include <vector>
 
 
+class LocationTable;
 class Statement;
 class UserProc;
 
@@ -25,7 +26,7 @@ class UserProc;
  * This class collects all definitions that reach the statement
  * that contains this collector.
  */
-class BOOMERANG_API DefCollector
+class BOOMERANG_API DefCollector : private IRCounted<IRObjectKind::DefCollector>
 {
 public:
     typedef AssignSet::const_iterator const_iterator;
@@ -64,10 +65,11 @@ public:
     /// If not found, returns nullptr.
     SharedExp findDefFor(const SharedExp &e) const;
 
-    /// Update the definitions with the current set of reaching definitions
-    /// \p proc is the enclosing procedure
-    void updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> &Stacks,
-                    UserProc *proc);
+    /// Update the definitions with the current set of reaching definitions.
+    /// \p stacks contains the definitions of each location in \p locations
+    /// (the last definition on top); \p proc is the enclosing procedure
+    void updateDefs(const LocationTable &locations,
+                    const std::vector<std::vector<SharedStmt>> &stacks, UserProc *proc);
 
     /// Search and replace all occurrences
     void searchReplaceAll(const Exp &pattern, SharedExp replacement, bool &change);
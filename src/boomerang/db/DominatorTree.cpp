@@ -0,0 +1,373 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DominatorTree.h"
+
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+DominatorTree::DominatorTree()
+{
+}
+
+
+bool DominatorTree::calculate(ProcCFG *cfg)
+{
+    if (cfg == m_cfg && cfg->getVersion() == m_cfgVersion) {
+        return m_valid; // CFG did not change
+    }
+
+    m_cfg        = cfg;
+    m_cfgVersion = cfg->getVersion();
+    m_valid      = false;
+
+    if (cfg->getNumFragments() == 0 || !cfg->getEntryFragment()) {
+        return false; // nothing to do
+    }
+    else if (!buildGraph(cfg)) {
+        return false;
+    }
+
+    depthFirstSearch();
+    calculateIdoms();
+    buildTree();
+    calculateDF();
+
+    m_valid = true;
+    return true;
+}
+
+
+void DominatorTree::clear()
+{
+    m_cfg        = nullptr;
+    m_cfgVersion = 0;
+    m_valid      = false;
+    m_root       = INDEX_INVALID;
+    N            = 0;
+
+    m_frags.clear();
+    m_indices.clear();
+    m_idom.clear();
+    m_semi.clear();
+    m_DF.clear();
+    m_children.clear();
+    m_treePre.clear();
+    m_treePost.clear();
+}
+
+
+FragIndex DominatorTree::fragToIdx(const IRFragment *frag) const
+{
+    auto it = m_indices.find(frag);
+    return it != m_indices.end() ? it->second : INDEX_INVALID;
+}
+
+
+bool DominatorTree::buildGraph(ProcCFG *cfg)
+{
+    const std::size_t numFrags = cfg->getNumFragments();
+
+    // Set up the fragment and indices vectors.
+    // Do this here because sometimes a fragment can be unreachable
+    // (so relying on in-edges doesn't work)
+    m_frags.clear();
+    m_indices.clear();
+    m_indices.reserve(numFrags);
+
+    for (IRFragment *frag : *cfg) {
+        m_indices[frag] = m_frags.size();
+        m_frags.push_back(frag);
+    }
+
+    m_root = fragToIdx(cfg->getEntryFragment());
+    if (m_root == INDEX_INVALID) {
+        LOG_ERROR("Entry fragment is not part of the CFG");
+        return false;
+    }
+
+    m_succBegin.assign(numFrags + 1, 0);
+    m_predBegin.assign(numFrags + 1, 0);
+    m_succs.clear();
+    m_preds.clear();
+
+    auto addEdges = [this](const std::vector<IRFragment *> &frags,
+                           std::vector<FragIndex> &edges) {
+        for (const IRFragment *frag : frags) {
+            auto it = m_indices.find(frag);
+            if (it == m_indices.end()) {
+                LOG_ERROR("Fragment not in indices: %1", frag->toString());
+                return false;
+            }
+
+            edges.push_back(it->second);
+        }
+
+        return true;
+    };
+
+    for (FragIndex n = 0; n < numFrags; ++n) {
+        const IRFragment *frag = m_frags[n];
+
+        m_succBegin[n] = m_succs.size();
+        m_predBegin[n] = m_preds.size();
+
+        if (!addEdges(frag->getSuccessors(), m_succs) ||
+            !addEdges(frag->getPredecessors(), m_preds)) {
+            return false;
+        }
+    }
+
+    m_succBegin[numFrags] = m_succs.size();
+    m_predBegin[numFrags] = m_preds.size();
+    return true;
+}
+
+
+void DominatorTree::depthFirstSearch()
+{
+    const std::size_t numNodes = m_succBegin.size() - 1;
+
+    m_dfnum.assign(numNodes, -1);
+    m_vertex.assign(numNodes, INDEX_INVALID);
+    m_parent.assign(numNodes, INDEX_INVALID);
+
+    // Stack of (node, position of the next successor to visit).
+    // Successors are visited in the same order as a recursive search would visit them.
+    std::vector<std::pair<FragIndex, std::size_t>> stack;
+    stack.reserve(numNodes);
+
+    m_dfnum[m_root]  = 0;
+    m_vertex[0]      = m_root;
+    m_parent[m_root] = INDEX_INVALID;
+    N                = 1;
+    stack.push_back({ m_root, m_succBegin[m_root] });
+
+    while (!stack.empty()) {
+        const FragIndex node = stack.back().first;
+        std::size_t &pos     = stack.back().second;
+
+        if (pos == m_succBegin[node + 1]) {
+            stack.pop_back();
+            continue;
+        }
+
+        const FragIndex succ = m_succs[pos++];
+        if (m_dfnum[succ] >= 0) {
+            continue; // already visited
+        }
+
+        m_dfnum[succ]  = N;
+        m_vertex[N]    = succ;
+        m_parent[succ] = node;
+        N++;
+
+        stack.push_back({ succ, m_succBegin[succ] });
+    }
+}
+
+
+void DominatorTree::calculateIdoms()
+{
+    const std::size_t numNodes = m_dfnum.size();
+
+    m_ancestor.assign(numNodes, INDEX_INVALID);
+    m_best.assign(numNodes, INDEX_INVALID);
+    m_semi.assign(numNodes, INDEX_INVALID);
+    m_idom.assign(numNodes, INDEX_INVALID);
+    m_samedom.assign(numNodes, INDEX_INVALID);
+    m_bucketHead.assign(numNodes, INDEX_INVALID);
+    m_bucketNext.assign(numNodes, INDEX_INVALID);
+
+    // Process nodes in reverse pre-traversal order (i.e. return blocks first)
+    for (std::size_t i = N - 1; i >= 1; i--) {
+        const FragIndex n = m_vertex[i];
+        const FragIndex p = m_parent[n];
+        FragIndex s       = p;
+
+        // These lines calculate the semi-dominator of n, based on the Semidominator Theorem
+        for (std::size_t j = m_predBegin[n]; j < m_predBegin[n + 1]; ++j) {
+            const FragIndex v = m_preds[j];
+            if (m_dfnum[v] < 0) {
+                continue; // unreachable predecessors do not affect dominance
+            }
+
+            FragIndex sdash = v;
+            if (isVisitedBefore(n, v)) {
+                sdash = m_semi[getAncestorWithLowestSemi(v)];
+            }
+
+            if (isVisitedBefore(sdash, s)) {
+                s = sdash;
+            }
+        }
+
+        m_semi[n] = s;
+
+        // Calculation of n's dominator is deferred until the path from s to n
+        // has been linked into the forest
+        m_bucketNext[n] = m_bucketHead[s];
+        m_bucketHead[s] = n;
+
+        // link(p, n)
+        m_ancestor[n] = p;
+        m_best[n]     = n;
+
+        // for each v in bucket[p]
+        for (FragIndex v = m_bucketHead[p]; v != INDEX_INVALID; v = m_bucketNext[v]) {
+            // Now that the path from p to v has been linked into the spanning forest,
+            // these lines calculate the dominator of v, based on the first clause of the
+            // Dominator Theorem, or else defer the calculation until y's dominator is known.
+            const FragIndex y = getAncestorWithLowestSemi(v);
+
+            if (m_semi[y] == m_semi[v]) {
+                m_idom[v] = p; // Success!
+            }
+            else {
+                m_samedom[v] = y; // Defer
+            }
+        }
+
+        m_bucketHead[p] = INDEX_INVALID;
+    }
+
+    for (std::size_t i = 1; i < N; i++) {
+        // Now all the deferred dominator calculations, based on the second clause of the Dominator
+        // Theorem, are performed.
+        const FragIndex n = m_vertex[i];
+
+        if (m_samedom[n] != INDEX_INVALID) {
+            m_idom[n] = m_idom[m_samedom[n]]; // Deferred success!
+        }
+    }
+
+    // the root is always executed.
+    m_idom[m_root] = m_root;
+    m_semi[m_root] = m_root;
+}
+
+
+FragIndex DominatorTree::getAncestorWithLowestSemi(FragIndex v)
+{
+    assert(v != INDEX_INVALID);
+
+    // Collect the path to the root of the spanning forest, then compress it top-down.
+    m_workList.clear();
+
+    FragIndex u = v;
+    while (m_ancestor[u] != INDEX_INVALID && m_ancestor[m_ancestor[u]] != INDEX_INVALID) {
+        m_workList.push_back(u);
+        u = m_ancestor[u];
+    }
+
+    while (!m_workList.empty()) {
+        const FragIndex w = m_workList.back();
+        m_workList.pop_back();
+
+        const FragIndex a = m_ancestor[w];
+        const FragIndex b = m_best[a];
+        m_ancestor[w]     = m_ancestor[a];
+
+        if (isVisitedBefore(m_semi[b], m_semi[m_best[w]])) {
+            m_best[w] = b;
+        }
+    }
+
+    return m_best[v];
+}
+
+
+void DominatorTree::buildTree()
+{
+    const std::size_t numNodes = m_idom.size();
+
+    m_children.resize(numNodes);
+    for (std::vector<FragIndex> &children : m_children) {
+        children.clear();
+    }
+
+    for (FragIndex n = 0; n < numNodes; ++n) {
+        if (n != m_root && m_idom[n] != INDEX_INVALID) {
+            m_children[m_idom[n]].push_back(n);
+        }
+    }
+
+    // Number the nodes of the tree in pre-order and post-order
+    m_treePre.assign(numNodes, -1);
+    m_treePost.assign(numNodes, -1);
+    m_treePostOrder.clear();
+
+    std::vector<std::pair<FragIndex, std::size_t>> stack;
+    stack.reserve(N);
+
+    int preNum  = 0;
+    int postNum = 0;
+
+    m_treePre[m_root] = preNum++;
+    stack.push_back({ m_root, 0 });
+
+    while (!stack.empty()) {
+        const FragIndex node = stack.back().first;
+        std::size_t &pos     = stack.back().second;
+
+        if (pos == m_children[node].size()) {
+            m_treePost[node] = postNum++;
+            m_treePostOrder.push_back(node);
+            stack.pop_back();
+            continue;
+        }
+
+        const FragIndex child = m_children[node][pos++];
+        m_treePre[child]      = preNum++;
+        stack.push_back({ child, 0 });
+    }
+}
+
+
+void DominatorTree::calculateDF()
+{
+    const std::size_t numNodes = m_idom.size();
+
+    m_DF.resize(numNodes);
+    for (std::vector<FragIndex> &df : m_DF) {
+        df.clear();
+    }
+
+    // Children are processed before their parents
+    for (FragIndex n : m_treePostOrder) {
+        std::vector<FragIndex> &S = m_DF[n];
+
+        // This loop computes DF_local[n]
+        for (std::size_t j = m_succBegin[n]; j < m_succBegin[n + 1]; ++j) {
+            const FragIndex y = m_succs[j];
+
+            if (m_idom[y] != n) {
+                S.push_back(y);
+            }
+        }
+
+        // for each child c of n in the dominator tree
+        for (FragIndex c : m_children[n]) {
+            // This loop computes DF_up[c]
+            for (FragIndex w : m_DF[c]) {
+                if (!strictlyDominates(n, w)) {
+                    S.push_back(w);
+                }
+            }
+        }
+
+        std::sort(S.begin(), S.end());
+        S.erase(std::unique(S.begin(), S.end()), S.end());
+    }
+}
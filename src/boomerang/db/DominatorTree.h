@@ -0,0 +1,162 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+class IRFragment;
+class ProcCFG;
+
+typedef std::size_t FragIndex;
+static constexpr const FragIndex INDEX_INVALID = FragIndex(-1);
+
+
+/**
+ * Dominator tree and dominance frontiers of the fragments of a ProcCFG.
+ * Dominators are calculated using Lengauer-Tarjan with path compression
+ * (Algorithm 19.9 of Appel's "Modern compiler implementation in Java" 2nd ed 2002).
+ * All data is kept in flat arrays indexed by FragIndex.
+ *
+ * The results are cached; they are only recalculated when the structure
+ * of the CFG has changed since the last calculation (see ProcCFG::getVersion).
+ */
+class BOOMERANG_API DominatorTree
+{
+public:
+    DominatorTree();
+    DominatorTree(const DominatorTree &other) = delete;
+    DominatorTree(DominatorTree &&other)      = default;
+
+    ~DominatorTree() = default;
+
+    DominatorTree &operator=(const DominatorTree &other) = delete;
+    DominatorTree &operator=(DominatorTree &&other) = default;
+
+public:
+    /// Calculate the dominators of all fragments in \p cfg,
+    /// unless the cached results for \p cfg are still up to date.
+    /// \returns false if the CFG is empty or malformed.
+    bool calculate(ProcCFG *cfg);
+
+    /// Drop all cached results.
+    void clear();
+
+    /// \returns the number of nodes in the tree.
+    std::size_t getNumNodes() const { return m_idom.size(); }
+
+    /// \returns the root of the tree, i.e. the entry fragment.
+    FragIndex getRoot() const { return m_root; }
+
+    /// \returns the fragment with index \p node, or nullptr if \p node is invalid.
+    IRFragment *idxToFrag(FragIndex node) const
+    {
+        return node < m_frags.size() ? m_frags[node] : nullptr;
+    }
+
+    /// \returns the index of \p frag, or INDEX_INVALID if \p frag is not known.
+    FragIndex fragToIdx(const IRFragment *frag) const;
+
+    /// \returns the immediate dominator of \p node. The root is its own immediate
+    /// dominator. Returns INDEX_INVALID for nodes not reachable from the root.
+    FragIndex getIdom(FragIndex node) const { return m_idom[node]; }
+
+    /// \returns the semi-dominator of \p node.
+    FragIndex getSemi(FragIndex node) const { return m_semi[node]; }
+
+    /// \returns the dominance frontier of \p node, sorted by index.
+    const std::vector<FragIndex> &getDF(FragIndex node) const { return m_DF[node]; }
+
+    /// \returns all nodes immediately dominated by \p node, sorted by index.
+    const std::vector<FragIndex> &getChildren(FragIndex node) const { return m_children[node]; }
+
+    /// \returns true if \p n dominates \p w. Every node dominates itself.
+    bool dominates(FragIndex n, FragIndex w) const
+    {
+        return n == w ? m_treePre[n] >= 0 : strictlyDominates(n, w);
+    }
+
+    /// \returns true if \p n dominates \p w and \p n != \p w.
+    bool strictlyDominates(FragIndex n, FragIndex w) const
+    {
+        return m_treePre[w] >= 0 && m_treePre[n] < m_treePre[w] &&
+               m_treePost[w] < m_treePost[n];
+    }
+
+private:
+    /// Build the successor and predecessor lists of all nodes.
+    /// \returns false if the CFG is malformed.
+    bool buildGraph(ProcCFG *cfg);
+
+    /// Number all nodes reachable from the root in depth first order.
+    void depthFirstSearch();
+
+    /// Calculate immediate dominators and semi-dominators.
+    void calculateIdoms();
+
+    /// Basically algorithm 19.10b of Appel 2002 (uses path compression for O(log N) amortised time
+    /// per operation (overall O(N log N))
+    FragIndex getAncestorWithLowestSemi(FragIndex v);
+
+    /// Build the dominator tree from the immediate dominators and number its nodes.
+    void buildTree();
+
+    /// Calculate the dominance frontiers of all nodes bottom-up in the dominator tree.
+    void calculateDF();
+
+    /// \returns true if \p n was visited before \p w during the depth first search.
+    bool isVisitedBefore(FragIndex n, FragIndex w) const { return m_dfnum[n] < m_dfnum[w]; }
+
+private:
+    const ProcCFG *m_cfg = nullptr; ///< The CFG the cached results belong to
+    uint64 m_cfgVersion  = 0;       ///< Version of the CFG the cached results belong to
+    bool m_valid         = false;   ///< True if the last calculation was successful
+
+    std::vector<IRFragment *> m_frags;                           ///< Maps index -> IRFragment
+    std::unordered_map<const IRFragment *, FragIndex> m_indices; ///< Maps IRFragment -> index
+    FragIndex m_root = INDEX_INVALID;
+
+    /// Successors and predecessors of node n are stored in m_succs[m_succBegin[n]] to
+    /// m_succs[m_succBegin[n+1]-1] (and likewise for predecessors).
+    std::vector<std::size_t> m_succBegin;
+    std::vector<FragIndex> m_succs;
+    std::vector<std::size_t> m_predBegin;
+    std::vector<FragIndex> m_preds;
+
+    /// Order number of node n during a depth first search, or -1 if n is not reachable.
+    std::vector<int> m_dfnum;
+    std::vector<FragIndex> m_vertex;   ///< Node with DFS number i
+    std::vector<FragIndex> m_parent;   ///< Parent in the depth first spanning tree
+    std::vector<FragIndex> m_ancestor; ///< Ancestor in the spanning forest built during the search
+    std::vector<FragIndex> m_best;     ///< Improves getAncestorWithLowestSemi
+    std::vector<FragIndex> m_semi;     ///< Semi-dominator of n
+    std::vector<FragIndex> m_idom;     ///< Immediate dominator of n
+    std::vector<FragIndex> m_samedom;  ///< Deferred: n has the same dominator as m_samedom[n]
+    std::size_t N = 0;                 ///< Number of nodes reachable from the root
+
+    /// Nodes whose dominator calculation is deferred until their semi-dominator is linked,
+    /// stored as singly linked lists (every node is in at most one bucket)
+    std::vector<FragIndex> m_bucketHead;
+    std::vector<FragIndex> m_bucketNext;
+
+    std::vector<std::vector<FragIndex>> m_children; ///< Children in the dominator tree
+    std::vector<int> m_treePre;  ///< Pre-order number in the dominator tree, -1 if unreachable
+    std::vector<int> m_treePost; ///< Post-order number in the dominator tree
+    std::vector<FragIndex> m_treePostOrder; ///< Nodes of the dominator tree in post-order
+
+    std::vector<std::vector<FragIndex>> m_DF; ///< Dominance frontier of every node n
+
+    std::vector<FragIndex> m_workList; ///< Scratch space for the iterative traversals
+};
@@ -65,6 +65,7 @@ public:
     {
         assert(Util::inRange(i, 0, getNumPredecessors()));
         m_predecessors[i] = pred;
+        edgesChanged();
     }
 
     /// Change the \p i-th successor of this node.
@@ -73,13 +74,22 @@ public:
     {
         assert(Util::inRange(i, 0, getNumSuccessors()));
         m_successors[i] = succ;
+        edgesChanged();
     }
 
     /// Add a predecessor to this node.
-    void addPredecessor(Derived *pred) { m_predecessors.push_back(pred); }
+    void addPredecessor(Derived *pred)
+    {
+        m_predecessors.push_back(pred);
+        edgesChanged();
+    }
 
     /// Add a successor to this node.
-    void addSuccessor(Derived *succ) { m_successors.push_back(succ); }
+    void addSuccessor(Derived *succ)
+    {
+        m_successors.push_back(succ);
+        edgesChanged();
+    }
 
     /// Remove a predecessor node.
     void removePredecessor(Derived *pred)
@@ -88,6 +98,7 @@ public:
         for (auto it = m_predecessors.begin(); it != m_predecessors.end(); ++it) {
             if (*it == pred) {
                 m_predecessors.erase(it);
+                edgesChanged();
                 return;
             }
         }
@@ -100,6 +111,7 @@ public:
         for (auto it = m_successors.begin(); it != m_successors.end(); ++it) {
             if (*it == succ) {
                 m_successors.erase(it);
+                edgesChanged();
                 return;
             }
         }
@@ -107,10 +119,18 @@ public:
 
     /// Removes all successor nodes.
     /// Called when noreturn call is found
-    void removeAllSuccessors() { m_successors.clear(); }
+    void removeAllSuccessors()
+    {
+        m_successors.clear();
+        edgesChanged();
+    }
 
     /// removes all predecessor nodes.
-    void removeAllPredecessors() { m_predecessors.clear(); }
+    void removeAllPredecessors()
+    {
+        m_predecessors.clear();
+        edgesChanged();
+    }
 
     /// \returns true if this node is a (direct) predecessor of \p node,
     /// i.e. there is an edge from this node to \p node
@@ -127,6 +147,14 @@ public:
                m_predecessors.end();
     }
 
+protected:
+    /// Called after an in-edge or out-edge of this node was added, changed or removed.
+    /// Derived classes can hide this function to get notified about changes of the graph.
+    void onEdgesChanged() {}
+
+private:
+    void edgesChanged() { static_cast<Derived *>(this)->onEdgesChanged(); }
+
 private:
     // in-edges and out-edges
     std::vector<Derived *> m_predecessors; ///< Vector of in-edges
@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "IRFragment.h"
 
+#include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/statements/BranchStatement.h"
@@ -632,3 +633,11 @@ QString IRFragment::toString() const
     print(os);
     return result;
 }
+
+
+void IRFragment::onEdgesChanged()
+{
+    if (m_cfg) {
+        m_cfg->structureChanged();
+    }
+}
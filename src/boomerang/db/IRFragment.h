@@ -12,6 +12,7 @@
 
 #include "boomerang/db/GraphNode.h"
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/StatementList.h"
 
 #include <list>
@@ -21,6 +22,7 @@
 class BasicBlock;
 class ImplicitAssign;
 class PhiAssign;
+class ProcCFG;
 
 using RTLList   = std::list<std::unique_ptr<RTL>>;
 using SharedExp = std::shared_ptr<Exp>;
@@ -44,8 +46,11 @@ enum class FragType
 
 /// Holds the IR for at most a single BasicBlock.
 /// In some cases, this might be only a part of a single instruction (e.g. x86 bsf/bsr)
-class BOOMERANG_API IRFragment : public GraphNode<IRFragment>
+class BOOMERANG_API IRFragment : public GraphNode<IRFragment>,
+                                 private IRCounted<IRObjectKind::IRFragment>
 {
+    friend class GraphNode<IRFragment>;
+
 public:
     typedef uint32 FragID;
 
@@ -175,10 +180,15 @@ public:
 
     QString toString() const;
 
+private:
+    /// Notifies the owning CFG that its structure has changed.
+    void onEdgesChanged();
+
 public:
     FragID m_id         = (FragID)-1;
     FragType m_fragType = FragType::Invalid;
     BasicBlock *m_bb;
+    ProcCFG *m_cfg                        = nullptr; ///< The CFG this fragment belongs to
     std::unique_ptr<RTLList> m_listOfRTLs = nullptr; ///< Ptr to list of RTLs
 
     Address m_lowAddr  = Address::ZERO;
@@ -0,0 +1,42 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LocationTable.h"
+
+#include "boomerang/ssl/exp/Exp.h"
+
+
+LocIndex LocationTable::insert(const SharedExp &loc)
+{
+    auto it = m_indices.find(loc);
+    if (it != m_indices.end()) {
+        return it->second;
+    }
+
+    // Copy the location, so it does not change when the original is modified
+    const LocIndex idx = m_locations.size();
+    m_locations.push_back(loc->clone());
+    m_indices.emplace(m_locations.back(), idx);
+
+    return idx;
+}
+
+
+LocIndex LocationTable::find(const SharedExp &loc) const
+{
+    auto it = m_indices.find(loc);
+    return it != m_indices.end() ? it->second : LOC_INVALID;
+}
+
+
+void LocationTable::clear()
+{
+    m_indices.clear();
+    m_locations.clear();
+}
@@ -0,0 +1,60 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+
+#include <map>
+#include <vector>
+
+
+typedef std::size_t LocIndex;
+static constexpr const LocIndex LOC_INVALID = LocIndex(-1);
+
+
+/**
+ * Assigns dense indices to the locations (e.g. r24 or m[r28{5} - 4]) of a procedure,
+ * so that per-location data of the SSA algorithms can be kept in flat arrays indexed by
+ * LocIndex instead of in maps keyed by expressions. Only looking up the index of
+ * a location compares expressions.
+ *
+ * Indices are assigned in the order the locations are inserted, and stay valid
+ * until the table is cleared.
+ */
+class BOOMERANG_API LocationTable
+{
+public:
+    typedef std::map<SharedExp, LocIndex, lessExpStar>::const_iterator const_iterator;
+
+public:
+    /// \returns the index of \p loc, adding a copy of \p loc to the table
+    /// if it is not in the table yet.
+    LocIndex insert(const SharedExp &loc);
+
+    /// \returns the index of \p loc, or LOC_INVALID if \p loc is not in the table.
+    LocIndex find(const SharedExp &loc) const;
+
+    /// \returns the location with index \p idx.
+    const SharedExp &getLocation(LocIndex idx) const { return m_locations[idx]; }
+
+    bool empty() const { return m_locations.empty(); }
+    std::size_t size() const { return m_locations.size(); }
+
+    void clear();
+
+    /// Iterate over all (location, index) pairs, sorted by location.
+    const_iterator begin() const { return m_indices.begin(); }
+    const_iterator end() const { return m_indices.end(); }
+
+private:
+    std::map<SharedExp, LocIndex, lessExpStar> m_indices;
+    std::vector<SharedExp> m_locations; ///< by index
+};
@@ -22,6 +22,7 @@
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/LibProc.h"
 #include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/ProofCache.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/ifc/ICodeGenerator.h"
@@ -39,6 +40,7 @@
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/util/ByteSignatureTrie.h"
 #include "boomerang/util/Types.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
@@ -47,14 +49,13 @@
 #include <QFileInfo>
 #include <QSaveFile>
 
-#include <cctype>
-
 
 Prog::Prog(const QString &name, Project *project)
     : m_name(name)
     , m_project(project)
     , m_binaryFile(project ? project->getLoadedBinaryFile() : nullptr)
     , m_fe(nullptr)
+    , m_proofCache(new ProofCache)
     , m_cfg(new LowLevelCFG)
 {
     m_rootModule = getOrInsertModule(getName());
@@ -198,6 +199,21 @@ Function *Prog::getOrCreateFunction(Address startAddress)
                                   ? m_binaryFile->getSymbols()->findSymbolByAddress(startAddress)
                                   : nullptr;
 
+    if (!sym && m_binaryFile) {
+        // Identify statically linked library functions of stripped binaries
+        const QString libName = matchLibraryPattern(startAddress);
+
+        if (!libName.isEmpty()) {
+            BinarySymbol *libSym = m_binaryFile->getSymbols()->createSymbol(startAddress,
+                                                                            libName);
+            if (libSym) {
+                libSym->setAttribute("Function", true);
+                libSym->setAttribute("StaticFunction", true);
+                sym = libSym;
+            }
+        }
+    }
+
     if (sym) {
         isLibFunction = sym->isImportedFunction() || sym->isStaticFunction();
         procName      = sym->getName();
@@ -357,7 +373,9 @@ void Prog::readDefaultLibraryCatalogues()
         return;
     }
 
+    // Discard catalogs of programs decompiled before by the same project
     ISymbolProvider *prov = plugin->getIfc<ISymbolProvider>();
+    prov->clearLibrarySignatures();
     prov->readLibraryCatalog(this, dataDir.absoluteFilePath("signatures/common.hs"));
 
     QString libCatalogName;
@@ -383,6 +401,81 @@ void Prog::readDefaultLibraryCatalogues()
 }
 
 
+void Prog::readLibraryPatterns()
+{
+    m_libPatterns.reset(new ByteSignatureTrie);
+
+    QString machineName;
+    switch (getMachine()) {
+    case Machine::X86: machineName = "x86"; break;
+    case Machine::PPC: machineName = "ppc"; break;
+    case Machine::ST20: machineName = "st20"; break;
+    default: return;
+    }
+
+    const QDir sigDir(m_project->getSettings()->getDataDirectory().absoluteFilePath("signatures"));
+    for (const QString &fileName : sigDir.entryList({ machineName + "*.pat" }, QDir::Files)) {
+        if (!m_libPatterns->readPatternFile(sigDir.absoluteFilePath(fileName))) {
+            LOG_WARN("Cannot read library patterns from '%1'", fileName);
+        }
+    }
+
+    if (m_libPatterns->empty()) {
+        return;
+    }
+
+    LOG_MSG("Read %1 library patterns", m_libPatterns->getNumPatterns());
+
+    // Match all function entries known from the symbol table only once, at load time
+    BinarySymbolTable *symbols = m_binaryFile->getSymbols();
+    std::vector<std::pair<QString, QString>> renames;
+    int numIdentified = 0;
+
+    for (BinarySymbol *sym : *symbols) {
+        if (!sym->isFunction() || sym->isImported() || sym->isStaticFunction()) {
+            continue;
+        }
+
+        const QString libName = matchLibraryPattern(sym->getLocation());
+        if (!libName.isEmpty()) {
+            sym->setAttribute("StaticFunction", true);
+            numIdentified++;
+
+            // Stripped or mangled names would miss the signature of the library function
+            if (sym->getName() != libName) {
+                renames.push_back({ sym->getName(), libName });
+            }
+        }
+    }
+
+    for (const auto &[oldName, newName] : renames) {
+        if (!symbols->findSymbolByName(newName)) {
+            symbols->renameSymbol(oldName, newName);
+        }
+    }
+
+    LOG_MSG("Identified %1 statically linked library functions", numIdentified);
+}
+
+
+QString Prog::matchLibraryPattern(Address entryAddr) const
+{
+    if (!m_libPatterns || m_libPatterns->empty()) {
+        return "";
+    }
+
+    const BinarySection *section = m_binaryFile->getImage()->getSectionByAddr(entryAddr);
+    if (!section || section->getHostAddr().isZero() || section->isAddressBss(entryAddr)) {
+        return "";
+    }
+
+    const std::size_t offset = (entryAddr - section->getSourceAddr()).value();
+    const Byte *code = static_cast<const Byte *>(static_cast<const void *>(section->getHostAddr()));
+
+    return m_libPatterns->match(code + offset, section->getSize() - offset);
+}
+
+
 bool Prog::addSymbolsFromSymbolFile(const QString &fname)
 {
     Plugin *plugin = m_project->getPluginManager()->getPluginByName("C Symbol Provider plugin");
@@ -431,49 +524,32 @@ const char *Prog::getStringConstant(Address addr, bool knownString /* = false */
         return nullptr;
     }
 
-    const BinarySection *sect = m_binaryFile->getImage()->getSectionByAddr(addr);
+    const BinaryImage *image = m_binaryFile->getImage();
 
     // Too many compilers put constants, including string constants,
     // into read/write sections, so we cannot check if the address is in a readonly section
-    if (!sect || sect->isAddressBss(addr)) {
-        return nullptr;
+    const BinaryStringIndex &strings    = image->getStringIndex();
+    const BinaryStringIndex::Entry *str = strings.find(addr);
+    if (str) {
+        return str->data + (addr - str->addr).value();
     }
-
-    // At this stage, only support ascii, null terminated, non unicode strings.
-    // At least 4 of the first 6 chars should be printable ascii
-    const char *p = reinterpret_cast<const char *>(
-        (sect->getHostAddr() - sect->getSourceAddr() + addr).value());
-
-    if (knownString) {
-        // No need to guess... this is hopefully a known string
-        return p;
+    else if (strings.isEmptyString(addr)) {
+        return "";
     }
-
-    // this address is not known to be a string -> use heuristic
-    int numPrintables = 0;
-    int numControl    = 0; // Control characters like \n, \r, \t
-    int numTotal      = 0;
-
-    for (int i = 0; i < 6; i++, numTotal++) {
-        if (p[i] == 0) {
-            break;
-        }
-        else if (std::isprint(static_cast<Byte>(p[i]))) {
-            numPrintables++;
-        }
-        else if (*p == '\n' || *p == '\t' || *p == '\r') {
-            numControl++;
-        }
+    else if (!knownString) {
+        // Everything that looks like a string is in the index
+        return nullptr;
     }
 
-    if (numTotal == 0) {
-        return "";
-    }
-    else if (numTotal - numPrintables - numControl < 2) {
-        return p;
+    // No need to guess... this is hopefully a known string,
+    // even if it contains non-printable characters
+    const BinarySection *sect = image->getSectionByAddr(addr);
+    if (!sect || sect->isAddressBss(addr)) {
+        return nullptr;
     }
 
-    return nullptr;
+    return reinterpret_cast<const char *>(
+        (sect->getHostAddr() - sect->getSourceAddr() + addr).value());
 }
 
 
@@ -542,9 +618,14 @@ bool Prog::isInStringsSection(Address a) const
         return false;
     }
 
-    const BinarySection *si = static_cast<const BinarySection *>(
-        m_binaryFile->getImage()->getSectionByAddr(a));
-    return si && si->isAttributeInRange("StringsSection", a, a + 1);
+    const BinaryStringIndex &strings      = m_binaryFile->getImage()->getStringIndex();
+    const BinaryStringIndex::Entry *entry = strings.find(a, StringEncoding::ASCII);
+
+    if (!entry) {
+        entry = strings.find(a, StringEncoding::UTF16LE);
+    }
+
+    return entry && entry->inStringsSection;
 }
 
 
@@ -661,6 +742,8 @@ bool Prog::reDecode(UserProc *proc)
 
 Global *Prog::createGlobal(Address addr, SharedType ty, QString name)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     if (addr == Address::INVALID) {
         return nullptr;
     }
@@ -684,6 +767,8 @@ Global *Prog::createGlobal(Address addr, SharedType ty, QString name)
 
 QString Prog::getGlobalNameByAddr(Address uaddr) const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     // FIXME: inefficient
     for (auto &glob : m_globals) {
         if (glob->containsAddress(uaddr)) {
@@ -697,6 +782,8 @@ QString Prog::getGlobalNameByAddr(Address uaddr) const
 
 Address Prog::getGlobalAddrByName(const QString &name) const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     const Global *glob = getGlobalByName(name);
     if (glob) {
         return glob->getAddress();
@@ -709,6 +796,8 @@ Address Prog::getGlobalAddrByName(const QString &name) const
 
 Global *Prog::getGlobalByName(const QString &name) const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     auto iter = std::find_if(
         m_globals.begin(), m_globals.end(),
         [&name](const std::shared_ptr<Global> &g) -> bool { return g->getName() == name; });
@@ -719,6 +808,8 @@ Global *Prog::getGlobalByName(const QString &name) const
 
 bool Prog::markGlobalUsed(Address uaddr, SharedType knownType)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     for (auto &glob : m_globals) {
         if (glob->containsAddress(uaddr)) {
             if (knownType) {
@@ -775,6 +866,8 @@ bool Prog::markGlobalUsed(Address uaddr, SharedType knownType)
 
 std::shared_ptr<ArrayType> Prog::makeArrayType(Address startAddr, SharedType baseType)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     QString name = newGlobalName(startAddr);
 
     // TODO: fix the case of missing symbol table interface
@@ -797,6 +890,9 @@ std::shared_ptr<ArrayType> Prog::makeArrayType(Address startAddr, SharedType bas
 
 SharedType Prog::guessGlobalType(const QString &globalName, Address globAddr) const
 {
+    // Also serializes the loader's debug information reader, which caches decoded types
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     SharedType type = DebugInfo::typeFromDebugInfo(globalName, globAddr);
     if (type) {
         return type;
@@ -804,6 +900,12 @@ SharedType Prog::guessGlobalType(const QString &globalName, Address globAddr) co
     else if (!m_binaryFile) {
         return VoidType::get();
     }
+    else if (m_project->getSettings()->useDebugInfo) {
+        type = m_binaryFile->getDebugGlobalType(globAddr);
+        if (type) {
+            return type;
+        }
+    }
 
     auto symbol = m_binaryFile->getSymbols()->findSymbolByName(globalName);
     int sz      = symbol ? symbol->getSize() : 0;
@@ -835,6 +937,8 @@ SharedType Prog::guessGlobalType(const QString &globalName, Address globAddr) co
 
 QString Prog::newGlobalName(Address uaddr)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     QString globalName = getGlobalNameByAddr(uaddr);
 
     if (!globalName.isEmpty()) {
@@ -849,9 +953,11 @@ QString Prog::newGlobalName(Address uaddr)
 
 SharedType Prog::getGlobalType(const QString &name) const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     for (auto &global : m_globals) {
         if (global->getName() == name) {
-            return global->getType();
+            return global->getType() ? global->getType()->clone() : nullptr;
         }
     }
 
@@ -861,6 +967,8 @@ SharedType Prog::getGlobalType(const QString &name) const
 
 void Prog::setGlobalType(const QString &name, SharedType ty)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
     // FIXME: inefficient
     for (auto &gl : m_globals) {
         if (gl->getName() == name) {
@@ -869,3 +977,28 @@ void Prog::setGlobalType(const QString &name, SharedType ty)
         }
     }
 }
+
+
+bool Prog::meetGlobalType(const QString &name, const SharedType &ty)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_globalsMutex);
+
+    for (auto &gl : m_globals) {
+        if (gl->getName() == name) {
+            if (!gl->getType()) {
+                return false;
+            }
+
+            bool changed       = false;
+            SharedType newType = gl->getType()->meetWith(ty, changed);
+
+            if (changed) {
+                gl->setType(newType);
+            }
+
+            return changed;
+        }
+    }
+
+    return false;
+}
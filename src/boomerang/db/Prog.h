@@ -24,6 +24,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 
 
@@ -31,11 +32,13 @@ class ArrayType;
 class BinaryFile;
 class BinarySection;
 class BinarySymbol;
+class ByteSignatureTrie;
 class Function;
 class IFrontEnd;
 class LibProc;
 class Module;
 class Project;
+class ProofCache;
 class Signature;
 class ISymbolProvider;
 class LowLevelCFG;
@@ -77,6 +80,9 @@ public:
     LowLevelCFG *getCFG() { return m_cfg.get(); }
     const LowLevelCFG *getCFG() const { return m_cfg.get(); }
 
+    /// \returns the cache for the results of UserProc::proveEqual.
+    ProofCache *getProofCache() { return m_proofCache.get(); }
+
     /**
      * Creates a new empty module.
      * \param name   The name of the new module.
@@ -157,6 +163,13 @@ public:
     Machine getMachine() const;
 
     void readDefaultLibraryCatalogues();
+
+    /// Read the byte patterns of statically linked library functions for the machine
+    /// of this program (signatures/<machine>*.pat), and mark all function symbols
+    /// matching a pattern as statically linked library functions.
+    /// Functions without symbols are identified when they are created.
+    void readLibraryPatterns();
+
     bool addSymbolsFromSymbolFile(const QString &fname);
     std::shared_ptr<Signature> getLibSignature(const QString &name);
 
@@ -165,7 +178,7 @@ public:
 
     /// get a string constant at a given address if appropriate
     /// if knownString, it is already known to be a char*
-    /// get a string constant at a give address if appropriate
+    /// \sa BinaryStringIndex
     const char *getStringConstant(Address addr, bool knownString = false) const;
     bool getFloatConstant(Address addr, double &value, int bits = 64) const;
 
@@ -177,6 +190,7 @@ public:
     Address getLimitTextHigh() const;
 
     bool isReadOnly(Address a) const;
+    /// \returns true if \p a is in a string literal in a read-only or strings section
     bool isInStringsSection(Address a) const;
     bool isDynamicallyLinkedProcPointer(Address dest) const;
 
@@ -200,6 +214,9 @@ public:
     const std::list<UserProc *> &getEntryProcs() const { return m_entryProcs; }
 
     // globals
+    // The functions below may be called by procedures analysed in parallel;
+    // they are serialized by a lock. getGlobals() is not; iterate only while no
+    // other thread modifies the globals.
 
     /**
      * Create a new global variable at address \p addr.
@@ -242,26 +259,46 @@ public:
     /// (or return an existing name if address already used)
     QString newGlobalName(Address uaddr);
 
-    /// Get the type of a global variable
+    /// Get the type of a global variable.
+    /// \returns a copy of the type, since the type might be changed by another thread
+    /// analysing types (see meetGlobalType).
     SharedType getGlobalType(const QString &name) const;
 
     /// Set the type of a global variable
     void setGlobalType(const QString &name, SharedType ty);
 
+    /// Meet the type of the global variable \p name with \p ty.
+    /// \returns true if the type of the global changed.
+    bool meetGlobalType(const QString &name, const SharedType &ty);
+
+private:
+    /// \returns the name of the library function whose byte pattern matches
+    /// the code at \p entryAddr, or the empty string if there is none.
+    QString matchLibraryPattern(Address entryAddr) const;
+
 private:
     QString m_name; ///< name of the program
     Project *m_project       = nullptr;
     BinaryFile *m_binaryFile = nullptr;
     IFrontEnd *m_fe          = nullptr; ///< Pointer to the FrontEnd object for the project
     Module *m_rootModule     = nullptr; ///< Root of the module tree
-    ModuleList m_moduleList;            ///< The Modules that make up this program
+
+    /// Must be destroyed after the modules, since procs invalidate their proofs on destruction.
+    std::unique_ptr<ProofCache> m_proofCache;
+    ModuleList m_moduleList; ///< The Modules that make up this program
 
     std::unique_ptr<LowLevelCFG> m_cfg;
 
+    /// Byte patterns of statically linked library functions
+    std::unique_ptr<ByteSignatureTrie> m_libPatterns;
+
     /// list of UserProcs for entry point(s)
     std::list<UserProc *> m_entryProcs;
 
     // FIXME: is a set of Globals the most appropriate data structure? Surely not.
     GlobalSet m_globals;         ///< globals to print at code generation time
     DataIntervalMap m_globalMap; ///< Map from address to DataInterval (has size, name, type)
+
+    /// Guards m_globals. Recursive, since the global functions call each other.
+    mutable std::recursive_mutex m_globalsMutex;
 };
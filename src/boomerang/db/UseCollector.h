@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/LocationSet.h"
 
 
@@ -24,7 +25,7 @@ class UserProc;
  * Typically the entries are not subscripted,
  * like parameters or locations on the LHS of assignments
  */
-class BOOMERANG_API UseCollector
+class BOOMERANG_API UseCollector : private IRCounted<IRObjectKind::UseCollector>
 {
 public:
     typedef LocationSet::iterator iterator;
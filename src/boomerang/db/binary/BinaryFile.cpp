@@ -89,7 +89,25 @@ Address BinaryFile::getJumpTarget(Address addr) const
 
 bool BinaryFile::hasDebugInfo() const
 {
-    return false;
+    return m_loader ? m_loader->hasDebugInfo() : false;
+}
+
+
+std::vector<Address> BinaryFile::getDebugFunctions() const
+{
+    return m_loader ? m_loader->getDebugFunctions() : std::vector<Address>();
+}
+
+
+std::shared_ptr<Signature> BinaryFile::getDebugSignature(Address entry) const
+{
+    return m_loader ? m_loader->getDebugSignature(entry) : nullptr;
+}
+
+
+SharedType BinaryFile::getDebugGlobalType(Address addr) const
+{
+    return m_loader ? m_loader->getDebugGlobalType(addr) : nullptr;
 }
 
 
@@ -13,11 +13,15 @@
 #include "boomerang/util/Address.h"
 
 #include <memory>
+#include <vector>
 
 
 class BinaryImage;
 class BinarySymbolTable;
 class IFileLoader;
+class Signature;
+
+using SharedType = std::shared_ptr<class Type>;
 
 class QByteArray;
 
@@ -89,9 +93,20 @@ public:
     /// \returns the destination of a jump at address \p addr, taking relocation into account
     Address getJumpTarget(Address addr) const;
 
-    /// \note not yet implemented.
+    /// \returns true if the binary file contains debug information usable by the loader.
     bool hasDebugInfo() const;
 
+    /// \returns the entry addresses of all functions described by the debug information.
+    std::vector<Address> getDebugFunctions() const;
+
+    /// \returns the signature of the function starting at \p entry
+    /// according to the debug information, or nullptr if it is not known.
+    std::shared_ptr<Signature> getDebugSignature(Address entry) const;
+
+    /// \returns the type of the global variable at \p addr
+    /// according to the debug information, or nullptr if it is not known.
+    SharedType getDebugGlobalType(Address addr) const;
+
     /// \returns the default instruction size of the instruction set in the binary,
     /// or 0 if not known.
     int getBitness() const;
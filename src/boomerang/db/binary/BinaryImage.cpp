@@ -31,6 +31,8 @@ BinaryImage::~BinaryImage()
 
 void BinaryImage::reset()
 {
+    m_stringIndex.clear();
+    m_pageTable.clear();
     m_sectionMap.clear();
     m_sections.clear();
 }
@@ -38,81 +40,56 @@ void BinaryImage::reset()
 
 bool BinaryImage::readNative1(Address addr, Byte &value) const
 {
-    const BinarySection *section = getSectionByAddr(addr);
+    const BinarySection *section = nullptr;
+    const Byte *data             = getReadPtr(addr, 1, section, false);
 
-    if (section == nullptr || section->getHostAddr() == HostAddress::INVALID) {
-        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr);
+    if (!data) {
         return false;
     }
 
-    HostAddress host = section->getHostAddr() - section->getSourceAddr() + addr;
-    value            = *reinterpret_cast<Byte *>(host.value());
+    value = *data;
     return true;
 }
 
 
 bool BinaryImage::readNative2(Address addr, SWord &value) const
 {
-    const BinarySection *si = getSectionByAddr(addr);
+    const BinarySection *si = nullptr;
+    const Byte *data        = getReadPtr(addr, 2, si, true);
 
-    if (si == nullptr || si->getHostAddr() == HostAddress::INVALID) {
-        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr.toString());
-        return false;
-    }
-    else if (addr + 2 > si->getSourceAddr() + si->getSize()) {
-        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
-        return false;
-    }
-    else if (si->isAddressBss(addr)) {
+    if (!data) {
         return false;
     }
 
-    HostAddress host = si->getHostAddr() - si->getSourceAddr() + addr;
-    value = Util::readWord(reinterpret_cast<const Byte *>(host.value()), si->getEndian());
+    value = Util::readWord(data, si->getEndian());
     return true;
 }
 
 
 bool BinaryImage::readNative4(Address addr, DWord &value) const
 {
-    const BinarySection *si = getSectionByAddr(addr);
+    const BinarySection *si = nullptr;
+    const Byte *data        = getReadPtr(addr, 4, si, true);
 
-    if (si == nullptr || si->getHostAddr() == HostAddress::INVALID) {
-        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr.toString());
-        return false;
-    }
-    else if (addr + 4 > si->getSourceAddr() + si->getSize()) {
-        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
-        return false;
-    }
-    else if (si->isAddressBss(addr)) {
+    if (!data) {
         return false;
     }
 
-    HostAddress host = si->getHostAddr() - si->getSourceAddr() + addr;
-    value = Util::readDWord(reinterpret_cast<const Byte *>(host.value()), si->getEndian());
+    value = Util::readDWord(data, si->getEndian());
     return true;
 }
 
 
 bool BinaryImage::readNative8(Address addr, QWord &value) const
 {
-    const BinarySection *si = getSectionByAddr(addr);
+    const BinarySection *si = nullptr;
+    const Byte *data        = getReadPtr(addr, 8, si, true);
 
-    if (si == nullptr || si->getHostAddr() == HostAddress::INVALID) {
-        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr.toString());
-        return false;
-    }
-    else if (addr + 8 > si->getSourceAddr() + si->getSize()) {
-        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
-        return false;
-    }
-    else if (si->isAddressBss(addr)) {
+    if (!data) {
         return false;
     }
 
-    HostAddress host = si->getHostAddr() - si->getSourceAddr() + addr;
-    value = Util::readQWord(reinterpret_cast<const Byte *>(host.value()), si->getEndian());
+    value = Util::readQWord(data, si->getEndian());
     return true;
 }
 
@@ -145,18 +122,8 @@ bool BinaryImage::readNativeAddr8(Address addr, Address &value) const
 
 bool BinaryImage::readNativeFloat4(Address addr, float &value) const
 {
-    const BinarySection *sect = getSectionByAddr(addr);
-    DWord raw                 = 0;
-
-    if (sect == nullptr || sect->getHostAddr() == HostAddress::INVALID) {
-        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr.toString());
-        return false;
-    }
-    else if (addr + 4 > sect->getSourceAddr() + sect->getSize()) {
-        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
-        return false;
-    }
-    else if (!readNative4(addr, raw)) {
+    DWord raw = 0;
+    if (!readNative4(addr, raw)) {
         return false;
     }
 
@@ -167,18 +134,8 @@ bool BinaryImage::readNativeFloat4(Address addr, float &value) const
 
 bool BinaryImage::readNativeFloat8(Address addr, double &value) const
 {
-    const BinarySection *sect = getSectionByAddr(addr);
-    QWord raw                 = 0;
-
-    if (sect == nullptr || sect->getHostAddr() == HostAddress::INVALID) {
-        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr.toString());
-        return false;
-    }
-    else if (addr + 8 > sect->getSourceAddr() + sect->getSize()) {
-        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
-        return false;
-    }
-    else if (!readNative8(addr, raw)) {
+    QWord raw = 0;
+    if (!readNative8(addr, raw)) {
         return false;
     }
 
@@ -187,6 +144,19 @@ bool BinaryImage::readNativeFloat8(Address addr, double &value) const
 }
 
 
+QByteArray BinaryImage::readSpan(Address addr, std::size_t len) const
+{
+    const BinarySection *section = nullptr;
+    const Byte *data             = getReadPtr(addr, len, section, true);
+
+    if (!data) {
+        return QByteArray();
+    }
+
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(data), len);
+}
+
+
 bool BinaryImage::writeNative4(Address addr, uint32_t value)
 {
     BinarySection *si = getSectionByAddr(addr);
@@ -201,6 +171,7 @@ bool BinaryImage::writeNative4(Address addr, uint32_t value)
     }
 
     si->addDefinedArea(addr, addr + 4);
+    invalidatePages(addr, addr + 4);
 
     HostAddress host = si->getHostAddr() - si->getSourceAddr() + addr;
     Util::writeDWord(reinterpret_cast<void *>(host.value()), value, si->getEndian());
@@ -208,6 +179,152 @@ bool BinaryImage::writeNative4(Address addr, uint32_t value)
 }
 
 
+const Byte *BinaryImage::getReadPtr(Address addr, std::size_t size, const BinarySection *&section,
+                                    bool checkBss) const
+{
+    const PageEntry *page = findPage(addr);
+
+    if (page) {
+        section = page->section;
+
+        // Reads may cross into the next page, but not past the end of the section
+        if (addr + size <= section->getSourceAddr() + section->getSize()) {
+            if (checkBss && page->bss) {
+                return nullptr;
+            }
+
+            return reinterpret_cast<const Byte *>(
+                (section->getHostAddr() - section->getSourceAddr() + addr).value());
+        }
+    }
+    else {
+        section = getSectionByAddr(addr);
+    }
+
+    if (section == nullptr || section->getHostAddr() == HostAddress::INVALID) {
+        LOG_WARN("Invalid read at address %1: Address is not mapped to a section", addr);
+        return nullptr;
+    }
+    else if (addr + size > section->getSourceAddr() + section->getSize()) {
+        LOG_WARN("Invalid read at address %1: Read extends past section boundary", addr);
+        return nullptr;
+    }
+    else if (checkBss && section->isAddressBss(addr)) {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const Byte *>(
+        (section->getHostAddr() - section->getSourceAddr() + addr).value());
+}
+
+
+void BinaryImage::updatePageTable()
+{
+    m_pageTable.clear();
+    m_pageTableBase = Address::ZERO;
+
+    Address low  = Address::INVALID;
+    Address high = Address::INVALID;
+
+    for (const BinarySection *section : m_sections) {
+        if (section->getHostAddr() == HostAddress::INVALID) {
+            continue;
+        }
+
+        const Address sectEnd = section->getSourceAddr() + section->getSize();
+
+        if (low == Address::INVALID || section->getSourceAddr() < low) {
+            low = section->getSourceAddr();
+        }
+
+        if (high == Address::INVALID || sectEnd > high) {
+            high = sectEnd;
+        }
+    }
+
+    if (low == Address::INVALID) {
+        return;
+    }
+
+    const Address::value_type pageSize = Address::value_type(1) << PAGE_BITS;
+    const Address::value_type numPages = ((high - low).value() + pageSize - 1) >> PAGE_BITS;
+
+    // Do not waste memory on images with huge holes between the sections
+    // (e.g. 64 bit binaries mapped to distant addresses). 1 GiB of address space
+    // needs 256K entries.
+    if (numPages > (Address::value_type(1) << (30 - PAGE_BITS))) {
+        LOG_VERBOSE("Not building page table: Sections span %1 pages", QString::number(numPages));
+        return;
+    }
+
+    m_pageTableBase = Address(low.value() & ~(pageSize - 1));
+    m_pageTable.resize(((high - m_pageTableBase).value() + pageSize - 1) >> PAGE_BITS);
+
+    // Count the sections overlapping each page. Only pages overlapped by a single section
+    // can be translated without looking at the section map (cf. .tbss overlapping
+    // other sections).
+    std::vector<Byte> numSections(m_pageTable.size(), 0);
+
+    for (const BinarySection *section : m_sections) {
+        if (section->getHostAddr() == HostAddress::INVALID || section->getSize() <= 0) {
+            continue;
+        }
+
+        const Address::value_type from = (section->getSourceAddr() - m_pageTableBase).value();
+        const Address::value_type to   = from + section->getSize();
+
+        for (Address::value_type page = from >> PAGE_BITS; page <= (to - 1) >> PAGE_BITS;
+             page++) {
+            numSections[page] = std::min(numSections[page] + 1, 2);
+        }
+    }
+
+    for (BinarySection *section : m_sections) {
+        if (section->getHostAddr() == HostAddress::INVALID) {
+            continue;
+        }
+
+        // only pages that are completely inside the section
+        const Address::value_type from = (section->getSourceAddr() - m_pageTableBase).value();
+        const Address::value_type to   = from + section->getSize();
+
+        for (Address::value_type page = (from + pageSize - 1) >> PAGE_BITS;
+             page < (to >> PAGE_BITS); page++) {
+            if (numSections[page] != 1) {
+                continue;
+            }
+
+            const Address pageStart = m_pageTableBase + (page << PAGE_BITS);
+            const Address pageEnd   = pageStart + pageSize;
+
+            if (section->isRangeDefined(pageStart, pageEnd)) {
+                m_pageTable[page] = { section, false };
+            }
+            else if (section->isAddressBss(pageStart) && !section->anyDefinedValues()) {
+                m_pageTable[page] = { section, true };
+            }
+            // else: partially defined; use the slow path
+        }
+    }
+}
+
+
+void BinaryImage::invalidatePages(Address from, Address to)
+{
+    if (m_pageTable.empty() || to <= m_pageTableBase) {
+        return;
+    }
+
+    const Address::value_type first = (std::max(from, m_pageTableBase) - m_pageTableBase).value() >>
+                                      PAGE_BITS;
+    const Address::value_type last = ((to - 1) - m_pageTableBase).value() >> PAGE_BITS;
+
+    for (Address::value_type page = first; page <= last && page < m_pageTable.size(); page++) {
+        m_pageTable[page] = PageEntry();
+    }
+}
+
+
 void BinaryImage::updateTextLimits()
 {
     m_limitTextLow  = Address::INVALID;
@@ -256,11 +373,13 @@ bool BinaryImage::isReadOnly(Address addr) const
         return false;
     }
 
-    if (section->isReadOnly()) {
-        return true;
-    }
+    return section->hasFlag(SectionFlag::ReadOnly, addr);
+}
+
 
-    return section->isAttributeInRange("ReadOnly", addr, addr + 1);
+void BinaryImage::updateStringIndex(bool withWideStrings)
+{
+    m_stringIndex.build(*this, withWideStrings);
 }
 
 
@@ -298,6 +417,9 @@ BinarySection *BinaryImage::createSection(const QString &name, Address from, Add
         to += 1; // open interval, so -> [from,to+1) is right
     }
 
+    // the page table is stale now
+    m_pageTable.clear();
+
 #if DEBUG
     // see
     // https://stackoverflow.com/questions/25501044/gcc-ld-overlapping-sections-tbss-init-array-in-statically-linked-elf-bin
@@ -379,6 +501,11 @@ const BinarySection *BinaryImage::getSectionByName(const QString &sectionName) c
 
 BinarySection *BinaryImage::getSectionByAddr(Address addr)
 {
+    const PageEntry *page = findPage(addr);
+    if (page) {
+        return page->section;
+    }
+
     auto iter = m_sectionMap.find(addr);
     return (iter != m_sectionMap.end()) ? iter->second.get() : nullptr;
 }
@@ -386,6 +513,11 @@ BinarySection *BinaryImage::getSectionByAddr(Address addr)
 
 const BinarySection *BinaryImage::getSectionByAddr(Address addr) const
 {
+    const PageEntry *page = findPage(addr);
+    if (page) {
+        return page->section;
+    }
+
     auto iter = m_sectionMap.find(addr);
     return (iter != m_sectionMap.end()) ? iter->second.get() : nullptr;
 }
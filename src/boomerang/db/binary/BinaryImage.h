@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include "boomerang/db/binary/BinaryStringIndex.h"
 #include "boomerang/util/Address.h"
 #include "boomerang/util/IntervalMap.h"
 
@@ -115,11 +116,56 @@ public:
     bool readNativeFloat4(Address addr, float &value) const;
     bool readNativeFloat8(Address addr, double &value) const;
 
+    /// \returns a view of the \p len bytes at \p addr without copying them,
+    /// or an empty array if the bytes are not all mapped to the same section.
+    /// The view is only valid as long as this image is not reset.
+    QByteArray readSpan(Address addr, std::size_t len) const;
+
     bool writeNative4(Address addr, DWord value);
 
     /// \returns true if \p addr is in a read-only section
     bool isReadOnly(Address addr) const;
 
+    /// Scan all sections for string literals. Must be called after all sections were loaded.
+    /// \param withWideStrings also index UTF-16 strings (e.g. for PE files)
+    void updateStringIndex(bool withWideStrings);
+
+    const BinaryStringIndex &getStringIndex() const { return m_stringIndex; }
+
+    /// Build the page table that translates addresses to sections for reads.
+    /// Must be called again after sections or their BSS areas were changed;
+    /// until then, lookups fall back to the slower section map.
+    void updatePageTable();
+
+private:
+    /// An entry of the page table. Only pages that lie completely inside a single
+    /// mapped section have an entry; all other pages take the slow path.
+    struct PageEntry
+    {
+        BinarySection *section = nullptr;
+        bool bss               = false; ///< Set if no address of this page has a defined value
+    };
+
+    /// \returns the page table entry of \p addr, or nullptr if there is none.
+    const PageEntry *findPage(Address addr) const
+    {
+        const Address::value_type page = (addr - m_pageTableBase).value() >> PAGE_BITS;
+        if (addr < m_pageTableBase || page >= m_pageTable.size()) {
+            return nullptr;
+        }
+
+        return m_pageTable[page].section ? &m_pageTable[page] : nullptr;
+    }
+
+    /// \returns a pointer to the host data of the \p size bytes at \p addr,
+    /// or nullptr if they cannot be read.
+    /// \param section set to the section containing \p addr
+    /// \param checkBss fail if \p addr does not have a defined value
+    const Byte *getReadPtr(Address addr, std::size_t size, const BinarySection *&section,
+                           bool checkBss) const;
+
+    void invalidatePages(Address from, Address to);
+
 private:
     QByteArray m_rawData;
     Address m_limitTextLow  = Address::INVALID;
@@ -128,4 +174,9 @@ private:
 
     SectionList m_sections; ///< The section info
     IntervalMap<Address, std::unique_ptr<BinarySection>> m_sectionMap;
+    BinaryStringIndex m_stringIndex;
+
+    static constexpr int PAGE_BITS = 12;
+    Address m_pageTableBase        = Address::ZERO;
+    std::vector<PageEntry> m_pageTable;
 };
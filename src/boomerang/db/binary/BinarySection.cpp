@@ -16,6 +16,10 @@
 
 #include <QVariantMap>
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 
 struct VariantHolder
 {
@@ -30,6 +34,54 @@ struct VariantHolder
     bool operator==(const VariantHolder &other) const { return val == other.val; }
 };
 
+/// Sorted list of disjoint, non-adjacent right-open address ranges.
+class RangeList
+{
+    typedef std::pair<Address, Address> Range;
+
+public:
+    void insert(Address from, Address to)
+    {
+        if (from >= to) {
+            return;
+        }
+
+        // first range that ends at or after \p from, i.e. that can be merged with [from, to)
+        auto first = std::lower_bound(m_ranges.begin(), m_ranges.end(), from,
+                                      [](const Range &r, Address a) { return r.second < a; });
+        auto last = first;
+
+        while (last != m_ranges.end() && last->first <= to) {
+            from = std::min(from, last->first);
+            to   = std::max(to, last->second);
+            ++last;
+        }
+
+        first = m_ranges.erase(first, last);
+        m_ranges.insert(first, Range(from, to));
+    }
+
+    bool contains(Address addr) const
+    {
+        auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), addr,
+                                   [](Address a, const Range &r) { return a < r.second; });
+        return it != m_ranges.end() && it->first <= addr;
+    }
+
+    bool overlaps(Address from, Address to) const
+    {
+        auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), from,
+                                   [](Address a, const Range &r) { return a < r.second; });
+        return it != m_ranges.end() && it->first < to;
+    }
+
+    bool isEmpty() const { return m_ranges.empty(); }
+
+private:
+    std::vector<Range> m_ranges;
+};
+
+
 class BinarySectionImpl
 {
 public:
@@ -94,8 +146,19 @@ public:
         return res;
     }
 
+    const RangeList &getFlagRanges(SectionFlag flag) const
+    {
+        return m_flagRanges[static_cast<std::size_t>(flag)];
+    }
+
+    RangeList &getFlagRanges(SectionFlag flag)
+    {
+        return m_flagRanges[static_cast<std::size_t>(flag)];
+    }
+
 public:
     IntervalSet<Address> m_hasDefinedValue;
+    std::array<RangeList, static_cast<std::size_t>(SectionFlag::NumFlags)> m_flagRanges;
     IntervalMap<Address, VariantHolder> m_attributeMap;
 };
 
@@ -126,7 +189,7 @@ bool BinarySection::isAddressBss(Address a) const
     if (!Util::inRange(a, m_nativeAddr, m_nativeAddr + m_size)) {
         return false;
     }
-    else if (m_bss) {
+    else if (m_bss || m_impl->getFlagRanges(SectionFlag::Bss).contains(a)) {
         return true;
     }
     else if (m_readOnly) {
@@ -137,6 +200,22 @@ bool BinarySection::isAddressBss(Address a) const
 }
 
 
+bool BinarySection::isRangeDefined(Address from, Address to) const
+{
+    if (from < m_nativeAddr || to > m_nativeAddr + m_size || m_bss) {
+        return false;
+    }
+    else if (m_impl->getFlagRanges(SectionFlag::Bss).overlaps(from, to)) {
+        return false;
+    }
+    else if (m_readOnly) {
+        return true;
+    }
+
+    return m_impl->m_hasDefinedValue.isContained(Interval<Address>(from, to));
+}
+
+
 bool BinarySection::anyDefinedValues() const
 {
     return !m_impl->m_hasDefinedValue.isEmpty();
@@ -170,6 +249,43 @@ void BinarySection::addDefinedArea(Address from, Address to)
 }
 
 
+void BinarySection::setFlagForRange(SectionFlag flag, Address from, Address to)
+{
+    m_impl->getFlagRanges(flag).insert(from, to);
+}
+
+
+bool BinarySection::hasFlag(SectionFlag flag, Address addr) const
+{
+    if (!Util::inRange(addr, m_nativeAddr, m_nativeAddr + m_size)) {
+        return false;
+    }
+
+    return isSectionFlag(flag) || m_impl->getFlagRanges(flag).contains(addr);
+}
+
+
+bool BinarySection::isFlagInRange(SectionFlag flag, Address from, Address to) const
+{
+    if (to <= m_nativeAddr || from >= m_nativeAddr + m_size) {
+        return false;
+    }
+
+    return isSectionFlag(flag) || m_impl->getFlagRanges(flag).overlaps(from, to);
+}
+
+
+bool BinarySection::isSectionFlag(SectionFlag flag) const
+{
+    switch (flag) {
+    case SectionFlag::Bss: return m_bss;
+    case SectionFlag::ReadOnly: return m_readOnly;
+    case SectionFlag::Code: return m_code;
+    default: return false;
+    }
+}
+
+
 void BinarySection::setAttributeForRange(const QString &name, const QVariant &val, Address from,
                                          Address to)
 {
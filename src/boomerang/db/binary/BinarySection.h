@@ -21,6 +21,23 @@
 class QVariant;
 
 
+/**
+ * Well-known attributes of address ranges in a section.
+ * Unlike the generic QVariant attributes, these are stored as compact sorted range lists
+ * and can be queried without allocating.
+ */
+enum class SectionFlag : uint8_t
+{
+    Bss,         ///< Range has no initialized contents
+    Strings,     ///< Range contains string literals (e.g. ELF string tables)
+    ReadOnly,    ///< Range is not writable at run time
+    Code,        ///< Range contains instructions
+    Relocated,   ///< Range was patched by a relocation while loading
+    ImportThunk, ///< Range contains import stubs or the import address table
+    NumFlags
+};
+
+
 /// File-format independent access to sections of binary files.
 class BOOMERANG_API BinarySection
 {
@@ -61,14 +78,32 @@ public:
     /// the behaviour of (at least) the question "Is this address in BSS".
     bool isAddressBss(Address addr) const;
 
+    /// \returns true if no address in [from, to) is in BSS, i.e. all of them have defined values.
+    bool isRangeDefined(Address from, Address to) const;
+
     bool anyDefinedValues() const;
     void clearDefinedArea();
     void addDefinedArea(Address from, Address to);
 
+    /// Set \p flag for all addresses in [from, to)
+    void setFlagForRange(SectionFlag flag, Address from, Address to);
+
+    /// \returns true if \p flag is set for \p addr, either for the whole section
+    /// (for Bss, ReadOnly and Code) or for a range containing \p addr.
+    bool hasFlag(SectionFlag flag, Address addr) const;
+
+    /// \returns true if \p flag is set for any address in [from, to)
+    bool isFlagInRange(SectionFlag flag, Address from, Address to) const;
+
+    /// Generic attributes. Prefer the typed flags above for well-known attributes.
     void setAttributeForRange(const QString &name, const QVariant &val, Address from, Address to);
     QVariantMap getAttributesForRange(Address from, Address to);
     bool isAttributeInRange(const QString &attrib, Address from, Address to) const;
 
+private:
+    /// \returns true if \p flag is set for the whole section
+    bool isSectionFlag(SectionFlag flag) const;
+
 private:
     class BinarySectionImpl *m_impl;
 
@@ -0,0 +1,273 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BinaryStringIndex.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+
+namespace
+{
+enum CharClass : uint8_t
+{
+    CC_Terminator = 0, ///< NUL
+    CC_Printable  = 1, ///< printable ASCII or whitespace
+    CC_Extended   = 2, ///< 0x80..0xFF (Latin-1 or UTF-8)
+    CC_Control    = 3  ///< other control characters
+};
+
+
+std::array<CharClass, 256> makeCharClassTable()
+{
+    std::array<CharClass, 256> table;
+
+    for (int c = 0; c < 256; c++) {
+        if (c == 0) {
+            table[c] = CC_Terminator;
+        }
+        else if ((c >= 0x20 && c < 0x7F) || (c >= '\t' && c <= '\r')) {
+            table[c] = CC_Printable;
+        }
+        else if (c >= 0x80) {
+            table[c] = CC_Extended;
+        }
+        else {
+            table[c] = CC_Control;
+        }
+    }
+
+    return table;
+}
+
+
+const std::array<CharClass, 256> g_charClass = makeCharClassTable();
+
+/// Code sections contain many short printable runs by accident,
+/// so only longer strings are indexed there.
+const uint32_t MIN_ASCII_LENGTH_CODE = 4;
+const uint32_t MIN_WIDE_LENGTH       = 3;
+
+/// Outside of code sections, strings may contain one control character
+/// (e.g. ESC of terminal escape sequences) per this many characters.
+const std::size_t CONTROL_CHAR_RATIO = 6;
+
+
+bool isStringsSection(const BinarySection *section, Address addr)
+{
+    return (section->isReadOnly() && !section->isCode()) ||
+           section->hasFlag(SectionFlag::Strings, addr);
+}
+}
+
+
+void BinaryStringIndex::build(const BinaryImage &image, bool withWideStrings)
+{
+    clear();
+
+    for (const BinarySection *section : image) {
+        if (section->getHostAddr() == HostAddress::INVALID || section->getSize() <= 0) {
+            continue;
+        }
+
+        scanAscii(section);
+
+        if (withWideStrings && !section->isCode()) {
+            scanWide(section);
+        }
+    }
+
+    // Sections are not necessarily sorted by address
+    auto byAddr = [](const Entry &a, const Entry &b) { return a.addr < b.addr; };
+    std::sort(m_asciiStrings.begin(), m_asciiStrings.end(), byAddr);
+    std::sort(m_wideStrings.begin(), m_wideStrings.end(), byAddr);
+    std::sort(m_emptyStrings.begin(), m_emptyStrings.end());
+
+    LOG_VERBOSE("Indexed %1 ASCII and %2 UTF-16 strings", m_asciiStrings.size(),
+                m_wideStrings.size());
+}
+
+
+void BinaryStringIndex::clear()
+{
+    m_asciiStrings.clear();
+    m_wideStrings.clear();
+    m_emptyStrings.clear();
+}
+
+
+const BinaryStringIndex::Entry *BinaryStringIndex::find(Address addr, StringEncoding enc) const
+{
+    const std::vector<Entry> &entries = getEntries(enc);
+
+    // find the last string starting at or before addr
+    auto it = std::upper_bound(entries.begin(), entries.end(), addr,
+                               [](Address a, const Entry &e) { return a < e.addr; });
+
+    if (it == entries.begin()) {
+        return nullptr;
+    }
+
+    --it;
+
+    // The terminator is part of the string, so a pointer to it is a pointer to ""
+    if (addr < it->addr + it->getByteSize()) {
+        return &*it;
+    }
+
+    return nullptr;
+}
+
+
+bool BinaryStringIndex::isEmptyString(Address addr) const
+{
+    auto it = std::upper_bound(
+        m_emptyStrings.begin(), m_emptyStrings.end(), addr,
+        [](Address a, const std::pair<Address, Address> &range) { return a < range.first; });
+
+    return it != m_emptyStrings.begin() && addr < std::prev(it)->second;
+}
+
+
+int BinaryStringIndex::getNumStrings(StringEncoding enc) const
+{
+    return getEntries(enc).size();
+}
+
+
+void BinaryStringIndex::scanAscii(const BinarySection *section)
+{
+    const char *data      = reinterpret_cast<const char *>(section->getHostAddr().value());
+    const std::size_t len = section->getSize();
+    const Address from    = section->getSourceAddr();
+
+    // Every NUL in a string table (e.g. .dynstr) terminates a string, even an empty one.
+    std::size_t minLen = 1;
+    if (section->hasFlag(SectionFlag::Strings, from)) {
+        minLen = 0;
+    }
+    else if (section->isCode()) {
+        minLen = MIN_ASCII_LENGTH_CODE;
+    }
+
+    const bool allowControl = !section->isCode();
+
+    // Only accept mostly-ASCII runs with few control characters
+    auto isString = [minLen](std::size_t length, std::size_t numExtended, std::size_t numControl) {
+        return length >= minLen && 2 * numExtended <= length &&
+               CONTROL_CHAR_RATIO * numControl <= length + CONTROL_CHAR_RATIO - 1;
+    };
+
+    std::size_t i = 0;
+    while (i < len) {
+        if (data[i] == 0 && minLen > 0) {
+            // Runs of NUL bytes are empty strings, unless they are part of instructions
+            const std::size_t start = i;
+            while (i < len && data[i] == 0) {
+                i++;
+            }
+
+            const Address addr = from + start;
+            if (!section->isCode() && !section->isAddressBss(addr)) {
+                m_emptyStrings.push_back({ addr, from + i });
+            }
+
+            continue;
+        }
+        else if (g_charClass[static_cast<Byte>(data[i])] == CC_Control) {
+            i++; // strings do not start with control characters
+            continue;
+        }
+
+        const std::size_t start = i;
+        std::size_t tail        = i; // first character after the last control character
+        std::size_t numExtended = 0;
+        std::size_t numTailExt  = 0;
+        std::size_t numControl  = 0;
+
+        CharClass cls;
+        while (i < len && (cls = g_charClass[static_cast<Byte>(data[i])]) != CC_Terminator) {
+            if (cls == CC_Control) {
+                if (!allowControl) {
+                    break;
+                }
+
+                numControl++;
+                numTailExt = 0;
+                tail       = i + 1;
+            }
+            else if (cls == CC_Extended) {
+                numExtended++;
+                numTailExt++;
+            }
+
+            i++;
+        }
+
+        if (i < len && data[i] == 0) {
+            if (isString(i - start, numExtended, numControl)) {
+                addAscii(section, start, i - start);
+            }
+            else if (tail > start && isString(i - tail, numTailExt, 0)) {
+                // Too many control characters, but the end of the run is a string
+                addAscii(section, tail, i - tail);
+            }
+        }
+
+        i++; // skip terminator or control character
+    }
+}
+
+
+void BinaryStringIndex::addAscii(const BinarySection *section, std::size_t offset,
+                                 std::size_t length)
+{
+    const char *data   = reinterpret_cast<const char *>(section->getHostAddr().value());
+    const Address addr = section->getSourceAddr() + offset;
+
+    if (!section->isAddressBss(addr)) {
+        m_asciiStrings.push_back({ addr, data + offset, static_cast<uint32_t>(length),
+                                   StringEncoding::ASCII, isStringsSection(section, addr) });
+    }
+}
+
+
+void BinaryStringIndex::scanWide(const BinarySection *section)
+{
+    const char *data      = reinterpret_cast<const char *>(section->getHostAddr().value());
+    const std::size_t len = section->getSize() & ~std::size_t(1);
+
+    std::size_t i = 0;
+    while (i < len) {
+        const std::size_t start = i;
+
+        while (i < len && data[i + 1] == 0 &&
+               g_charClass[static_cast<Byte>(data[i])] == CC_Printable) {
+            i += 2;
+        }
+
+        const uint32_t length = static_cast<uint32_t>((i - start) / 2);
+
+        if (i < len && data[i] == 0 && data[i + 1] == 0 && length >= MIN_WIDE_LENGTH) {
+            const Address addr = section->getSourceAddr() + start;
+
+            if (!section->isAddressBss(addr)) {
+                m_wideStrings.push_back({ addr, data + start, length, StringEncoding::UTF16LE,
+                                          isStringsSection(section, addr) });
+            }
+        }
+
+        i += 2;
+    }
+}
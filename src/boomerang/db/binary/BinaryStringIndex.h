@@ -0,0 +1,96 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/Address.h"
+
+#include <vector>
+
+
+class BinaryImage;
+class BinarySection;
+
+
+enum class StringEncoding : uint8_t
+{
+    ASCII,  ///< NUL terminated 8 bit characters
+    UTF16LE ///< NUL terminated 16 bit little endian characters
+};
+
+
+/**
+ * Index of all string literals in the sections of a BinaryImage.
+ *
+ * The sections are scanned once for NUL terminated runs of printable characters
+ * (and optionally for UTF-16 runs, which are common in PE files).
+ * The runs are stored as sorted, non-overlapping intervals per encoding,
+ * so finding the string containing an address is a binary search.
+ * Outside of code sections, runs of NUL bytes are recorded as empty strings,
+ * so the index is complete: An address that is not in the index is not a string.
+ */
+class BOOMERANG_API BinaryStringIndex
+{
+public:
+    struct Entry
+    {
+        Address addr;            ///< Address of the first character
+        const char *data;        ///< Host pointer to the first character
+        uint32_t length;         ///< Number of characters, excluding the terminator
+        StringEncoding encoding; ///< Encoding of the characters
+        bool inStringsSection;   ///< Set if the string is in a read-only or strings section
+
+        /// \returns the number of bytes of the string, including the terminator
+        uint32_t getByteSize() const
+        {
+            return (length + 1) * (encoding == StringEncoding::UTF16LE ? 2 : 1);
+        }
+    };
+
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+public:
+    /// Scan all sections of \p image for strings, discarding any previous contents.
+    /// UTF-16 strings are only scanned for if \p withWideStrings is set.
+    void build(const BinaryImage &image, bool withWideStrings);
+
+    void clear();
+
+    /// \returns the string of encoding \p enc containing \p addr, or nullptr if there is none.
+    const Entry *find(Address addr, StringEncoding enc = StringEncoding::ASCII) const;
+
+    /// \returns true if \p addr points to a run of NUL bytes outside of code sections
+    /// that does not terminate an indexed string.
+    bool isEmptyString(Address addr) const;
+
+    /// \returns the number of strings of encoding \p enc
+    int getNumStrings(StringEncoding enc) const;
+
+    /// Iterate over all strings of encoding \p enc, sorted by address.
+    const_iterator begin(StringEncoding enc) const { return getEntries(enc).begin(); }
+    const_iterator end(StringEncoding enc) const { return getEntries(enc).end(); }
+
+private:
+    void scanAscii(const BinarySection *section);
+    void addAscii(const BinarySection *section, std::size_t offset, std::size_t length);
+    void scanWide(const BinarySection *section);
+
+    const std::vector<Entry> &getEntries(StringEncoding enc) const
+    {
+        return enc == StringEncoding::UTF16LE ? m_wideStrings : m_asciiStrings;
+    }
+
+private:
+    std::vector<Entry> m_asciiStrings;
+    std::vector<Entry> m_wideStrings;
+
+    /// Sorted, non-overlapping [begin; end) intervals of NUL bytes
+    std::vector<std::pair<Address, Address>> m_emptyStrings;
+};
@@ -12,7 +12,9 @@
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 
 
 BinarySymbolTable::BinarySymbolTable()
@@ -29,64 +31,90 @@ BinarySymbolTable::~BinarySymbolTable()
 void BinarySymbolTable::clear()
 {
     m_addrIndex.clear();
-    m_symbolList.clear();
     m_nameIndex.clear();
+    m_appended.clear();
+    m_symbolList.clear();
+    m_pool.clear();
+}
+
+
+void BinarySymbolTable::reserve(int n)
+{
+    m_addrIndex.reserve(m_addrIndex.size() + n);
+    m_nameIndex.reserve(m_nameIndex.size() + n);
+    m_appended.reserve(m_appended.size() + n);
+    m_symbolList.reserve(m_symbolList.size() + n);
 }
 
 
 BinarySymbol *BinarySymbolTable::createSymbol(Address addr, const QString &name, bool local)
 {
-    if (m_addrIndex.find(addr) != m_addrIndex.end()) {
+    updateIndex();
+
+    auto addrIt = lowerBound(addr);
+    if (addrIt != m_addrIndex.end() && addrIt->first == addr) {
         return nullptr; // symbol already exists
     }
 
     // If the symbol already exists, redirect the new symbol to the old one.
-    std::map<QString, std::shared_ptr<BinarySymbol>>::iterator it = m_nameIndex.find(name);
+    auto nameIt = m_nameIndex.find(name);
 
-    if (it != m_nameIndex.end()) {
+    if (nameIt != m_nameIndex.end()) {
         LOG_WARN("Symbol '%1' already exists in the global symbol table!", name);
-        std::shared_ptr<BinarySymbol> existingSymbol = it->second;
-        m_addrIndex[addr]                            = existingSymbol;
-        return existingSymbol.get();
+        m_addrIndex.insert(addrIt, { addr, nameIt.value() });
+        return nameIt.value();
     }
 
-    std::shared_ptr<BinarySymbol> sym = std::make_shared<BinarySymbol>(addr, name);
-    m_addrIndex[addr]                 = sym;
+    m_pool.emplace_back(addr, name);
+    BinarySymbol *sym = &m_pool.back();
+    m_addrIndex.insert(addrIt, { addr, sym });
 
     if (!local) {
-        m_nameIndex[name] = sym;
+        m_nameIndex.insert(sym->getName(), sym);
     }
 
-    m_symbolList.push_back(sym.get());
-    return sym.get();
+    m_symbolList.push_back(sym);
+    return sym;
+}
+
+
+BinarySymbol *BinarySymbolTable::appendSymbol(Address addr, const QString &name, bool local)
+{
+    m_pool.emplace_back(addr, name);
+    m_appended.push_back({ &m_pool.back(), local });
+    return &m_pool.back();
 }
 
 
 BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr)
 {
-    auto ff = m_addrIndex.find(addr);
-    return (ff != m_addrIndex.end()) ? ff->second.get() : nullptr;
+    updateIndex();
+
+    auto it = lowerBound(addr);
+    return (it != m_addrIndex.end() && it->first == addr) ? it->second : nullptr;
 }
 
 
 const BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr) const
 {
-    auto ff = m_addrIndex.find(addr);
-    return (ff != m_addrIndex.end()) ? ff->second.get() : nullptr;
+    updateIndex();
+
+    auto it = lowerBound(addr);
+    return (it != m_addrIndex.end() && it->first == addr) ? it->second : nullptr;
 }
 
 
 BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name)
 {
-    auto ff = m_nameIndex.find(name);
-    return (ff != m_nameIndex.end()) ? ff->second.get() : nullptr;
+    updateIndex();
+    return m_nameIndex.value(name, nullptr);
 }
 
 
 const BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name) const
 {
-    auto ff = m_nameIndex.find(name);
-    return (ff != m_nameIndex.end()) ? ff->second.get() : nullptr;
+    updateIndex();
+    return m_nameIndex.value(name, nullptr);
 }
 
 
@@ -96,24 +124,124 @@ bool BinarySymbolTable::renameSymbol(const QString &oldName, const QString &newN
         return true;
     }
 
+    updateIndex();
+
     auto oldIt = m_nameIndex.find(oldName);
-    auto newIt = m_nameIndex.find(newName);
 
     if (oldIt == m_nameIndex.end()) { // symbol not found
         LOG_ERROR("Could not rename symbol '%1' to '%2': A symbol with name '%1' was not found.",
                   oldName, newName);
         return false;
     }
-    else if (newIt != m_nameIndex.end()) { // symbol name clash
+    else if (m_nameIndex.contains(newName)) { // symbol name clash
         LOG_ERROR("Could not rename symbol '%1' to '%2': A symbol with name '%2' already exists",
                   oldName, newName);
         return false;
     }
 
-    std::shared_ptr<BinarySymbol> oldSymbol = oldIt->second;
+    BinarySymbol *oldSymbol = oldIt.value();
     m_nameIndex.erase(oldIt);
-    oldSymbol->m_name    = newName;
-    m_nameIndex[newName] = oldSymbol;
+    oldSymbol->m_name = newName;
+    m_nameIndex.insert(oldSymbol->m_name, oldSymbol);
 
     return true;
 }
+
+
+void BinarySymbolTable::indexAppendedSymbols() const
+{
+    std::vector<std::pair<BinarySymbol *, bool>> appended;
+    std::swap(appended, m_appended);
+
+    // Only the first symbol appended at an address is kept, like for createSymbol.
+    // The sort is stable, so the first symbol of a run of equal addresses is the oldest one.
+    std::vector<std::size_t> byAddr(appended.size());
+    std::iota(byAddr.begin(), byAddr.end(), 0);
+    std::stable_sort(byAddr.begin(), byAddr.end(), [&appended](std::size_t a, std::size_t b) {
+        return appended[a].first->getLocation() < appended[b].first->getLocation();
+    });
+
+    std::vector<bool> accepted(appended.size(), false);
+
+    BinarySymbol *kept = nullptr; // symbol kept at the current address
+    for (std::size_t i = 0; i < byAddr.size(); i++) {
+        BinarySymbol *sym  = appended[byAddr[i]].first;
+        const Address addr = sym->getLocation();
+
+        if (i > 0 && appended[byAddr[i - 1]].first->getLocation() == addr) {
+            mergeSymbol(kept, sym);
+            continue;
+        }
+
+        auto it = lowerBound(addr);
+        if (it == m_addrIndex.end() || it->first != addr) {
+            accepted[byAddr[i]] = true;
+            kept                = sym;
+        }
+        else {
+            kept = it->second;
+            mergeSymbol(kept, sym);
+        }
+    }
+
+    // Name clashes are resolved in order of creation.
+    AddrIndex newEntries;
+    newEntries.reserve(appended.size());
+
+    for (std::size_t i = 0; i < appended.size(); i++) {
+        if (!accepted[i]) {
+            continue;
+        }
+
+        BinarySymbol *sym = appended[i].first;
+        auto nameIt       = m_nameIndex.find(sym->getName());
+
+        if (nameIt != m_nameIndex.end()) {
+            LOG_WARN("Symbol '%1' already exists in the global symbol table!", sym->getName());
+            newEntries.push_back({ sym->getLocation(), nameIt.value() });
+            mergeSymbol(nameIt.value(), sym);
+            continue;
+        }
+
+        newEntries.push_back({ sym->getLocation(), sym });
+
+        if (!appended[i].second) {
+            m_nameIndex.insert(sym->getName(), sym);
+        }
+
+        m_symbolList.push_back(sym);
+    }
+
+    auto byEntryAddr = [](const AddrEntry &a, const AddrEntry &b) { return a.first < b.first; };
+    std::sort(newEntries.begin(), newEntries.end(), byEntryAddr);
+
+    const std::size_t numOld = m_addrIndex.size();
+    m_addrIndex.insert(m_addrIndex.end(), newEntries.begin(), newEntries.end());
+    std::inplace_merge(m_addrIndex.begin(), m_addrIndex.begin() + numOld, m_addrIndex.end(),
+                       byEntryAddr);
+}
+
+
+void BinarySymbolTable::mergeSymbol(BinarySymbol *into, const BinarySymbol *from)
+{
+    if (into == from) {
+        return;
+    }
+
+    if (into->m_size == 0) {
+        into->m_size = from->m_size;
+    }
+
+    for (auto it = from->m_attributes.begin(); it != from->m_attributes.end(); ++it) {
+        if (!into->m_attributes.contains(it.key())) {
+            into->m_attributes.insert(it.key(), it.value());
+        }
+    }
+}
+
+
+BinarySymbolTable::AddrIndex::iterator BinarySymbolTable::lowerBound(Address addr) const
+{
+    return std::lower_bound(m_addrIndex.begin(), m_addrIndex.end(), addr,
+                            [](const AddrEntry &e, Address a) { return e.first < a; });
+}
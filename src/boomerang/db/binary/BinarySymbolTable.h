@@ -10,24 +10,27 @@
 #pragma once
 
 
+#include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/util/Address.h"
 
-#include <map>
-#include <memory>
-#include <vector>
-
+#include <QHash>
+#include <QString>
 
-class BinarySymbol;
+#include <deque>
+#include <vector>
 
 
 /**
- * A simple class to implement a symbol table than can be looked up by address or by name.
+ * A symbol table that can be looked up by address or by name.
+ *
+ * Symbols are stored in a single pool and never move, so pointers to them stay valid
+ * until the table is cleared. Symbol names are stored once; the name index shares them
+ * (QString is implicitly shared). The address index is a sorted vector,
+ * the name index is a hash table.
  *
- * \note Can't readily use operator[] overloaded for address and string parameters.
- * The main problem is that when you do symtab[0x100] = "main", the string map
- * doesn't see the string. If you have one of the maps be a pointer to the other string
- * and use a special comparison operator, then if the strings are ever changed,
- * then the map's internal rb-tree becomes invalid.
+ * Loaders adding many symbols should use appendSymbol, which defers all duplicate checks
+ * and indexing until the table is accessed next; the appended symbols are then indexed
+ * with a single sort. createSymbol inserts a single symbol into the indexes immediately.
  */
 class BOOMERANG_API BinarySymbolTable
 {
@@ -49,24 +52,45 @@ public:
     BinarySymbolTable &operator=(BinarySymbolTable &&other) = default;
 
 public:
-    iterator begin() { return m_symbolList.begin(); }
-    iterator end() { return m_symbolList.end(); }
-    const_iterator begin() const { return m_symbolList.begin(); }
-    const_iterator end() const { return m_symbolList.end(); }
+    iterator begin() { updateIndex(); return m_symbolList.begin(); }
+    iterator end() { updateIndex(); return m_symbolList.end(); }
+    const_iterator begin() const { updateIndex(); return m_symbolList.begin(); }
+    const_iterator end() const { updateIndex(); return m_symbolList.end(); }
 
-    reverse_iterator rbegin() { return m_symbolList.rbegin(); }
-    reverse_iterator rend() { return m_symbolList.rend(); }
-    const_reverse_iterator rbegin() const { return m_symbolList.rbegin(); }
-    const_reverse_iterator rend() const { return m_symbolList.rend(); }
+    reverse_iterator rbegin() { updateIndex(); return m_symbolList.rbegin(); }
+    reverse_iterator rend() { updateIndex(); return m_symbolList.rend(); }
+    const_reverse_iterator rbegin() const { updateIndex(); return m_symbolList.rbegin(); }
+    const_reverse_iterator rend() const { updateIndex(); return m_symbolList.rend(); }
 
 public:
-    int size() const { return m_symbolList.size(); }
-    bool empty() const { return m_symbolList.empty(); }
+    int size() const
+    {
+        updateIndex();
+        return m_symbolList.size();
+    }
+
+    bool empty() const { return size() == 0; }
     void clear();
 
+    /// Reserve memory for \p n additional symbols.
+    void reserve(int n);
+
     /// Creates a symbol if it does not exist.
+    /// \returns the new symbol; the existing symbol if a symbol with the same name exists;
+    /// or nullptr if a symbol already exists at \p addr.
     BinarySymbol *createSymbol(Address addr, const QString &name, bool local = false);
 
+    /**
+     * Appends a symbol without checking for existing symbols.
+     * Symbols at addresses that already have a symbol are discarded when the table is
+     * accessed next, and symbols with the name of an existing symbol are redirected
+     * to the existing symbol, like for createSymbol. The size and attributes of discarded
+     * or redirected symbols are merged into the symbol that is kept, so they may be set
+     * on the returned symbol until the table is accessed next.
+     * \returns the new symbol, which may be discarded later.
+     */
+    BinarySymbol *appendSymbol(Address addr, const QString &name, bool local = false);
+
     BinarySymbol *findSymbolByAddress(Address addr);
     const BinarySymbol *findSymbolByAddress(Address addr) const;
 
@@ -76,12 +100,42 @@ public:
     /// \returns true iff the rename was successful
     bool renameSymbol(const QString &oldName, const QString &newName);
 
+    /// Index all symbols added by appendSymbol. Lookups do this on demand,
+    /// so it only needs to be called before the table is read by several threads.
+    void updateIndex() const
+    {
+        if (!m_appended.empty()) {
+            indexAppendedSymbols();
+        }
+    }
+
 private:
-    /// The map indexed by address.
-    std::map<Address, std::shared_ptr<BinarySymbol>> m_addrIndex;
+    typedef std::pair<Address, BinarySymbol *> AddrEntry;
+    typedef std::vector<AddrEntry> AddrIndex;
+
+    void indexAppendedSymbols() const;
+
+    /// Merge the size and attributes of the discarded symbol \p from into \p into.
+    /// Values already set on \p into take precedence.
+    static void mergeSymbol(BinarySymbol *into, const BinarySymbol *from);
+
+    /// \returns the position of the first entry of the address index at or after \p addr
+    AddrIndex::iterator lowerBound(Address addr) const;
+
+private:
+    /// Storage of all symbols. Symbols are never removed from the pool before clear().
+    std::deque<BinarySymbol> m_pool;
+
+    /// Sorted by address.
+    /// Several addresses may map to the same symbol (see createSymbol).
+    mutable AddrIndex m_addrIndex;
+
+    /// Global (non-local) symbols by name.
+    mutable QHash<QString, BinarySymbol *> m_nameIndex;
 
-    /// The map indexed by string. Note that the strings are stored twice.
-    std::map<QString, std::shared_ptr<BinarySymbol>> m_nameIndex;
+    /// Symbols added by appendSymbol which have not been indexed yet, with their local flag.
+    mutable std::vector<std::pair<BinarySymbol *, bool>> m_appended;
 
-    SymbolList m_symbolList;
+    /// All indexed symbols in order of creation
+    mutable SymbolList m_symbolList;
 };
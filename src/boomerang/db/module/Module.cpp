@@ -12,6 +12,7 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
 #include "boomerang/db/proc/LibProc.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
@@ -264,6 +265,25 @@ void Module::addWin32DbgInfo(Function *function)
 }
 
 
+void Module::addDebugInfo(UserProc *proc)
+{
+    const BinaryFile *binaryFile = m_prog->getBinaryFile();
+
+    if (!binaryFile || !m_prog->getProject()->getSettings()->useDebugInfo ||
+        proc->getEntryAddress() == Address::INVALID) {
+        return;
+    }
+
+    // The signature is forced, so parameters and returns are neither added nor removed
+    std::shared_ptr<Signature> sig = binaryFile->getDebugSignature(proc->getEntryAddress());
+
+    if (sig) {
+        sig->setName(proc->getName());
+        proc->setSignature(sig);
+    }
+}
+
+
 Function *Module::createFunction(const QString &name, Address entryAddr, bool libraryFunction)
 {
     Function *function;
@@ -283,8 +303,10 @@ Function *Module::createFunction(const QString &name, Address entryAddr, bool li
     m_functionList.push_back(function); // Append this to list of procs
     m_prog->getProject()->alertFunctionCreated(function);
 
-    // TODO: add platform agnostic way of using debug information, should be moved to Loaders, Prog
-    // should just collect info from Loader
+    if (!libraryFunction) {
+        addDebugInfo(static_cast<UserProc *>(function));
+    }
+
     addWin32DbgInfo(function);
     return function;
 }
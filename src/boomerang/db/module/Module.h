@@ -23,6 +23,7 @@
 class Signature;
 class Function;
 class Prog;
+class UserProc;
 
 
 /**
@@ -113,6 +114,9 @@ public:
     void updateLibrarySignatures();
 
 private:
+    /// Apply the signature of \p proc described by the debug information of the binary file
+    void addDebugInfo(UserProc *proc);
+
     /// Retrieve Win32 PDB debug information for the function \p function
     void addWin32DbgInfo(Function *function);
 
@@ -0,0 +1,35 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcBudget.h"
+
+
+void ProcBudget::setLimits(qint64 timeLimit, qint64 workLimit)
+{
+    m_timeLimit = timeLimit;
+    m_workLimit = workLimit;
+}
+
+
+bool ProcBudget::charge(qint64 time, qint64 work, const QString &passName)
+{
+    m_timeSpent += time;
+    m_workSpent += work;
+
+    if (isExceeded()) {
+        return false;
+    }
+    else if ((m_timeLimit > 0 && m_timeSpent > m_timeLimit) ||
+             (m_workLimit > 0 && m_workSpent > m_workLimit)) {
+        m_exceededIn = passName;
+        return true;
+    }
+
+    return false;
+}
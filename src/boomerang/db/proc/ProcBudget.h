@@ -0,0 +1,61 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QString>
+
+
+/**
+ * Limits the effort spent on decompiling a single UserProc.
+ *
+ * The budget is charged with the time spent in the passes executed on the procedure
+ * and with the work done by them, measured as the number of statements of the procedure
+ * each time a pass is executed (so callees decompiled in between are not accounted for).
+ * Once either limit is exceeded, the procedure is degraded: optional passes
+ * (see \ref IPass::isOptional) are skipped and fixed-point iterations stop early,
+ * so the procedure is emitted as low-level code instead of stalling the whole program.
+ */
+class BOOMERANG_API ProcBudget
+{
+public:
+    /// Set the limits of this budget. A limit of 0 means unlimited.
+    /// \param timeLimit maximum time in milliseconds
+    /// \param workLimit maximum number of work units
+    void setLimits(qint64 timeLimit, qint64 workLimit);
+
+    bool hasLimits() const { return m_timeLimit > 0 || m_workLimit > 0; }
+
+    /// Charge \p time milliseconds and \p work work units spent in pass \p passName.
+    /// \returns true if this charge exceeded the budget for the first time.
+    bool charge(qint64 time, qint64 work, const QString &passName);
+
+    /// \returns true if the budget was exceeded,
+    /// i.e. only the degraded pipeline is run for the procedure.
+    bool isExceeded() const { return !m_exceededIn.isEmpty(); }
+
+    /// \returns the name of the pass that exceeded the budget,
+    /// or the empty string if the budget was not exceeded.
+    const QString &getExceededIn() const { return m_exceededIn; }
+
+    qint64 getTimeSpent() const { return m_timeSpent; }
+    qint64 getWorkSpent() const { return m_workSpent; }
+    qint64 getTimeLimit() const { return m_timeLimit; }
+    qint64 getWorkLimit() const { return m_workLimit; }
+
+private:
+    qint64 m_timeLimit = 0;
+    qint64 m_workLimit = 0;
+    qint64 m_timeSpent = 0;
+    qint64 m_workSpent = 0;
+    QString m_exceededIn;
+};
@@ -45,6 +45,7 @@ void ProcCFG::clear()
 
     qDeleteAll(begin(), end()); // deletes all fragments
     m_fragmentSet.clear();
+    structureChanged();
 }
 
 
@@ -64,7 +65,9 @@ IRFragment *ProcCFG::createFragment(FragType fragType, std::unique_ptr<RTLList>
     assert(bb != nullptr);
 
     IRFragment *frag = new IRFragment(getNextFragID(), bb, std::move(rtls));
+    frag->m_cfg      = this;
     m_fragmentSet.insert(frag);
+    structureChanged();
 
     frag->setType(fragType);
     frag->updateAddresses();
@@ -149,6 +152,7 @@ void ProcCFG::removeFragment(IRFragment *frag)
 
     assert(*it == frag);
     m_fragmentSet.erase(it);
+    structureChanged();
     delete frag;
 }
 
@@ -342,6 +346,7 @@ void ProcCFG::setEntryAndExitFragment(IRFragment *entryFrag)
 {
     m_entryFrag = entryFrag;
     m_exitFrag  = nullptr;
+    structureChanged();
 
     for (IRFragment *frag : *this) {
         if (frag->isType(FragType::Ret)) {
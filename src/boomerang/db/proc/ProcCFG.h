@@ -147,6 +147,16 @@ public:
     bool isImplicitsDone() const { return m_implicitsDone; }
     void setImplicitsDone() { m_implicitsDone = true; }
 
+public:
+    /// \returns a number that changes whenever fragments or edges are added to or removed
+    /// from this CFG, or when the entry fragment changes. Results derived from the structure
+    /// of the CFG (e.g. dominators) are still valid if the version did not change.
+    uint64 getVersion() const { return m_version; }
+
+    /// Must be called after the structure of this CFG was modified.
+    /// Changes to the edges of fragments in this CFG are detected automatically.
+    void structureChanged() { m_version++; }
+
 public:
     /// print this CFG, mainly for debugging
     void print(OStream &out) const;
@@ -172,5 +182,7 @@ private:
     /// (e.g. with ad-hoc global assignment)
     bool m_implicitsDone = false;
 
+    uint64 m_version = 0; ///< \sa getVersion
+
     static IRFragment::FragID m_nextID;
 };
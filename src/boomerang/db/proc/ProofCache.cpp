@@ -0,0 +1,69 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCache.h"
+
+#include "boomerang/ssl/exp/Binary.h"
+
+
+bool ProofCache::lookup(const UserProc *proc, const SharedConstExp &lhs,
+                        const SharedConstExp &rhs, bool &result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto procIt = m_results.find(proc);
+    if (procIt == m_results.end()) {
+        m_numMisses++;
+        return false;
+    }
+
+    // The query is only used for the lookup, so no need to clone the operands
+    const SharedConstExp query = Binary::get(opEquals, std::const_pointer_cast<Exp>(lhs),
+                                             std::const_pointer_cast<Exp>(rhs));
+
+    auto it = procIt->second.find(query);
+    if (it == procIt->second.end()) {
+        m_numMisses++;
+        return false;
+    }
+    else if (!it->second.result && it->second.factEpoch != m_factEpoch) {
+        // More facts are known now; the proof might succeed this time.
+        procIt->second.erase(it);
+        m_numMisses++;
+        return false;
+    }
+
+    m_numHits++;
+    result = it->second.result;
+    return true;
+}
+
+
+void ProofCache::insert(const UserProc *proc, const SharedConstExp &lhs,
+                        const SharedConstExp &rhs, bool result)
+{
+    const SharedConstExp query = Binary::get(opEquals, lhs->clone(), rhs->clone());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results[proc][query] = Entry{ result, m_factEpoch };
+}
+
+
+void ProofCache::invalidate(const UserProc *proc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.erase(proc);
+}
+
+
+void ProofCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.clear();
+}
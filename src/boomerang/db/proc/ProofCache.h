@@ -0,0 +1,90 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/Types.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+
+class UserProc;
+
+
+/**
+ * Program-wide cache of the results of UserProc::proveEqual.
+ * Results are keyed by the procedure and the query (lhs = rhs).
+ *
+ * A cached result is only valid as long as the IR of the procedure
+ * does not change; the cache entries of a procedure are dropped by \ref invalidate
+ * whenever its IR is modified. Since a failed proof might succeed when more facts
+ * about callees become known, negative results are additionally only valid
+ * until the next fact is proven about any procedure (see \ref addedFact).
+ *
+ * All functions may be called by several threads concurrently.
+ */
+class BOOMERANG_API ProofCache
+{
+public:
+    ProofCache()                        = default;
+    ProofCache(const ProofCache &other) = delete;
+    ProofCache(ProofCache &&other)      = delete;
+
+    ~ProofCache() = default;
+
+    ProofCache &operator=(const ProofCache &other) = delete;
+    ProofCache &operator=(ProofCache &&other) = delete;
+
+public:
+    /// Look up the result of the query lhs = rhs in procedure \p proc.
+    /// \param[out] result the cached result, if any.
+    /// \returns true if the result of the query is cached.
+    bool lookup(const UserProc *proc, const SharedConstExp &lhs, const SharedConstExp &rhs,
+                bool &result);
+
+    /// Store the result of the query lhs = rhs in procedure \p proc.
+    void insert(const UserProc *proc, const SharedConstExp &lhs, const SharedConstExp &rhs,
+                bool result);
+
+    /// Drop all cached results for \p proc, e.g. because its IR has changed.
+    void invalidate(const UserProc *proc);
+
+    /// Must be called when a new fact was proven about any procedure.
+    /// Invalidates all negative results.
+    void addedFact() { m_factEpoch++; }
+
+    /// Drop all cached results
+    void clear();
+
+    int getNumHits() const { return m_numHits; }
+    int getNumMisses() const { return m_numMisses; }
+
+private:
+    struct Entry
+    {
+        bool result;
+        uint64 factEpoch; ///< Value of m_factEpoch when the result was computed
+    };
+
+    /// Map from query (lhs = rhs) to result
+    typedef std::map<SharedConstExp, Entry, lessExpStar> QueryMap;
+
+    std::unordered_map<const UserProc *, QueryMap> m_results;
+    std::atomic<uint64> m_factEpoch{ 0 };
+
+    std::atomic<int> m_numHits{ 0 };
+    std::atomic<int> m_numMisses{ 0 };
+
+    std::mutex m_mutex; ///< Guards m_results
+};
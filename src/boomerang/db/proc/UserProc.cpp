@@ -13,6 +13,7 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/ProofCache.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/ProcDecompiler.h"
 #include "boomerang/ifc/ITypeRecovery.h"
@@ -55,6 +56,9 @@ UserProc::UserProc(Address address, const QString &name, Module *module)
 
 UserProc::~UserProc()
 {
+    if (m_prog) {
+        m_prog->getProofCache()->invalidate(this);
+    }
 }
 
 
@@ -152,7 +156,7 @@ void UserProc::getStatements(StatementList &stmts) const
         frag->appendStatementsTo(stmts);
     }
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (s->getProc() == nullptr) {
             s->setProc(const_cast<UserProc *>(this));
         }
@@ -182,6 +186,9 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
                         provenIt->first, provenIt->second);
 
             provenIt = m_provenTrue.erase(provenIt);
+
+            // Proofs in other procedures might have relied on this
+            m_prog->getProofCache()->clear();
             continue;
         }
 
@@ -913,7 +920,7 @@ bool UserProc::searchAndReplace(const Exp &search, SharedExp replace)
     StatementList stmts;
     getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         ch |= s->searchAndReplace(search, replace);
     }
 
@@ -932,7 +939,7 @@ bool UserProc::allPhisHaveDefs() const
     StatementList stmts;
     getStatements(stmts);
 
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : stmts) {
         if (!stmt->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -1184,6 +1191,21 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
         return true;
     }
 
+    // Results of conditional proofs and proofs involving recursion premises
+    // depend on the premises of other procedures, so do not cache them.
+    ProofCache *proofCache = m_prog->getProofCache();
+    const bool useCache    = !conditional && !m_recursionGroup;
+    bool cachedResult      = false;
+
+    if (useCache && proofCache->lookup(this, queryLeft, queryRight, cachedResult)) {
+        if (m_prog->getProject()->getSettings()->debugProof) {
+            LOG_MSG("found %1 in proof cache for %2 in %3", cachedResult ? "true" : "false",
+                    Binary::get(opEquals, queryLeft, queryRight), getName());
+        }
+
+        return cachedResult;
+    }
+
     const SharedExp origLeft  = queryLeft;
     const SharedExp origRight = queryRight;
 
@@ -1224,7 +1246,12 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
                     LOG_MSG("Prove returns true");
                 }
 
-                m_provenTrue[origLeft->clone()] = right;
+                addProvenTrue(origLeft->clone(), right);
+
+                if (useCache) {
+                    proofCache->insert(this, origLeft, origRight, true);
+                }
+
                 return true;
             }
 
@@ -1233,6 +1260,10 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
                 LOG_MSG("Prove returns false");
             }
 
+            if (useCache) {
+                proofCache->insert(this, origLeft, origRight, false);
+            }
+
             return false;
         }
     }
@@ -1256,13 +1287,36 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
     }
 
     if (result && !conditional) {
-        m_provenTrue[origLeft] = origRight; // Save the now proven equation
+        addProvenTrue(origLeft, origRight); // Save the now proven equation
+    }
+
+    if (useCache) {
+        proofCache->insert(this, origLeft, origRight, result);
     }
 
     return result;
 }
 
 
+void UserProc::addProvenTrue(const SharedExp &left, const SharedExp &right)
+{
+    auto it = m_provenTrue.find(left);
+
+    if (it == m_provenTrue.end()) {
+        m_provenTrue[left] = right;
+    }
+    else if (*it->second == *right) {
+        return; // already known
+    }
+    else {
+        it->second = right;
+    }
+
+    // A failed proof in another procedure might succeed now
+    m_prog->getProofCache()->addedFact();
+}
+
+
 bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &lastPhis,
                       std::map<std::shared_ptr<PhiAssign>, SharedExp> &cache,
                       std::shared_ptr<PhiAssign> lastPhi /* = nullptr */)
@@ -1505,7 +1559,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                         LOG_ERROR("Detected ref loop %1", s);
                         LOG_ERROR("refsTo: ");
 
-                        for (SharedStmt ins : refsTo) {
+                        for (const SharedStmt &ins : refsTo) {
                             LOG_MSG("  %1, ", ins->toString());
                         }
 
@@ -1543,7 +1597,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                 StatementList stmts;
                 getStatements(stmts);
 
-                for (SharedStmt s : stmts) {
+                for (const SharedStmt &s : stmts) {
                     std::shared_ptr<Assign> as = std::dynamic_pointer_cast<Assign>(s);
 
                     if (as && (*as->getRight() == *query->getSubExp2()) &&
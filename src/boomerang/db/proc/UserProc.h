@@ -13,6 +13,7 @@
 #include "boomerang/db/DataFlow.h"
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/db/proc/Proc.h"
+#include "boomerang/db/proc/ProcBudget.h"
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/util/StatementList.h"
 
@@ -31,6 +32,7 @@ enum class ProcStatus : uint8_t
     InCycle,    ///< Is involved in cycles, has not completed early decompilation as yet
     Preserveds, ///< Has had preservation analysis done
     MiddleDone, ///< Has completed everything except the global analyses
+    Summarized, ///< Has completed middle decompilation and parameter search (see ProcDecompiler)
     FinalDone,  ///< Has had final decompilation
     CodegenDone ///< Has had code generated
 };
@@ -105,6 +107,10 @@ public:
     DataFlow *getDataFlow() { return &m_df; }
     const DataFlow *getDataFlow() const { return &m_df; }
 
+    /// \returns the budget limiting the effort spent on decompiling this procedure.
+    ProcBudget *getBudget() { return &m_budget; }
+    const ProcBudget *getBudget() const { return &m_budget; }
+
     const std::shared_ptr<ProcSet> &getRecursionGroup() { return m_recursionGroup; }
     void setRecursionGroup(const std::shared_ptr<ProcSet> &recursionGroup)
     {
@@ -368,6 +374,9 @@ private:
     /// \note this function was non-reentrant, but now reentrancy is frequently used
     bool proveEqual(const SharedExp &lhs, const SharedExp &rhs, bool conditional = false);
 
+    /// Record the proven equation \p left = \p right.
+    void addProvenTrue(const SharedExp &left, const SharedExp &right);
+
     /// helper function for proveEqual()
     bool prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &lastPhis,
                 std::map<std::shared_ptr<PhiAssign>, SharedExp> &cache,
@@ -399,6 +408,8 @@ private:
     /// DataFlow object. Holds information relevant to transforming to and from SSA form.
     DataFlow m_df;
 
+    ProcBudget m_budget;
+
     /**
      * The list of parameters, ordered and filtered.
      * Note that a LocationList could be used, but then there would be nowhere
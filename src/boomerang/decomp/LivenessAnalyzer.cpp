@@ -32,7 +32,7 @@
 void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig, UserProc *proc)
 {
     // For each location to be considered
-    for (SharedExp exp : ls) {
+    for (const SharedExp &exp : ls) {
         if (!exp->isSubscript()) {
             continue; // Only interested in subscripted vars
         }
@@ -13,6 +13,7 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/passes/PassManager.h"
@@ -24,8 +25,11 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/util/log/SeparateLogger.h"
 
+#include <algorithm>
 
-ProcDecompiler::ProcDecompiler()
+
+ProcDecompiler::ProcDecompiler(bool summarizeCallees)
+    : m_summarizeCallees(summarizeCallees)
 {
 }
 
@@ -40,7 +44,29 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
 {
     Project *project = proc->getProg()->getProject();
 
-    if (proc->getStatus() < ProcStatus::Visited) {
+    if (proc->getStatus() == ProcStatus::Summarized) {
+        if (m_summarizeCallees && !m_callStack.empty()) {
+            return ProcStatus::Summarized;
+        }
+
+        // Reuse the summary; only the final decompilation is missing
+        LOG_MSG("Finishing summarized procedure '%1'", proc->getName());
+        const std::shared_ptr<Signature> summary = proc->getSignature()->clone();
+
+        m_callStack.push_back(proc);
+        lateDecompile(proc);
+        proc->setStatus(ProcStatus::FinalDone);
+        project->alertEndDecompile(proc);
+        m_callStack.pop_back();
+
+        if (!(*proc->getSignature() == *summary)) {
+            // Callers were decompiled against the summary
+            updateCallers(proc);
+        }
+
+        return proc->getStatus();
+    }
+    else if (proc->getStatus() < ProcStatus::Visited) {
         LOG_MSG("Visiting procedure '%1'", proc->getName());
     }
     else {
@@ -72,6 +98,9 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
         printCallStack();
     }
 
+    proc->getBudget()->setLimits(project->getSettings()->procTimeLimit,
+                                 project->getSettings()->procWorkLimit);
+
     PassManager::get()->executePass(PassID::StatementInit, proc);
     project->alertDecompileDebugPoint(proc, "after lifting");
 
@@ -106,7 +135,8 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
                 continue;
             }
 
-            if (callee->isDecompiled()) {
+            if (callee->isDecompiled() ||
+                (m_summarizeCallees && callee->getStatus() == ProcStatus::Summarized)) {
                 // Already decompiled, but the return statement still needs to be set for this call
                 call->setCalleeReturn(callee->getRetStmt());
                 continue;
@@ -133,9 +163,15 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
     }
 
     if (proc->getStatus() != ProcStatus::InCycle) {
-        lateDecompile(proc); // Do the whole works
-        proc->setStatus(ProcStatus::FinalDone);
-        project->alertEndDecompile(proc);
+        if (m_summarizeCallees && m_callStack.size() > 1) {
+            // Callers only need to know the effects of this proc
+            summarize(proc);
+        }
+        else {
+            lateDecompile(proc); // Do the whole works
+            proc->setStatus(ProcStatus::FinalDone);
+            project->alertEndDecompile(proc);
+        }
     }
     else if (m_recursionGroups.find(proc) != m_recursionGroups.end()) {
         // This proc's callees, and hence this proc, is/are involved in recursion.
@@ -356,7 +392,8 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 
         // FIXME: Check if this is needed any more. At least fib seems to need it at present.
         if (project->getSettings()->changeSignatures) {
-            for (int i = 0; i < 3; i++) { // FIXME: should be iterate until no change
+            for (int i = 0; i < 3 && !proc->getBudget()->isExceeded(); i++) {
+                // FIXME: should be iterate until no change
                 LOG_VERBOSE("### update returns loop iteration %1 ###", i);
 
                 if (proc->getStatus() != ProcStatus::InCycle) {
@@ -381,7 +418,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         PassManager::get()->executePass(PassID::AssignRemoval, proc);
         project->alertDecompileDebugPoint(proc,
                                           "after updating returns pass " + QString::number(pass));
-    } while (change && ++pass < 12);
+    } while (change && ++pass < 12 && !proc->getBudget()->isExceeded());
 
     // At this point, there will be some memofs that have still not been renamed. They have been
     // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
@@ -527,10 +564,16 @@ void ProcDecompiler::recursionGroupAnalysis(const std::shared_ptr<ProcSet> &grou
     bool changed    = false;
     int numRepeats  = 0;
 
+    // Stop iterating as soon as any procedure of the group exceeds its budget
+    auto budgetExceeded = [&group]() {
+        return std::any_of(group->begin(), group->end(),
+                           [](UserProc *proc) { return proc->getBudget()->isExceeded(); });
+    };
+
     do {
         ProcSet visited;
         changed = decompileProcInRecursionGroup(entry, visited);
-    } while (changed && numRepeats++ < 2);
+    } while (changed && numRepeats++ < 2 && !budgetExceeded());
 
     // while no change
     for (int i = 0; i < 2; i++) {
@@ -568,6 +611,34 @@ void ProcDecompiler::lateDecompile(UserProc *proc)
 }
 
 
+void ProcDecompiler::summarize(UserProc *proc)
+{
+    LOG_VERBOSE("Summarizing procedure '%1'", proc->getName());
+
+    // Same as lateDecompile, so the parameters of the summary are the final ones
+    PassManager::get()->executePass(PassID::UnusedStatementRemoval, proc);
+    PassManager::get()->executePass(PassID::FinalParameterSearch, proc);
+    proc->setStatus(ProcStatus::Summarized);
+
+    proc->getProg()->getProject()->alertDecompileDebugPoint(proc, "after summarizing");
+}
+
+
+void ProcDecompiler::updateCallers(UserProc *proc)
+{
+    for (const std::shared_ptr<CallStatement> &call : proc->getCallers()) {
+        UserProc *caller = call->getProc();
+
+        // Callers that are not decompiled yet update their calls in lateDecompile
+        if (caller && caller != proc && caller->isDecompiled()) {
+            LOG_VERBOSE("Updating calls to '%1' in '%2'", proc->getName(), caller->getName());
+            PassManager::get()->executePass(PassID::CallDefineUpdate, caller);
+            PassManager::get()->executePass(PassID::CallArgumentUpdate, caller);
+        }
+    }
+}
+
+
 void ProcDecompiler::printCallStack()
 {
     LOG_MSG("Call stack (most recent procedure last):");
@@ -629,7 +700,7 @@ bool ProcDecompiler::tryConvertFunctionPointerAssignments(UserProc *proc)
     StatementList statements;
     proc->getStatements(statements);
 
-    for (SharedStmt stmt : statements) {
+    for (const SharedStmt &stmt : statements) {
         if (stmt->isAssign()) {
             std::shared_ptr<Assign> asgn = stmt->as<Assign>();
             if (asgn->getType()->resolvesToFuncPtr()) {
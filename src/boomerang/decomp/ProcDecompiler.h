@@ -18,11 +18,19 @@
 
 /**
  * Contains the algorithm that determines how and in which order UserProcs are decompiled.
+ *
+ * When only a single procedure is requested (e.g. interactively), callees can be summarized
+ * instead of being decompiled completely: A summarized callee has completed middle
+ * decompilation (preservation analysis, returns) and parameter search, which is all
+ * its callers need to know. Summaries are kept in the procedures (ProcStatus::Summarized),
+ * so later requests reuse them and only need to do the final decompilation.
  */
 class BOOMERANG_API ProcDecompiler
 {
 public:
-    ProcDecompiler();
+    /// \param summarizeCallees if true, callees of the procedure passed to \ref decompileRecursive
+    /// are only summarized instead of decompiled completely.
+    explicit ProcDecompiler(bool summarizeCallees = false);
 
 public:
     void decompileRecursive(UserProc *proc);
@@ -58,6 +66,14 @@ private:
     /// Remove unused statements etc.
     void lateDecompile(UserProc *proc);
 
+    /// Find the parameters of \p proc after middle decompilation,
+    /// so callers can be decompiled without decompiling \p proc completely.
+    void summarize(UserProc *proc);
+
+    /// Update the calls to \p proc in all callers that are decompiled already,
+    /// e.g. when the final signature of a summarized procedure differs from its summary.
+    void updateCallers(UserProc *proc);
+
     void printCallStack();
 
     /**
@@ -89,6 +105,7 @@ private:
     Function *tryDecompileRecursive(Address entryAddr, Prog *prog, UserProc *caller);
 
 private:
+    bool m_summarizeCallees;
     ProcList m_callStack;
 
     /**
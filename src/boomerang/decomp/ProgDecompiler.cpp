@@ -13,15 +13,103 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Global.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/CFGCompressor.h"
 #include "boomerang/decomp/UnusedReturnRemover.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/util/IRMemoryReport.h"
+#include "boomerang/util/OStream.h"
+#include "boomerang/util/ParallelFor.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <unordered_map>
+
+
+/// Maximum number of times procedures are analysed again after the types at call sites changed
+static const int CALL_TYPES_ITER_LIMIT = 10;
+
+
+/// \returns the meet of the type \p ty1 with the type \p ty2, or nullptr if either is nullptr
+/// or the types are not compatible. Types are met across procedures only if they are compatible,
+/// so that a conflicting use in one procedure does not make unions in others.
+static SharedType meetCompatible(const SharedType &ty1, const SharedType &ty2)
+{
+    if (!ty1 || !ty2 || !ty1->isCompatibleWith(*ty2)) {
+        return nullptr;
+    }
+
+    bool changed = false;
+    return ty1->meetWith(ty2, changed);
+}
+
+
+/// Partition \p procs into sets of procedures that do not call each other directly.
+/// The procedures in each set keep their relative order.
+static std::vector<std::vector<UserProc *>> partitionByCalls(const std::vector<UserProc *> &procs)
+{
+    std::unordered_map<const Function *, std::size_t> indices;
+    for (std::size_t i = 0; i < procs.size(); i++) {
+        indices[procs[i]] = i;
+    }
+
+    // undirected call graph
+    std::vector<std::vector<std::size_t>> neighbours(procs.size());
+
+    for (std::size_t i = 0; i < procs.size(); i++) {
+        auto addEdge = [&](const Function *other) {
+            auto it = indices.find(other);
+            if (it != indices.end() && it->second != i) {
+                neighbours[i].push_back(it->second);
+                neighbours[it->second].push_back(i);
+            }
+        };
+
+        for (const Function *callee : procs[i]->getCallees()) {
+            addEdge(callee);
+        }
+
+        for (const std::shared_ptr<CallStatement> &caller : procs[i]->getCallers()) {
+            addEdge(caller->getProc());
+        }
+    }
+
+    // Greedy coloring: Put each procedure into the first set without any of its neighbours.
+    const std::size_t NO_SET = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> setOf(procs.size(), NO_SET);
+    std::vector<std::vector<UserProc *>> sets;
+    std::vector<bool> isUsed;
+
+    for (std::size_t i = 0; i < procs.size(); i++) {
+        isUsed.assign(sets.size(), false);
+
+        for (std::size_t n : neighbours[i]) {
+            if (setOf[n] != NO_SET) {
+                isUsed[setOf[n]] = true;
+            }
+        }
+
+        const std::size_t set = std::find(isUsed.begin(), isUsed.end(), false) - isUsed.begin();
+        if (set == sets.size()) {
+            sets.emplace_back();
+        }
+
+        sets[set].push_back(procs[i]);
+        setOf[i] = set;
+    }
+
+    return sets;
+}
+
 
 ProgDecompiler::ProgDecompiler(Prog *prog)
     : m_prog(prog)
@@ -40,6 +128,8 @@ void ProgDecompiler::decompile()
         up->decompileRecursive();
     }
 
+    reportMemory("decompiling entry points");
+
     // Just in case there are any Procs not in the call graph.
 
     if (m_prog->getProject()->getSettings()->decodeMain &&
@@ -67,7 +157,10 @@ void ProgDecompiler::decompile()
         }
     }
 
+    reportMemory("decompiling all procedures");
+
     globalTypeAnalysis();
+    reportMemory("global type analysis");
 
     if (m_prog->getProject()->getSettings()->removeReturns) {
         // Repeat until no change. Not 100% sure if needed.
@@ -83,12 +176,16 @@ void ProgDecompiler::decompile()
                 }
             }
         }
+
+        reportMemory("removing unused parameters and returns");
     }
 
     globalTypeAnalysis();
 
     // Now it is OK to transform out of SSA form
     fromSSAForm();
+    reportMemory("transforming out of SSA form");
+
     removeUnusedGlobals();
 
     LOG_MSG("Compressing CFG...");
@@ -101,6 +198,8 @@ void ProgDecompiler::decompile()
         }
     }
 
+    reportMemory("compressing CFGs");
+    reportBudgets();
     LOG_MSG("Decompilation finished.");
 }
 
@@ -113,19 +212,36 @@ void ProgDecompiler::globalTypeAnalysis()
         LOG_VERBOSE("### Start global data-flow-based type analysis ###");
     }
 
+    std::vector<UserProc *> allProcs;
+
     for (const auto &module : m_prog->getModuleList()) {
         for (Function *pp : *module) {
             UserProc *proc = dynamic_cast<UserProc *>(pp);
 
-            if (!proc || !proc->isDecoded()) {
-                continue;
+            if (proc && proc->isDecoded()) {
+                allProcs.push_back(proc);
             }
+        }
+    }
+
+    // Analyse all procedures. If enabled, meet the types at their call sites, and analyse
+    // procedures with types changed by a call site again until the call sites do not change.
+    // FIXME: By default, this just does local TA again. Meeting the types for all
+    // parameter/arguments and return/results is opt-in (--meet-call-types) for now.
+    std::vector<UserProc *> procs = allProcs;
 
-            // FIXME: this just does local TA again. Need to meet types for all parameter/arguments,
-            // and return/results! This will require a repeat until no change loop
-            LOG_VERBOSE("Global type analysis for '%1'", proc->getName());
-            PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+    for (int iter = 1; !procs.empty(); iter++) {
+        localTypeAnalysis(procs);
+
+        if (!m_prog->getProject()->getSettings()->meetCallSiteTypes) {
+            break;
+        }
+        else if (iter == CALL_TYPES_ITER_LIMIT) {
+            LOG_VERBOSE("Iteration limit exceeded for meeting types at call sites");
+            break;
         }
+
+        procs = meetCallSiteTypes(allProcs, procs);
     }
 
     if (m_prog->getProject()->getSettings()->debugTA) {
@@ -134,6 +250,145 @@ void ProgDecompiler::globalTypeAnalysis()
 }
 
 
+void ProgDecompiler::localTypeAnalysis(const std::vector<UserProc *> &procs)
+{
+    auto analyse = [](UserProc *proc) {
+        LOG_VERBOSE("Global type analysis for '%1'", proc->getName());
+        PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+    };
+
+    const int numThreads = Util::getNumThreads(m_prog->getProject()->getSettings()->numThreads);
+
+    if (numThreads == 1 || procs.size() < 2) {
+        for (UserProc *proc : procs) {
+            analyse(proc);
+        }
+
+        return;
+    }
+
+    // The symbol table is indexed lazily; make sure it is only read from now on.
+    if (m_prog->getBinaryFile()) {
+        m_prog->getBinaryFile()->getSymbols()->updateIndex();
+    }
+
+    // The analysis of a procedure reads the signatures and return statements of its callees
+    // and modifies its own signature and returns, so a caller and its callee
+    // must never be analysed at the same time. Changes to globals are serialized by Prog.
+    for (const std::vector<UserProc *> &procSet : partitionByCalls(procs)) {
+        Util::parallelFor(procSet.size(), numThreads,
+                          [&procSet, &analyse](std::size_t i) { analyse(procSet[i]); });
+    }
+}
+
+
+std::vector<UserProc *> ProgDecompiler::meetCallSiteTypes(const std::vector<UserProc *> &procs,
+                                                          const std::vector<UserProc *> &analysed)
+{
+    const std::set<const UserProc *> analysedProcs(analysed.begin(), analysed.end());
+    std::set<const UserProc *> changedProcs;
+
+    for (UserProc *caller : procs) {
+        for (IRFragment *frag : *caller->getCFG()) {
+            const SharedStmt last = frag->getLastStmt();
+            if (!last || !last->isCall()) {
+                continue;
+            }
+
+            std::shared_ptr<CallStatement> call = last->as<CallStatement>();
+            UserProc *callee = dynamic_cast<UserProc *>(call->getDestProc());
+
+            if (!callee || !callee->isDecoded() ||
+                (analysedProcs.count(caller) == 0 && analysedProcs.count(callee) == 0)) {
+                continue; // no types at this call site changed since the last time
+            }
+
+            meetCallTypes(call, caller, callee, changedProcs);
+        }
+    }
+
+    std::vector<UserProc *> changed;
+    std::copy_if(procs.begin(), procs.end(), std::back_inserter(changed),
+                 [&changedProcs](UserProc *proc) { return changedProcs.count(proc) != 0; });
+
+    LOG_VERBOSE("Types at call sites changed for %1 procedures", changed.size());
+    return changed;
+}
+
+
+void ProgDecompiler::meetCallTypes(const std::shared_ptr<CallStatement> &call, UserProc *caller,
+                                   UserProc *callee, std::set<const UserProc *> &changedProcs)
+{
+    // Arguments and parameters
+    const std::shared_ptr<Signature> sig = callee->getSignature();
+
+    for (const SharedStmt &stmt : call->getArguments()) {
+        if (!stmt->isAssignment()) {
+            continue;
+        }
+
+        std::shared_ptr<Assignment> arg = stmt->as<Assignment>();
+        const int i                     = sig->findParam(arg->getLeft());
+
+        if (i == -1) {
+            continue;
+        }
+
+        const SharedType paramType = sig->getParamType(i);
+        const SharedType ty        = meetCompatible(arg->getType(), paramType);
+
+        if (ty && !(*ty == *arg->getType())) {
+            arg->setType(ty->clone());
+            changedProcs.insert(caller);
+        }
+
+        if (ty && !(*ty == *paramType)) {
+            callee->setParamType(i, ty->clone());
+            changedProcs.insert(callee);
+        }
+    }
+
+    // Results and returns
+    std::shared_ptr<ReturnStatement> retStmt = callee->getRetStmt();
+    if (!retStmt) {
+        return;
+    }
+
+    for (const SharedStmt &def : call->getDefines()) {
+        if (!def->isAssignment()) {
+            continue;
+        }
+
+        std::shared_ptr<Assignment> result = def->as<Assignment>();
+
+        for (const SharedStmt &ret : retStmt->getReturns()) {
+            if (!ret->isAssignment()) {
+                continue;
+            }
+
+            std::shared_ptr<Assignment> retAsgn = ret->as<Assignment>();
+            if (!(*retAsgn->getLeft() == *result->getLeft())) {
+                continue;
+            }
+
+            const SharedType ty = meetCompatible(result->getType(), retAsgn->getType());
+
+            if (ty && !(*ty == *result->getType())) {
+                result->setType(ty->clone());
+                changedProcs.insert(caller);
+            }
+
+            if (ty && !(*ty == *retAsgn->getType())) {
+                retAsgn->setType(ty->clone());
+                changedProcs.insert(callee);
+            }
+
+            break;
+        }
+    }
+}
+
+
 void ProgDecompiler::removeUnusedGlobals()
 {
     LOG_MSG("Removing unused global variables...");
@@ -155,7 +410,7 @@ void ProgDecompiler::removeUnusedGlobals()
             StatementList::iterator ss;
             proc->getStatements(stmts);
 
-            for (SharedStmt s : stmts) {
+            for (const SharedStmt &s : stmts) {
                 if (s->isImplicit()) {
                     continue; // Ignore the uses in ImplicitAssigns
                 }
@@ -221,3 +476,60 @@ void ProgDecompiler::fromSSAForm()
         }
     }
 }
+
+
+void ProgDecompiler::reportMemory(const QString &phaseName)
+{
+    const int topN = m_prog->getProject()->getSettings()->memReportTopN;
+    if (topN <= 0) {
+        return;
+    }
+
+    IRMemoryReport report(m_prog);
+    report.collect();
+
+    QString tgt;
+    OStream os(&tgt);
+    report.print(os, topN);
+    os.flush();
+
+    LOG_MSG("IR memory after %1:\n%2", phaseName, tgt);
+}
+
+
+void ProgDecompiler::reportBudgets()
+{
+    const Settings *settings = m_prog->getProject()->getSettings();
+    if (settings->procTimeLimit <= 0 && settings->procWorkLimit <= 0) {
+        return;
+    }
+
+    QString tgt;
+    OStream os(&tgt);
+    int numDegraded = 0;
+
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            const ProcBudget *budget = static_cast<UserProc *>(func)->getBudget();
+            os << "    " << func->getName() << ": ";
+
+            if (budget->isExceeded()) {
+                os << "degraded (budget exceeded in " << budget->getExceededIn() << ")";
+                numDegraded++;
+            }
+            else {
+                os << "complete";
+            }
+
+            os << ", " << QString::number(budget->getTimeSpent()) << " ms, "
+               << QString::number(budget->getWorkSpent()) << " work units\n";
+        }
+    }
+
+    os.flush();
+    LOG_MSG("Procedure budgets (%1 degraded):\n%2", numDegraded, tgt);
+}
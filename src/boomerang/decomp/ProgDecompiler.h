@@ -12,8 +12,16 @@
 
 #include "boomerang/core/BoomerangAPI.h"
 
+#include <QString>
 
+#include <memory>
+#include <set>
+#include <vector>
+
+
+class CallStatement;
 class Prog;
+class UserProc;
 
 
 class BOOMERANG_API ProgDecompiler
@@ -26,10 +34,28 @@ public:
     void decompile();
 
 private:
-    /// Do global type analysis.
-    /// \note For now, it just does local type analysis for every procedure of the program.
+    /// Do global type analysis: Do local type analysis for every procedure of the program.
+    /// If enabled (see Settings::meetCallSiteTypes), then meet the types of arguments and
+    /// parameters, and of results and returns, at all call sites,
+    /// and repeat for the procedures whose types changed.
     void globalTypeAnalysis();
 
+    /// Do local type analysis for all procedures in \p procs.
+    /// Procedures that do not call each other are analysed in parallel
+    /// if several threads are enabled (see Settings::numThreads).
+    void localTypeAnalysis(const std::vector<UserProc *> &procs);
+
+    /// Meet the types at all calls in \p procs that are made by or to a procedure in \p analysed.
+    /// \returns the procedures in \p procs whose types changed.
+    std::vector<UserProc *> meetCallSiteTypes(const std::vector<UserProc *> &procs,
+                                              const std::vector<UserProc *> &analysed);
+
+    /// Meet the types of the arguments of \p call with the parameters of \p callee,
+    /// and the types of the results of \p call with the returns of \p callee.
+    /// Procedures with changed types are added to \p changedProcs.
+    void meetCallTypes(const std::shared_ptr<CallStatement> &call, UserProc *caller,
+                       UserProc *callee, std::set<const UserProc *> &changedProcs);
+
     /// As the name suggests, removes globals unused in the decompiled code.
     void removeUnusedGlobals();
 
@@ -41,6 +67,14 @@ private:
     /// Convert from SSA form
     void fromSSAForm();
 
+    /// Print the IR memory report after the phase \p phaseName,
+    /// if enabled by Settings::memReportTopN.
+    void reportMemory(const QString &phaseName);
+
+    /// Print the outcome (complete or degraded) and the effort spent on each procedure,
+    /// if procedure budgets are enabled (see Settings::procTimeLimit, Settings::procWorkLimit).
+    void reportBudgets();
+
 private:
     Prog *m_prog;
 };
@@ -22,6 +22,7 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
+#include "boomerang/frontend/FunctionSweeper.h"
 #include "boomerang/frontend/LiftedInstruction.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
@@ -57,6 +58,12 @@ bool DefaultFrontEnd::initialize(Project *project)
     m_program    = project->getProg();
     m_binaryFile = project->getLoadedBinaryFile();
 
+    // The front end is reused for all programs loaded by the project
+    m_refHints.clear();
+    m_firstFragment.clear();
+    m_lastFragment.clear();
+    m_needSuccessors.clear();
+
     if (!m_decoder) {
         return false;
     }
@@ -73,6 +80,14 @@ bool DefaultFrontEnd::disassembleEntryPoints()
 
     m_program->getProject()->alertStartDecode(lowAddr, numBytes);
 
+    if (m_program->getProject()->getSettings()->useDebugInfo) {
+        createFunctionsFromDebugInfo();
+    }
+
+    if (m_program->getProject()->getSettings()->sweepForFunctions) {
+        createFunctionsFromSweep();
+    }
+
     bool gotMain;
     const Address mainAddr = findMainEntryPoint(gotMain);
 
@@ -735,14 +750,14 @@ void DefaultFrontEnd::extraProcessCall(IRFragment *)
 
 bool DefaultFrontEnd::disassembleInstruction(Address pc, MachineInstruction &insn)
 {
-    BinaryImage *image = m_program->getBinaryFile()->getImage();
-    if (!image || (image->getSectionByAddr(pc) == nullptr)) {
+    BinaryImage *image           = m_program->getBinaryFile()->getImage();
+    const BinarySection *section = image ? image->getSectionByAddr(pc) : nullptr;
+
+    if (section == nullptr) {
         LOG_ERROR("Attempted to disassemble outside any known section at address %1", pc);
         return false;
     }
-
-    const BinarySection *section = image->getSectionByAddr(pc);
-    if (section->getHostAddr() == HostAddress::INVALID) {
+    else if (section->getHostAddr() == HostAddress::INVALID) {
         LOG_ERROR("Attempted to disassemble instruction in unmapped section '%1' at address %2",
                   section->getName(), pc);
         return false;
@@ -1270,6 +1285,49 @@ UserProc *DefaultFrontEnd::createFunctionForEntryPoint(Address entryAddr,
 }
 
 
+void DefaultFrontEnd::createFunctionsFromDebugInfo()
+{
+    const BinaryFile *binaryFile = m_program->getBinaryFile();
+    if (!binaryFile->hasDebugInfo()) {
+        return;
+    }
+
+    int numCreated = 0;
+
+    for (Address addr : binaryFile->getDebugFunctions()) {
+        if (m_program->getFunctionByAddr(addr) == nullptr) {
+            m_program->getOrCreateFunction(addr);
+            numCreated++;
+        }
+    }
+
+    LOG_MSG("Debug information describes %1 new procedures", numCreated);
+}
+
+
+void DefaultFrontEnd::createFunctionsFromSweep()
+{
+    const FunctionSweeper sweeper(m_program->getBinaryFile()->getImage(),
+                                  m_program->getMachine());
+
+    if (!sweeper.isSupported()) {
+        LOG_WARN("Linear sweep is not supported for this machine");
+        return;
+    }
+
+    int numCreated = 0;
+
+    for (Address addr : sweeper.findFunctionStarts()) {
+        if (m_program->getFunctionByAddr(addr) == nullptr) {
+            m_program->getOrCreateFunction(addr);
+            numCreated++;
+        }
+    }
+
+    LOG_MSG("Linear sweep found %1 new procedures", numCreated);
+}
+
+
 Address DefaultFrontEnd::getAddrOfLibraryThunk(const std::shared_ptr<CallStatement> &call,
                                                UserProc *proc)
 {
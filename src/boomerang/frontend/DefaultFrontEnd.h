@@ -157,6 +157,14 @@ private:
     /// Returns nullptr on failure.
     UserProc *createFunctionForEntryPoint(Address entryAddr, const QString &functionType);
 
+    /// Create procedures for all functions described by the debug information
+    /// of the binary file.
+    void createFunctionsFromDebugInfo();
+
+    /// Create procedures for all function starts found by a linear sweep of the code sections,
+    /// so they are disassembled even if they are not reachable from the entry points.
+    void createFunctionsFromSweep();
+
     /**
      * Get the address of the destination of a library thunk.
      * Returns Address::INVALID if the call is not a library thunk or an error occurred.
@@ -0,0 +1,268 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FunctionSweeper.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/util/ByteUtil.h"
+#include "boomerang/util/ParallelFor.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+
+
+namespace
+{
+const Address::value_type CHUNK_SIZE = 0x10000;
+
+const int SCORE_CALLED      = 3; ///< Target of at least one direct call
+const int SCORE_CALLED_MANY = 2; ///< Target of more than one direct call (in addition)
+const int SCORE_PROLOGUE    = 3;
+const int SCORE_PADDING     = 2;
+
+/// A single feature is not enough evidence for a function start
+const int MIN_SCORE = 4;
+
+const Address::value_type X86_FUNCTION_ALIGNMENT = 16;
+
+/// Longer runs of padding bytes are not alignment padding
+const std::size_t MAX_PADDING = 64;
+
+
+bool isX86Padding(Byte b)
+{
+    return b == 0xCC || b == 0x90; // int3, nop
+}
+
+
+/// \returns true if the byte sequence \p pattern of length \p len is at \p data[pos]
+bool matches(const Byte *data, std::size_t size, std::size_t pos, const Byte *pattern,
+             std::size_t len)
+{
+    return pos + len <= size && std::equal(pattern, pattern + len, data + pos);
+}
+}
+
+
+FunctionSweeper::FunctionSweeper(const BinaryImage *image, Machine machine)
+    : m_image(image)
+    , m_machine(machine)
+{
+}
+
+
+bool FunctionSweeper::isSupported() const
+{
+    return m_machine == Machine::X86 || m_machine == Machine::PPC;
+}
+
+
+std::vector<Address> FunctionSweeper::findFunctionStarts(int numThreads) const
+{
+    if (!m_image || !isSupported()) {
+        return {};
+    }
+
+    std::vector<Chunk> chunks;
+
+    for (const BinarySection *section : *m_image) {
+        if (!section->isCode() || section->getHostAddr() == HostAddress::INVALID ||
+            section->getSize() <= 0) {
+            continue;
+        }
+
+        const Address base             = section->getSourceAddr();
+        const Address::value_type size = section->getSize();
+
+        for (Address::value_type offset = 0; offset < size; offset += CHUNK_SIZE) {
+            const Address::value_type end = std::min(offset + CHUNK_SIZE, size);
+            chunks.push_back({ section, base + offset, base + end });
+        }
+    }
+
+    if (chunks.empty()) {
+        return {};
+    }
+
+    // Chunks are independent; each one is scanned by exactly one thread
+    // into its own result list, so no locking is needed.
+    std::vector<std::vector<Candidate>> chunkResults(chunks.size());
+
+    Util::parallelFor(chunks.size(), numThreads,
+                      [&](std::size_t idx) { scanChunk(chunks[idx], chunkResults[idx]); });
+
+    std::vector<Candidate> candidates;
+    for (const std::vector<Candidate> &result : chunkResults) {
+        candidates.insert(candidates.end(), result.begin(), result.end());
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.addr < b.addr;
+    });
+
+    std::vector<Address> starts;
+
+    for (auto it = candidates.begin(); it != candidates.end();) {
+        const Address addr = it->addr;
+        int numCalls       = 0;
+        bool hasPrologue   = false;
+        bool hasPadding    = false;
+
+        for (; it != candidates.end() && it->addr == addr; ++it) {
+            switch (it->feature) {
+            case Feature::Call: numCalls++; break;
+            case Feature::Prologue: hasPrologue = true; break;
+            case Feature::Padding: hasPadding = true; break;
+            }
+        }
+
+        int score = 0;
+        score += (numCalls > 0) ? SCORE_CALLED : 0;
+        score += (numCalls > 1) ? SCORE_CALLED_MANY : 0;
+        score += hasPrologue ? SCORE_PROLOGUE : 0;
+        score += hasPadding ? SCORE_PADDING : 0;
+
+        if (score >= MIN_SCORE && isValidStart(addr)) {
+            starts.push_back(addr);
+        }
+    }
+
+    LOG_VERBOSE("Linear sweep of %1 chunks found %2 function candidates", chunks.size(),
+                starts.size());
+
+    return starts;
+}
+
+
+void FunctionSweeper::scanChunk(const Chunk &chunk, std::vector<Candidate> &result) const
+{
+    switch (m_machine) {
+    case Machine::X86: scanChunkX86(chunk, result); break;
+    case Machine::PPC: scanChunkPPC(chunk, result); break;
+    default: break;
+    }
+}
+
+
+void FunctionSweeper::scanChunkX86(const Chunk &chunk, std::vector<Candidate> &result) const
+{
+    static const Byte pushMovEBP1[] = { 0x55, 0x89, 0xE5 };             // push ebp; mov ebp, esp
+    static const Byte pushMovEBP2[] = { 0x55, 0x8B, 0xEC };             // push ebp; mov ebp, esp
+    static const Byte hotPatch[]    = { 0x8B, 0xFF, 0x55, 0x8B, 0xEC }; // mov edi, edi; ...
+
+    const BinarySection *section = chunk.section;
+    const Byte *data   = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+    const Address base = section->getSourceAddr();
+    const std::size_t size  = section->getSize();
+    const std::size_t first = (chunk.from - base).value();
+    const std::size_t last  = (chunk.to - base).value();
+
+    for (std::size_t i = first; i < last; i++) {
+        const Address addr = base + i;
+
+        // call rel32
+        if (data[i] == 0xE8 && i + 5 <= size) {
+            const int32_t disp = static_cast<int32_t>(Util::readDWord(data + i + 1,
+                                                                      Endian::Little));
+            result.push_back({ addr + 5 + disp, Feature::Call });
+        }
+
+        if (matches(data, size, i, hotPatch, sizeof(hotPatch))) {
+            result.push_back({ addr, Feature::Prologue });
+        }
+        else if (matches(data, size, i, pushMovEBP1, sizeof(pushMovEBP1)) ||
+                 matches(data, size, i, pushMovEBP2, sizeof(pushMovEBP2))) {
+            // do not report the inner sequence of a hot patch prologue
+            if (i < 2 || data[i - 2] != 0x8B || data[i - 1] != 0xFF) {
+                result.push_back({ addr, Feature::Prologue });
+            }
+        }
+
+        // Compilers align function starts, and pad the gap after the last return or jump
+        // of the previous function.
+        if (i > 0 && (addr.value() % X86_FUNCTION_ALIGNMENT) == 0 && !isX86Padding(data[i])) {
+            std::size_t j = i;
+            while (j > 0 && i - j < MAX_PADDING && isX86Padding(data[j - 1])) {
+                j--;
+            }
+
+            const bool afterRet     = j >= 1 && data[j - 1] == 0xC3;           // ret
+            const bool afterRetImm  = j >= 3 && data[j - 3] == 0xC2;           // ret imm16
+            const bool afterJmp     = j >= 5 && data[j - 5] == 0xE9;           // jmp rel32
+            const bool afterJmpNear = j >= 2 && data[j - 2] == 0xEB && j != i; // jmp rel8
+
+            if (afterRet || afterRetImm || afterJmp || afterJmpNear) {
+                result.push_back({ addr, Feature::Padding });
+            }
+        }
+    }
+}
+
+
+void FunctionSweeper::scanChunkPPC(const Chunk &chunk, std::vector<Candidate> &result) const
+{
+    const DWord STWU_R1_MASK = 0xFFFF8000; // stwu r1, -N(r1)
+    const DWord STWU_R1      = 0x94218000;
+    const DWord MFLR_R0      = 0x7C0802A6;
+    const DWord BLR          = 0x4E800020;
+    const DWord NOP          = 0x60000000;
+
+    const BinarySection *section = chunk.section;
+    const Byte *data   = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+    const Address base = section->getSourceAddr();
+    const Endian endian     = section->getEndian();
+    const std::size_t size  = section->getSize() & ~std::size_t(3);
+    const std::size_t first = ((chunk.from - base).value() + 3) & ~Address::value_type(3);
+    const std::size_t last  = std::min<std::size_t>((chunk.to - base).value(), size);
+
+    for (std::size_t i = first; i < last; i += 4) {
+        const Address addr = base + i;
+        const DWord insn   = Util::readDWord(data + i, endian);
+
+        // bl target
+        if ((insn & 0xFC000003) == 0x48000001) {
+            int32_t disp = insn & 0x03FFFFFC;
+            if (disp & 0x02000000) {
+                disp |= 0xFC000000; // sign extend
+            }
+
+            result.push_back({ addr + disp, Feature::Call });
+        }
+
+        const DWord prev = (i >= 4) ? Util::readDWord(data + i - 4, endian) : 0;
+
+        if ((insn & STWU_R1_MASK) == STWU_R1) {
+            result.push_back({ addr, Feature::Prologue });
+        }
+        else if (insn == MFLR_R0 && (prev & STWU_R1_MASK) != STWU_R1) {
+            result.push_back({ addr, Feature::Prologue });
+        }
+
+        if (insn != NOP) {
+            std::size_t j = i;
+            while (j >= 4 && i - j < MAX_PADDING && Util::readDWord(data + j - 4, endian) == NOP) {
+                j -= 4;
+            }
+
+            if (j >= 4 && Util::readDWord(data + j - 4, endian) == BLR) {
+                result.push_back({ addr, Feature::Padding });
+            }
+        }
+    }
+}
+
+
+bool FunctionSweeper::isValidStart(Address addr) const
+{
+    const BinarySection *section = m_image->getSectionByAddr(addr);
+
+    return section && section->isCode() && section->getHostAddr() != HostAddress::INVALID &&
+           !section->hasFlag(SectionFlag::ImportThunk, addr);
+}
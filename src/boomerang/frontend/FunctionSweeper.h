@@ -0,0 +1,82 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/util/Address.h"
+
+#include <vector>
+
+
+class BinaryImage;
+class BinarySection;
+
+
+/**
+ * Finds likely function entry points by a linear sweep over the code sections of an image,
+ * without following control flow. This is mostly useful for stripped binaries,
+ * where recursive descent from the entry point misses functions that are only called
+ * indirectly.
+ *
+ * The code sections are split into chunks that are scanned in parallel for
+ * direct call targets, function prologues and returns followed by alignment padding.
+ * Each candidate address is scored by these features; only addresses with a high enough
+ * score are reported.
+ */
+class BOOMERANG_API FunctionSweeper
+{
+public:
+    /// Features of a function entry point found by the sweep
+    enum class Feature : uint8_t
+    {
+        Call,     ///< Target of a direct call
+        Prologue, ///< Starts with a stack frame setup sequence
+        Padding   ///< Follows a return or jump and alignment padding
+    };
+
+    struct Candidate
+    {
+        Address addr;
+        Feature feature;
+    };
+
+public:
+    FunctionSweeper(const BinaryImage *image, Machine machine);
+
+public:
+    /// \returns true if function starts can be found for the machine of the image.
+    bool isSupported() const;
+
+    /// Sweep all code sections of the image using up to \p numThreads threads
+    /// (0 for one thread per hardware thread).
+    /// \returns the likely function starts, sorted by address.
+    std::vector<Address> findFunctionStarts(int numThreads = 0) const;
+
+private:
+    struct Chunk
+    {
+        const BinarySection *section;
+        Address from; ///< first address to scan
+        Address to;   ///< end of the addresses to scan; reads may extend to the section end
+    };
+
+    void scanChunk(const Chunk &chunk, std::vector<Candidate> &result) const;
+    void scanChunkX86(const Chunk &chunk, std::vector<Candidate> &result) const;
+    void scanChunkPPC(const Chunk &chunk, std::vector<Candidate> &result) const;
+
+    /// \returns true if \p addr can be the start of a function, i.e. is in a code section
+    /// and not in an import stub.
+    bool isValidStart(Address addr) const;
+
+private:
+    const BinaryImage *m_image;
+    Machine m_machine;
+};
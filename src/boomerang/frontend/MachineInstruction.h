@@ -14,6 +14,7 @@
 #include "boomerang/ssl/Register.h"
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/util/Address.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/Types.h"
 
 #include <array>
@@ -35,7 +36,7 @@ enum class MIGroup
 };
 
 
-class BOOMERANG_API MachineInstruction
+class BOOMERANG_API MachineInstruction : private IRCounted<IRObjectKind::MachineInstruction>
 {
 public:
     Address m_addr;     ///< Address (IP) of the instruction
@@ -13,8 +13,11 @@
 #include "boomerang/db/binary/BinaryFile.h"
 #include "boomerang/db/binary/BinaryImage.h"
 
+#include <vector>
+
 
 class Project;
+class Signature;
 
 class QIODevice;
 
@@ -90,5 +93,27 @@ public:
         Q_UNUSED(addr);
         return Address::INVALID;
     }
+
+public:
+    /// Debug information functions
     virtual bool hasDebugInfo() const { return false; }
+
+    /// \returns the entry addresses of all functions described by the debug information.
+    virtual std::vector<Address> getDebugFunctions() const { return {}; }
+
+    /// \returns the signature of the function starting at \p entry
+    /// according to the debug information, or nullptr if it is not known.
+    virtual std::shared_ptr<Signature> getDebugSignature(Address entry) const
+    {
+        Q_UNUSED(entry);
+        return nullptr;
+    }
+
+    /// \returns the type of the global variable at \p addr
+    /// according to the debug information, or nullptr if it is not known.
+    virtual SharedType getDebugGlobalType(Address addr) const
+    {
+        Q_UNUSED(addr);
+        return nullptr;
+    }
 };
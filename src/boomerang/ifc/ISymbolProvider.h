@@ -35,6 +35,10 @@ public:
     /// \returns true on success.
     virtual bool readLibraryCatalog(const Prog *prog, const QString &fileName) = 0;
 
+    /// Forget the signatures of all catalogs read so far, e.g. before the catalogs
+    /// of a different program are read.
+    virtual void clearLibrarySignatures() = 0;
+
     /// Add symbol information from a symbol file to the program.
     /// \returns true on success.
     virtual bool addSymbolsFromSymbolFile(Prog *prog, const QString &fileName) = 0;
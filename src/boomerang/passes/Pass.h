@@ -65,7 +65,18 @@ public:
     /// This means that procLocal passes can be executed for each function in parallel.
     virtual bool isProcLocal() const { return false; }
 
+    /// \returns false iff the pass does not change any statements the proof engine depends on
+    /// (e.g. because it only proves facts about the function).
+    /// Cached proofs of the function are discarded after running a pass that returns true.
+    virtual bool invalidatesProofs() const { return true; }
+
+    /// \returns true iff the pass only improves the quality of the decompiled code.
+    /// Optional passes are skipped for procedures that exceeded their budget (see ProcBudget).
+    virtual bool isOptional() const { return false; }
+
     /// Run this pass, updating \p proc
+    /// \note A pass can be executed for several procedures concurrently
+    /// (see ProgDecompiler::globalTypeAnalysis), so it must not keep state in members.
     /// \returns true iff any change
     virtual bool execute(UserProc *proc) = 0;
 
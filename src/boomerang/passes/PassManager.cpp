@@ -11,6 +11,7 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProofCache.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/call/CallArgumentUpdatePass.h"
 #include "boomerang/passes/call/CallDefineUpdatePass.h"
@@ -38,15 +39,37 @@
 #include "boomerang/passes/middle/PreservationAnalysisPass.h"
 #include "boomerang/passes/middle/SPPreservationPass.h"
 #include "boomerang/passes/middle/StrengthReductionReversalPass.h"
+#include "boomerang/ssl/RTL.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QElapsedTimer>
+
 #include <cassert>
 
 
 static PassManager g_passManager;
 
 
+/// \returns the number of statements in \p proc, i.e. the work units of running a pass on it
+static qint64 countStatements(const UserProc *proc)
+{
+    qint64 numStmts = 0;
+
+    for (const IRFragment *frag : *proc->getCFG()) {
+        if (!frag->getRTLs()) {
+            continue;
+        }
+
+        for (const auto &rtl : *frag->getRTLs()) {
+            numStmts += rtl->size();
+        }
+    }
+
+    return numStmts;
+}
+
+
 PassManager::PassManager()
 {
     m_passes.resize(static_cast<size_t>(PassID::NUM_PASSES));
@@ -106,10 +129,33 @@ bool PassManager::executePass(PassID passID, UserProc *proc)
 bool PassManager::executePass(IPass *pass, UserProc *proc)
 {
     assert(pass != nullptr);
+
+    ProcBudget *budget = proc->getBudget();
+    if (budget->isExceeded() && pass->isOptional()) {
+        LOG_VERBOSE("Skipping pass '%1' for '%2' (budget exceeded)", pass->getName(),
+                    proc->getName());
+        return false;
+    }
+
     LOG_VERBOSE("Executing pass '%1' for '%2'", pass->getName(), proc->getName());
 
+    QElapsedTimer timer;
+    timer.start();
+
     const bool change = pass->execute(proc);
 
+    if (budget->hasLimits() &&
+        budget->charge(timer.elapsed(), countStatements(proc), pass->getName())) {
+        LOG_WARN("Procedure '%1' exceeded its decompilation budget in pass '%2' "
+                 "(%3 ms, %4 work units); skipping optional passes from now on",
+                 proc->getName(), pass->getName(), budget->getTimeSpent(),
+                 budget->getWorkSpent());
+    }
+
+    if (pass->invalidatesProofs() && proc->getProg()) {
+        proc->getProg()->getProofCache()->invalidate(proc);
+    }
+
     if (Log::getOrCreateLog().getLogLevel() >= LogLevel::Verbose1) {
         const QString msg = QString("after executing pass '%1'").arg(pass->getName());
         proc->debugPrintAll(msg);
@@ -33,6 +33,8 @@ public:
     PassManager &operator=(const PassManager &) = delete;
     PassManager &operator=(PassManager &&) = delete;
 
+    /// \returns the pass manager. The passes are shared by all threads
+    /// analysing procedures in parallel, so they must not have state (see IPass::execute).
     static PassManager *get();
 
 public:
@@ -34,7 +34,7 @@ bool CallDefineUpdatePass::execute(UserProc *proc)
 
     bool changed = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (!s->isCall()) {
             continue;
         }
@@ -76,7 +76,7 @@ bool CallDefineUpdatePass::updateCallDefines(UserProc *proc,
         const StatementList
             &modifieds = static_cast<UserProc *>(callee)->getRetStmt()->getModifieds();
 
-        for (SharedStmt mm : modifieds) {
+        for (const SharedStmt &mm : modifieds) {
             std::shared_ptr<Assignment> as = mm->as<Assignment>();
             SharedExp loc                  = as->getLeft();
 
@@ -107,7 +107,7 @@ bool CallDefineUpdatePass::updateCallDefines(UserProc *proc,
         }
     }
 
-    for (SharedStmt stmt : newDefines) {
+    for (const SharedStmt &stmt : newDefines) {
         // Make sure the LHS is still in the return or collector
         std::shared_ptr<Assignment> as = stmt->as<Assignment>();
         SharedExp lhs                  = as->getLeft();
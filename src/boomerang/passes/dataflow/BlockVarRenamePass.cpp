@@ -11,6 +11,7 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/DataFlow.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Const.h"
@@ -25,16 +26,12 @@
 
 static const SharedExp defineAll = Terminal::get(opDefineAll); // An expression representing <all>
 
-// There is an entry in stacks[defineAll] that represents the latest definition
+// There is a stack for defineAll whose top represents the latest definition
 // from a define-all source. It is needed for variables that don't have a definition as yet
-// (i.e. stacks[x].empty() is true). As soon as a real definition to x appears,
-// stacks[defineAll] does not apply for variable x. This is needed to get correct
+// (i.e. the stack of x is empty). As soon as a real definition to x appears,
+// the stack of defineAll does not apply for variable x. This is needed to get correct
 // operation of the use collectors in calls.
 
-// Care with the Stacks object (a map from expression to stack);
-// using Stacks[q].empty() can needlessly insert an empty stack
-#define STACKS_EMPTY(q) (stacks.find(q) == stacks.end() || stacks[q].empty())
-
 
 BlockVarRenamePass::BlockVarRenamePass()
     : IPass("BlockVarRename", PassID::BlockVarRename)
@@ -50,22 +47,22 @@ bool BlockVarRenamePass::execute(UserProc *proc)
         return false;
     }
 
+    DefStacks defStacks(proc->getDataFlow()->getLocationTable());
+
     const FragIndex entryIdx = proc->getDataFlow()->fragToIdx(entryFrag);
-    const bool changed       = renameBlockVars(proc, entryIdx);
+    const bool changed       = renameBlockVars(proc, entryIdx, defStacks);
 
 #ifndef NDEBUG
-    for (auto &[var, stack] : stacks) {
-        Q_UNUSED(var);
+    for (const std::vector<SharedStmt> &stack : defStacks.stacks) {
         assert(stack.empty());
     }
 #endif
 
-    stacks.clear();
     return changed;
 }
 
 
-bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
+bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n, DefStacks &defStacks)
 {
     if (proc->getCFG()->getNumFragments() == 0) {
         return false;
@@ -98,7 +95,7 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
     }
 
     for (SharedStmt stmt = frag->getFirstStmt(rit, sit); stmt; stmt = frag->getNextStmt(rit, sit)) {
-        changed |= subscriptUsedLocations(stmt);
+        changed |= subscriptUsedLocations(stmt, defStacks);
 
         // MVE: Check for Call and Return Statements;
         // these have DefCollector objects that need to be updated
@@ -113,10 +110,10 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
                 col = stmt->as<ReturnStatement>()->getCollector();
             }
 
-            col->updateDefs(stacks, proc);
+            col->updateDefs(defStacks.locations, defStacks.stacks, proc);
         }
 
-        pushDefinitions(stmt, assumeABICompliance);
+        pushDefinitions(stmt, assumeABICompliance, defStacks);
     }
 
     // For each successor Y of block n
@@ -138,26 +135,14 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
                 continue;
             }
 
-            SharedStmt def = nullptr; // assume No reaching definition
-
-            if (!STACKS_EMPTY(a)) {
-                def = stacks[a].top();
-            }
-
             // "Replace jth operand with a_i"
-            pa->putAt(frag, def, a);
+            pa->putAt(frag, defStacks.getLastDef(a), a);
         }
     }
 
-    // For each child X of n
-    // Note: linear search!
-    const std::size_t numFrags = proc->getCFG()->getNumFragments();
-
-    for (FragIndex X = 0; X < numFrags; ++X) {
-        const FragIndex idom = proc->getDataFlow()->getIdom(X);
-        if (idom == n && X != n) { // if 'n' is immediate dominator of X
-            renameBlockVars(proc, X);
-        }
+    // For each child X of n in the dominator tree
+    for (FragIndex X : proc->getDataFlow()->getDominatedChildren(n)) {
+        renameBlockVars(proc, X, defStacks);
     }
 
     // NOTE: Because of the need to pop childless calls from the Stacks, it is important in my
@@ -168,7 +153,7 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
     StatementList::reverse_iterator srit;
 
     for (SharedStmt S = frag->getLastStmt(rrit, srit); S; S = frag->getPrevStmt(rrit, srit)) {
-        popDefinitions(S, assumeABICompliance);
+        popDefinitions(S, assumeABICompliance, defStacks);
     }
 
     return changed;
@@ -185,7 +170,7 @@ void BlockVarRenamePass::subscriptVar(const SharedStmt &stmt, SharedExp var,
 }
 
 
-bool BlockVarRenamePass::subscriptUsedLocations(SharedStmt stmt)
+bool BlockVarRenamePass::subscriptUsedLocations(SharedStmt stmt, const DefStacks &defStacks)
 {
     bool changed   = false;
     UserProc *proc = stmt->getProc();
@@ -204,7 +189,7 @@ bool BlockVarRenamePass::subscriptUsedLocations(SharedStmt stmt)
         stmt->addUsedLocs(locs);
     }
 
-    for (SharedExp location : locs) {
+    for (const SharedExp &location : locs) {
         // Don't rename memOfs that are not renamable according to the current policy
         if (!proc->canRename(location)) {
             continue;
@@ -233,13 +218,13 @@ bool BlockVarRenamePass::subscriptUsedLocations(SharedStmt stmt)
             continue; // Don't re-rename the renamed variable
         }
 
-        if (!STACKS_EMPTY(location)) {
-            def = stacks[location].top();
-        }
-        else if (!STACKS_EMPTY(defineAll)) {
-            def = stacks[defineAll].top();
+        def = defStacks.getLastDef(location);
+
+        if (!def) {
+            def = defStacks.getLastDef(defineAll);
         }
-        else {
+
+        if (!def) {
             // If the both stacks are empty, use a nullptr definition. This will be changed
             // into a pointer to an implicit definition at the start of type analysis, but
             // not until all the m[...] have stopped changing their expressions (complicates
@@ -272,14 +257,15 @@ bool BlockVarRenamePass::subscriptUsedLocations(SharedStmt stmt)
 }
 
 
-void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABICompliance)
+void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABICompliance,
+                                         DefStacks &defStacks)
 {
     UserProc *proc = stmt->getProc();
 
     LocationSet defs;
     stmt->getDefinitions(defs, assumeABICompliance);
 
-    for (SharedExp a : defs) {
+    for (const SharedExp &a : defs) {
         // Don't consider a if it cannot be renamed
         const bool suitable = proc->canRename(a);
 
@@ -288,13 +274,8 @@ void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABIComplian
             // Note: we clone a because otherwise it could be an expression
             // that gets deleted through various modifications.
             // This is necessary because we do several passes of this algorithm
-            // to sort out the memory expressions.
-            if (stacks.find(a) != stacks.end()) { // expression exists, no need for clone ?
-                stacks[a].push(stmt);
-            }
-            else {
-                stacks[a->clone()].push(stmt);
-            }
+            // to sort out the memory expressions. The location table does this for us.
+            defStacks.getStack(a).push_back(stmt);
 
             // Replace definition of 'a' with definition of a_i in S (we don't do this)
         }
@@ -306,7 +287,7 @@ void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABIComplian
 
             // Stacks already has a definition for a (as just the bare local)
             if (suitable) {
-                stacks[a1->clone()].push(stmt);
+                defStacks.getStack(a1->clone()).push_back(stmt);
             }
         }
     }
@@ -316,17 +297,17 @@ void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABIComplian
     if (stmt->isCall() && stmt->as<CallStatement>()->isChildless() &&
         !proc->getProg()->getProject()->getSettings()->assumeABI) {
         // S is a childless call (and we're not assuming ABI compliance)
-        stacks[defineAll]; // Ensure that there is an entry for defineAll
+        defStacks.getStack(defineAll); // Ensure that there is a stack for defineAll
 
-        for (auto &elem : stacks) {
-            // if (dd->first->isMemDepth(memDepth))
-            elem.second.push(stmt); // Add a definition for all vars
+        for (LocIndex loc : defStacks.stackLocs) {
+            defStacks.stacks[loc].push_back(stmt); // Add a definition for all vars
         }
     }
 }
 
 
-void BlockVarRenamePass::popDefinitions(SharedStmt stmt, bool assumeABICompliance)
+void BlockVarRenamePass::popDefinitions(SharedStmt stmt, bool assumeABICompliance,
+                                        DefStacks &defStacks)
 {
     UserProc *proc = stmt->getProc();
 
@@ -339,22 +320,52 @@ void BlockVarRenamePass::popDefinitions(SharedStmt stmt, bool assumeABIComplianc
             continue;
         }
 
-        auto stackIt = stacks.find(def);
-        if (stackIt == stacks.end() || stackIt->second.empty()) {
+        const LocIndex loc = defStacks.locations.find(def);
+        if (loc >= defStacks.stacks.size() || defStacks.stacks[loc].empty()) {
             LOG_FATAL("Tried to pop '%1' from Stacks; does not exist", def);
         }
 
-        stackIt->second.pop();
+        defStacks.stacks[loc].pop_back();
     }
 
     // Pop all defs due to childless calls
     if (stmt->isCall() && stmt->as<CallStatement>()->isChildless()) {
-        for (auto &[var, lastDef] : stacks) {
-            Q_UNUSED(var);
+        for (LocIndex loc : defStacks.stackLocs) {
+            std::vector<SharedStmt> &lastDef = defStacks.stacks[loc];
 
-            if (!lastDef.empty() && (lastDef.top() == stmt)) {
-                lastDef.pop();
+            if (!lastDef.empty() && (lastDef.back() == stmt)) {
+                lastDef.pop_back();
             }
         }
     }
 }
+
+
+std::vector<SharedStmt> &BlockVarRenamePass::DefStacks::getStack(const SharedExp &var)
+{
+    const LocIndex loc = locations.insert(var);
+
+    if (stacks.size() <= loc) {
+        stacks.resize(loc + 1);
+        hasStack.resize(loc + 1, false);
+    }
+
+    if (!hasStack[loc]) {
+        hasStack[loc] = true;
+        stackLocs.push_back(loc);
+    }
+
+    return stacks[loc];
+}
+
+
+SharedStmt BlockVarRenamePass::DefStacks::getLastDef(const SharedExp &var) const
+{
+    const LocIndex loc = locations.find(var);
+
+    if (loc >= stacks.size() || stacks[loc].empty()) {
+        return nullptr;
+    }
+
+    return stacks[loc].back();
+}
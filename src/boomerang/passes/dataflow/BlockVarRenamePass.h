@@ -10,12 +10,12 @@
 #pragma once
 
 
+#include "boomerang/db/LocationTable.h"
 #include "boomerang/passes/Pass.h"
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/ssl/statements/Statement.h"
 
-#include <map>
-#include <stack>
+#include <vector>
 
 
 /// Rewrites Statements in BasicBlocks into SSA form.
@@ -29,20 +29,45 @@ public:
     bool execute(UserProc *proc) override;
 
 private:
-    bool renameBlockVars(UserProc *proc, std::size_t n);
+    /// The definitions of all locations of the procedure being renamed. This is not part
+    /// of the pass itself, since a pass can be executed for several procedures concurrently.
+    struct DefStacks
+    {
+        explicit DefStacks(LocationTable &locs)
+            : locations(locs)
+        {
+        }
+
+        /// \returns the stack of definitions of \p var, creating it if it does not exist.
+        std::vector<SharedStmt> &getStack(const SharedExp &var);
+
+        /// \returns the last definition of \p var, or nullptr if there is none.
+        SharedStmt getLastDef(const SharedExp &var) const;
+
+        /// Dense indices of the locations of the procedure
+        LocationTable &locations;
+
+        /// For each location index, the definitions of the location; the last definition is on
+        /// top.
+        std::vector<std::vector<SharedStmt>> stacks;
+
+        /// Indices of all locations that have a stack, in order of creation.
+        /// Stacks of other locations are always empty.
+        std::vector<LocIndex> stackLocs;
+        std::vector<bool> hasStack;
+    };
+
+private:
+    bool renameBlockVars(UserProc *proc, std::size_t n, DefStacks &defStacks);
 
     /// For all expressions in \p stmt, replace \p var with var{varDef}
     void subscriptVar(const SharedStmt &stmt, SharedExp var, const SharedStmt &varDef);
 
-    bool subscriptUsedLocations(SharedStmt stmt);
+    bool subscriptUsedLocations(SharedStmt stmt, const DefStacks &defStacks);
 
     /// push definitions in this statement onto the stacks
-    void pushDefinitions(SharedStmt stmt, bool assumeABI);
+    void pushDefinitions(SharedStmt stmt, bool assumeABI, DefStacks &defStacks);
 
     /// pop definitions in this statement from the stacks
-    void popDefinitions(SharedStmt stmt, bool assumeABI);
-
-private:
-    /// stores the last definition of a variable
-    std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> stacks;
+    void popDefinitions(SharedStmt stmt, bool assumeABI, DefStacks &defStacks);
 };
@@ -35,7 +35,7 @@ bool GlobalConstReplacePass::execute(UserProc *proc)
     const BinarySymbolTable *syms = proc->getProg()->getBinaryFile()->getSymbols();
     bool changed                  = false;
 
-    for (SharedStmt st : stmts) {
+    for (const SharedStmt &st : stmts) {
         std::shared_ptr<Assign> assgn = std::dynamic_pointer_cast<Assign>(st);
 
         if (assgn == nullptr) {
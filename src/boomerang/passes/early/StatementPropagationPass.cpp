@@ -36,7 +36,7 @@ bool StatementPropagationPass::execute(UserProc *proc)
     std::map<SharedExp, int, lessExpStar> destCounts;
 
     // Also maintain a set of locations which are used by phi statements
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         ExpDestCounter edc(destCounts);
         StmtDestCounter sdc(&edc);
         s->accept(&sdc);
@@ -46,7 +46,7 @@ bool StatementPropagationPass::execute(UserProc *proc)
     // (these must be propagated even if it results in extra locals)
     bool change = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (!s->isPhi()) {
             change |= s->propagateFlagsToThis();
         }
@@ -54,7 +54,7 @@ bool StatementPropagationPass::execute(UserProc *proc)
 
     // Finally the actual propagation
     const int propMaxDepth = proc->getProg()->getProject()->getSettings()->propMaxDepth;
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (!s->isPhi()) {
             change |= s->propagateToThis(propMaxDepth, &destCounts);
         }
@@ -23,6 +23,9 @@ public:
     StatementPropagationPass();
 
 public:
+    /// \copydoc IPass::isOptional
+    bool isOptional() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
@@ -32,6 +32,9 @@ public:
     BranchAnalysisPass();
 
 public:
+    /// \copydoc IPass::isOptional
+    bool isOptional() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
@@ -42,7 +42,7 @@ bool FromSSAFormPass::execute(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         // Map registers to initial local variables
         mapRegistersToLocals(s);
 
@@ -62,11 +62,11 @@ bool FromSSAFormPass::execute(UserProc *proc)
     ConnectionGraph pu; // The Phi Unites: these need the same local variable or copies
     const bool assumeABICompliance = proc->getProg()->getProject()->getSettings()->assumeABI;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         LocationSet defs;
         s->getDefinitions(defs, assumeABICompliance);
 
-        for (SharedExp defdByS : defs) {
+        for (const SharedExp &defdByS : defs) {
             SharedType ty = s->getTypeForExp(defdByS);
 
             if (ty == nullptr) { // Can happen e.g. when getting the type for %flags
@@ -243,7 +243,7 @@ bool FromSSAFormPass::execute(UserProc *proc)
     removeSubscriptsFromSymbols(proc);
     removeSubscriptsFromParameters(proc);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         // The last part of the fromSSA logic:
         // replace subscripted locations with suitable local variables
         ExpSSAXformer esx(proc);
@@ -263,7 +263,7 @@ void FromSSAFormPass::nameParameterPhis(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt insn : stmts) {
+    for (const SharedStmt &insn : stmts) {
         if (!insn->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -377,7 +377,7 @@ void FromSSAFormPass::findPhiUnites(UserProc *proc, ConnectionGraph &pu)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : stmts) {
         if (!stmt->isPhi()) {
             continue;
         }
@@ -422,7 +422,7 @@ void FromSSAFormPass::removePhis(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (!s->isPhi()) {
             continue;
         }
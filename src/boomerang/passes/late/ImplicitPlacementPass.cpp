@@ -28,7 +28,7 @@ bool ImplicitPlacementPass::execute(UserProc *proc)
     ImplicitConverter ic(proc->getCFG());
     StmtImplicitConverter sm(&ic, proc->getCFG());
 
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : stmts) {
         stmt->accept(&sm);
     }
 
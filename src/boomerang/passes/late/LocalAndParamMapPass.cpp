@@ -30,7 +30,7 @@ bool LocalAndParamMapPass::execute(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         DfaLocalMapper dlm(proc);
         StmtModifier sm(&dlm, true); // True to ignore def collector in return statement
 
@@ -20,6 +20,9 @@ public:
     LocalTypeAnalysisPass();
 
 public:
+    /// \copydoc IPass::isOptional
+    bool isOptional() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 };
@@ -39,11 +39,11 @@ bool UnusedLocalRemovalPass::execute(UserProc *proc)
     // First count any uses of the locals
     bool all = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         LocationSet locs;
         all |= addUsedLocalsForStmt(s, locs);
 
-        for (SharedExp u : locs) {
+        for (const SharedExp &u : locs) {
             // Must be a real symbol, and not defined in this statement, unless it is a return
             // statement (in which case it is used outside this procedure), or a call statement.
             // Consider local7 = local7+1 and return local7 = local7+1 and local7 = call(local7+1),
@@ -99,7 +99,7 @@ bool UnusedLocalRemovalPass::execute(UserProc *proc)
     // Remove any definitions of the removed locals
     const bool assumeABICompliance = proc->getProg()->getProject()->getSettings()->assumeABI;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         LocationSet ls;
         s->getDefinitions(ls, assumeABICompliance);
 
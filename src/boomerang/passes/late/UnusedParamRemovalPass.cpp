@@ -109,7 +109,7 @@ bool UnusedParamRemovalPass::checkForGainfulUse(UserProc *proc, SharedExp bparam
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         // Special checking for recursive calls
         if (s->isCall()) {
             std::shared_ptr<CallStatement> c = s->as<CallStatement>();
@@ -50,7 +50,7 @@ void UnusedStatementRemovalPass::updateRefCounts(UserProc *proc, RefCounter &ref
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         // Don't count uses in implicit statements. There is no RHS of course,
         // but you can still have x from m[x] on the LHS and so on, but these are not real uses
         if (s->isImplicit()) {
@@ -153,7 +153,7 @@ void UnusedStatementRemovalPass::remUnusedStmtEtc(UserProc *proc, RefCounter &re
                     }
                 }
 
-                for (SharedStmt refd : stmtsRefdByUnused) {
+                for (const SharedStmt &refd : stmtsRefdByUnused) {
                     if (refd == nullptr) {
                         continue;
                     }
@@ -197,7 +197,7 @@ bool UnusedStatementRemovalPass::removeNullStatements(UserProc *proc)
     proc->getStatements(stmts);
 
     // remove null code
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (s->isNullStatement()) {
             // A statement of the form x := x
             LOG_VERBOSE("Removing null statement: %1 %2", s->getNumber(), s);
@@ -49,7 +49,7 @@ bool AssignRemovalPass::removeSpAssigns(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : stmts) {
         if (stmt->isAssign() && (*stmt->as<Assign>()->getLeft() == *sp)) {
             foundone = true;
         }
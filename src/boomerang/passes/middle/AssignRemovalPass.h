@@ -24,6 +24,9 @@ public:
     AssignRemovalPass();
 
 public:
+    /// \copydoc IPass::isOptional
+    bool isOptional() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
@@ -19,6 +19,12 @@ public:
     PreservationAnalysisPass();
 
 public:
+    /// \copydoc IPass::invalidatesProofs
+    bool invalidatesProofs() const override { return false; }
+
+    /// \copydoc IPass::isOptional
+    bool isOptional() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 };
@@ -20,6 +20,9 @@ public:
     SPPreservationPass();
 
 public:
+    /// \copydoc IPass::invalidatesProofs
+    bool invalidatesProofs() const override { return false; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 };
@@ -29,7 +29,7 @@ bool StrengthReductionReversalPass::execute(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (!s->isAssign()) {
             continue;
         }
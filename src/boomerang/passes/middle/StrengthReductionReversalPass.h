@@ -19,6 +19,9 @@ public:
     StrengthReductionReversalPass();
 
 public:
+    /// \copydoc IPass::isOptional
+    bool isOptional() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 };
@@ -101,7 +101,7 @@ void RTL::print(OStream &os) const
     // First line has 8 extra chars as above
     bool firstStmt = true;
 
-    for (SharedStmt stmt : *this) {
+    for (const SharedStmt &stmt : *this) {
         if (firstStmt) {
             os << " ";
         }
@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/util/Address.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 #include <list>
 #include <memory>
@@ -26,7 +27,7 @@ class OStream;
  * \note when time permits, this class could be removed,
  * replaced with new Statements that mark the current native address
  */
-class BOOMERANG_API RTL
+class BOOMERANG_API RTL : private IRCounted<IRObjectKind::RTL>
 {
 public:
     typedef std::list<SharedStmt> StmtList;
@@ -10,6 +10,7 @@
 #include "RTLInstDict.h"
 
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDictCache.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
@@ -24,6 +25,8 @@
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QFile>
+
 
 RTLInstDict::RTLInstDict(bool verboseOutput)
     : m_verboseOutput(verboseOutput)
@@ -55,7 +58,7 @@ int RTLInstDict::insert(const QString &name, std::list<QString> &params, const R
 }
 
 
-bool RTLInstDict::readSSLFile(const QString &sslFileName)
+bool RTLInstDict::readSSLFile(const QString &sslFileName, bool useCache)
 {
     LOG_MSG("Loading machine specifications from '%1'...", sslFileName);
     // emptying the rtl dictionary
@@ -64,10 +67,24 @@ bool RTLInstDict::readSSLFile(const QString &sslFileName)
     // Clear all state
     reset();
 
-    SSL2ParserDriver drv(this);
+    QFile sslFile(sslFileName);
+    const QByteArray cacheKey = (useCache && sslFile.open(QFile::ReadOnly))
+                                    ? RTLInstDictCache::getCacheKey(sslFile.readAll())
+                                    : QByteArray();
+    const QString cachePath = !cacheKey.isEmpty() ? RTLInstDictCache::getCachePath(cacheKey)
+                                                  : QString();
+
+    if (RTLInstDictCache::read(cachePath, cacheKey, *this)) {
+        LOG_VERBOSE("Read expanded RTL template dictionary from '%1'", cachePath);
+    }
+    else {
+        SSL2ParserDriver drv(this);
+
+        if (drv.parse(sslFileName.toStdString()) != 0) {
+            return false;
+        }
 
-    if (drv.parse(sslFileName.toStdString()) != 0) {
-        return false;
+        RTLInstDictCache::write(cachePath, cacheKey, *this);
     }
 
     if (m_verboseOutput) {
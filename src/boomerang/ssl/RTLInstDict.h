@@ -40,6 +40,7 @@ class BOOMERANG_API RTLInstDict
 {
     friend class SSL2ParserDriver;
     friend class SSL2::parser;
+    friend class RTLInstDictCache;
 
 public:
     RTLInstDict(bool verboseOutput = false);
@@ -55,11 +56,14 @@ public:
     /**
      * Read and parse the SSL file, and initialise the expanded instruction dictionary
      * (this object). This also reads and sets up the register map and flag functions.
+     * If \p useCache is true and the dictionary of an identical SSL file was cached before,
+     * the cached dictionary is read instead of parsing the file (see \ref RTLInstDictCache).
      *
      * \param sslFileName the name of the file containing the SSL specification.
+     * \param useCache    read the dictionary from and write it to the user's cache directory.
      * \returns           true if the file was read successfully.
      */
-    bool readSSLFile(const QString &sslFileName);
+    bool readSSLFile(const QString &sslFileName, bool useCache = false);
 
     /**
      * Returns a new RTL containing the semantics of the instruction with name \p name.
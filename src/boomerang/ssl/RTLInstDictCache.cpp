@@ -0,0 +1,525 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RTLInstDictCache.h"
+
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/GotoStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+
+static const quint32 CACHE_MAGIC   = 0x42535343; // "BSSC"
+static const quint32 CACHE_VERSION = 1;          ///< Increment on every change of the format
+
+static const QDataStream::Version DATASTREAM_VERSION = QDataStream::Qt_5_0;
+
+
+/// Exp subclasses that can be stored in the cache
+enum class ExpTag : quint8
+{
+    Const    = 0,
+    Terminal = 1,
+    Unary    = 2,
+    Binary   = 3,
+    Ternary  = 4,
+    TypedExp = 5,
+    Location = 6
+};
+
+
+/// Thrown when a dictionary cannot be written to or read from the cache.
+class CacheError
+{
+};
+
+
+static void writeType(QDataStream &os, const SharedConstType &ty)
+{
+    os << static_cast<quint8>(ty->getId());
+
+    switch (ty->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char: return;
+
+    case TypeClass::Integer:
+        os << static_cast<quint64>(ty->getSize())
+           << static_cast<qint8>(ty->as<IntegerType>()->getSign());
+        return;
+
+    case TypeClass::Float:
+    case TypeClass::Size: os << static_cast<quint64>(ty->getSize()); return;
+
+    case TypeClass::Pointer: writeType(os, ty->as<PointerType>()->getPointsTo()); return;
+
+    default: break;
+    }
+
+    LOG_VERBOSE("Cannot store type '%1' in SSL cache", ty->getCtype());
+    throw CacheError();
+}
+
+
+static SharedType readType(QDataStream &is)
+{
+    quint8 id;
+    quint64 size;
+    is >> id;
+
+    switch (static_cast<TypeClass>(id)) {
+    case TypeClass::Void: return VoidType::get();
+    case TypeClass::Boolean: return BooleanType::get();
+    case TypeClass::Char: return CharType::get();
+
+    case TypeClass::Integer: {
+        qint8 sign;
+        is >> size >> sign;
+        return IntegerType::get(size, static_cast<Sign>(sign));
+    }
+
+    case TypeClass::Float: is >> size; return FloatType::get(size);
+    case TypeClass::Size: is >> size; return SizeType::get(size);
+    case TypeClass::Pointer: return PointerType::get(readType(is));
+
+    default: throw CacheError();
+    }
+}
+
+
+static void writeExp(QDataStream &os, const SharedConstExp &exp)
+{
+    const qint32 oper = exp->getOper();
+
+    if (exp->isConst()) {
+        std::shared_ptr<const Const> c = std::static_pointer_cast<const Const>(exp);
+        os << static_cast<quint8>(ExpTag::Const) << oper;
+
+        switch (exp->getOper()) {
+        case opIntConst: os << static_cast<qint32>(c->getInt()); break;
+        case opLongConst: os << static_cast<quint64>(c->getLong()); break;
+        case opFltConst: os << c->getFlt(); break;
+        case opStrConst: os << c->getStr(); break;
+        default:
+            LOG_VERBOSE("Cannot store constant '%1' in SSL cache", exp);
+            throw CacheError();
+        }
+
+        writeType(os, c->getType());
+    }
+    else if (std::dynamic_pointer_cast<const Terminal>(exp)) {
+        os << static_cast<quint8>(ExpTag::Terminal) << oper;
+    }
+    else if (std::dynamic_pointer_cast<const Location>(exp)) {
+        os << static_cast<quint8>(ExpTag::Location) << oper;
+        writeExp(os, exp->getSubExp1());
+    }
+    else if (std::dynamic_pointer_cast<const TypedExp>(exp)) {
+        os << static_cast<quint8>(ExpTag::TypedExp) << oper;
+        writeType(os, std::static_pointer_cast<const TypedExp>(exp)->getType());
+        writeExp(os, exp->getSubExp1());
+    }
+    else if (std::dynamic_pointer_cast<const RefExp>(exp)) {
+        LOG_VERBOSE("Cannot store expression '%1' in SSL cache", exp);
+        throw CacheError();
+    }
+    else if (std::dynamic_pointer_cast<const Ternary>(exp)) {
+        os << static_cast<quint8>(ExpTag::Ternary) << oper;
+        writeExp(os, exp->getSubExp1());
+        writeExp(os, exp->getSubExp2());
+        writeExp(os, exp->getSubExp3());
+    }
+    else if (std::dynamic_pointer_cast<const Binary>(exp)) {
+        os << static_cast<quint8>(ExpTag::Binary) << oper;
+        writeExp(os, exp->getSubExp1());
+        writeExp(os, exp->getSubExp2());
+    }
+    else {
+        os << static_cast<quint8>(ExpTag::Unary) << oper;
+        writeExp(os, exp->getSubExp1());
+    }
+}
+
+
+static SharedExp readExp(QDataStream &is)
+{
+    quint8 tag;
+    qint32 oper;
+    is >> tag >> oper;
+
+    if (is.status() != QDataStream::Ok || oper < 0 || oper > opFLF) {
+        throw CacheError();
+    }
+
+    const OPER op = static_cast<OPER>(oper);
+
+    switch (static_cast<ExpTag>(tag)) {
+    case ExpTag::Const: {
+        std::shared_ptr<Const> c;
+
+        if (op == opIntConst) {
+            qint32 value;
+            is >> value;
+            c = Const::get(static_cast<int>(value));
+        }
+        else if (op == opLongConst) {
+            quint64 value;
+            is >> value;
+            c = Const::get(static_cast<QWord>(value));
+        }
+        else if (op == opFltConst) {
+            double value;
+            is >> value;
+            c = Const::get(value);
+        }
+        else if (op == opStrConst) {
+            QString value;
+            is >> value;
+            c = Const::get(value);
+        }
+        else {
+            throw CacheError();
+        }
+
+        c->setType(readType(is));
+        return c;
+    }
+
+    case ExpTag::Terminal: return Terminal::get(op);
+    case ExpTag::Location: return Location::get(op, readExp(is), nullptr);
+
+    case ExpTag::TypedExp: {
+        SharedType ty = readType(is);
+        return TypedExp::get(ty, readExp(is));
+    }
+
+    case ExpTag::Unary: return Unary::get(op, readExp(is));
+
+    case ExpTag::Binary: {
+        SharedExp e1 = readExp(is);
+        return Binary::get(op, e1, readExp(is));
+    }
+
+    case ExpTag::Ternary: {
+        SharedExp e1 = readExp(is);
+        SharedExp e2 = readExp(is);
+        return Ternary::get(op, e1, e2, readExp(is));
+    }
+    }
+
+    throw CacheError();
+}
+
+
+static void writeStmt(QDataStream &os, const SharedConstStmt &stmt)
+{
+    os << static_cast<quint8>(stmt->getKind());
+
+    switch (stmt->getKind()) {
+    case StmtType::Assign: {
+        std::shared_ptr<const Assign> asgn = stmt->as<Assign>();
+        writeType(os, asgn->getType());
+        writeExp(os, asgn->getLeft());
+        writeExp(os, asgn->getRight());
+
+        os << static_cast<quint8>(asgn->getGuard() != nullptr);
+        if (asgn->getGuard()) {
+            writeExp(os, asgn->getGuard());
+        }
+        return;
+    }
+
+    case StmtType::Goto: writeExp(os, stmt->as<GotoStatement>()->getDest()); return;
+
+    case StmtType::Branch: {
+        std::shared_ptr<const BranchStatement> branch = stmt->as<BranchStatement>();
+        writeExp(os, branch->getDest());
+        writeExp(os, branch->getCondExpr());
+        return;
+    }
+
+    case StmtType::Call: writeExp(os, stmt->as<CallStatement>()->getDest()); return;
+    case StmtType::Ret: return;
+
+    default: break;
+    }
+
+    LOG_VERBOSE("Cannot store statement '%1' in SSL cache", stmt->toString());
+    throw CacheError();
+}
+
+
+static SharedStmt readStmt(QDataStream &is)
+{
+    quint8 kind;
+    is >> kind;
+
+    switch (static_cast<StmtType>(kind)) {
+    case StmtType::Assign: {
+        SharedType ty  = readType(is);
+        SharedExp lhs  = readExp(is);
+        SharedExp rhs  = readExp(is);
+        quint8 hasGuard;
+        is >> hasGuard;
+
+        return std::make_shared<Assign>(ty, lhs, rhs, hasGuard ? readExp(is) : nullptr);
+    }
+
+    case StmtType::Goto: return std::make_shared<GotoStatement>(readExp(is));
+
+    case StmtType::Branch: {
+        std::shared_ptr<BranchStatement> branch = std::make_shared<BranchStatement>(readExp(is));
+        branch->setCondExpr(readExp(is));
+        return branch;
+    }
+
+    case StmtType::Call: return std::make_shared<CallStatement>(readExp(is));
+    case StmtType::Ret: return std::make_shared<ReturnStatement>();
+
+    default: throw CacheError();
+    }
+}
+
+
+QByteArray RTLInstDictCache::getCacheKey(const QByteArray &sslContents)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    // Operator numbers are stored in the cache; they might change between versions.
+    // The hash of the parser and expander sources is generated by the build,
+    // so changing them invalidates the cache even if the version stays the same.
+    hash.addData(QByteArray(BOOMERANG_VERSION));
+    hash.addData(QByteArray(BOOMERANG_SSL_PARSER_HASH));
+    hash.addData(QByteArray::number(CACHE_VERSION));
+    hash.addData(QByteArray::number(static_cast<int>(opFLF)));
+    hash.addData(sslContents);
+
+    return hash.result();
+}
+
+
+QString RTLInstDictCache::getCachePath(const QByteArray &key)
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDir.isEmpty()) {
+        return "";
+    }
+
+    return QDir(cacheDir).absoluteFilePath(QString("ssl/%1.sslcache").arg(QString(key.toHex())));
+}
+
+
+bool RTLInstDictCache::read(const QString &cachePath, const QByteArray &key, RTLInstDict &dict)
+{
+    QFile file(cachePath);
+    if (cachePath.isEmpty() || !file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    const uchar *data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+
+    const QByteArray contents = QByteArray::fromRawData(reinterpret_cast<const char *>(data),
+                                                        file.size());
+    QDataStream is(contents);
+    is.setVersion(DATASTREAM_VERSION);
+
+    dict.reset();
+
+    try {
+        quint32 magic, version;
+        QByteArray fileKey;
+        is >> magic >> version >> fileKey;
+
+        if (magic != CACHE_MAGIC || version != CACHE_VERSION || fileKey != key) {
+            throw CacheError();
+        }
+
+        quint8 endianness;
+        is >> endianness;
+        dict.m_endianness = static_cast<Endian>(endianness);
+
+        // Replay the creation of registers and their relations
+        quint32 numRegs;
+        is >> numRegs;
+
+        for (quint32 i = 0; i < numRegs && is.status() == QDataStream::Ok; i++) {
+            quint8 regType;
+            quint16 regNum, size;
+            QString name;
+            is >> regType >> regNum >> size >> name;
+
+            if (!dict.m_regDB.createReg(static_cast<RegType>(regType), regNum, name, size)) {
+                throw CacheError();
+            }
+        }
+
+        quint32 numRelations;
+        is >> numRelations;
+
+        for (quint32 i = 0; i < numRelations && is.status() == QDataStream::Ok; i++) {
+            QString parent, child;
+            qint32 offset;
+            is >> parent >> child >> offset;
+
+            if (!dict.m_regDB.createRegRelation(parent, child, offset)) {
+                throw CacheError();
+            }
+        }
+
+        quint32 numFlagFuncs;
+        is >> numFlagFuncs;
+
+        for (quint32 i = 0; i < numFlagFuncs && is.status() == QDataStream::Ok; i++) {
+            QString name;
+            is >> name;
+            dict.m_flagFuncs.insert(name);
+        }
+
+        quint32 numInstructions;
+        is >> numInstructions;
+
+        for (quint32 i = 0; i < numInstructions && is.status() == QDataStream::Ok; i++) {
+            QString name;
+            quint32 numParams, numStmts;
+            is >> name >> numParams;
+
+            std::list<QString> params;
+            for (quint32 j = 0; j < numParams && is.status() == QDataStream::Ok; j++) {
+                QString param;
+                is >> param;
+                params.push_back(param);
+            }
+
+            RTL rtl(Address::ZERO);
+            is >> numStmts;
+
+            for (quint32 j = 0; j < numStmts && is.status() == QDataStream::Ok; j++) {
+                rtl.append(readStmt(is));
+            }
+
+            dict.m_instructions.emplace(std::make_pair(name, static_cast<int>(params.size())),
+                                        TableEntry(params, rtl));
+        }
+
+        if (is.status() != QDataStream::Ok) {
+            throw CacheError();
+        }
+    }
+    catch (const CacheError &) {
+        LOG_VERBOSE("Ignoring invalid SSL cache '%1'", cachePath);
+        dict.reset();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool RTLInstDictCache::write(const QString &cachePath, const QByteArray &key,
+                             const RTLInstDict &dict)
+{
+    if (cachePath.isEmpty() || !QDir().mkpath(QFileInfo(cachePath).absolutePath())) {
+        return false;
+    }
+
+    QByteArray contents;
+    QDataStream os(&contents, QIODevice::WriteOnly);
+    os.setVersion(DATASTREAM_VERSION);
+
+    try {
+        os << CACHE_MAGIC << CACHE_VERSION << key;
+        os << static_cast<quint8>(dict.m_endianness);
+
+        // Registers are recreated in the order of their numbers, so the first name of a register
+        // is created before its aliases. Special registers are stored last.
+        const RegDB &regDB = dict.m_regDB;
+        std::vector<std::pair<RegID, QString>> regs;
+
+        for (const auto &[id, reg] : regDB.m_regInfo) {
+            regs.push_back({ id, reg.getName() });
+        }
+
+        for (const auto &[name, id] : regDB.m_regNums) {
+            if (id != RegNumSpecial && regDB.getRegNameByNum(id.getNum()) != name) {
+                regs.push_back({ id, name }); // alias
+            }
+        }
+
+        for (const auto &[name, reg] : regDB.m_specialRegInfo) {
+            regs.push_back({ regDB.getRegIDByName(name), name });
+        }
+
+        os << static_cast<quint32>(regs.size());
+        for (const auto &[id, name] : regs) {
+            os << static_cast<quint8>(id.getRegType()) << id.getNum() << id.getSize() << name;
+        }
+
+        os << static_cast<quint32>(regDB.m_parent.size());
+        for (const auto &[child, parent] : regDB.m_parent) {
+            os << parent << child << static_cast<qint32>(regDB.m_offsetInParent.at(child));
+        }
+
+        os << static_cast<quint32>(dict.m_flagFuncs.size());
+        for (const QString &name : dict.m_flagFuncs) {
+            os << name;
+        }
+
+        os << static_cast<quint32>(dict.m_instructions.size());
+        for (const auto &[nameAndNumParams, entry] : dict.m_instructions) {
+            os << nameAndNumParams.first << static_cast<quint32>(entry.m_params.size());
+            for (const QString &param : entry.m_params) {
+                os << param;
+            }
+
+            os << static_cast<quint32>(entry.m_rtl.size());
+            for (const SharedConstStmt &stmt : entry.m_rtl) {
+                writeStmt(os, stmt);
+            }
+        }
+    }
+    catch (const CacheError &) {
+        return false;
+    }
+
+    QSaveFile file(cachePath);
+    if (!file.open(QFile::WriteOnly) || file.write(contents) != contents.size() ||
+        !file.commit()) {
+        LOG_VERBOSE("Cannot write SSL cache '%1'", cachePath);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,50 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QByteArray>
+#include <QString>
+
+
+class RTLInstDict;
+
+
+/**
+ * Binary cache of fully expanded RTL instruction dictionaries.
+ *
+ * Parsing an SSL file and expanding its instruction tables is expensive (especially for x86.ssl),
+ * so the resulting dictionary (endianness, registers and their relations, flag functions
+ * and instruction templates) is stored in a cache file after the SSL file was parsed.
+ * The cache is keyed by a hash of the contents of the SSL file, of the cache format
+ * and of the sources of the SSL parser and expander (computed by the build),
+ * so a modified SSL file or a different build of Boomerang never reads a stale cache.
+ */
+class BOOMERANG_API RTLInstDictCache
+{
+public:
+    /// \returns the cache key of the SSL file with contents \p sslContents
+    static QByteArray getCacheKey(const QByteArray &sslContents);
+
+    /// \returns the path of the cache file for \p key,
+    /// or the empty string if there is no writable cache directory.
+    static QString getCachePath(const QByteArray &key);
+
+    /// Read the dictionary from the cache file \p cachePath into \p dict.
+    /// \returns false if the cache file does not exist, does not match \p key or is corrupt.
+    /// In this case, \p dict is left empty.
+    static bool read(const QString &cachePath, const QByteArray &key, RTLInstDict &dict);
+
+    /// Write \p dict to the cache file \p cachePath.
+    /// \returns false if the dictionary cannot be stored in the cache.
+    static bool write(const QString &cachePath, const QByteArray &key, const RTLInstDict &dict);
+};
@@ -35,6 +35,10 @@ void RegDB::clear()
     m_regNums.clear();
     m_regInfo.clear();
     m_specialRegInfo.clear();
+
+    m_parent.clear();
+    m_offsetInParent.clear();
+    m_children.clear();
 }
 
 
@@ -25,6 +25,8 @@ class Assignment;
  */
 class BOOMERANG_API RegDB
 {
+    friend class RTLInstDictCache;
+
 public:
     RegDB();
     ~RegDB();
@@ -11,10 +11,11 @@
 
 
 #include "boomerang/ssl/exp/Unary.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /// Binary is an expression holding two subexpressions.
-class BOOMERANG_API Binary : public Unary
+class BOOMERANG_API Binary : public Unary, private IRCounted<IRObjectKind::Binary>
 {
 public:
     Binary(OPER op, SharedExp e1, SharedExp e2);
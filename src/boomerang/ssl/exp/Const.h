@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/exp/Exp.h"
 #include "boomerang/util/Address.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 #include <variant>
 
@@ -21,7 +22,7 @@ class Function;
 
 /// Const is a terminal expression holding either an integer, floating point,
 /// string, or address constant.
-class BOOMERANG_API Const : public Exp
+class BOOMERANG_API Const : public Exp, private IRCounted<IRObjectKind::Const>
 {
 private:
     typedef std::variant<int,         ///< Integer
@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/Register.h"
 #include "boomerang/ssl/exp/Unary.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /// Location encompasses two kinds of expressions:
@@ -22,7 +23,7 @@
 ///  - For register accesses (opRegOf), the ID of the register (not necessarily constant)
 ///  - For memory accesses (opMemOf), the address expression
 ///  - For all others (e.g. global, local, temporary variables), the name of the variable.
-class BOOMERANG_API Location : public Unary
+class BOOMERANG_API Location : public Unary, private IRCounted<IRObjectKind::Location>
 {
 public:
     /**
@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/exp/Unary.h"
 #include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /**
@@ -29,7 +30,7 @@
  * If the expression is not explicitly defined anywhere,
  * the defining statement is nullptr.
  */
-class BOOMERANG_API RefExp : public Unary
+class BOOMERANG_API RefExp : public Unary, private IRCounted<IRObjectKind::RefExp>
 {
 public:
     /// \param usedExp Expression that is used
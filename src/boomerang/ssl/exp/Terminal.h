@@ -11,12 +11,13 @@
 
 
 #include "boomerang/ssl/exp/Exp.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /// Terminal holds special zero arity items
 /// such as opFlags (abstract flags register)
 /// These are always terminal expressions.
-class BOOMERANG_API Terminal : public Exp
+class BOOMERANG_API Terminal : public Exp, private IRCounted<IRObjectKind::Terminal>
 {
 public:
     Terminal(OPER op);
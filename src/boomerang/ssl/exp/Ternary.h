@@ -11,10 +11,11 @@
 
 
 #include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /// Ternary is a non-terminal expression holding three subexpressions.
-class BOOMERANG_API Ternary : public Binary
+class BOOMERANG_API Ternary : public Binary, private IRCounted<IRObjectKind::Ternary>
 {
 public:
     Ternary(OPER op, SharedExp e1, SharedExp e2, SharedExp e3);
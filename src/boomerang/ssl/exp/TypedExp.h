@@ -11,10 +11,11 @@
 
 
 #include "boomerang/ssl/exp/Unary.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /// Holds one subexpression and the type of this subexpression.
-class BOOMERANG_API TypedExp : public Unary
+class BOOMERANG_API TypedExp : public Unary, private IRCounted<IRObjectKind::TypedExp>
 {
 public:
     TypedExp(SharedExp e1);
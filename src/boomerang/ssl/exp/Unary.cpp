@@ -252,18 +252,11 @@ bool Unary::descendType(SharedType newType)
         break;
 
     case opGlobal: {
-        Prog *_prog   = access<Location>()->getProc()->getProg();
-        QString name  = access<Const, 1>()->getStr();
-        SharedType ty = _prog->getGlobalType(name);
-
-        if (ty) {
-            ty = ty->meetWith(newType, changed);
-
-            if (changed) {
-                _prog->setGlobalType(name, ty);
-            }
-        }
+        Prog *_prog  = access<Location>()->getProc()->getProg();
+        QString name = access<Const, 1>()->getStr();
 
+        // The meet is done by Prog, so it cannot race with other procedures analysed in parallel
+        changed |= _prog->meetGlobalType(name, newType);
         break;
     }
 
@@ -11,10 +11,11 @@
 
 
 #include "boomerang/ssl/exp/Exp.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /// Unary is a non-terminal expression holding a single subexpression.
-class BOOMERANG_API Unary : public Exp
+class BOOMERANG_API Unary : public Exp, private IRCounted<IRObjectKind::Unary>
 {
 public:
     Unary(OPER op, SharedExp subExp1);
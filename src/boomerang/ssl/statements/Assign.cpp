@@ -138,7 +138,7 @@ bool Assign::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
     // Ugh: searchAll clears the list!
     res |= m_rhs->searchAll(pattern, result);
 
-    for (SharedExp exp : leftResult) {
+    for (const SharedExp &exp : leftResult) {
         result.push_back(exp);
     }
 
@@ -11,13 +11,14 @@
 
 
 #include "boomerang/ssl/statements/Assignment.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /**
  * An ordinary assignment with left and right hand sides.
  * Example: *i32* r25 := 5
  */
-class BOOMERANG_API Assign : public Assignment
+class BOOMERANG_API Assign : public Assignment, private IRCounted<IRObjectKind::Assign>
 {
 public:
     Assign(SharedExp lhs, SharedExp rhs, SharedExp guard = nullptr);
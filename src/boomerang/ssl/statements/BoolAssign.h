@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/statements/Assignment.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /**
@@ -18,7 +19,7 @@
  * (to 1 or 0) depending on the condition codes.
  * It has a condition Exp, similar to the BranchStatement class.
  */
-class BOOMERANG_API BoolAssign : public Assignment
+class BOOMERANG_API BoolAssign : public Assignment, private IRCounted<IRObjectKind::BoolAssign>
 {
 public:
     BoolAssign(SharedExp lhs, BranchType bt, SharedExp cond);
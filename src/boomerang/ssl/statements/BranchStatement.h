@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/statements/GotoStatement.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 // index of the "then" branch of conditional jumps
@@ -23,7 +24,8 @@
 /**
  * BranchStatement has a condition Exp in addition to the destination of the jump.
  */
-class BOOMERANG_API BranchStatement : public GotoStatement
+class BOOMERANG_API BranchStatement : public GotoStatement,
+                                      private IRCounted<IRObjectKind::BranchStatement>
 {
 public:
     BranchStatement(Address dest);
@@ -130,7 +130,7 @@ bool CallStatement::accept(StmtExpVisitor *v)
         ret = m_dest->acceptVisitor(v->ev);
     }
 
-    for (SharedStmt s : m_arguments) {
+    for (const SharedStmt &s : m_arguments) {
         ret &= s->accept(v);
     }
 
@@ -153,7 +153,7 @@ bool CallStatement::accept(StmtModifier *v)
     }
 
     if (visitChildren) {
-        for (SharedStmt s : m_arguments) {
+        for (const SharedStmt &s : m_arguments) {
             s->accept(v);
         }
     }
@@ -165,13 +165,13 @@ bool CallStatement::accept(StmtModifier *v)
     if (!v->ignoreCollector()) {
         DefCollector::iterator cc;
 
-        for (SharedStmt s : m_defCol) {
+        for (const SharedStmt &s : m_defCol) {
             s->accept(v);
         }
     }
 
     if (visitChildren) {
-        for (SharedStmt s : m_defines) {
+        for (const SharedStmt &s : m_defines) {
             s->accept(v);
         }
     }
@@ -189,7 +189,7 @@ bool CallStatement::accept(StmtPartModifier *v)
     }
 
     if (visitChildren) {
-        for (SharedStmt s : m_arguments) {
+        for (const SharedStmt &s : m_arguments) {
             s->accept(v);
         }
     }
@@ -199,11 +199,11 @@ bool CallStatement::accept(StmtPartModifier *v)
     // logic should take care of it. Then again, what about the use collectors in calls?
     // Best to do it.
     if (!v->ignoreCollector()) {
-        for (SharedStmt s : m_defCol) {
+        for (const SharedStmt &s : m_defCol) {
             s->accept(v);
         }
 
-        for (SharedExp exp : m_useCol) {
+        for (const SharedExp &exp : m_useCol) {
             // I believe that these should never change at the top level,
             // e.g. m[esp{30} + 4] -> m[esp{-} - 20]
             exp->acceptModifier(v->mod);
@@ -213,7 +213,7 @@ bool CallStatement::accept(StmtPartModifier *v)
     StatementList::iterator dd;
 
     if (visitChildren) {
-        for (SharedStmt s : m_defines) {
+        for (const SharedStmt &s : m_defines) {
             s->accept(v);
         }
     }
@@ -251,7 +251,7 @@ void CallStatement::getDefinitions(LocationSet &defs, bool assumeABICompliance)
 
 bool CallStatement::definesLoc(SharedExp loc) const
 {
-    for (SharedConstStmt def : m_defines) {
+    for (const SharedConstStmt &def : m_defines) {
         if (*def->as<const Assign>()->getLeft() == *loc) {
             return true;
         }
@@ -332,11 +332,11 @@ void CallStatement::simplify()
 {
     GotoStatement::simplify();
 
-    for (SharedStmt ss : m_arguments) {
+    for (const SharedStmt &ss : m_arguments) {
         ss->simplify();
     }
 
-    for (SharedStmt ss : m_defines) {
+    for (const SharedStmt &ss : m_defines) {
         ss->simplify();
     }
 }
@@ -603,7 +603,7 @@ void CallStatement::updateArguments()
         }
     }
 
-    for (SharedStmt oldArg : oldArguments) {
+    for (const SharedStmt &oldArg : oldArguments) {
         // Make sure the LHS is still in the callee signature / callee parameters / use collector
         std::shared_ptr<Assign> asgn = oldArg->as<Assign>();
         SharedExp lhs                = asgn->getLeft();
@@ -803,7 +803,7 @@ bool CallStatement::removeDefine(SharedExp e)
 void CallStatement::setDefines(const StatementList &defines)
 {
     if (!m_defines.empty()) {
-        for (SharedConstStmt stmt : defines) {
+        for (const SharedConstStmt &stmt : defines) {
             Q_UNUSED(stmt);
             assert(std::find(m_defines.begin(), m_defines.end(), stmt) == m_defines.end());
         }
@@ -14,6 +14,7 @@
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/ssl/statements/Assignment.h"
 #include "boomerang/ssl/statements/GotoStatement.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/StatementList.h"
 
 
@@ -27,7 +28,8 @@ class Prog;
  * Represents a high level call.
  * Information about parameters and the like is stored here.
  */
-class BOOMERANG_API CallStatement : public GotoStatement
+class BOOMERANG_API CallStatement : public GotoStatement,
+                                    private IRCounted<IRObjectKind::CallStatement>
 {
 public:
     CallStatement(Address dest);
@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/statements/GotoStatement.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 enum class SwitchType : char
@@ -53,7 +54,8 @@ public:
  * CaseStatement is derived from GotoStatement. In addition to the destination
  * of the jump, it has a switch variable Exp.
  */
-class BOOMERANG_API CaseStatement : public GotoStatement
+class BOOMERANG_API CaseStatement : public GotoStatement,
+                                    private IRCounted<IRObjectKind::CaseStatement>
 {
 public:
     CaseStatement(SharedExp dest);
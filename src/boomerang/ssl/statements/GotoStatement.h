@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /**
@@ -21,7 +22,7 @@
  * respecitvely.
  * This class also represents unconditional jumps with a fixed offset.
  */
-class BOOMERANG_API GotoStatement : public Statement
+class BOOMERANG_API GotoStatement : public Statement, private IRCounted<IRObjectKind::GotoStatement>
 {
 public:
     /// Construct a jump to a fixed address \p jumpDest
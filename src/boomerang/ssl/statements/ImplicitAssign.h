@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/statements/Assignment.h"
+#include "boomerang/util/IRObjectCounter.h"
 
 
 /**
@@ -19,7 +20,8 @@
  * That way, you can always find the type of a subscripted variable
  * by looking in its defining Assignment.
  */
-class BOOMERANG_API ImplicitAssign : public Assignment
+class BOOMERANG_API ImplicitAssign : public Assignment,
+                                     private IRCounted<IRObjectKind::ImplicitAssign>
 {
 public:
     ImplicitAssign(SharedExp lhs);
@@ -13,6 +13,7 @@
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/statements/Assignment.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/MapIterators.h"
 
 
@@ -31,7 +32,7 @@
  * circumstance: when finding locations used by some statement, and the reference is to a
  * CallStatement returning multiple locations.
  */
-class BOOMERANG_API PhiAssign : public Assignment
+class BOOMERANG_API PhiAssign : public Assignment, private IRCounted<IRObjectKind::PhiAssign>
 {
 public:
     typedef std::map<IRFragment *, std::shared_ptr<RefExp>, Util::ptrCompare<IRFragment>> PhiDefs;
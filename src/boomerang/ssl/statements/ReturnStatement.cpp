@@ -114,7 +114,7 @@ bool ReturnStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result
 {
     bool found = false;
 
-    for (SharedStmt ret : m_returns) {
+    for (const SharedStmt &ret : m_returns) {
         if (ret->searchAll(pattern, result)) {
             found = true;
         }
@@ -186,11 +186,11 @@ void ReturnStatement::setTypeForExp(SharedExp e, SharedType ty)
 
 void ReturnStatement::simplify()
 {
-    for (SharedStmt s : m_modifieds) {
+    for (const SharedStmt &s : m_modifieds) {
         s->simplify();
     }
 
-    for (SharedStmt s : m_returns) {
+    for (const SharedStmt &s : m_returns) {
         s->simplify();
     }
 }
@@ -214,7 +214,7 @@ bool ReturnStatement::accept(StmtExpVisitor *v)
     }
 
     if (!v->isIgnoreCol()) {
-        for (SharedStmt stmt : m_col) {
+        for (const SharedStmt &stmt : m_col) {
             if (!stmt->accept(v)) {
                 return false;
             }
@@ -223,14 +223,14 @@ bool ReturnStatement::accept(StmtExpVisitor *v)
         // EXPERIMENTAL: for now, count the modifieds as if they are a collector (so most, if not
         // all of the time, ignore them). This is so that we can detect better when a definition is
         // used only once, and therefore propagate anything to it
-        for (SharedStmt stmt : m_modifieds) {
+        for (const SharedStmt &stmt : m_modifieds) {
             if (!stmt->accept(v)) {
                 return false;
             }
         }
     }
 
-    for (SharedStmt stmt : m_returns) {
+    for (const SharedStmt &stmt : m_returns) {
         if (!stmt->accept(v)) {
             return false;
         }
@@ -259,13 +259,13 @@ bool ReturnStatement::accept(StmtModifier *v)
         }
     }
 
-    for (SharedStmt stmt : m_modifieds) {
+    for (const SharedStmt &stmt : m_modifieds) {
         if (!stmt->accept(v)) {
             return false;
         }
     }
 
-    for (SharedStmt stmt : m_returns) {
+    for (const SharedStmt &stmt : m_returns) {
         if (!stmt->accept(v)) {
             return false;
         }
@@ -280,13 +280,13 @@ bool ReturnStatement::accept(StmtPartModifier *v)
     bool visitChildren = true;
     v->visit(shared_from_this()->as<ReturnStatement>(), visitChildren);
 
-    for (SharedStmt stmt : m_modifieds) {
+    for (const SharedStmt &stmt : m_modifieds) {
         if (!stmt->accept(v)) {
             return false;
         }
     }
 
-    for (SharedStmt stmt : m_returns) {
+    for (const SharedStmt &stmt : m_returns) {
         if (!stmt->accept(v)) {
             return false;
         }
@@ -416,7 +416,7 @@ void ReturnStatement::updateModifieds()
             continue; // Filtered out
         }
 
-        for (SharedStmt s : oldMods) {
+        for (const SharedStmt &s : oldMods) {
             SharedExp lhs = s->as<Assignment>()->getLeft();
 
             if (*lhs == *colLhs) {
@@ -490,7 +490,7 @@ void ReturnStatement::updateReturns()
             continue;
         }
 
-        for (SharedStmt oldRet : oldRets) {
+        for (const SharedStmt &oldRet : oldRets) {
             SharedExp lhs = oldRet->as<Assign>()->getLeft();
 
             if (*lhs == *loc) {
@@ -509,7 +509,7 @@ void ReturnStatement::updateReturns()
         }
     }
 
-    for (SharedStmt stmt : oldRets) {
+    for (const SharedStmt &stmt : oldRets) {
         // Make sure the LHS is still in the modifieds
         assert(stmt->isAssign());
         std::shared_ptr<Assign> asgn = stmt->as<Assign>();
@@ -12,13 +12,15 @@
 
 #include "boomerang/db/DefCollector.h"
 #include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/IRObjectCounter.h"
 #include "boomerang/util/StatementList.h"
 
 
 /**
  * Represents an ordinary high level return.
  */
-class BOOMERANG_API ReturnStatement : public Statement
+class BOOMERANG_API ReturnStatement : public Statement,
+                                      private IRCounted<IRObjectKind::ReturnStatement>
 {
 public:
     typedef StatementList::iterator iterator;
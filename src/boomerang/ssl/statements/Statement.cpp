@@ -25,9 +25,11 @@
 #include "boomerang/visitor/stmtexpvisitor/UsedLocsVisitor.h"
 #include "boomerang/visitor/stmtmodifier/StmtPartModifier.h"
 
+#include <atomic>
+
 
 SharedStmt Statement::wild = SharedStmt(new Assign(Terminal::get(opNil), Terminal::get(opNil)));
-static uint32 m_nextStmtID = 0;
+static std::atomic<uint32> m_nextStmtID(0);
 
 
 Statement::Statement(StmtType kind)
@@ -90,7 +92,7 @@ void Statement::setProc(UserProc *proc)
     getDefinitions(defs, assumeABICompliance);
     exps.makeUnion(defs);
 
-    for (SharedExp exp : exps) {
+    for (const SharedExp &exp : exps) {
         if (exp->isLocation()) {
             exp->access<Location>()->setProc(proc);
         }
@@ -186,7 +188,7 @@ bool Statement::propagateToThis(int propMaxDepth, const ExpIntMap *destCounts, b
 
         // Example: m[r24{10}] := r25{20} + m[r26{30}]
         // exps has r24{10}, r25{20}, m[r26{30}], r26{30}
-        for (SharedExp usedHere : usedExps) {
+        for (const SharedExp &usedHere : usedExps) {
             if (!Statement::canPropagateToExp(*usedHere)) {
                 continue;
             }
@@ -244,7 +246,7 @@ bool Statement::propagateFlagsToThis()
         LocationSet usedExps;
         addUsedLocs(usedExps, true);
 
-        for (SharedExp usedHere : usedExps) {
+        for (const SharedExp &usedHere : usedExps) {
             if (!usedHere->isSubscript()) {
                 continue; // e.g. %pc
             }
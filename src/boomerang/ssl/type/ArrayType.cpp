@@ -9,6 +9,8 @@
 #pragma endregion License
 #include "ArrayType.h"
 
+#include <algorithm>
+
 
 ArrayType::ArrayType(SharedType baseType, uint64 length)
     : Type(TypeClass::Array)
@@ -71,6 +73,14 @@ void ArrayType::setBaseType(SharedType b)
     }
 
     m_baseType = b;
+    invalidateLayout();
+}
+
+
+void ArrayType::setLength(unsigned n)
+{
+    m_length = n;
+    invalidateLayout();
 }
 
 
@@ -86,6 +96,12 @@ Type::Size ArrayType::getSize() const
 }
 
 
+uint64 ArrayType::getLayoutVersion() const
+{
+    return std::max(Type::getLayoutVersion(), m_baseType->getLayoutVersion());
+}
+
+
 bool ArrayType::operator==(const Type &other) const
 {
     if (!other.isArray()) {
@@ -121,7 +137,7 @@ QString ArrayType::getCtype(bool final) const
 }
 
 
-SharedType ArrayType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType ArrayType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return const_cast<ArrayType *>(this)->shared_from_this();
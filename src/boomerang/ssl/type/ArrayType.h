@@ -50,15 +50,15 @@ public:
     /// \copydoc Type::getSize
     Size getSize() const override;
 
+    /// \copydoc Type::getLayoutVersion
+    uint64 getLayoutVersion() const override;
+
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
     /// \copydoc Type::isCompatibleWith
     bool isCompatibleWith(const Type &other, bool all = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 public:
     /// \returns the type of elements of this array
     SharedType getBaseType() { return m_baseType; }
@@ -69,12 +69,15 @@ public:
 
     /// \returns the number of elements in this array.
     uint64 getLength() const { return m_length; }
-    void setLength(unsigned n) { m_length = n; }
+    void setLength(unsigned n);
 
     /// \returns true iff we do not know the length of the array (yet)
     bool isUnbounded() const;
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
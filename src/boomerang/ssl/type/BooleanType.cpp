@@ -25,7 +25,7 @@ BooleanType::~BooleanType()
 
 SharedType BooleanType::clone() const
 {
-    return std::make_shared<BooleanType>();
+    return BooleanType::get();
 }
 
 
@@ -53,7 +53,7 @@ QString BooleanType::getCtype(bool /*final*/) const
 }
 
 
-SharedType BooleanType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType BooleanType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid() || other->resolvesToBoolean()) {
         return const_cast<BooleanType *>(this)->shared_from_this();
@@ -26,7 +26,11 @@ public:
     BooleanType &operator=(BooleanType &&other) = default;
 
 public:
-    static std::shared_ptr<BooleanType> get() { return std::make_shared<BooleanType>(); }
+    /// \returns the shared boolean type. \sa Type::isShared
+    static std::shared_ptr<BooleanType> get()
+    {
+        return std::static_pointer_cast<BooleanType>(getSharedScalar(TypeClass::Boolean, 0));
+    }
 
     /// \copydoc Type::operator==
     bool operator==(const Type &other) const override;
@@ -43,10 +47,10 @@ public:
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 };
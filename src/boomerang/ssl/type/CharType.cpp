@@ -54,7 +54,7 @@ QString CharType::getCtype(bool /*final*/) const
 }
 
 
-SharedType CharType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType CharType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid() || other->resolvesToChar()) {
         return const_cast<CharType *>(this)->shared_from_this();
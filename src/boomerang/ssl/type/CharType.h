@@ -27,7 +27,11 @@ public:
     CharType &operator=(CharType &&other) = default;
 
 public:
-    static std::shared_ptr<CharType> get() { return std::make_shared<CharType>(); }
+    /// \returns the shared char type. \sa Type::isShared
+    static std::shared_ptr<CharType> get()
+    {
+        return std::static_pointer_cast<CharType>(getSharedScalar(TypeClass::Char, 0));
+    }
 
     /// \copydoc Type::operator==
     bool operator==(const Type &other) const override;
@@ -44,10 +48,10 @@ public:
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 };
@@ -10,7 +10,8 @@
 #include "CompoundType.h"
 
 #include "boomerang/ssl/type/SizeType.h"
-#include "boomerang/util/Util.h"
+
+#include <algorithm>
 
 
 CompoundType::CompoundType()
@@ -19,17 +20,55 @@ CompoundType::CompoundType()
 }
 
 
+CompoundType::CompoundType(const CompoundType &other)
+    : Type(other)
+    , m_types(other.m_types)
+    , m_names(other.m_names)
+{
+}
+
+
+CompoundType::CompoundType(CompoundType &&other)
+    : Type(std::move(other))
+    , m_types(std::move(other.m_types))
+    , m_names(std::move(other.m_names))
+{
+}
+
+
 CompoundType::~CompoundType()
 {
 }
 
 
+CompoundType &CompoundType::operator=(const CompoundType &other)
+{
+    Type::operator=(other);
+
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    m_types = other.m_types;
+    m_names = other.m_names;
+    return *this;
+}
+
+
+CompoundType &CompoundType::operator=(CompoundType &&other)
+{
+    Type::operator=(std::move(other));
+
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    m_types = std::move(other.m_types);
+    m_names = std::move(other.m_names);
+    return *this;
+}
+
+
 SharedType CompoundType::clone() const
 {
     auto t = CompoundType::get();
 
     for (int i = 0; i < getNumMembers(); i++) {
-        t->addMember(m_types[i]->clone(), m_names[i]);
+        t->appendMember(m_types[i]->clone(), m_names[i]);
     }
 
     return t;
@@ -44,14 +83,17 @@ bool CompoundType::isCompatibleWith(const Type &other, bool all) const
 
 Type::Size CompoundType::getSize() const
 {
-    Size size = 0;
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
+    return m_offsets.back();
+}
 
-    for (const SharedConstType &elem : m_types) {
-        // NOTE: this assumes no padding... perhaps explicit padding will be needed
-        size += elem->getSize();
-    }
 
-    return size;
+uint64 CompoundType::getLayoutVersion() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
+    return m_membersVersion;
 }
 
 
@@ -100,80 +142,43 @@ SharedType CompoundType::getMemberTypeByName(const QString &name)
 
 SharedType CompoundType::getMemberTypeByOffset(uint64 bitOffset)
 {
-    uint64 offset = 0;
-
-    for (auto &elem : m_types) {
-        if (Util::inRange(bitOffset, offset, offset + elem->getSize())) {
-            return elem;
-        }
-
-        offset += elem->getSize();
-    }
-
-    return nullptr;
+    const int idx = findMemberIdxByOffset(bitOffset);
+    return idx >= 0 ? m_types[idx] : nullptr;
 }
 
 
 void CompoundType::setMemberTypeByOffset(uint64 bitOffset, SharedType ty)
 {
-    uint64 offset = 0;
-
-    for (int i = 0; i < getNumMembers(); i++) {
-        if (Util::inRange(bitOffset, offset, offset + m_types[i]->getSize())) {
-            unsigned oldsz = m_types[i]->getSize();
-            m_types[i]     = ty;
-
-            if (ty->getSize() < oldsz) {
-                m_types.push_back(m_types[m_types.size() - 1]);
-                m_names.push_back(m_names[m_names.size() - 1]);
-
-                for (int _n = getNumMembers() - 1; _n > i; _n--) {
-                    m_types[_n] = m_types[_n - 1];
-                    m_names[_n] = m_names[_n - 1];
-                }
-
-                m_types[i + 1] = SizeType::get(oldsz - ty->getSize());
-                m_names[i + 1] = "pad";
-            }
+    const int idx = findMemberIdxByOffset(bitOffset);
+    if (idx < 0) {
+        return;
+    }
 
-            return;
-        }
+    const Size oldsz = m_types[idx]->getSize();
+    m_types[idx]     = ty;
 
-        offset += m_types[i]->getSize();
+    if (ty->getSize() < oldsz) {
+        m_types.insert(m_types.begin() + idx + 1, SizeType::get(oldsz - ty->getSize()));
+        m_names.insert(m_names.begin() + idx + 1, "pad");
     }
+
+    invalidateLayout();
 }
 
 
 void CompoundType::setMemberNameByOffset(uint64 bitOffset, const QString &name)
 {
-    uint64 offset = 0;
-
-    for (int i = 0; i < getNumMembers(); i++) {
-        if (Util::inRange(bitOffset, offset, offset + m_types[i]->getSize())) {
-            m_names[i] = name;
-            return;
-        }
-
-        offset += m_types[i]->getSize();
+    const int idx = findMemberIdxByOffset(bitOffset);
+    if (idx >= 0) {
+        m_names[idx] = name;
     }
 }
 
 
 QString CompoundType::getMemberNameByOffset(uint64 n)
 {
-    uint64 offset = 0;
-
-    for (int i = 0; i < getNumMembers(); i++) {
-        // if (offset >= n && n < offset + types[i]->getSize())
-        if ((offset <= n) && (n < offset + m_types[i]->getSize())) {
-            // return getName(offset == n ? i : i - 1);
-            return m_names[i];
-        }
-
-        offset += m_types[i]->getSize();
-    }
-
-    return "";
+    const int idx = findMemberIdxByOffset(n);
+    return idx >= 0 ? m_names[idx] : "";
 }
 
 
@@ -181,25 +186,20 @@ uint64 CompoundType::getMemberOffsetByIdx(int n)
 {
     assert(n < getNumMembers());
 
-    uint64 offset = 0;
-    for (int i = 0; i < n; i++) {
-        offset += m_types[i]->getSize();
-    }
-
-    return offset;
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
+    return m_offsets[n];
 }
 
 
 uint64 CompoundType::getMemberOffsetByName(const QString &member)
 {
-    uint64 offset = 0;
-
     for (int i = 0; i < getNumMembers(); i++) {
         if (m_names[i] == member) {
-            return offset;
+            std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+            updateLayout();
+            return m_offsets[i];
         }
-
-        offset += m_types[i]->getSize();
     }
 
     return static_cast<unsigned int>(-1);
@@ -208,20 +208,14 @@ uint64 CompoundType::getMemberOffsetByName(const QString &member)
 
 uint64 CompoundType::getOffsetRemainder(uint64 bitSize)
 {
-    uint64 remainder = bitSize;
-    uint64 offset    = 0;
-
-    for (auto &elem : m_types) {
-        offset += elem->getSize();
-
-        if (offset > bitSize) {
-            break;
-        }
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
 
-        remainder -= elem->getSize();
-    }
+    // Number of members that end at or before bitSize
+    const auto firstEnd   = m_offsets.begin() + 1;
+    const auto numMembers = std::upper_bound(firstEnd, m_offsets.end(), bitSize) - firstEnd;
 
-    return remainder;
+    return bitSize - m_offsets[numMembers];
 }
 
 
@@ -295,6 +289,13 @@ QString CompoundType::getCtype(bool final) const
 
 
 void CompoundType::addMember(SharedType memberType, const QString &memberName)
+{
+    appendMember(memberType, memberName);
+    invalidateLayout(); // this struct might be a member of another aggregate
+}
+
+
+void CompoundType::appendMember(SharedType memberType, const QString &memberName)
 {
     // check if it is a user defined type (typedef)
     SharedType existingType = getNamedType(memberType->getCtype());
@@ -305,6 +306,7 @@ void CompoundType::addMember(SharedType memberType, const QString &memberName)
 
     m_types.push_back(memberType);
     m_names.push_back(memberName);
+    m_checkedEpoch = 0; // recalculate offsets
 }
 
 
@@ -322,7 +324,7 @@ QString CompoundType::getMemberNameByIdx(int idx)
 }
 
 
-SharedType CompoundType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType CompoundType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return const_cast<CompoundType *>(this)->shared_from_this();
@@ -390,3 +392,53 @@ bool CompoundType::isCompatible(const Type &other, bool all) const
 
     return true;
 }
+
+
+void CompoundType::updateLayout() const
+{
+    const uint64 epoch = getLayoutEpoch();
+    if (m_checkedEpoch == epoch) {
+        return; // no type changed since the last check
+    }
+
+    // Keep the offsets unless this struct or one of its members changed
+    uint64 version = Type::getLayoutVersion();
+    for (const SharedType &ty : m_types) {
+        version = std::max(version, ty->getLayoutVersion());
+    }
+
+    m_checkedEpoch = epoch;
+
+    if (version == m_membersVersion && m_offsets.size() == m_types.size() + 1) {
+        return;
+    }
+
+    m_offsets.resize(m_types.size() + 1);
+
+    uint64 offset = 0;
+    for (std::size_t i = 0; i < m_types.size(); i++) {
+        m_offsets[i] = offset;
+
+        // NOTE: this assumes no padding... perhaps explicit padding will be needed
+        offset += m_types[i]->getSize();
+    }
+
+    m_offsets.back() = offset;
+    m_membersVersion = version;
+}
+
+
+int CompoundType::findMemberIdxByOffset(uint64 bitOffset) const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
+
+    // The member containing bitOffset is the last member starting at or before bitOffset.
+    // Members of size 0 are skipped since the next member starts at the same offset.
+    const auto it = std::upper_bound(m_offsets.begin(), m_offsets.end(), bitOffset);
+    if (it == m_offsets.end()) {
+        return -1; // bitOffset is not inside the struct
+    }
+
+    return static_cast<int>(it - m_offsets.begin()) - 1;
+}
@@ -12,11 +12,15 @@
 
 #include "boomerang/ssl/type/Type.h"
 
+#include <mutex>
 #include <vector>
 
 
 /**
  * The compound type represents aggregate types like structures or classes.
+ * The offsets of all members are cached and only recalculated after the layout
+ * of the struct or of one of its members has changed (see Type::getLayoutVersion),
+ * so looking up a member by its offset is a binary search.
  */
 class BOOMERANG_API CompoundType : public Type
 {
@@ -24,13 +28,13 @@ public:
     /// Constructs an empty compound type.
     explicit CompoundType();
 
-    CompoundType(CompoundType &other)  = default;
-    CompoundType(CompoundType &&other) = default;
+    CompoundType(const CompoundType &other);
+    CompoundType(CompoundType &&other);
 
     ~CompoundType() override;
 
-    CompoundType &operator=(CompoundType &other) = default;
-    CompoundType &operator=(CompoundType &&other) = default;
+    CompoundType &operator=(const CompoundType &other);
+    CompoundType &operator=(CompoundType &&other);
 
 public:
     static std::shared_ptr<CompoundType> get() { return std::make_shared<CompoundType>(); }
@@ -47,15 +51,15 @@ public:
     /// \copydoc Type::getSize
     Size getSize() const override;
 
+    /// \copydoc Type::getLayoutVersion
+    uint64 getLayoutVersion() const override;
+
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
     /// \copydoc Type::isCompatibleWith
     bool isCompatibleWith(const Type &other, bool all = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 public:
     /// \returns true if this is a superstructure of \p other,
     /// i.e. we have the same types at the same offsets as \p other
@@ -89,10 +93,33 @@ public:
     uint64 getOffsetRemainder(uint64 bitOffset);
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
+private:
+    /// Append a new member variable without invalidating the layouts of other types.
+    void appendMember(SharedType memberType, const QString &memberName);
+
+    /// Recalculate the offsets of all members if they are out of date.
+    /// \pre m_layoutMutex is held
+    void updateLayout() const;
+
+    /// \returns the index of the member containing the bit at \p bitOffset,
+    /// or -1 if there is no such member.
+    int findMemberIdxByOffset(uint64 bitOffset) const;
+
 private:
     std::vector<SharedType> m_types;
     std::vector<QString> m_names;
+
+    /// Guards the cached layout, since types may be shared by procedures analysed in parallel
+    mutable std::recursive_mutex m_layoutMutex;
+
+    /// Bit offset of each member, followed by the size of the struct
+    mutable std::vector<uint64> m_offsets;
+    mutable uint64 m_membersVersion = 0; ///< Layout version of this struct and its members
+    mutable uint64 m_checkedEpoch   = 0; ///< Layout epoch when m_membersVersion was checked
 };
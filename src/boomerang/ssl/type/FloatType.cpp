@@ -22,7 +22,7 @@ FloatType::FloatType(Size sz)
 
 std::shared_ptr<FloatType> FloatType::get(Size sz)
 {
-    return std::make_shared<FloatType>(sz);
+    return std::static_pointer_cast<FloatType>(getSharedScalar(TypeClass::Float, sz));
 }
 
 
@@ -33,7 +33,7 @@ FloatType::~FloatType()
 
 SharedType FloatType::clone() const
 {
-    return FloatType::get(m_size);
+    return std::make_shared<FloatType>(m_size);
 }
 
 
@@ -46,6 +46,7 @@ Type::Size FloatType::getSize() const
 void FloatType::setSize(Type::Size sz)
 {
     m_size = sz;
+    invalidateLayout();
 }
 
 
@@ -83,7 +84,7 @@ QString FloatType::getCtype(bool /*final*/) const
 }
 
 
-SharedType FloatType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType FloatType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return const_cast<FloatType *>(this)->shared_from_this();
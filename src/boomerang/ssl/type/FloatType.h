@@ -27,6 +27,7 @@ public:
     FloatType &operator=(FloatType &&other) = default;
 
 public:
+    /// \returns the shared float type with the given size. \sa Type::isShared
     static std::shared_ptr<FloatType> get(Size numBits);
 
     /// \copydoc Type::operator==
@@ -47,10 +48,10 @@ public:
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
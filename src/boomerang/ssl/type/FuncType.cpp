@@ -139,7 +139,7 @@ void FuncType::getReturnAndParam(QString &ret, QString &param)
 }
 
 
-SharedType FuncType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType FuncType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return const_cast<FuncType *>(this)->shared_from_this();
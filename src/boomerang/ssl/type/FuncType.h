@@ -47,9 +47,6 @@ public:
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 public:
     Signature *getSignature() { return m_signature.get(); }
     const Signature *getSignature() const { return m_signature.get(); }
@@ -60,6 +57,9 @@ public:
     void getReturnAndParam(QString &ret, QString &param);
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
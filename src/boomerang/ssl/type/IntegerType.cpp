@@ -23,13 +23,14 @@ IntegerType::IntegerType(Size numBits, Sign sign)
 
 std::shared_ptr<IntegerType> IntegerType::get(Size numBits, Sign sign)
 {
-    return std::make_shared<IntegerType>(numBits, sign);
+    return std::static_pointer_cast<IntegerType>(
+        getSharedScalar(TypeClass::Integer, numBits, sign));
 }
 
 
 SharedType IntegerType::clone() const
 {
-    return IntegerType::get(m_size, m_sign);
+    return std::make_shared<IntegerType>(m_size, m_sign);
 }
 
 
@@ -39,6 +40,13 @@ Type::Size IntegerType::getSize() const
 }
 
 
+void IntegerType::setSize(Size sz)
+{
+    m_size = sz;
+    invalidateLayout();
+}
+
+
 void IntegerType::hintAsSigned()
 {
     m_sign = std::min((Sign)((int)m_sign + 1), Sign::SignedStrong);
@@ -127,7 +135,7 @@ QString IntegerType::getCtype(bool final) const
 }
 
 
-SharedType IntegerType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType IntegerType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid() || other->resolvesToChar()) {
         return const_cast<IntegerType *>(this)->shared_from_this();
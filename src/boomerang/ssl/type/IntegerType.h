@@ -27,6 +27,7 @@ public:
     IntegerType &operator=(IntegerType &&other) = default;
 
 public:
+    /// \returns the shared integer type with the given size and sign. \sa Type::isShared
     static std::shared_ptr<IntegerType> get(Size numBits, Sign sign = Sign::Unknown);
 
     /// \copydoc Type::operator==
@@ -48,10 +49,7 @@ public:
     Size getSize() const override;
 
     /// \copydoc Type::setSize
-    void setSize(Size sz) override { m_size = sz; }
-
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
+    void setSize(Size sz) override;
 
 public:
     /// \returns true if definitely signed
@@ -77,6 +75,9 @@ public:
     Sign getSign() const { return m_sign; }
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
@@ -11,6 +11,8 @@
 
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+
 
 NamedType::NamedType(const QString &name)
     : Type(TypeClass::Named)
@@ -49,6 +51,15 @@ Type::Size NamedType::getSize() const
 }
 
 
+uint64 NamedType::getLayoutVersion() const
+{
+    const uint64 version = getNamedTypesVersion();
+    const SharedType ty  = resolvesTo();
+
+    return ty ? std::max(version, ty->getLayoutVersion()) : version;
+}
+
+
 bool NamedType::operator==(const Type &other) const
 {
     return other.isNamed() && m_name == static_cast<const NamedType &>(other).m_name;
@@ -83,7 +94,7 @@ QString NamedType::getCtype(bool /*final*/) const
 }
 
 
-SharedType NamedType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType NamedType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     SharedType rt = resolvesTo();
 
@@ -41,18 +41,21 @@ public:
     /// \copydoc Type::getSize
     Size getSize() const override;
 
+    /// \copydoc Type::getLayoutVersion
+    uint64 getLayoutVersion() const override;
+
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 public:
     QString getName() const { return m_name; }
 
     SharedType resolvesTo() const;
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
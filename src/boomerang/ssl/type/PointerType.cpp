@@ -151,7 +151,7 @@ QString PointerType::getCtype(bool final) const
 }
 
 
-SharedType PointerType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType PointerType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return std::const_pointer_cast<PointerType>(this->as<PointerType>());
@@ -49,9 +49,6 @@ public:
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 public:
     /// Set the pointer type of this pointer.
     /// E.g. for a pointer of type 'Foo *' the pointer type is 'Foo'
@@ -72,6 +69,9 @@ public:
     int getPointerDepth() const;
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
@@ -10,6 +10,7 @@
 #include "SizeType.h"
 
 #include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/util/log/Log.h"
 
 
@@ -34,7 +35,7 @@ SizeType::~SizeType()
 
 SharedType SizeType::clone() const
 {
-    return SizeType::get(m_size);
+    return std::make_shared<SizeType>(m_size);
 }
 
 
@@ -62,19 +63,20 @@ bool SizeType::operator<(const Type &other) const
 
 std::shared_ptr<SizeType> SizeType::get(Type::Size sz)
 {
-    return std::make_shared<SizeType>(sz);
+    return std::static_pointer_cast<SizeType>(getSharedScalar(TypeClass::Size, sz));
 }
 
 
 std::shared_ptr<SizeType> SizeType::get()
 {
-    return std::make_shared<SizeType>();
+    return std::static_pointer_cast<SizeType>(getSharedScalar(TypeClass::Size, 0));
 }
 
 
 void SizeType::setSize(Size sz)
 {
     m_size = sz;
+    invalidateLayout();
 }
 
 
@@ -95,7 +97,7 @@ QString SizeType::getCtype(bool /*final*/) const
 }
 
 
-SharedType SizeType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType SizeType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return const_cast<SizeType *>(this)->shared_from_this();
@@ -123,8 +125,8 @@ SharedType SizeType::meetWith(SharedType other, bool &changed, bool useHighestPt
 
     if (other->resolvesToInteger()) {
         if (other->getSize() == 0) {
-            other->setSize(m_size);
-            return other->clone();
+            // other might be a shared type, so do not modify it
+            return IntegerType::get(m_size, other->as<IntegerType>()->getSign());
         }
 
         if (other->getSize() != m_size) {
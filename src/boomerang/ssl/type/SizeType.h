@@ -32,6 +32,7 @@ public:
     SizeType &operator=(SizeType &&other) = default;
 
 public:
+    /// \returns the shared size type of unknown size or of size \p sz. \sa Type::isShared
     static std::shared_ptr<SizeType> get();
     static std::shared_ptr<SizeType> get(Size sz);
 
@@ -56,10 +57,10 @@ public:
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool) const override;
 
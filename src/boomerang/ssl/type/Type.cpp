@@ -33,14 +33,71 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
-#include <QMap>
+#include <QHash>
 
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
 
 
 /// For NamedType
-static QMap<QString, SharedType> g_namedTypes;
+static QHash<QString, SharedType> g_namedTypes;
+static std::mutex g_namedTypesMutex;
+
+/// Incremented whenever the size of any type might have changed.
+/// The new value becomes the layout version of the changed type.
+static std::atomic<uint64> g_layoutEpoch(1);
+
+/// Layout version of g_namedTypes
+static std::atomic<uint64> g_namedTypesVersion(0);
+
+/// Shared instances of all scalar types, keyed by (type class, size, sign).
+/// The instances are never released, so they can be identified by their address.
+static std::map<std::tuple<TypeClass, Type::Size, Sign>, SharedType> g_sharedScalars;
+static std::mutex g_sharedScalarsMutex;
+
+
+/// Key of a memoized meet of two shared scalar types
+struct MeetKey
+{
+    const Type *lhs;
+    const Type *rhs;
+    bool useHighestPtr;
+
+    bool operator==(const MeetKey &other) const
+    {
+        return lhs == other.lhs && rhs == other.rhs && useHighestPtr == other.useHighestPtr;
+    }
+};
+
+
+struct MeetKeyHash
+{
+    std::size_t operator()(const MeetKey &key) const
+    {
+        const std::size_t h = std::hash<const Type *>()(key.lhs) * 31 +
+                              std::hash<const Type *>()(key.rhs);
+        return key.useHighestPtr ? ~h : h;
+    }
+};
+
+
+struct MeetResult
+{
+    SharedType result;
+    bool changed;
+};
+
+
+/// Memoized results of Type::meetWith for shared scalar types.
+/// The cache is emptied when it grows too large. Every thread has its own cache,
+/// so procedures can be analysed in parallel without locking.
+static thread_local std::unordered_map<MeetKey, MeetResult, MeetKeyHash> g_meetCache;
+static const std::size_t MAX_MEET_CACHE_SIZE = 4096;
 
 
 Type::Type(TypeClass _class)
@@ -49,11 +106,39 @@ Type::Type(TypeClass _class)
 }
 
 
+Type::Type(const Type &other)
+    : m_id(other.m_id)
+{
+}
+
+
+Type::Type(Type &&other)
+    : m_id(other.m_id)
+{
+}
+
+
 Type::~Type()
 {
 }
 
 
+Type &Type::operator=(const Type &other)
+{
+    m_id = other.m_id;
+    invalidateLayout();
+    return *this;
+}
+
+
+Type &Type::operator=(Type &&other)
+{
+    m_id = other.m_id;
+    invalidateLayout();
+    return *this;
+}
+
+
 void Type::setSize(Type::Size)
 {
     assert(false); /* Redefined in subclasses. */
@@ -75,11 +160,16 @@ bool Type::operator!=(const Type &other) const
 
 void Type::addNamedType(const QString &name, SharedType type)
 {
-    if (g_namedTypes.find(name) != g_namedTypes.end()) {
-        if (!(*type == *g_namedTypes[name])) {
+    // Do not hold the lock while comparing types; comparing might resolve named types.
+    const SharedType previous = getNamedType(name);
+
+    if (previous) {
+        if (!(*type == *previous)) {
             LOG_WARN("Redefinition of type %1", name);
             LOG_WARN(" type     = %1", type->getCtype());
-            LOG_WARN(" previous = %1", g_namedTypes[name]->getCtype());
+            LOG_WARN(" previous = %1", previous->getCtype());
+
+            std::lock_guard<std::mutex> lock(g_namedTypesMutex);
             g_namedTypes[name] = type; // WARN: was *type==*namedTypes[name], verify !
         }
     }
@@ -89,18 +179,20 @@ void Type::addNamedType(const QString &name, SharedType type)
         // typedef a b;
         // we then need to define b as int
         // we create clones to keep the GC happy
-        if (g_namedTypes.find(type->getCtype()) != g_namedTypes.end()) {
-            g_namedTypes[name] = g_namedTypes[type->getCtype()]->clone();
-        }
-        else {
-            g_namedTypes[name] = type->clone();
-        }
+        const SharedType aliased = getNamedType(type->getCtype());
+        const SharedType newType = aliased ? aliased->clone() : type->clone();
+
+        std::lock_guard<std::mutex> lock(g_namedTypesMutex);
+        g_namedTypes[name] = newType;
     }
+
+    g_namedTypesVersion = ++g_layoutEpoch; // named types might resolve to a different type now
 }
 
 
 SharedType Type::getNamedType(const QString &name)
 {
+    std::lock_guard<std::mutex> lock(g_namedTypesMutex);
     auto iter = g_namedTypes.find(name);
 
     return (iter != g_namedTypes.end()) ? *iter : nullptr;
@@ -109,7 +201,110 @@ SharedType Type::getNamedType(const QString &name)
 
 void Type::clearNamedTypes()
 {
-    g_namedTypes.clear();
+    {
+        std::lock_guard<std::mutex> lock(g_namedTypesMutex);
+        g_namedTypes.clear();
+    }
+
+    g_namedTypesVersion = ++g_layoutEpoch;
+}
+
+
+uint64 Type::getLayoutVersion() const
+{
+    return m_layoutVersion;
+}
+
+
+void Type::invalidateLayout()
+{
+    m_layoutVersion = ++g_layoutEpoch;
+}
+
+
+uint64 Type::getLayoutEpoch()
+{
+    return g_layoutEpoch;
+}
+
+
+uint64 Type::getNamedTypesVersion()
+{
+    return g_namedTypesVersion;
+}
+
+
+SharedType Type::getSharedScalar(TypeClass id, Size size, Sign sign)
+{
+    // Only the integer sign and the size of sized types distinguish scalar types
+    if (id != TypeClass::Integer) {
+        sign = Sign::Unknown;
+    }
+
+    if (id == TypeClass::Void || id == TypeClass::Boolean || id == TypeClass::Char) {
+        size = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(g_sharedScalarsMutex);
+    SharedType &ty = g_sharedScalars[std::make_tuple(id, size, sign)];
+    if (ty) {
+        return ty;
+    }
+
+    switch (id) {
+    case TypeClass::Void: ty = std::make_shared<VoidType>(); break;
+    case TypeClass::Boolean: ty = std::make_shared<BooleanType>(); break;
+    case TypeClass::Char: ty = std::make_shared<CharType>(); break;
+    case TypeClass::Integer: ty = std::make_shared<IntegerType>(size, sign); break;
+    case TypeClass::Float: ty = std::make_shared<FloatType>(size); break;
+    case TypeClass::Size: ty = std::make_shared<SizeType>(size); break;
+    default: assert(false); return nullptr;
+    }
+
+    ty->m_isShared = true;
+    return ty;
+}
+
+
+SharedType Type::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+{
+    if (!m_isShared || !other->m_isShared) {
+        return meet(other, changed, useHighestPtr);
+    }
+
+    const MeetKey key{ this, other.get(), useHighestPtr };
+    auto it = g_meetCache.find(key);
+    if (it != g_meetCache.end()) {
+        changed |= it->second.changed;
+        return it->second.result;
+    }
+
+    bool thisChanged  = false;
+    SharedType result = meet(other, thisChanged, useHighestPtr);
+    changed |= thisChanged;
+
+    // Replace scalar results by their shared instance so they can be memoized
+    switch (result->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char:
+    case TypeClass::Float:
+    case TypeClass::Size:
+        result = getSharedScalar(result->getId(), result->getSize());
+        break;
+    case TypeClass::Integer:
+        result = getSharedScalar(TypeClass::Integer, result->getSize(),
+                                 result->as<IntegerType>()->getSign());
+        break;
+    default: return result; // not a scalar
+    }
+
+    if (g_meetCache.size() >= MAX_MEET_CACHE_SIZE) {
+        g_meetCache.clear();
+    }
+
+    g_meetCache[key] = MeetResult{ result, thisChanged };
+    return result;
 }
 
 
@@ -15,6 +15,7 @@
 
 #include <QString>
 
+#include <atomic>
 #include <cassert>
 #include <memory>
 
@@ -73,13 +74,13 @@ public:
 public:
     // Constructors
     Type(TypeClass id);
-    Type(const Type &other) = default;
-    Type(Type &&other)      = default;
+    Type(const Type &other);
+    Type(Type &&other);
 
     virtual ~Type();
 
-    Type &operator=(const Type &other) = default;
-    Type &operator=(Type &&other) = default;
+    Type &operator=(const Type &other);
+    Type &operator=(Type &&other);
 
 public:
     // Comparisons
@@ -176,6 +177,11 @@ public:
     /// Clear the named type map. Required for testing.
     static void clearNamedTypes();
 
+    /// \returns true if this is the shared instance of a scalar type
+    /// (void, bool, char, integer, float or size) returned by the get() functions
+    /// of the scalar types. Shared instances must not be modified; clone them instead.
+    bool isShared() const { return m_isShared; }
+
     /// Create a union of this Type and other. Set \p changed to true if any change
     SharedType createUnion(SharedType other, bool &changed, bool useHighestPtr = false) const;
 
@@ -193,13 +199,37 @@ public:
      * For data-flow-based type analysis only: implement the meet operator.
      * Set \p changed true if any change. If \p useHighestPtr is true,
      * then if this and other are non void* pointers, set the result to the
-     * *highest* possible type compatible with both (i.e. this JOIN other)
+     * *highest* possible type compatible with both (i.e. this JOIN other).
+     * The results of meeting two shared scalar types are memoized.
      * \todo the best possible thing would be to have both types as const
      */
-    virtual SharedType meetWith(SharedType other, bool &changed,
-                                bool useHighestPtr = false) const = 0;
+    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr = false) const;
+
+    /// \returns the layout version of this type. It changes whenever the size of this type
+    /// or of any type it contains (e.g. members of aggregates) might have changed,
+    /// so aggregates only recalculate their cached layout when it changed. \sa invalidateLayout
+    virtual uint64 getLayoutVersion() const;
 
 protected:
+    /// Must be called whenever this type is modified in a way that might change its size.
+    void invalidateLayout();
+
+    /// \returns the current layout epoch. It is incremented whenever the layout
+    /// of any type might have changed, so aggregates do not need to check the layout versions
+    /// of their members if the epoch did not change since their last check.
+    static uint64 getLayoutEpoch();
+
+    /// \returns the layout version of the named types. It changes whenever a named type
+    /// is added or replaced, or all named types are removed.
+    static uint64 getNamedTypesVersion();
+
+    /// \returns the shared instance of the scalar type with the given properties.
+    /// \sa isShared
+    static SharedType getSharedScalar(TypeClass id, Size size, Sign sign = Sign::Unknown);
+
+    /// meet does all of the work of meetWith, without looking up memoized results.
+    virtual SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const = 0;
+
     /**
      * isCompatible does most of the work; isCompatibleWith looks for complex types in other, and if
      * so reverses the parameters (this and other) to prevent many tedious repetitions
@@ -208,6 +238,10 @@ protected:
 
 protected:
     TypeClass m_id;
+
+private:
+    bool m_isShared = false; ///< Not copied; a copy of a shared type can be modified.
+    std::atomic<uint64> m_layoutVersion{ 0 }; ///< Not copied. \sa getLayoutVersion
 };
 
 
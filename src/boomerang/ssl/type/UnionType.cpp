@@ -15,6 +15,8 @@
 
 #include <QHash>
 
+#include <atomic>
+
 
 bool lessType::operator()(const SharedConstType &lhs, const SharedConstType &rhs) const
 {
@@ -31,7 +33,7 @@ UnionType::UnionType()
 UnionType::UnionType(const std::initializer_list<SharedType> members)
     : Type(TypeClass::Union)
 {
-    for (SharedType member : members) {
+    for (const SharedType &member : members) {
         addType(member, "");
     }
 }
@@ -46,10 +48,44 @@ UnionType::UnionType(const std::initializer_list<UnionType::Member> members)
 }
 
 
+UnionType::UnionType(const UnionType &other)
+    : Type(other)
+    , m_entries(other.m_entries)
+{
+}
+
+
+UnionType::UnionType(UnionType &&other)
+    : Type(std::move(other))
+    , m_entries(std::move(other.m_entries))
+{
+}
+
+
 UnionType::~UnionType()
 {
 }
 
+
+UnionType &UnionType::operator=(const UnionType &other)
+{
+    Type::operator=(other);
+
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    m_entries = other.m_entries;
+    return *this;
+}
+
+
+UnionType &UnionType::operator=(UnionType &&other)
+{
+    Type::operator=(std::move(other));
+
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    m_entries = std::move(other.m_entries);
+    return *this;
+}
+
 std::shared_ptr<UnionType> UnionType::get()
 {
     return std::make_shared<UnionType>();
@@ -82,6 +118,40 @@ SharedType UnionType::clone() const
 
 Type::Size UnionType::getSize() const
 {
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
+    return m_size;
+}
+
+
+uint64 UnionType::getLayoutVersion() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_layoutMutex);
+    updateLayout();
+    return m_membersVersion;
+}
+
+
+void UnionType::updateLayout() const
+{
+    const uint64 epoch = getLayoutEpoch();
+    if (m_checkedEpoch == epoch) {
+        return; // no type changed since the last check
+    }
+
+    // Keep the size unless this union or one of its members changed
+    uint64 version = Type::getLayoutVersion();
+    for (auto &[ty, name] : m_entries) {
+        Q_UNUSED(name);
+        version = std::max(version, ty->getLayoutVersion());
+    }
+
+    m_checkedEpoch = epoch;
+
+    if (version == m_membersVersion && m_size != 0) {
+        return;
+    }
+
     Size max = 0;
 
     for (auto &[ty, name] : m_entries) {
@@ -89,7 +159,8 @@ Type::Size UnionType::getSize() const
         max = std::max(max, ty->getSize());
     }
 
-    return std::max(max, (Size)1);
+    m_size           = std::max(max, (Size)1);
+    m_membersVersion = version;
 }
 
 
@@ -189,6 +260,9 @@ void UnionType::addType(SharedType newType, const QString &name)
         m_entries.insert({ newType, name });
         // TODO: update name if not inserted because of type clash
     }
+
+    m_size         = 0; // recalculate size
+    m_checkedEpoch = 0;
 }
 
 
@@ -215,9 +289,9 @@ QString UnionType::getCtype(bool final) const
 }
 
 
-static int nextUnionNumber = 0;
+static std::atomic<int> nextUnionNumber(0);
 
-SharedType UnionType::meetWith(SharedType other, bool &changed, bool useHighestPtr) const
+SharedType UnionType::meet(SharedType other, bool &changed, bool useHighestPtr) const
 {
     if (other->resolvesToVoid()) {
         return this->simplify(changed);
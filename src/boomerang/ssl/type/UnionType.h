@@ -13,6 +13,7 @@
 #include "boomerang/ssl/type/Type.h"
 
 #include <map>
+#include <mutex>
 
 
 struct BOOMERANG_API lessType
@@ -44,13 +45,13 @@ public:
     /// Create a new union type with named members.
     UnionType(const std::initializer_list<Member> members);
 
-    UnionType(const UnionType &other) = default;
-    UnionType(UnionType &&other)      = default;
+    UnionType(const UnionType &other);
+    UnionType(UnionType &&other);
 
     ~UnionType() override;
 
-    UnionType &operator=(const UnionType &other) = default;
-    UnionType &operator=(UnionType &&other) = default;
+    UnionType &operator=(const UnionType &other);
+    UnionType &operator=(UnionType &&other);
 
 public:
     static std::shared_ptr<UnionType> get();
@@ -69,12 +70,12 @@ public:
     /// \copydoc Type::getSize
     Size getSize() const override;
 
+    /// \copydoc Type::getLayoutVersion
+    uint64 getLayoutVersion() const override;
+
     /// \copydoc Type::getCtype
     QString getCtype(bool final = false) const override;
 
-    /// \copydoc Type::meetWith
-    SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
-
     /// \copydoc Type::isCompatibleWith
     bool isCompatibleWith(const Type &other, bool all) const override;
 
@@ -91,17 +92,32 @@ public:
     SharedType simplify(bool &changed) const;
 
 protected:
+    /// \copydoc Type::meet
+    SharedType meet(SharedType other, bool &changed, bool useHighestPtr) const override;
+
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
 private:
     /**
-     * Add a new type to this union.
+     * Add a new type to this union. Only used while constructing a new union,
+     * so the cached layouts of other types cannot be affected.
      * \param type the type of the new member
      * \param name the name of the new member
      */
     void addType(SharedType type, const QString &name = "");
 
+    /// Recalculate the size of this union if it is out of date.
+    /// \pre m_layoutMutex is held
+    void updateLayout() const;
+
 private:
     UnionEntries m_entries;
+
+    /// Guards the cached size, since types may be shared by procedures analysed in parallel
+    mutable std::recursive_mutex m_layoutMutex;
+
+    mutable Size m_size             = 0; ///< Cached size of the largest member
+    mutable uint64 m_membersVersion = 0; ///< Layout version of this union and its members
+    mutable uint64 m_checkedEpoch   = 0; ///< Layout epoch when m_membersVersion was checked
 };
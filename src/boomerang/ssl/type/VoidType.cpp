@@ -53,7 +53,7 @@ QString VoidType::getCtype(bool /*final*/) const
 }
 
 
-SharedType VoidType::meetWith(SharedType other, bool &changed, bool) const
+SharedType VoidType::meet(SharedType other, bool &changed, bool) const
 {
     if (other->resolvesToUnion()) {
         changed = true;
@@ -0,0 +1,158 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ByteSignatureTrie.h"
+
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QRegExp>
+#include <QTextStream>
+
+#include <map>
+#include <vector>
+
+
+struct ByteSignatureTrie::Node
+{
+    std::map<Byte, std::unique_ptr<Node>> children;
+    std::unique_ptr<Node> anyChild; ///< Child for wildcard bytes
+
+    QString name;           ///< Name of the function whose pattern ends here, if any
+    bool ambiguous = false; ///< Set if different functions have this pattern
+};
+
+
+ByteSignatureTrie::ByteSignatureTrie()
+    : m_root(new Node)
+{
+}
+
+
+ByteSignatureTrie::ByteSignatureTrie(ByteSignatureTrie &&other) = default;
+
+
+ByteSignatureTrie::~ByteSignatureTrie()
+{
+}
+
+
+ByteSignatureTrie &ByteSignatureTrie::operator=(ByteSignatureTrie &&other) = default;
+
+
+bool ByteSignatureTrie::addPattern(const QString &pattern, const QString &name)
+{
+    if (pattern.isEmpty() || pattern.size() % 2 != 0 || name.isEmpty()) {
+        return false;
+    }
+
+    // Parse the whole pattern first, so malformed patterns do not leave dangling nodes
+    std::vector<int> bytes; // -1 for wildcards
+    bytes.reserve(pattern.size() / 2);
+
+    for (int i = 0; i < pattern.size(); i += 2) {
+        const QStringRef byteStr = pattern.midRef(i, 2);
+        if (byteStr == "..") {
+            bytes.push_back(-1);
+            continue;
+        }
+
+        bool ok          = false;
+        const uint value = byteStr.toUInt(&ok, 16);
+        if (!ok) {
+            return false;
+        }
+
+        bytes.push_back(static_cast<int>(value));
+    }
+
+    Node *node = m_root.get();
+    for (int byte : bytes) {
+        std::unique_ptr<Node> &child = (byte == -1) ? node->anyChild
+                                                    : node->children[static_cast<Byte>(byte)];
+        if (!child) {
+            child.reset(new Node);
+        }
+
+        node = child.get();
+    }
+
+    if (node->name.isEmpty()) {
+        node->name = name;
+    }
+    else if (node->name != name) {
+        LOG_VERBOSE("Pattern of '%1' is ambiguous with pattern of '%2'", name, node->name);
+        node->ambiguous = true;
+    }
+
+    m_numPatterns++;
+    return true;
+}
+
+
+bool ByteSignatureTrie::readPatternFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        return false;
+    }
+
+    QTextStream strm(&file);
+    int lineNum = 0;
+
+    while (!strm.atEnd()) {
+        const QString line = strm.readLine().trimmed();
+        lineNum++;
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QStringList fields = line.split(QRegExp("\\s+"), QString::SkipEmptyParts);
+        if (fields.size() != 2 || !addPattern(fields[0], fields[1])) {
+            LOG_WARN("Ignoring malformed pattern in %1, line %2", filePath, lineNum);
+        }
+    }
+
+    return true;
+}
+
+
+QString ByteSignatureTrie::match(const Byte *data, std::size_t size) const
+{
+    const Node *best      = nullptr;
+    std::size_t bestDepth = 0;
+
+    matchNode(m_root.get(), data, size, 0, best, bestDepth);
+    return best ? best->name : QString();
+}
+
+
+void ByteSignatureTrie::matchNode(const Node *node, const Byte *data, std::size_t size,
+                                  std::size_t depth, const Node *&best, std::size_t &bestDepth)
+{
+    if (!node->name.isEmpty() && !node->ambiguous && depth > bestDepth) {
+        best      = node;
+        bestDepth = depth;
+    }
+
+    if (depth == size) {
+        return;
+    }
+
+    // Prefer exact bytes over wildcards for patterns of the same length
+    auto it = node->children.find(data[depth]);
+    if (it != node->children.end()) {
+        matchNode(it->second.get(), data, size, depth + 1, best, bestDepth);
+    }
+
+    if (node->anyChild) {
+        matchNode(node->anyChild.get(), data, size, depth + 1, best, bestDepth);
+    }
+}
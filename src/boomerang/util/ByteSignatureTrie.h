@@ -0,0 +1,77 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <memory>
+
+
+/**
+ * A trie of byte patterns identifying the entry points of library functions
+ * (e.g. statically linked libc or CRT functions).
+ *
+ * A pattern is a sequence of hexadecimal bytes, where ".." matches any byte
+ * (e.g. relocated addresses or displacements), for example
+ *   558BEC83EC..E8........C9C3
+ * All patterns are merged into a single trie, so the bytes at a candidate function entry
+ * are only compared once against all patterns sharing a common prefix.
+ */
+class BOOMERANG_API ByteSignatureTrie
+{
+    struct Node;
+
+public:
+    ByteSignatureTrie();
+    ByteSignatureTrie(const ByteSignatureTrie &other) = delete;
+    ByteSignatureTrie(ByteSignatureTrie &&other);
+
+    ~ByteSignatureTrie();
+
+    ByteSignatureTrie &operator=(const ByteSignatureTrie &other) = delete;
+    ByteSignatureTrie &operator=(ByteSignatureTrie &&other);
+
+public:
+    /// Add \p pattern identifying the function \p name.
+    /// \returns false if the pattern is malformed or empty.
+    bool addPattern(const QString &pattern, const QString &name);
+
+    /**
+     * Read all patterns from the pattern file \p filePath.
+     * Each line consists of a pattern and the name of the function, separated by whitespace.
+     * Empty lines and lines starting with '#' are ignored.
+     * \returns false if the file cannot be read.
+     */
+    bool readPatternFile(const QString &filePath);
+
+    /**
+     * Match all patterns against the \p size bytes at \p data.
+     * If several patterns match, the longest one wins.
+     * Identical patterns for different functions are ambiguous and never match.
+     * \returns the name of the matching function, or the empty string if no pattern matches.
+     */
+    QString match(const Byte *data, std::size_t size) const;
+
+    int getNumPatterns() const { return m_numPatterns; }
+    bool empty() const { return m_numPatterns == 0; }
+
+private:
+    /// Find the longest pattern in the subtrie \p node matching the bytes at \p data
+    static void matchNode(const Node *node, const Byte *data, std::size_t size,
+                          std::size_t depth, const Node *&best, std::size_t &bestDepth);
+
+private:
+    std::unique_ptr<Node> m_root;
+    int m_numPatterns = 0;
+};
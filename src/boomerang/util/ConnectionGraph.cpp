@@ -107,7 +107,7 @@ void ConnectionGraph::connect(SharedExp a, SharedExp b)
 
     add(b, a);
 
-    for (SharedExp e : a_connections) {
+    for (const SharedExp &e : a_connections) {
         add(e, b);
     }
 }
@@ -33,7 +33,7 @@ void DFGWriter::printDFG(const UserProc *proc, const QString &fname)
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (s->isPhi()) {
             out << s->getNumber() << " [shape=\"triangle\"];\n";
         }
@@ -49,7 +49,7 @@ void DFGWriter::printDFG(const UserProc *proc, const QString &fname)
         LocationSet refs;
         s->addUsedLocs(refs);
 
-        for (SharedExp rr : refs) {
+        for (const SharedExp &rr : refs) {
             auto r = std::dynamic_pointer_cast<RefExp>(rr);
 
             if (r) {
@@ -0,0 +1,270 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRMemoryReport.h"
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/util/OStream.h"
+#include "boomerang/visitor/expvisitor/ExpVisitor.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtExpVisitor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+
+/// Approximate size of a single collector entry (a node of a std::set holding one pointer)
+static constexpr std::size_t COLLECTOR_ENTRY_SIZE = 48;
+
+
+/// Counts all subexpressions of an expression by kind.
+class ExpKindCounter : public ExpVisitor
+{
+public:
+    ExpKindCounter(IRMemoryReport::ProcStats &stats)
+        : m_stats(stats)
+    {
+    }
+
+    bool preVisit(const std::shared_ptr<Unary> &, bool &) override
+    {
+        return count(IRObjectKind::Unary);
+    }
+
+    bool preVisit(const std::shared_ptr<Binary> &, bool &) override
+    {
+        return count(IRObjectKind::Binary);
+    }
+
+    bool preVisit(const std::shared_ptr<Ternary> &, bool &) override
+    {
+        return count(IRObjectKind::Ternary);
+    }
+
+    bool preVisit(const std::shared_ptr<TypedExp> &, bool &) override
+    {
+        return count(IRObjectKind::TypedExp);
+    }
+
+    bool preVisit(const std::shared_ptr<RefExp> &, bool &) override
+    {
+        return count(IRObjectKind::RefExp);
+    }
+
+    bool preVisit(const std::shared_ptr<Location> &, bool &) override
+    {
+        return count(IRObjectKind::Location);
+    }
+
+    bool visit(const std::shared_ptr<Const> &) override { return count(IRObjectKind::Const); }
+    bool visit(const std::shared_ptr<Terminal> &) override
+    {
+        return count(IRObjectKind::Terminal);
+    }
+
+private:
+    bool count(IRObjectKind kind)
+    {
+        m_stats.numObjects[static_cast<int>(kind)]++;
+        return true;
+    }
+
+private:
+    IRMemoryReport::ProcStats &m_stats;
+};
+
+
+static IRObjectKind getStatementKind(const SharedConstStmt &stmt)
+{
+    switch (stmt->getKind()) {
+    case StmtType::Assign: return IRObjectKind::Assign;
+    case StmtType::PhiAssign: return IRObjectKind::PhiAssign;
+    case StmtType::ImpAssign: return IRObjectKind::ImplicitAssign;
+    case StmtType::BoolAssign: return IRObjectKind::BoolAssign;
+    case StmtType::Call: return IRObjectKind::CallStatement;
+    case StmtType::Ret: return IRObjectKind::ReturnStatement;
+    case StmtType::Branch: return IRObjectKind::BranchStatement;
+    case StmtType::Goto: return IRObjectKind::GotoStatement;
+    case StmtType::Case: return IRObjectKind::CaseStatement;
+    case StmtType::INVALID: break;
+    }
+
+    return IRObjectKind::NUM_KINDS;
+}
+
+
+std::size_t IRMemoryReport::ProcStats::getEstimatedSize() const
+{
+    std::size_t size = numCollectorEntries * COLLECTOR_ENTRY_SIZE;
+
+    for (int i = 0; i < static_cast<int>(IRObjectKind::NUM_KINDS); ++i) {
+        size += numObjects[i] * IRObjectCounter::getObjectSize(static_cast<IRObjectKind>(i));
+    }
+
+    return size;
+}
+
+
+IRMemoryReport::IRMemoryReport(Prog *prog)
+    : m_prog(prog)
+{
+}
+
+
+IRMemoryReport::ProcStats IRMemoryReport::collectProcStats(UserProc *proc)
+{
+    ProcStats stats;
+    stats.proc = proc;
+
+    ExpKindCounter expCounter(stats);
+    StmtExpVisitor stmtCounter(&expCounter);
+
+    stats.numCollectorEntries = std::distance(proc->getUseCollector().begin(),
+                                              proc->getUseCollector().end());
+
+    for (IRFragment *frag : *proc->getCFG()) {
+        stats.numObjects[static_cast<int>(IRObjectKind::IRFragment)]++;
+
+        if (!frag->getRTLs()) {
+            continue;
+        }
+
+        for (const auto &rtl : *frag->getRTLs()) {
+            stats.numObjects[static_cast<int>(IRObjectKind::RTL)]++;
+
+            for (const SharedStmt &stmt : *rtl) {
+                const IRObjectKind kind = getStatementKind(stmt);
+                if (kind != IRObjectKind::NUM_KINDS) {
+                    stats.numObjects[static_cast<int>(kind)]++;
+                }
+
+                stmt->accept(&stmtCounter);
+
+                if (stmt->isCall()) {
+                    const std::shared_ptr<CallStatement> call = stmt->as<CallStatement>();
+                    stats.numObjects[static_cast<int>(IRObjectKind::DefCollector)]++;
+                    stats.numObjects[static_cast<int>(IRObjectKind::UseCollector)]++;
+                    stats.numCollectorEntries += std::distance(call->getDefCollector()->begin(),
+                                                               call->getDefCollector()->end());
+                    stats.numCollectorEntries += std::distance(call->getUseCollector()->begin(),
+                                                               call->getUseCollector()->end());
+                }
+                else if (stmt->isReturn()) {
+                    DefCollector *col = stmt->as<ReturnStatement>()->getCollector();
+                    stats.numObjects[static_cast<int>(IRObjectKind::DefCollector)]++;
+                    stats.numCollectorEntries += std::distance(col->begin(), col->end());
+                }
+            }
+        }
+    }
+
+    return stats;
+}
+
+
+void IRMemoryReport::collect()
+{
+    m_procStats.clear();
+    std::map<const UserProc *, std::size_t> procIndex;
+
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            UserProc *proc  = static_cast<UserProc *>(func);
+            procIndex[proc] = m_procStats.size();
+            m_procStats.push_back(collectProcStats(proc));
+        }
+    }
+
+    for (const BasicBlock *bb : *m_prog->getCFG()) {
+        auto it = procIndex.find(bb->getProc());
+        if (it != procIndex.end()) {
+            ProcStats &stats = m_procStats[it->second];
+            stats.numObjects[static_cast<int>(IRObjectKind::MachineInstruction)] +=
+                bb->getInsns().size();
+        }
+    }
+
+    std::stable_sort(m_procStats.begin(), m_procStats.end(),
+                     [](const ProcStats &a, const ProcStats &b) {
+                         return a.getEstimatedSize() > b.getEstimatedSize();
+                     });
+}
+
+
+void IRMemoryReport::print(OStream &os, int topN) const
+{
+    int64_t totalObjects  = 0;
+    std::size_t totalSize = 0;
+
+    os << "Live IR objects:\n";
+
+    for (int i = 0; i < static_cast<int>(IRObjectKind::NUM_KINDS); ++i) {
+        const IRObjectKind kind = static_cast<IRObjectKind>(i);
+        const int64_t count     = IRObjectCounter::getExclusiveCount(kind);
+        const std::size_t size  = count * IRObjectCounter::getObjectSize(kind);
+
+        totalObjects += count;
+        totalSize += size;
+
+        os << QString("  %1 %2 %3 bytes\n")
+                  .arg(IRObjectCounter::getKindName(kind), -20)
+                  .arg(count, 10)
+                  .arg(size, 12);
+    }
+
+    os << QString("  %1 %2 %3 bytes\n").arg("Total", -20).arg(totalObjects, 10).arg(totalSize, 12);
+
+    if (m_procStats.empty() || topN <= 0) {
+        return;
+    }
+
+    os << "Largest procedures by estimated IR size:\n";
+
+    const int numProcs = std::min(topN, static_cast<int>(m_procStats.size()));
+
+    for (int i = 0; i < numProcs; ++i) {
+        const ProcStats &stats = m_procStats[i];
+
+        int64_t numStmts = 0;
+        int64_t numExps  = 0;
+
+        for (int k = 0; k < static_cast<int>(IRObjectKind::NUM_KINDS); ++k) {
+            const IRObjectKind kind = static_cast<IRObjectKind>(k);
+
+            if (kind <= IRObjectKind::Location) {
+                numExps += stats.numObjects[k];
+            }
+            else if (kind <= IRObjectKind::ReturnStatement) {
+                numStmts += stats.numObjects[k];
+            }
+        }
+
+        os << QString("  %1 %2 bytes: %3 fragments, %4 RTLs, %5 statements, %6 expressions, "
+                      "%7 collector entries, %8 instructions\n")
+                  .arg(stats.proc->getName(), -30)
+                  .arg(stats.getEstimatedSize(), 12)
+                  .arg(stats.numObjects[static_cast<int>(IRObjectKind::IRFragment)])
+                  .arg(stats.numObjects[static_cast<int>(IRObjectKind::RTL)])
+                  .arg(numStmts)
+                  .arg(numExps)
+                  .arg(stats.numCollectorEntries)
+                  .arg(stats.numObjects[static_cast<int>(IRObjectKind::MachineInstruction)]);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/IRObjectCounter.h"
+
+#include <array>
+#include <vector>
+
+
+class OStream;
+class Prog;
+class UserProc;
+
+
+/**
+ * Attributes the IR memory of a program to the procedures owning it,
+ * and prints a summary of the largest procedures together with the global
+ * live object counts maintained by IRObjectCounter.
+ *
+ * Sizes are estimates: they count the fixed size of each IR object,
+ * but not memory owned by the object (e.g. strings or statement lists).
+ * Expressions shared between several statements are counted once per use.
+ */
+class BOOMERANG_API IRMemoryReport
+{
+public:
+    /// IR objects owned by a single procedure
+    struct ProcStats
+    {
+        UserProc *proc = nullptr;
+        std::array<int64_t, static_cast<int>(IRObjectKind::NUM_KINDS)> numObjects = {};
+        int64_t numCollectorEntries = 0; ///< Entries in the DefCollectors and UseCollectors
+
+        /// \returns the estimated number of bytes used by the IR of the procedure.
+        std::size_t getEstimatedSize() const;
+    };
+
+public:
+    IRMemoryReport(Prog *prog);
+
+public:
+    /// Walk the IR of all user procedures in the program.
+    void collect();
+
+    /// \returns the statistics of all procedures, largest procedure first.
+    /// Only valid after calling \ref collect.
+    const std::vector<ProcStats> &getProcStats() const { return m_procStats; }
+
+    /// Print the global live object counts and the \p topN largest procedures to \p os.
+    void print(OStream &os, int topN) const;
+
+    /// Collect the IR objects owned by \p proc, except for machine instructions.
+    static ProcStats collectProcStats(UserProc *proc);
+
+private:
+    Prog *m_prog;
+    std::vector<ProcStats> m_procStats;
+};
@@ -0,0 +1,127 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRObjectCounter.h"
+
+#include "boomerang/db/DefCollector.h"
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/UseCollector.h"
+#include "boomerang/frontend/MachineInstruction.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/BoolAssign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/CaseStatement.h"
+#include "boomerang/ssl/statements/ImplicitAssign.h"
+#include "boomerang/ssl/statements/PhiAssign.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+
+
+std::array<std::atomic<int64_t>, static_cast<int>(IRObjectKind::NUM_KINDS)>
+    IRObjectCounter::s_liveCount = {};
+
+
+int64_t IRObjectCounter::getExclusiveCount(IRObjectKind kind)
+{
+    int64_t count = getLiveCount(kind);
+
+    for (int i = 0; i < static_cast<int>(IRObjectKind::NUM_KINDS); ++i) {
+        if (getParentKind(static_cast<IRObjectKind>(i)) == kind) {
+            count -= getLiveCount(static_cast<IRObjectKind>(i));
+        }
+    }
+
+    return count;
+}
+
+
+std::size_t IRObjectCounter::getObjectSize(IRObjectKind kind)
+{
+    switch (kind) {
+    case IRObjectKind::Const: return sizeof(Const);
+    case IRObjectKind::Terminal: return sizeof(Terminal);
+    case IRObjectKind::Unary: return sizeof(Unary);
+    case IRObjectKind::Binary: return sizeof(Binary);
+    case IRObjectKind::Ternary: return sizeof(Ternary);
+    case IRObjectKind::TypedExp: return sizeof(TypedExp);
+    case IRObjectKind::RefExp: return sizeof(RefExp);
+    case IRObjectKind::Location: return sizeof(Location);
+    case IRObjectKind::Assign: return sizeof(Assign);
+    case IRObjectKind::PhiAssign: return sizeof(PhiAssign);
+    case IRObjectKind::ImplicitAssign: return sizeof(ImplicitAssign);
+    case IRObjectKind::BoolAssign: return sizeof(BoolAssign);
+    case IRObjectKind::GotoStatement: return sizeof(GotoStatement);
+    case IRObjectKind::BranchStatement: return sizeof(BranchStatement);
+    case IRObjectKind::CaseStatement: return sizeof(CaseStatement);
+    case IRObjectKind::CallStatement: return sizeof(CallStatement);
+    case IRObjectKind::ReturnStatement: return sizeof(ReturnStatement);
+    case IRObjectKind::RTL: return sizeof(RTL);
+    case IRObjectKind::IRFragment: return sizeof(IRFragment);
+    case IRObjectKind::MachineInstruction: return sizeof(MachineInstruction);
+    case IRObjectKind::DefCollector: return sizeof(DefCollector);
+    case IRObjectKind::UseCollector: return sizeof(UseCollector);
+    case IRObjectKind::NUM_KINDS: break;
+    }
+
+    return 0;
+}
+
+
+IRObjectKind IRObjectCounter::getParentKind(IRObjectKind kind)
+{
+    switch (kind) {
+    case IRObjectKind::Binary:
+    case IRObjectKind::TypedExp:
+    case IRObjectKind::RefExp:
+    case IRObjectKind::Location: return IRObjectKind::Unary;
+    case IRObjectKind::Ternary: return IRObjectKind::Binary;
+    case IRObjectKind::BranchStatement:
+    case IRObjectKind::CaseStatement:
+    case IRObjectKind::CallStatement: return IRObjectKind::GotoStatement;
+    default: return IRObjectKind::NUM_KINDS;
+    }
+}
+
+
+QString IRObjectCounter::getKindName(IRObjectKind kind)
+{
+    switch (kind) {
+    case IRObjectKind::Const: return "Const";
+    case IRObjectKind::Terminal: return "Terminal";
+    case IRObjectKind::Unary: return "Unary";
+    case IRObjectKind::Binary: return "Binary";
+    case IRObjectKind::Ternary: return "Ternary";
+    case IRObjectKind::TypedExp: return "TypedExp";
+    case IRObjectKind::RefExp: return "RefExp";
+    case IRObjectKind::Location: return "Location";
+    case IRObjectKind::Assign: return "Assign";
+    case IRObjectKind::PhiAssign: return "PhiAssign";
+    case IRObjectKind::ImplicitAssign: return "ImplicitAssign";
+    case IRObjectKind::BoolAssign: return "BoolAssign";
+    case IRObjectKind::GotoStatement: return "GotoStatement";
+    case IRObjectKind::BranchStatement: return "BranchStatement";
+    case IRObjectKind::CaseStatement: return "CaseStatement";
+    case IRObjectKind::CallStatement: return "CallStatement";
+    case IRObjectKind::ReturnStatement: return "ReturnStatement";
+    case IRObjectKind::RTL: return "RTL";
+    case IRObjectKind::IRFragment: return "IRFragment";
+    case IRObjectKind::MachineInstruction: return "MachineInstruction";
+    case IRObjectKind::DefCollector: return "DefCollector";
+    case IRObjectKind::UseCollector: return "UseCollector";
+    case IRObjectKind::NUM_KINDS: break;
+    }
+
+    return "<invalid>";
+}
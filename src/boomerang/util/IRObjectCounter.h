@@ -0,0 +1,118 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QString>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+
+/// Kinds of IR objects whose live instances are counted by IRObjectCounter.
+enum class IRObjectKind : uint8_t
+{
+    // Expressions
+    Const,
+    Terminal,
+    Unary,
+    Binary,
+    Ternary,
+    TypedExp,
+    RefExp,
+    Location,
+
+    // Statements
+    Assign,
+    PhiAssign,
+    ImplicitAssign,
+    BoolAssign,
+    GotoStatement,
+    BranchStatement,
+    CaseStatement,
+    CallStatement,
+    ReturnStatement,
+
+    // Containers
+    RTL,
+    IRFragment,
+    MachineInstruction,
+    DefCollector,
+    UseCollector,
+
+    NUM_KINDS
+};
+
+
+/**
+ * Keeps track of the number of live IR objects, by kind.
+ * The counts are maintained by the IRCounted base class and are inclusive,
+ * i.e. the count for Unary also includes all live Binary, Location etc. objects.
+ * Use getExclusiveCount() to get the number of objects of exactly one kind.
+ */
+class BOOMERANG_API IRObjectCounter
+{
+public:
+    /// \returns the number of live objects of kind \p kind, including subclasses.
+    static int64_t getLiveCount(IRObjectKind kind)
+    {
+        return s_liveCount[static_cast<int>(kind)].load(std::memory_order_relaxed);
+    }
+
+    /// \returns the number of live objects of exactly kind \p kind, excluding subclasses.
+    static int64_t getExclusiveCount(IRObjectKind kind);
+
+    /// \returns the size of a single object of kind \p kind in bytes.
+    /// Memory owned by the object (e.g. statement lists) is not included.
+    static std::size_t getObjectSize(IRObjectKind kind);
+
+    /// \returns the kind \p kind directly derives from,
+    /// or IRObjectKind::NUM_KINDS if \p kind is not a subclass of another counted kind.
+    static IRObjectKind getParentKind(IRObjectKind kind);
+
+    /// \returns the name of \p kind (e.g. "Binary")
+    static QString getKindName(IRObjectKind kind);
+
+    static void increment(IRObjectKind kind)
+    {
+        s_liveCount[static_cast<int>(kind)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void decrement(IRObjectKind kind)
+    {
+        s_liveCount[static_cast<int>(kind)].fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    static std::array<std::atomic<int64_t>, static_cast<int>(IRObjectKind::NUM_KINDS)>
+        s_liveCount;
+};
+
+
+/**
+ * Empty base class that counts the number of live objects of kind \p Kind.
+ * Derive privately from this class to have all instances of the derived class
+ * counted by IRObjectCounter.
+ */
+template<IRObjectKind Kind>
+class IRCounted
+{
+protected:
+    IRCounted() { IRObjectCounter::increment(Kind); }
+    IRCounted(const IRCounted &) { IRObjectCounter::increment(Kind); }
+    IRCounted(IRCounted &&) { IRObjectCounter::increment(Kind); }
+    ~IRCounted() { IRObjectCounter::decrement(Kind); }
+
+    IRCounted &operator=(const IRCounted &) = default;
+    IRCounted &operator=(IRCounted &&) = default;
+};
@@ -136,6 +136,26 @@ public:
         }
     }
 
+    /// \returns true if \p interval is completely contained in a single interval of this set.
+    bool isContained(const Interval<T> &interval) const
+    {
+        if (isEmpty()) {
+            return false;
+        }
+
+        const_iterator it = std::lower_bound(m_data.begin(), m_data.end(), interval.lower());
+
+        if ((it != end()) && it->containsInterval(interval)) {
+            return true;
+        }
+        else if (it == m_data.begin()) {
+            return false;
+        }
+        else {
+            return std::prev(it)->containsInterval(interval);
+        }
+    }
+
 private:
     Data m_data;
 };
@@ -0,0 +1,76 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace Util
+{
+/// \returns the number of threads to use if \p numThreads threads were requested.
+/// Zero or negative values request one thread per hardware thread.
+inline int getNumThreads(int numThreads)
+{
+    if (numThreads <= 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    return numThreads;
+}
+
+
+/**
+ * Call \p func(i) for every i in [0, \p count) on a pool of at most \p numThreads threads
+ * (see getNumThreads). The calling thread is part of the pool, so no thread is created
+ * if a single thread is requested. Items are handed out one at a time in ascending order,
+ * so that expensive items do not delay the others; the order in which they finish
+ * is unspecified. Returns after all items are done.
+ */
+template<typename Func>
+void parallelFor(std::size_t count, int numThreads, Func func)
+{
+    numThreads = static_cast<int>(std::min<std::size_t>(getNumThreads(numThreads), count));
+
+    if (numThreads <= 1) {
+        for (std::size_t i = 0; i < count; i++) {
+            func(i);
+        }
+
+        return;
+    }
+
+    std::atomic<std::size_t> nextItem(0);
+
+    auto worker = [&]() {
+        std::size_t idx;
+        while ((idx = nextItem++) < count) {
+            func(idx);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+
+    for (int i = 0; i < numThreads - 1; i++) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
+}
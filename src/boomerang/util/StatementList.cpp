@@ -94,7 +94,7 @@ void StatementList::makeIsect(StatementList &a, LocationSet &b)
     }
     else { // normal assignment
         clear();
-        for (SharedStmt stmt : a) {
+        for (const SharedStmt &stmt : a) {
             assert(stmt->isAssignment());
             std::shared_ptr<Assignment> as = stmt->as<Assignment>();
 
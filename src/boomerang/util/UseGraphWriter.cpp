@@ -35,7 +35,7 @@ void UseGraphWriter::writeUseGraph(const UserProc *proc, const QString &filePath
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : stmts) {
         if (s->isPhi()) {
             out << s->getNumber() << " [shape=diamond];\n";
         }
@@ -43,7 +43,7 @@ void UseGraphWriter::writeUseGraph(const UserProc *proc, const QString &filePath
         LocationSet refs;
         s->addUsedLocs(refs);
 
-        for (SharedExp rr : refs) {
+        for (const SharedExp &rr : refs) {
             if (rr->isSubscript()) {
                 auto r = rr->access<RefExp>();
 
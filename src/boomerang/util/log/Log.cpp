@@ -57,6 +57,8 @@ Log &Log::getOrCreateLog()
 
 void Log::flush()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     for (std::unique_ptr<ILogSink> &s : m_sinks) {
         s->flush();
     }
@@ -65,6 +67,8 @@ void Log::flush()
 
 void Log::log(LogLevel level, const char *file, int line, const QString &msg)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     const QStringList msgLines = msg.split('\n');
 
     for (const QString &msgLine : msgLines) {
@@ -88,6 +92,8 @@ void Log::logDirect(LogLevel level, const char *file, int line, const QString &m
 #endif
 
     const QString pattern = "%1 | %2 | %3 | %4\n";
+
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     this->write(pattern.arg(levelToString(level)).arg(prettyFilePath).arg(line, 4).arg(msg));
 
     if (level == LogLevel::Fatal) {
@@ -100,6 +106,8 @@ void Log::addLogSink(std::unique_ptr<ILogSink> s)
 {
     assert(s != nullptr);
 
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     if (std::find(m_sinks.begin(), m_sinks.end(), s) == m_sinks.end()) {
         m_sinks.push_back(std::move(s));
     }
@@ -119,6 +127,8 @@ void Log::addDefaultLogSinks(const QString &outputDir)
 
 void Log::removeAllSinks()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
     flush();
 
     m_sinks.clear();
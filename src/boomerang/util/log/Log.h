@@ -14,6 +14,7 @@
 #include "boomerang/util/Types.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
@@ -189,6 +190,10 @@ private:
     size_t m_fileNameOffset;
     LogLevel m_level = LogLevel::Default;
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
+
+    /// Serializes writing to the sinks, so that messages logged by different threads
+    /// are not interleaved.
+    std::recursive_mutex m_mutex;
 };
 
 template<>
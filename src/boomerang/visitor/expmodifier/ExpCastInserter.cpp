@@ -35,7 +35,6 @@ static SharedExp checkSignedness(SharedExp e, Sign reqSignedness)
         std::shared_ptr<IntegerType> newtype = IntegerType::get(
             ty->as<const IntegerType>()->getSize(), reqSignedness);
 
-        newtype->setSignedness(reqSignedness);
         return TypedExp::get(newtype, e);
     }
 
@@ -147,7 +147,7 @@ bool UsedLocsVisitor::visit(const std::shared_ptr<CallStatement> &stmt, bool &vi
 
     const StatementList &arguments = stmt->getArguments();
 
-    for (SharedStmt s : arguments) {
+    for (const SharedStmt &s : arguments) {
         // Don't want to ever collect anything from the lhs
         if (s->isAssign()) {
             s->as<Assign>()->getRight()->acceptVisitor(ev);
@@ -168,7 +168,7 @@ bool UsedLocsVisitor::visit(const std::shared_ptr<CallStatement> &stmt, bool &vi
 bool UsedLocsVisitor::visit(const std::shared_ptr<ReturnStatement> &stmt, bool &visitChildren)
 {
     // For the final pass, only consider the first return
-    for (SharedStmt ret : *stmt) {
+    for (const SharedStmt &ret : *stmt) {
         ret->accept(this);
     }
 
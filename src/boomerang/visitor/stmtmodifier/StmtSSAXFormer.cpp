@@ -101,7 +101,7 @@ void StmtSSAXformer::visit(const std::shared_ptr<CallStatement> &stmt, bool &vis
 
     const StatementList &arguments = stmt->getArguments();
 
-    for (SharedStmt s : arguments) {
+    for (const SharedStmt &s : arguments) {
         s->accept(this);
     }
 
@@ -111,7 +111,7 @@ void StmtSSAXformer::visit(const std::shared_ptr<CallStatement> &stmt, bool &vis
     // fromSSA() function
     StatementList &defines = stmt->getDefines();
 
-    for (SharedStmt define : defines) {
+    for (const SharedStmt &define : defines) {
         assert(define->isAssignment());
         std::shared_ptr<Assignment> as = define->as<Assignment>();
 
@@ -84,7 +84,7 @@ void StmtSubscripter::visit(const std::shared_ptr<CallStatement> &stmt, bool &vi
     }
 
     // Subscript the ordinary arguments
-    for (SharedStmt arg : stmt->getArguments()) {
+    for (const SharedStmt &arg : stmt->getArguments()) {
         arg->accept(this);
     }
 
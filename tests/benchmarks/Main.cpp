@@ -0,0 +1,107 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StageBenchmark.h"
+
+#include "boomerang/util/log/Log.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <iostream>
+
+
+static void help()
+{
+    // clang-format off
+    std::cout <<
+"Usage:\n"
+"  boomerang-stage-bench [ -n <iterations> ] [ -o <file> ] [ -P <path> ] [ <sample>... ]\n"
+"\n"
+"  -n <iterations>  : Run each binary <iterations> times (default 5)\n"
+"  -o <file>        : Write the results to <file> instead of stdout\n"
+"  -P <path>        : Path to the Boomerang installation (containing share/ and lib/)\n"
+"  <sample>         : Binary to benchmark, relative to the samples directory.\n"
+"                     If no sample is given, the default corpus is used.\n";
+    // clang-format on
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QString basePath = BOOMERANG_TEST_BASE;
+    QString outFile;
+    QStringList corpus;
+    int iterations = 5;
+
+    for (int i = 1; i < args.size(); ++i) {
+        const QString &arg = args[i];
+
+        if (arg == "-h" || arg == "--help") {
+            help();
+            return 0;
+        }
+        else if (arg == "-n" || arg == "-o" || arg == "-P") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            if (arg == "-n") {
+                bool converted = false;
+                iterations     = args[i].toInt(&converted, 0);
+
+                if (!converted || iterations < 1) {
+                    std::cerr << "'-n': Bad argument '" << args[i].toStdString() << "'"
+                              << std::endl;
+                    return 1;
+                }
+            }
+            else if (arg == "-o") {
+                outFile = args[i];
+            }
+            else {
+                basePath = args[i] + "/";
+            }
+        }
+        else {
+            corpus.append(arg);
+        }
+    }
+
+    if (corpus.empty()) {
+        corpus = StageBenchmark::getDefaultCorpus();
+    }
+
+    // Keep logging overhead out of the measurements.
+    Log::getOrCreateLog().setLogLevel(LogLevel::Error);
+
+    StageBenchmark bench(basePath + "share/boomerang/", basePath + "lib/boomerang/plugins/");
+    bench.setIterations(iterations);
+
+    const QByteArray json = QJsonDocument(bench.run(corpus)).toJson();
+
+    if (outFile.isEmpty()) {
+        std::cout << json.constData();
+        return 0;
+    }
+
+    QFile file(outFile);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        std::cerr << "Cannot open '" << outFile.toStdString() << "' for writing" << std::endl;
+        return 1;
+    }
+
+    file.write(json);
+    return 0;
+}
@@ -0,0 +1,158 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "MicroBenchmark.h"
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/DataFlow.h"
+#include "boomerang/db/DominatorTree.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+static IRFragment *createFragment(Prog &prog, UserProc &proc, BBType bbType, Address addr)
+{
+    BasicBlock *bb = prog.getCFG()->createBB(bbType, createInsns(addr, 1));
+    bb->setProc(&proc);
+    return proc.getCFG()->createFragment(static_cast<FragType>(bbType), createRTLs(addr, 1, 1),
+                                         bb);
+}
+
+
+void MicroBenchmark::benchInstantiateRTL()
+{
+    RTLInstDict dict(false);
+    QVERIFY(dict.readSSLFile(BOOMERANG_TEST_BASE "share/boomerang/ssl/x86.ssl"));
+
+    const std::vector<SharedExp> args = { Location::regOf(REG_X86_EAX),
+                                          Location::regOf(REG_X86_ECX) };
+
+    QBENCHMARK {
+        std::unique_ptr<RTL> rtl = dict.instantiateRTL("ADD.reg32.reg32", Address(0x1000), args);
+        QVERIFY(rtl != nullptr);
+    }
+}
+
+
+void MicroBenchmark::benchExpSimplify()
+{
+    // (r28 + 8 - 8) + m[r29 - 4] * 1
+    const SharedExp exp = Binary::get(
+        opPlus,
+        Binary::get(opMinus, Binary::get(opPlus, Location::regOf(REG_X86_ESP), Const::get(8)),
+                    Const::get(8)),
+        Binary::get(opMult,
+                    Location::memOf(
+                        Binary::get(opMinus, Location::regOf(REG_X86_EBP), Const::get(4))),
+                    Const::get(1)));
+
+    QBENCHMARK {
+        SharedExp simplified = exp->clone()->simplify();
+        QVERIFY(simplified != nullptr);
+    }
+}
+
+
+void MicroBenchmark::benchCalculateDominators()
+{
+    const int NUM_DIAMONDS = 500;
+
+    Prog prog("bench", nullptr);
+    UserProc proc(Address(0x1000), "bench", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    IRFragment *entry    = createFragment(prog, proc, BBType::Fall, Address(0x1000));
+    IRFragment *prev     = entry;
+    IRFragment *loopHead = nullptr;
+
+    // A chain of if-then-else diamonds, with a back edge every 10 diamonds
+    for (int i = 0; i < NUM_DIAMONDS; ++i) {
+        const Address base = Address(0x2000) + 4 * i;
+
+        IRFragment *cond  = createFragment(prog, proc, BBType::Twoway, base);
+        IRFragment *left  = createFragment(prog, proc, BBType::Fall, base + 1);
+        IRFragment *right = createFragment(prog, proc, BBType::Fall, base + 2);
+        IRFragment *join  = createFragment(prog, proc, BBType::Twoway, base + 3);
+
+        cfg->addEdge(prev, cond);
+        cfg->addEdge(cond, left);
+        cfg->addEdge(cond, right);
+        cfg->addEdge(left, join);
+        cfg->addEdge(right, join);
+
+        if (i % 10 == 0) {
+            loopHead = cond;
+        }
+
+        cfg->addEdge(join, loopHead);
+        prev = join;
+    }
+
+    IRFragment *exit = createFragment(prog, proc, BBType::Ret, Address(0x1001));
+    cfg->addEdge(prev, exit);
+    proc.setEntryFragment();
+
+    DominatorTree domTree;
+
+    QBENCHMARK {
+        // The results are cached until the CFG changes, so drop them to measure the calculation
+        domTree.clear();
+        QVERIFY(domTree.calculate(cfg));
+    }
+}
+
+
+void MicroBenchmark::benchReadNative4()
+{
+    const int NUM_SECTIONS = 16;
+    const int SECTION_SIZE = 0x1000;
+
+    std::vector<Byte> data(NUM_SECTIONS * SECTION_SIZE);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<Byte>(i);
+    }
+
+    BinaryImage img(QByteArray{});
+
+    for (int i = 0; i < NUM_SECTIONS; ++i) {
+        const Address from  = Address(0x10000) + i * SECTION_SIZE;
+        BinarySection *sect = img.createSection(QString(".sect%1").arg(i), from,
+                                                from + SECTION_SIZE);
+        sect->setHostAddr(HostAddress(data.data() + i * SECTION_SIZE));
+        sect->addDefinedArea(from, from + SECTION_SIZE);
+    }
+
+    // Translate addresses like a loaded program does (see Project::loadBinaryFile)
+    img.updatePageTable();
+
+    const Address low  = Address(0x10000);
+    const Address high = low + NUM_SECTIONS * SECTION_SIZE;
+    DWord sum          = 0;
+
+    QBENCHMARK {
+        for (Address addr = low; addr < high; addr += 4) {
+            DWord value = 0;
+            img.readNative4(addr, value);
+            sum += value;
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+
+QTEST_GUILESS_MAIN(MicroBenchmark)
@@ -0,0 +1,36 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Micro benchmarks for functions that dominate the decompilation time.
+ * Run with e.g. "-o result.xml,xml" to get machine-readable results.
+ */
+class MicroBenchmark : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Benchmark instantiating an x86 instruction from its SSL template
+    void benchInstantiateRTL();
+
+    /// Benchmark simplifying a typical address expression
+    void benchExpSimplify();
+
+    /// Benchmark calculating dominators and dominance frontiers of a large CFG
+    void benchCalculateDominators();
+
+    /// Benchmark reading 32 bit values from a multi-section binary image
+    void benchReadNative4();
+};
@@ -0,0 +1,324 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StageBenchmark.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QTemporaryDir>
+
+#include <vector>
+
+#if defined(_WIN32)
+#    include <windows.h>
+#    include <psapi.h>
+#elif defined(__APPLE__)
+#    include <mach/mach.h>
+#else
+#    include <unistd.h>
+#endif
+
+
+StageBenchmark::StageBenchmark(const QString &dataDir, const QString &pluginDir)
+    : m_dataDir(dataDir)
+    , m_pluginDir(pluginDir)
+{
+}
+
+
+QStringList StageBenchmark::getDefaultCorpus()
+{
+    // clang-format off
+    return {
+        "elf/hello-clang4-dynamic",
+        "elf32-ppc/fibo",
+        "elf32-ppc/switch",
+        "OSX/fibo",
+        "OSX/switch",
+        "ppc/fibo",
+        "ppc/switch",
+        "windows/hello.exe",
+        "windows/switch_gcc.exe",
+        "windows/switch_msvc5.exe",
+    };
+    // clang-format on
+}
+
+
+QString StageBenchmark::getStageName(BenchStage stage)
+{
+    switch (stage) {
+    case BenchStage::Load: return "load";
+    case BenchStage::Decode: return "decode";
+    case BenchStage::Lift: return "lift";
+    case BenchStage::Decompile: return "decompile";
+    case BenchStage::CodeGen: return "codegen";
+    case BenchStage::NUM_STAGES: break;
+    }
+
+    return "<invalid>";
+}
+
+
+QJsonObject StageBenchmark::run(const QStringList &corpus)
+{
+    QJsonArray binaries;
+    const QDir samplesDir(QDir(m_dataDir).absoluteFilePath("samples"));
+
+    for (const QString &binary : corpus) {
+        std::vector<RunResult> runs;
+        bool ok = true;
+
+        for (int i = 0; i < m_iterations && ok; ++i) {
+            runs.emplace_back();
+            ok = runOnce(samplesDir.absoluteFilePath(binary), runs.back());
+        }
+
+        QJsonObject binaryResult;
+        binaryResult["binary"] = binary;
+        binaryResult["ok"]     = ok;
+
+        if (!ok) {
+            binaries.append(binaryResult);
+            continue;
+        }
+
+        QJsonObject stages;
+
+        for (int st = 0; st < static_cast<int>(BenchStage::NUM_STAGES); ++st) {
+            std::vector<qint64> times;
+            qint64 rss      = -1;
+            qint64 rssDelta = 0;
+
+            for (const RunResult &run : runs) {
+                times.push_back(run[st].nsecs);
+                rss      = std::max(rss, run[st].rss);
+                rssDelta = std::max(rssDelta, run[st].rssDelta);
+            }
+
+            std::sort(times.begin(), times.end());
+            const qint64 median = (times.size() % 2 != 0)
+                                      ? times[times.size() / 2]
+                                      : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+
+            // IR node counts are deterministic; take them from the last run.
+            QJsonObject counts;
+            for (const auto &[name, count] : runs.back()[st].counts) {
+                counts[name] = count;
+            }
+
+            QJsonObject stageResult;
+            stageResult["median_ms"]    = static_cast<double>(median) / 1.0e6;
+            stageResult["rss_kb"]       = rss >= 0 ? rss / 1024 : -1;
+            stageResult["rss_delta_kb"] = rssDelta / 1024;
+            stageResult["counts"]       = counts;
+
+            stages[getStageName(static_cast<BenchStage>(st))] = stageResult;
+        }
+
+        binaryResult["stages"] = stages;
+        binaries.append(binaryResult);
+    }
+
+    QJsonObject result;
+    result["format"]     = 1;
+    result["iterations"] = m_iterations;
+    result["binaries"]   = binaries;
+    return result;
+}
+
+
+bool StageBenchmark::runOnce(const QString &filePath, RunResult &result)
+{
+    QTemporaryDir outputDir;
+    if (!outputDir.isValid()) {
+        return false;
+    }
+
+    Project project;
+    project.getSettings()->setDataDirectory(m_dataDir);
+    project.getSettings()->setPluginDirectory(m_pluginDir);
+    project.getSettings()->setOutputDirectory(outputDir.path() + "/");
+    project.loadPlugins();
+
+    QElapsedTimer timer;
+    StageResult *stage = nullptr;
+    qint64 rssBefore   = getCurrentRSS();
+
+    // Record time and memory usage of the current stage
+    auto finishStage = [&]() {
+        stage->nsecs    = timer.nsecsElapsed();
+        stage->rss      = getCurrentRSS();
+        stage->rssDelta = (stage->rss >= 0 && rssBefore >= 0) ? stage->rss - rssBefore : 0;
+        rssBefore       = stage->rss;
+    };
+
+    // Load
+    stage = &result[static_cast<int>(BenchStage::Load)];
+    timer.start();
+    if (!project.loadBinaryFile(filePath)) {
+        return false;
+    }
+
+    finishStage();
+    stage->counts["sections"] = project.getLoadedBinaryFile()->getImage()->getNumSections();
+    stage->counts["symbols"]  = project.getLoadedBinaryFile()->getSymbols()->size();
+
+    // Decode
+    stage = &result[static_cast<int>(BenchStage::Decode)];
+    timer.restart();
+    if (!project.decodeBinaryFile()) {
+        return false;
+    }
+
+    finishStage();
+
+    qint64 numInsns = 0;
+    for (const BasicBlock *bb : *project.getProg()->getCFG()) {
+        numInsns += bb->getInsns().size();
+    }
+
+    stage->counts["functions"] = project.getProg()->getNumFunctions();
+    stage->counts["bbs"]       = project.getProg()->getCFG()->getNumBBs();
+    stage->counts["insns"]     = numInsns;
+
+    // Lift. Decompilation lifts each procedure again when it is visited,
+    // so the decompile stage includes its own lifting time.
+    stage = &result[static_cast<int>(BenchStage::Lift)];
+    timer.restart();
+
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib() && static_cast<UserProc *>(func)->isDecoded()) {
+                PassManager::get()->executePass(PassID::StatementInit,
+                                                static_cast<UserProc *>(func));
+            }
+        }
+    }
+
+    finishStage();
+    countIR(project, stage->counts);
+
+    // Decompile
+    stage = &result[static_cast<int>(BenchStage::Decompile)];
+    timer.restart();
+    if (!project.decompileBinaryFile()) {
+        return false;
+    }
+
+    finishStage();
+    countIR(project, stage->counts);
+
+    // Code generation
+    stage = &result[static_cast<int>(BenchStage::CodeGen)];
+    timer.restart();
+    if (!project.generateCode()) {
+        return false;
+    }
+
+    finishStage();
+
+    qint64 outputBytes = 0;
+    QDirIterator it(outputDir.path(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileInfo().suffix() == "c" || it.fileInfo().suffix() == "h") {
+            outputBytes += it.fileInfo().size();
+        }
+    }
+
+    stage->counts["output_bytes"] = outputBytes;
+    return true;
+}
+
+
+void StageBenchmark::countIR(const Project &project, std::map<QString, qint64> &counts) const
+{
+    qint64 numFragments = 0;
+    qint64 numRTLs      = 0;
+    qint64 numStmts     = 0;
+
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (const Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            const ProcCFG *cfg = static_cast<const UserProc *>(func)->getCFG();
+            numFragments += cfg->getNumFragments();
+
+            for (const IRFragment *frag : *cfg) {
+                if (!frag->getRTLs()) {
+                    continue;
+                }
+
+                for (const auto &rtl : *frag->getRTLs()) {
+                    ++numRTLs;
+                    numStmts += rtl->size();
+                }
+            }
+        }
+    }
+
+    counts["fragments"] = numFragments;
+    counts["rtls"]      = numRTLs;
+    counts["stmts"]     = numStmts;
+}
+
+
+qint64 StageBenchmark::getCurrentRSS()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return -1;
+    }
+
+    return static_cast<qint64>(pmc.WorkingSetSize);
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+        return -1;
+    }
+
+    return static_cast<qint64>(info.resident_size);
+#else
+    // The second field of /proc/self/statm is the number of resident pages.
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QFile::ReadOnly)) {
+        return -1;
+    }
+
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    bool ok                        = false;
+    const qint64 residentPages     = fields.size() > 1 ? fields[1].toLongLong(&ok) : 0;
+
+    return ok ? residentPages * sysconf(_SC_PAGESIZE) : -1;
+#endif
+}
@@ -0,0 +1,97 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+
+class Project;
+
+
+/// The stages of the decompilation pipeline measured by \ref StageBenchmark, in execution order.
+enum class BenchStage
+{
+    Load = 0,
+    Decode,
+    Lift,
+    Decompile,
+    CodeGen,
+    NUM_STAGES
+};
+
+
+/**
+ * Runs the decompilation pipeline (load -> decode -> lift -> decompile -> codegen)
+ * stage by stage over a corpus of sample binaries.
+ * For each stage, the median wall time, the resident set size of the process
+ * after the stage, its growth during the stage
+ * and IR node counts are recorded. The results are reported as JSON so they can be
+ * compared against a stored baseline (see compare-benchmarks.py).
+ */
+class StageBenchmark
+{
+public:
+    /// Per-stage measurements of a single pipeline run.
+    struct StageResult
+    {
+        qint64 nsecs    = 0;  ///< Wall time of the stage in nanoseconds
+        qint64 rss      = -1; ///< RSS of the process after the stage in bytes, or -1
+        qint64 rssDelta = 0;  ///< Growth of the RSS during the stage in bytes
+        std::map<QString, qint64> counts;
+    };
+
+    using RunResult = std::array<StageResult, static_cast<int>(BenchStage::NUM_STAGES)>;
+
+public:
+    StageBenchmark(const QString &dataDir, const QString &pluginDir);
+
+public:
+    /// Set the number of times each binary is run through the pipeline.
+    void setIterations(int iterations) { m_iterations = std::max(1, iterations); }
+    int getIterations() const { return m_iterations; }
+
+    /**
+     * Benchmark all binaries in \p corpus.
+     * \param corpus paths of the binaries, relative to the samples directory.
+     * \returns the results of all binaries.
+     */
+    QJsonObject run(const QStringList &corpus);
+
+    /// \returns the default benchmark corpus (relative to the samples directory).
+    static QStringList getDefaultCorpus();
+
+    /// \returns the name of \p stage as used in the JSON output.
+    static QString getStageName(BenchStage stage);
+
+private:
+    /// Run the whole pipeline once on the binary at \p filePath.
+    /// \returns false if any stage failed.
+    bool runOnce(const QString &filePath, RunResult &result);
+
+    /// Count fragments, RTLs and statements of all user procedures of \p project.
+    void countIR(const Project &project, std::map<QString, qint64> &counts) const;
+
+    /// \returns the current resident set size of this process in bytes, or -1 if unavailable.
+    /// The peak RSS is not used since it never decreases, so it would only reflect
+    /// the largest stage run so far.
+    static qint64 getCurrentRSS();
+
+private:
+    QString m_dataDir;
+    QString m_pluginDir;
+    int m_iterations = 5;
+};
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+#
+# This file is part of the Boomerang Decompiler.
+#
+# See the file "LICENSE.TERMS" for information on usage and
+# redistribution of this file, and for a DISCLAIMER OF ALL
+# WARRANTIES.
+#
+
+# Compare benchmark results against a stored baseline.
+#
+# Usage:
+#   compare-benchmarks.py [--threshold <fraction>] <baseline> <current>
+#
+# <baseline> and <current> are either both stage benchmark results (.json,
+# written by boomerang-stage-bench) or both micro benchmark results (.xml,
+# written by boomerang-micro-bench -o <file>,xml).
+# Exits with a non-zero status if any measurement regressed by more than
+# the threshold (default 10%).
+
+import json
+import sys
+import xml.etree.ElementTree as ET
+
+
+def load_stage_results(path):
+    """Returns a dict (binary, stage, metric) -> value"""
+    with open(path) as f:
+        data = json.load(f)
+
+    results = {}
+    for binary in data["binaries"]:
+        if not binary["ok"]:
+            results[(binary["binary"], "-", "ok")] = 0
+            continue
+
+        for stage_name, stage in binary["stages"].items():
+            results[(binary["binary"], stage_name, "median_ms")] = stage["median_ms"]
+            results[(binary["binary"], stage_name, "rss_kb")] = stage["rss_kb"]
+            results[(binary["binary"], stage_name, "rss_delta_kb")] = stage["rss_delta_kb"]
+            for count_name, count in stage["counts"].items():
+                results[(binary["binary"], stage_name, "count:" + count_name)] = count
+
+    return results
+
+
+def load_micro_results(path):
+    """Returns a dict (test function, data tag, metric) -> value per iteration"""
+    results = {}
+    root = ET.parse(path).getroot()
+
+    for func in root.iter("TestFunction"):
+        for res in func.iter("BenchmarkResult"):
+            iterations = max(1, int(res.get("iterations", "1")))
+            value = float(res.get("value")) / iterations
+            results[(func.get("name"), res.get("tag", ""), res.get("metric"))] = value
+
+    return results
+
+
+def load_results(path):
+    if path.endswith(".json"):
+        return load_stage_results(path)
+    else:
+        return load_micro_results(path)
+
+
+def compare(baseline, current, threshold):
+    regressions = 0
+
+    for key in sorted(baseline.keys() | current.keys()):
+        name = " / ".join(k for k in key if k)
+
+        if key not in current:
+            print("MISSING   %s" % name)
+            regressions += 1
+            continue
+        elif key not in baseline:
+            print("NEW       %s: %s" % (name, current[key]))
+            continue
+
+        old, new = baseline[key], current[key]
+
+        if key[2].startswith("count:"):
+            # IR node counts are exact; any change is worth a look, but not a failure
+            if old != new:
+                print("CHANGED   %s: %d -> %d" % (name, old, new))
+            continue
+        elif key[2] == "ok" or old <= 0:
+            continue
+
+        ratio = (new - old) / old
+        if ratio > threshold:
+            print("REGRESSED %s: %.3f -> %.3f (+%.1f%%)" % (name, old, new, ratio * 100))
+            regressions += 1
+        elif ratio < -threshold:
+            print("IMPROVED  %s: %.3f -> %.3f (%.1f%%)" % (name, old, new, ratio * 100))
+
+    return regressions
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    threshold = 0.10
+
+    if len(args) >= 2 and args[0] == "--threshold":
+        threshold = float(args[1])
+        args = args[2:]
+
+    if len(args) != 2:
+        print("Usage: %s [--threshold <fraction>] <baseline> <current>" % sys.argv[0])
+        sys.exit(2)
+
+    num_regressions = compare(load_results(args[0]), load_results(args[1]), threshold)
+
+    if num_regressions > 0:
+        print("%d regression(s) found." % num_regressions)
+        sys.exit(1)
+
+    print("No regressions found.")
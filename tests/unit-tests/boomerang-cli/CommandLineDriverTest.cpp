@@ -14,8 +14,13 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
 #include <iostream>
 
 
@@ -191,6 +196,20 @@ void CommandLineDriverTest::testApplyCommandline()
         QCOMPARE(drv.getProject()->getSettings()->useDataflow, false);
     }
 
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->useDebugInfo, false);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--debug-info", "test.exe" }), 0);
+        QCOMPARE(drv.getProject()->getSettings()->useDebugInfo, true);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->meetCallSiteTypes, false);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--meet-call-types", "test.exe" }), 0);
+        QCOMPARE(drv.getProject()->getSettings()->meetCallSiteTypes, true);
+    }
+
     {
         CommandlineDriver drv;
         QCOMPARE(drv.getProject()->getSettings()->useGlobals, true);
@@ -389,4 +408,40 @@ void CommandLineDriverTest::testApplyCommandline()
 }
 
 
+void CommandLineDriverTest::testBatch()
+{
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+
+    const QString batchPath = tmpDir.filePath("batch.txt");
+    {
+        QFile batchFile(batchPath);
+        QVERIFY(batchFile.open(QFile::WriteOnly | QFile::Text));
+
+        QTextStream os(&batchFile);
+        os << "# comments and empty lines are ignored\n\n";
+        os << getFullSamplePath("x86/hello") << "\n";
+        os << getFullSamplePath("x86/fib") << "\n";
+        os << getFullSamplePath("x86/hello") << "\n";
+    }
+
+    const QString outPath = tmpDir.filePath("output");
+
+    // named types of one binary must not leak into the next one
+    Type::addNamedType("batch_t", IntegerType::get(32, Sign::Signed));
+
+    CommandlineDriver drv;
+    QCOMPARE(drv.applyCommandline({ "boomerang-cli", "-P", BOOMERANG_TEST_BASE "bin", "-o",
+                                    outPath, "--batch", batchPath }),
+             0);
+    QCOMPARE(drv.decompile(), 0);
+
+    QVERIFY(QFile::exists(outPath + "/hello/hello/hello.c"));
+    QVERIFY(QFile::exists(outPath + "/fib/fib/fib.c"));
+    QVERIFY(QFile::exists(outPath + "/hello-2/hello/hello.c"));
+    QVERIFY(Type::getNamedType("batch_t") == nullptr);
+    QCOMPARE(drv.getProject()->getSettings()->getOutputDirectory(), QDir(outPath));
+}
+
+
 QTEST_GUILESS_MAIN(CommandLineDriverTest)
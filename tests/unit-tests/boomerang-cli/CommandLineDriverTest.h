@@ -20,5 +20,8 @@ class CommandLineDriverTest : public BoomerangTest
 private slots:
     void initTestCase();
     void testApplyCommandline();
+
+    /// Decompile two binaries in a single batch
+    void testBatch();
 };
 
@@ -11,14 +11,20 @@
 
 #include "boomerang-plugins/frontend/x86/X86FrontEnd.h"
 
+#include "boomerang/db/IRFragment.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ifc/IDecoder.h"
+#include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/util/Types.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QDebug>
 
+#include <algorithm>
+
 
 #define HELLO_X86         getFullSamplePath("x86/hello")
 #define BRANCH_X86        getFullSamplePath("x86/branch")
@@ -252,4 +258,99 @@ void X86FrontEndTest::testFindMain()
 }
 
 
+/// \returns the lifted RTL of the instruction at \p addr in \p proc, or nullptr if not found.
+static const RTL *findRTL(UserProc *proc, Address addr)
+{
+    for (const IRFragment *frag : *proc->getCFG()) {
+        if (!frag->getRTLs()) {
+            continue;
+        }
+
+        for (const auto &rtl : *frag->getRTLs()) {
+            if (rtl->getAddress() == addr) {
+                return rtl.get();
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+
+static bool hasFlagAssign(const RTL *rtl)
+{
+    return std::any_of(rtl->begin(), rtl->end(),
+                       [](const SharedStmt &stmt) { return stmt->isFlagAssign(); });
+}
+
+
+void X86FrontEndTest::testRemoveDeadFlags()
+{
+    // All flag definitions in main are dead
+    {
+        QVERIFY(m_project.loadBinaryFile(HELLO_X86));
+        QVERIFY(m_project.decodeBinaryFile());
+
+        UserProc *main = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("main"));
+        QVERIFY(main && !main->isLib());
+        PassManager::get()->executePass(PassID::StatementInit, main);
+
+        // sub $0x8,%esp; and $0xfffffff0,%esp; sub %eax,%esp; sub $0xc,%esp; add $0x10,%esp
+        for (Address addr : { Address(0x0804832B), Address(0x0804832E), Address(0x08048336),
+                              Address(0x08048338), Address(0x08048345) }) {
+            const RTL *rtl = findRTL(main, addr);
+            QVERIFY(rtl != nullptr);
+            QVERIFY(!rtl->empty()); // the assignment to %esp is kept
+            QVERIFY2(!hasFlagAssign(rtl), qPrintable(rtl->toString()));
+        }
+
+        StatementList stmts;
+        main->getStatements(stmts);
+        QVERIFY(!stmts.empty());
+
+        for (const SharedStmt &stmt : stmts) {
+            QVERIFY2(!stmt->isFlagAssign(), qPrintable(stmt->toString()));
+        }
+    }
+
+    // The flags used by branches must be kept
+    {
+        QVERIFY(m_project.loadBinaryFile(BRANCH_X86));
+        QVERIFY(m_project.decodeBinaryFile());
+
+        UserProc *main = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("main"));
+        QVERIFY(main && !main->isLib());
+        PassManager::get()->executePass(PassID::StatementInit, main);
+
+        // add $0x10,%esp and add $0x4,%esp are followed by cmp
+        for (Address addr : { Address(0x08048973), Address(0x08048985) }) {
+            const RTL *rtl = findRTL(main, addr);
+            QVERIFY(rtl != nullptr);
+            QVERIFY2(!hasFlagAssign(rtl), qPrintable(rtl->toString()));
+        }
+
+        // cmp %ebx,-0x4(%ebp) followed by jne and je
+        for (Address addr : { Address(0x08048976), Address(0x08048988) }) {
+            const RTL *rtl = findRTL(main, addr);
+            QVERIFY(rtl != nullptr);
+            QVERIFY2(hasFlagAssign(rtl), qPrintable(rtl->toString()));
+        }
+
+        for (IRFragment *frag : *main->getCFG()) {
+            if (!frag->isType(FragType::Twoway)) {
+                continue;
+            }
+
+            const bool flagsDefined = std::any_of(frag->getRTLs()->begin(),
+                                                  frag->getRTLs()->end(),
+                                                  [](const auto &rtl) {
+                                                      return hasFlagAssign(rtl.get());
+                                                  });
+
+            QVERIFY2(flagsDefined, qPrintable(frag->toString()));
+        }
+    }
+}
+
+
 QTEST_GUILESS_MAIN(X86FrontEndTest)
@@ -23,4 +23,5 @@ private slots:
     void test3();
     void testFindMain();
     void testBranch();
+    void testRemoveDeadFlags();
 };
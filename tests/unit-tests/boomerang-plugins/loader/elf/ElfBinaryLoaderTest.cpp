@@ -13,14 +13,18 @@
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/binary/BinaryImage.h"
 #include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/signature/Signature.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QLibrary>
 
+#include <algorithm>
+
 
 #define HELLO_CLANG4           (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/elf/hello-clang4-dynamic"))
 #define HELLO_CLANG4_STATIC    (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/hello-clang4-static"))
 #define HELLO_X86              (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/x86/hello"))
+#define FIBO_PPC               (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/elf32-ppc/fibo"))
 
 
 /// path to the ELF loader plugin
@@ -130,5 +134,38 @@ void ElfBinaryLoaderTest::testLoadSolaris_data()
 }
 
 
+void ElfBinaryLoaderTest::testDwarfDebugInfo()
+{
+    QVERIFY(m_project.loadBinaryFile(FIBO_PPC));
+    BinaryFile *binary = m_project.getLoadedBinaryFile();
+
+    QVERIFY(binary != nullptr);
+    QCOMPARE(binary->getMachine(), Machine::PPC);
+    QCOMPARE(binary->hasDebugInfo(), true);
+
+    const std::vector<Address> functions = binary->getDebugFunctions();
+    QVERIFY(std::find(functions.begin(), functions.end(), Address(0x10000434)) != functions.end());
+    QVERIFY(std::find(functions.begin(), functions.end(), Address(0x100004A8)) != functions.end());
+
+    // out of line instance of the inline function int fib(int x)
+    std::shared_ptr<Signature> sig = binary->getDebugSignature(Address(0x10000434));
+    QVERIFY(sig != nullptr);
+    QVERIFY(sig->isForced());
+    QCOMPARE(sig->getName(), QString("fib"));
+    QCOMPARE(sig->getNumParams(), 1);
+    QCOMPARE(sig->getParamName(0), QString("x"));
+    QVERIFY(sig->getParamType(0)->isInteger());
+    QCOMPARE(sig->getNumReturns(), 2); // stack pointer and int
+
+    // int main(void)
+    sig = binary->getDebugSignature(Address(0x100004A8));
+    QVERIFY(sig != nullptr);
+    QCOMPARE(sig->getName(), QString("main"));
+    QCOMPARE(sig->getNumParams(), 0);
+    QCOMPARE(sig->getNumReturns(), 2);
+
+    QVERIFY(binary->getDebugSignature(Address(0x100004AC)) == nullptr);
+}
+
 
 QTEST_GUILESS_MAIN(ElfBinaryLoaderTest)
@@ -25,4 +25,7 @@ private slots:
     /// Test loading the x86 (Solaris) hello world program
     void testLoadSolaris();
     void testLoadSolaris_data();
+
+    /// Test reading functions and signatures from DWARF debug information
+    void testDwarfDebugInfo();
 };
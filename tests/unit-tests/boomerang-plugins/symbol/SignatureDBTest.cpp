@@ -0,0 +1,177 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDBTest.h"
+
+#include "boomerang-plugins/symbol/c/SignatureDB.h"
+#include "boomerang-plugins/symbol/c/parser/AnsiCParserDriver.h"
+
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <QTemporaryDir>
+#include <QTextStream>
+
+
+static const char *TEST_HEADER = R"(
+typedef unsigned int size_t;
+
+typedef struct
+{
+    int x;
+    char *name;
+} Point;
+
+int add(int a, int b);
+void *fetch(Point *p, size_t count);
+void reset();
+)";
+
+
+/// Write \p contents to the file \p path.
+static bool writeFile(const QString &path, const QString &contents)
+{
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+        return false;
+    }
+
+    QTextStream os(&file);
+    os << contents;
+    return true;
+}
+
+
+void SignatureDBTest::testGetDatabasePath()
+{
+    QCOMPARE(SignatureDB::getDatabasePath(QDir("/lib/signatures"), "/data/win32.hs", Machine::X86),
+             QString("/lib/signatures/win32.x86.sigdb"));
+    QCOMPARE(SignatureDB::getDatabasePath(QDir("/lib/signatures"), "/data/common.hs", Machine::PPC),
+             QString("/lib/signatures/common.ppc.sigdb"));
+}
+
+
+void SignatureDBTest::testRoundTrip()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString catalogPath = dir.filePath("test.hs");
+    const QString headerPath  = dir.filePath("test.h");
+    const QString dbPath      = dir.filePath("test.x86.sigdb");
+
+    QVERIFY(writeFile(headerPath, TEST_HEADER));
+    QVERIFY(writeFile(catalogPath, "test.h\n"));
+
+    // the signatures as read from the header
+    Type::clearNamedTypes();
+    AnsiCParserDriver driver;
+    QCOMPARE(driver.parse(headerPath, Machine::X86, CallConv::C), 0);
+    QCOMPARE(driver.signatures.size(), std::size_t(3));
+
+    Type::clearNamedTypes();
+    QVERIFY(SignatureDB::compile(catalogPath, Machine::X86, dbPath));
+
+    // opening the database registers the named types
+    Type::clearNamedTypes();
+    SignatureDB db;
+    QVERIFY(db.open(dbPath, catalogPath, Machine::X86));
+
+    QVERIFY(Type::getNamedType("size_t") != nullptr);
+
+    SharedType pointType = Type::getNamedType("Point");
+    QVERIFY(pointType != nullptr && pointType->isCompound());
+    QCOMPARE(pointType->as<CompoundType>()->getNumMembers(), 2);
+
+    for (const std::shared_ptr<Signature> &expected : driver.signatures) {
+        QVERIFY(db.contains(expected->getName()));
+
+        std::shared_ptr<Signature> sig = db.getSignature(expected->getName());
+        QVERIFY(sig != nullptr);
+        QVERIFY2(*sig == *expected, qPrintable(expected->getName()));
+        QCOMPARE(sig->getNumParams(), expected->getNumParams());
+
+        for (int i = 0; i < sig->getNumParams(); i++) {
+            QCOMPARE(sig->getParamName(i), expected->getParamName(i));
+            QCOMPARE(sig->getParamType(i)->getCtype(), expected->getParamType(i)->getCtype());
+        }
+    }
+
+    QVERIFY(!db.contains("missing"));
+    QVERIFY(db.getSignature("missing") == nullptr);
+
+    // databases are specific to a machine
+    SignatureDB ppcDB;
+    QVERIFY(!ppcDB.open(dbPath, catalogPath, Machine::PPC));
+}
+
+
+void SignatureDBTest::testOutOfDate()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString catalogPath = dir.filePath("test.hs");
+    const QString headerPath  = dir.filePath("test.h");
+    const QString dbPath      = dir.filePath("test.x86.sigdb");
+
+    QVERIFY(writeFile(headerPath, TEST_HEADER));
+    QVERIFY(writeFile(catalogPath, "test.h\n"));
+    QVERIFY(SignatureDB::compile(catalogPath, Machine::X86, dbPath));
+
+    {
+        SignatureDB db;
+        QVERIFY(db.open(dbPath, catalogPath, Machine::X86));
+    }
+
+    // changing a header invalidates the database
+    QVERIFY(writeFile(headerPath, QString(TEST_HEADER) + "int sub(int a, int b);\n"));
+
+    SignatureDB db;
+    QVERIFY(!db.open(dbPath, catalogPath, Machine::X86));
+
+    // missing databases cannot be opened either
+    QVERIFY(!db.open(dir.filePath("missing.x86.sigdb"), catalogPath, Machine::X86));
+}
+
+
+
+void SignatureDBTest::testSeparateDirectories()
+{
+    // The databases are installed next to the plugins, not next to the catalogs
+    QTemporaryDir catalogDir;
+    QTemporaryDir dbDir;
+    QVERIFY(catalogDir.isValid() && dbDir.isValid());
+
+    const QString catalogPath = catalogDir.filePath("test.hs");
+    const QString headerPath  = catalogDir.filePath("test.h");
+    const QString dbPath      = SignatureDB::getDatabasePath(QDir(dbDir.path()), catalogPath,
+                                                             Machine::X86);
+
+    QVERIFY(writeFile(headerPath, TEST_HEADER));
+    QVERIFY(writeFile(catalogPath, "test.h\n"));
+    QVERIFY(SignatureDB::compile(catalogPath, Machine::X86, dbPath));
+
+    {
+        Type::clearNamedTypes();
+        SignatureDB db;
+        QVERIFY(db.open(dbPath, catalogPath, Machine::X86));
+        QVERIFY(db.contains("add"));
+        QVERIFY(Type::getNamedType("Point") != nullptr);
+    }
+
+    // changing a header next to the catalog invalidates the database
+    QVERIFY(writeFile(headerPath, QString(TEST_HEADER) + "int sub(int a, int b);\n"));
+
+    SignatureDB db;
+    QVERIFY(!db.open(dbPath, catalogPath, Machine::X86));
+}
+
+QTEST_GUILESS_MAIN(SignatureDBTest)
@@ -13,6 +13,8 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/statements/CallStatement.h"
 
 
 void ProjectTest::testLoadBinaryFile()
@@ -104,6 +106,69 @@ void ProjectTest::testDecompileBinaryFile()
 }
 
 
+void ProjectTest::testDecompileProc()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("x86/callchain")));
+    QVERIFY(project.decodeBinaryFile());
+
+    UserProc *main = dynamic_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+
+    QVERIFY(project.decompileProc(main));
+    QVERIFY(main->isDecompiled());
+
+    // callees are only summarized
+    for (Function *callee : main->getCallees()) {
+        if (!callee->isLib()) {
+            UserProc *userCallee = static_cast<UserProc *>(callee);
+            QVERIFY(userCallee->getStatus() == ProcStatus::Summarized);
+
+            // the summary is reused when the callee is requested
+            QVERIFY(project.decompileProc(userCallee));
+            QVERIFY(userCallee->isDecompiled());
+
+            // and the calls in main match the final parameters
+            for (const std::shared_ptr<CallStatement> &call : userCallee->getCallers()) {
+                QCOMPARE(call->getNumArguments(),
+                         static_cast<int>(userCallee->getParameters().size()));
+            }
+        }
+    }
+}
+
+
+void ProjectTest::testDecompileMeetCallTypes()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->numThreads        = 2;
+    project.getSettings()->meetCallSiteTypes = true;
+    project.loadPlugins();
+
+    // main calls fib, which calls itself
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("x86/fib")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+
+    UserProc *fib = dynamic_cast<UserProc *>(project.getProg()->getFunctionByName("fib"));
+    QVERIFY(fib != nullptr);
+    QVERIFY(fib->isDecompiled());
+    QVERIFY(!fib->getCallers().empty());
+
+    for (const std::shared_ptr<CallStatement> &call : fib->getCallers()) {
+        QVERIFY(call->getProc()->isDecompiled());
+    }
+
+    QVERIFY(project.generateCode());
+}
+
+
 void ProjectTest::testGenerateCode()
 {
     Project project;
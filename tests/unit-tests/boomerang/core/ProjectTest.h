@@ -33,5 +33,9 @@ private slots:
 
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
+    void testDecompileProc();
+
+    /// Test parallel global type analysis and meeting of types at call sites.
+    void testDecompileMeetCallTypes();
     void testGenerateCode();
 };
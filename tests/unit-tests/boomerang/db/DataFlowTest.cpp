@@ -17,6 +17,7 @@
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/LowLevelCFG.h"
 #include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
@@ -197,6 +198,47 @@ void DataFlowTest::testCalculateDominatorsComplex()
 }
 
 
+void DataFlowTest::testCalculateDominatorsCached()
+{
+    Prog prog("test", nullptr);
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+    DataFlow *df = proc.getDataFlow();
+
+    IRFragment *entry  = createBBAndFragment(prog.getCFG(), BBType::Twoway, Address(0x1000), &proc);
+    IRFragment *middle = createBBAndFragment(prog.getCFG(), BBType::Oneway, Address(0x1001), &proc);
+    IRFragment *exit   = createBBAndFragment(prog.getCFG(), BBType::Ret,    Address(0x1002), &proc);
+
+    cfg->addEdge(entry, middle);
+    cfg->addEdge(middle, exit);
+    proc.setEntryFragment();
+
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(df->getDominator(exit), middle);
+    QCOMPARE(df->getDominanceFrontier(middle), std::set<const IRFragment *>({}));
+
+    // unchanged CFG
+    const uint64 version = cfg->getVersion();
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(cfg->getVersion(), version);
+    QCOMPARE(df->getDominator(exit), middle);
+
+    // changing the CFG must invalidate the cached results
+    cfg->addEdge(entry, exit);
+    QVERIFY(cfg->getVersion() != version);
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(df->getDominator(exit), entry);
+    QCOMPARE(df->getDominanceFrontier(middle), std::set<const IRFragment *>({ exit }));
+
+    // also when the edges are modified directly
+    entry->removeSuccessor(middle);
+    middle->removePredecessor(entry);
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(df->getDominator(middle), static_cast<const IRFragment *>(nullptr));
+    QCOMPARE(df->getDominator(exit), entry);
+}
+
+
 void DataFlowTest::testPlacePhi()
 {
     QVERIFY(m_project.loadBinaryFile(FRONTIER_X86));
@@ -225,7 +267,7 @@ void DataFlowTest::testPlacePhi()
     OStream actual(&actualStr);
 
     // r24 == eax
-    std::set<FragIndex>& A_phi = df->getA_phi(Location::regOf(REG_X86_EAX));
+    const std::set<FragIndex> A_phi = df->getA_phi(Location::regOf(REG_X86_EAX));
 
     for (FragIndex bb : A_phi) {
         actual << (int)bb << " ";
@@ -260,7 +302,7 @@ void DataFlowTest::testPlacePhi2()
     QString     actual_st;
     OStream actual(&actual_st);
     SharedExp            e = Location::regOf(REG_X86_EAX);
-    std::set<FragIndex>& s = df->getA_phi(e);
+    const std::set<FragIndex> s = df->getA_phi(e);
 
     for (auto pp = s.begin(); pp != s.end(); ++pp) {
         actual << (uint64)*pp << " ";
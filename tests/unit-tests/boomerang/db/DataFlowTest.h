@@ -27,6 +27,9 @@ private slots:
     void testCalculateDominatorsSelfLoop();
     void testCalculateDominatorsComplex();
 
+    /// Test that dominators are recalculated when the CFG changes
+    void testCalculateDominatorsCached();
+
     /// Test the placing of phi functions
     void testPlacePhi();
 
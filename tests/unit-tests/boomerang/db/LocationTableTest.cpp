@@ -0,0 +1,68 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LocationTableTest.h"
+
+
+#include "boomerang/db/LocationTable.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+void LocationTableTest::testInsert()
+{
+    LocationTable table;
+    QVERIFY(table.empty());
+
+    SharedExp reg = Location::regOf(REG_X86_ESP);
+    SharedExp mem = Location::memOf(Binary::get(opMinus, Location::regOf(REG_X86_ESP),
+                                                Const::get(4)));
+
+    QCOMPARE(table.insert(reg), LocIndex(0));
+    QCOMPARE(table.insert(mem), LocIndex(1));
+    QCOMPARE(table.insert(Location::regOf(REG_X86_ESP)), LocIndex(0));
+    QCOMPARE(table.size(), std::size_t(2));
+
+    // the table keeps a copy of the location
+    QVERIFY(table.getLocation(0) != reg);
+    QVERIFY(*table.getLocation(0) == *reg);
+    QVERIFY(*table.getLocation(1) == *mem);
+
+    // iteration is sorted by location
+    for (const auto &[loc, idx] : table) {
+        QVERIFY(*table.getLocation(idx) == *loc);
+    }
+}
+
+
+void LocationTableTest::testFind()
+{
+    LocationTable table;
+    QCOMPARE(table.find(Location::regOf(REG_X86_EAX)), LOC_INVALID);
+
+    table.insert(Location::regOf(REG_X86_EAX));
+    QCOMPARE(table.find(Location::regOf(REG_X86_EAX)), LocIndex(0));
+    QCOMPARE(table.find(Location::regOf(REG_X86_ECX)), LOC_INVALID);
+}
+
+
+void LocationTableTest::testClear()
+{
+    LocationTable table;
+    table.insert(Location::regOf(REG_X86_EAX));
+    table.clear();
+
+    QVERIFY(table.empty());
+    QCOMPARE(table.find(Location::regOf(REG_X86_EAX)), LOC_INVALID);
+    QCOMPARE(table.insert(Location::regOf(REG_X86_ECX)), LocIndex(0));
+}
+
+
+QTEST_GUILESS_MAIN(LocationTableTest)
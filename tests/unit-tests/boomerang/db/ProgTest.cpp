@@ -392,6 +392,7 @@ void ProgTest::testIsInStringsSection()
     QVERIFY(!m_project.getProg()->isInStringsSection(Address::INVALID));
     QVERIFY(!m_project.getProg()->isInStringsSection(Address(0x080483f4))); // address in .rodata
     QVERIFY( m_project.getProg()->isInStringsSection(Address(0x080481a0))); // address in .dynstr
+    QVERIFY( m_project.getProg()->isInStringsSection(Address(0x080483fc))); // string in .rodata
 }
 
 
@@ -192,6 +192,27 @@ void BinaryImageTest::testRead()
 }
 
 
+void BinaryImageTest::testReadSpan()
+{
+    char sectionData[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
+
+    BinaryImage img(QByteArray{});
+    QVERIFY(img.readSpan(Address(0x1000), 4).isEmpty());
+
+    BinarySection *sect1 = img.createSection("sect1", Address(0x1000), Address(0x1008));
+    sect1->setHostAddr(HostAddress(sectionData));
+    sect1->addDefinedArea(Address(0x1000), Address(0x1008));
+
+    const QByteArray span = img.readSpan(Address(0x1002), 4);
+    QCOMPARE(span.size(), 4);
+    QVERIFY(span.constData() == sectionData + 2); // no copy
+    QCOMPARE(span, QByteArray("\x22\x33\x44\x55"));
+
+    // read crosses section boundary
+    QVERIFY(img.readSpan(Address(0x1006), 4).isEmpty());
+}
+
+
 void BinaryImageTest::testWrite()
 {
     char sectionData[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
@@ -218,6 +239,49 @@ void BinaryImageTest::testWrite()
 }
 
 
+void BinaryImageTest::testUpdatePageTable()
+{
+    std::vector<Byte> textData(0x2800, 0xCC);
+    std::vector<Byte> data(0x1000, 0x00);
+
+    BinaryImage img(QByteArray{});
+    BinarySection *text = img.createSection("text", Address(0x1800), Address(0x4000));
+    text->setHostAddr(HostAddress(textData.data()));
+    text->setReadOnly(true);
+
+    // writable section without initialized data
+    BinarySection *uninit = img.createSection("uninit", Address(0x4000), Address(0x5000));
+    uninit->setHostAddr(HostAddress(data.data()));
+
+    img.updatePageTable();
+
+    // full pages and pages shared by sections must give the same results
+    QVERIFY(img.getSectionByAddr(Address(0x17FF)) == nullptr);
+    QVERIFY(img.getSectionByAddr(Address(0x1800)) == text);
+    QVERIFY(img.getSectionByAddr(Address(0x2000)) == text);
+    QVERIFY(img.getSectionByAddr(Address(0x3FFF)) == text);
+    QVERIFY(img.getSectionByAddr(Address(0x4000)) == uninit);
+    QVERIFY(img.getSectionByAddr(Address(0x5000)) == nullptr);
+
+    DWord value = 0;
+    QVERIFY(img.readNative4(Address(0x1800), value));
+    QCOMPARE(value, static_cast<DWord>(0xCCCCCCCC));
+    QVERIFY(img.readNative4(Address(0x2FFE), value)); // crosses a page boundary
+    QVERIFY(!img.readNative4(Address(0x3FFE), value)); // crosses a section boundary
+    QVERIFY(!img.readNative4(Address(0x4000), value)); // no defined value
+
+    // the page table must follow writes to undefined areas
+    QVERIFY(img.writeNative4(Address(0x4000), static_cast<DWord>(0x12345678)));
+    QVERIFY(img.readNative4(Address(0x4000), value));
+    QCOMPARE(value, static_cast<DWord>(0x12345678));
+
+    // creating a section invalidates the page table
+    img.createSection("data", Address(0x6000), Address(0x7000));
+    QVERIFY(img.getSectionByAddr(Address(0x2000)) == text);
+    QVERIFY(img.readNative4(Address(0x2000), value));
+}
+
+
 void BinaryImageTest::testIsReadOnly()
 {
     BinaryImage img(QByteArray{});
@@ -230,7 +294,7 @@ void BinaryImageTest::testIsReadOnly()
     QVERIFY(img.isReadOnly(Address(0x1800)));
     sect1->setReadOnly(false);
 
-    sect1->setAttributeForRange("ReadOnly", true, Address(0x1400), Address(0x2000));
+    sect1->setFlagForRange(SectionFlag::ReadOnly, Address(0x1400), Address(0x2000));
     QVERIFY(!img.isReadOnly(Address(0x1200)));
     QVERIFY(img.isReadOnly(Address(0x1800)));
 }
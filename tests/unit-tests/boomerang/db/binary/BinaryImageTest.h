@@ -28,7 +28,9 @@ private slots:
     void testUpdateTextLimits();
 
     void testRead();
+    void testReadSpan();
     void testWrite();
+    void testUpdatePageTable();
 
     void testIsReadOnly();
 };
@@ -34,6 +34,26 @@ void BinarySectionTest::testIsAddressBss()
 }
 
 
+void BinarySectionTest::testIsRangeDefined()
+{
+    BinarySection section(Address(0x1000), 0x1000, "testSection");
+    QVERIFY(!section.isRangeDefined(Address(0x1000), Address(0x1010)));
+
+    section.addDefinedArea(Address(0x1000), Address(0x1800));
+    QVERIFY( section.isRangeDefined(Address(0x1000), Address(0x1010)));
+    QVERIFY( section.isRangeDefined(Address(0x1000), Address(0x1800)));
+    QVERIFY(!section.isRangeDefined(Address(0x1000), Address(0x1810)));
+    QVERIFY(!section.isRangeDefined(Address(0x0800), Address(0x1010))); // not in range
+
+    section.setBss(true);
+    QVERIFY(!section.isRangeDefined(Address(0x1000), Address(0x1010)));
+
+    section.setBss(false);
+    section.setReadOnly(true);
+    QVERIFY( section.isRangeDefined(Address(0x1000), Address(0x2000)));
+}
+
+
 void BinarySectionTest::testAnyDefinedValues()
 {
     BinarySection section(Address(0x1000), 0x1000, "testSection");
@@ -85,4 +105,47 @@ void BinarySectionTest::testAttributes()
     QVERIFY(section.isAttributeInRange("ReadOnly", Address(0x1000), Address(0x2000)));
 }
 
+
+void BinarySectionTest::testFlags()
+{
+    BinarySection section(Address(0x1000), 0x1000, "testSection");
+    QVERIFY(!section.hasFlag(SectionFlag::Strings, Address(0x1000)));
+    QVERIFY(!section.isFlagInRange(SectionFlag::Strings, Address(0x1000), Address(0x2000)));
+
+    section.setFlagForRange(SectionFlag::Strings, Address(0x1200), Address(0x1400));
+    section.setFlagForRange(SectionFlag::Strings, Address(0x1400), Address(0x1500)); // adjacent
+    section.setFlagForRange(SectionFlag::Strings, Address(0x1800), Address(0x1900));
+    QVERIFY(!section.hasFlag(SectionFlag::Strings, Address(0x11FF)));
+    QVERIFY( section.hasFlag(SectionFlag::Strings, Address(0x1200)));
+    QVERIFY( section.hasFlag(SectionFlag::Strings, Address(0x14FF)));
+    QVERIFY(!section.hasFlag(SectionFlag::Strings, Address(0x1500)));
+    QVERIFY( section.hasFlag(SectionFlag::Strings, Address(0x1800)));
+    QVERIFY(!section.hasFlag(SectionFlag::Relocated, Address(0x1200)));
+
+    QVERIFY(!section.isFlagInRange(SectionFlag::Strings, Address(0x1500), Address(0x1800)));
+    QVERIFY( section.isFlagInRange(SectionFlag::Strings, Address(0x1500), Address(0x1801)));
+    QVERIFY( section.isFlagInRange(SectionFlag::Strings, Address(0x1000), Address(0x2000)));
+
+    // overlapping ranges are merged
+    section.setFlagForRange(SectionFlag::Strings, Address(0x1450), Address(0x1850));
+    QVERIFY( section.hasFlag(SectionFlag::Strings, Address(0x1600)));
+    QVERIFY( section.hasFlag(SectionFlag::Strings, Address(0x18FF)));
+
+    // whole-section flags
+    QVERIFY(!section.hasFlag(SectionFlag::Code, Address(0x1000)));
+    section.setCode(true);
+    QVERIFY( section.hasFlag(SectionFlag::Code, Address(0x1000)));
+    QVERIFY(!section.hasFlag(SectionFlag::Code, Address(0x2000))); // not in section
+
+    // BSS ranges
+    section.addDefinedArea(Address(0x1000), Address(0x2000));
+    section.setReadOnly(true);
+    QVERIFY(!section.isAddressBss(Address(0x1F00)));
+    section.setFlagForRange(SectionFlag::Bss, Address(0x1E00), Address(0x2000));
+    QVERIFY( section.isAddressBss(Address(0x1F00)));
+    QVERIFY(!section.isRangeDefined(Address(0x1D00), Address(0x1F00)));
+    QVERIFY( section.isRangeDefined(Address(0x1D00), Address(0x1E00)));
+}
+
+
 QTEST_GUILESS_MAIN(BinarySectionTest)
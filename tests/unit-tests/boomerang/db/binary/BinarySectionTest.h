@@ -19,10 +19,12 @@ class BinarySectionTest : public BoomerangTest
 
 private slots:
     void testIsAddressBss();
+    void testIsRangeDefined();
     void testAnyDefinedValues();
     void testResize();
     void testClearDefinedArea();
     void testAddDefinedArea();
 
     void testAttributes();
+    void testFlags();
 };
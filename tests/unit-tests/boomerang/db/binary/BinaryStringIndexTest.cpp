@@ -0,0 +1,115 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BinaryStringIndexTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinaryStringIndex.h"
+
+#include <QByteArray>
+
+
+static const char g_sectionData[] = "\x01\x02Hello\0\0ab\x03W\0i\0d\0e\0\0\0";
+
+
+static BinarySection *createDataSection(BinaryImage &img, bool readOnly)
+{
+    BinarySection *sect = img.createSection("data", Address(0x1000),
+                                            Address(0x1000) + sizeof(g_sectionData));
+    sect->setHostAddr(HostAddress(g_sectionData));
+    sect->setReadOnly(readOnly);
+    sect->addDefinedArea(Address(0x1000), Address(0x1000) + sizeof(g_sectionData));
+    return sect;
+}
+
+
+void BinaryStringIndexTest::testBuild()
+{
+    BinaryImage img(QByteArray{});
+    createDataSection(img, true);
+
+    img.updateStringIndex(false);
+    const BinaryStringIndex &index = img.getStringIndex();
+    QCOMPARE(index.getNumStrings(StringEncoding::ASCII), 5); // "Hello", "ab\x03W", "i", "d", "e"
+    QCOMPARE(index.getNumStrings(StringEncoding::UTF16LE), 0);
+
+    img.updateStringIndex(true);
+    QCOMPARE(index.getNumStrings(StringEncoding::UTF16LE), 1);
+
+    img.reset();
+    QCOMPARE(index.getNumStrings(StringEncoding::ASCII), 0);
+}
+
+
+void BinaryStringIndexTest::testFind()
+{
+    BinaryImage img(QByteArray{});
+    createDataSection(img, true);
+    img.updateStringIndex(false);
+
+    const BinaryStringIndex &index = img.getStringIndex();
+    QVERIFY(index.find(Address(0x0FFF)) == nullptr);
+    QVERIFY(index.find(Address(0x1000)) == nullptr); // control characters
+
+    const BinaryStringIndex::Entry *hello = index.find(Address(0x1002));
+    QVERIFY(hello != nullptr);
+    QCOMPARE(hello->addr, Address(0x1002));
+    QCOMPARE(hello->length, 5U);
+    QVERIFY(hello->inStringsSection);
+    QCOMPARE(QString::fromLatin1(hello->data, hello->length), QString("Hello"));
+
+    // inside the string and at the terminator
+    QVERIFY(index.find(Address(0x1005)) == hello);
+    QVERIFY(index.find(Address(0x1007)) == hello);
+
+    // empty strings
+    QVERIFY(index.find(Address(0x1008)) == nullptr);
+    QVERIFY(index.isEmptyString(Address(0x1008)));
+    QVERIFY(index.isEmptyString(Address(0x1015)));
+    QVERIFY(!index.isEmptyString(Address(0x1007))); // terminator of "Hello"
+    QVERIFY(!index.isEmptyString(Address(0x1009)));
+
+    // single control characters inside of strings
+    const BinaryStringIndex::Entry *ab = index.find(Address(0x100C));
+    QVERIFY(ab != nullptr);
+    QCOMPARE(ab->addr, Address(0x1009));
+    QCOMPARE(ab->length, 4U);
+
+    // strings in writable sections are indexed, but not in a strings section
+    BinaryImage img2(QByteArray{});
+    createDataSection(img2, false);
+    img2.updateStringIndex(false);
+
+    hello = img2.getStringIndex().find(Address(0x1002));
+    QVERIFY(hello != nullptr);
+    QVERIFY(!hello->inStringsSection);
+}
+
+
+void BinaryStringIndexTest::testFindWide()
+{
+    BinaryImage img(QByteArray{});
+    createDataSection(img, true);
+    img.updateStringIndex(true);
+
+    const BinaryStringIndex &index = img.getStringIndex();
+    const BinaryStringIndex::Entry *wide = index.find(Address(0x100E), StringEncoding::UTF16LE);
+    QVERIFY(wide != nullptr);
+    QCOMPARE(wide->addr, Address(0x100C));
+    QCOMPARE(wide->length, 4U);
+    QCOMPARE(wide->getByteSize(), 10U);
+    QVERIFY(wide->encoding == StringEncoding::UTF16LE);
+
+    QVERIFY(index.find(Address(0x1002), StringEncoding::UTF16LE) == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(BinaryStringIndexTest)
@@ -66,6 +66,62 @@ void BinarySymbolTableTest::testCreateSymbol()
 }
 
 
+void BinarySymbolTableTest::testAppendSymbol()
+{
+    BinarySymbolTable tbl;
+    BinarySymbol *existing = tbl.createSymbol(Address(0x1000), "existing");
+
+    // appended in reverse address order
+    BinarySymbol *sym3 = tbl.appendSymbol(Address(0x3000), "sym3");
+    BinarySymbol *sym2 = tbl.appendSymbol(Address(0x2000), "sym2");
+    // same address -> discarded
+    BinarySymbol *sym2dup      = tbl.appendSymbol(Address(0x2000), "sym2dup");
+    // existing address -> discarded
+    BinarySymbol *existingAddr = tbl.appendSymbol(Address(0x1000), "existingAddr");
+    // existing name -> redirected
+    BinarySymbol *existingName = tbl.appendSymbol(Address(0x4000), "existing");
+    BinarySymbol *local = tbl.appendSymbol(Address(0x5000), "local", true);
+
+    // size and attributes of discarded or redirected symbols are merged into the kept symbol
+    sym2->setSize(4);
+    sym2->setAttribute("Function", true);
+    sym2dup->setSize(8);
+    sym2dup->setAttribute("Function", false);
+    sym2dup->setAttribute("Imported", true);
+    existingAddr->setSize(16);
+    existingName->setAttribute("SourceFile", "test.c");
+
+    QCOMPARE(tbl.size(), 4);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x1000)) == existing);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x2000)) == sym2);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x3000)) == sym3);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x4000)) == existing);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x5000)) == local);
+
+    QVERIFY(tbl.findSymbolByName("sym2") == sym2);
+    QVERIFY(tbl.findSymbolByName("sym2dup") == nullptr);
+    QVERIFY(tbl.findSymbolByName("existingAddr") == nullptr);
+    QVERIFY(tbl.findSymbolByName("local") == nullptr);
+
+    QCOMPARE(sym2->getSize(), 4);
+    QVERIFY(sym2->isFunction());
+    QVERIFY(sym2->isImported());
+    QCOMPARE(existing->getSize(), 16);
+    QCOMPARE(existing->belongsToSourceFile(), QString("test.c"));
+
+    // symbols are in order of creation
+    QVERIFY(*tbl.begin() == existing);
+    QVERIFY(*std::next(tbl.begin()) == sym3);
+
+    // incremental inserts still work afterwards
+    BinarySymbol *sym0 = tbl.createSymbol(Address(0x0800), "sym0");
+    QVERIFY(sym0 != nullptr);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x0800)) == sym0);
+    QVERIFY(tbl.findSymbolByAddress(Address(0x2000)) == sym2);
+    QCOMPARE(tbl.size(), 5);
+}
+
+
 void BinarySymbolTableTest::testFindSymbolByAddress()
 {
     BinarySymbolTable tbl;
@@ -23,6 +23,7 @@ private slots:
     void testClear();
 
     void testCreateSymbol();
+    void testAppendSymbol();
     void testFindSymbolByAddress();
     void testFindSymbolByName();
     void testRenameSymbol();
@@ -0,0 +1,61 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcBudgetTest.h"
+
+
+#include "boomerang/db/proc/ProcBudget.h"
+
+
+void ProcBudgetTest::testUnlimited()
+{
+    ProcBudget budget;
+    QVERIFY(!budget.hasLimits());
+
+    QVERIFY(!budget.charge(1000000, 1000000, "Pass"));
+    QVERIFY(!budget.isExceeded());
+    QCOMPARE(budget.getTimeSpent(), qint64(1000000));
+    QCOMPARE(budget.getWorkSpent(), qint64(1000000));
+}
+
+
+void ProcBudgetTest::testTimeLimit()
+{
+    ProcBudget budget;
+    budget.setLimits(100, 0);
+    QVERIFY(budget.hasLimits());
+
+    QVERIFY(!budget.charge(60, 1000, "Pass1"));
+    QVERIFY(!budget.charge(40, 1000, "Pass2"));
+    QVERIFY(!budget.isExceeded());
+
+    // only the first charge exceeding the budget is reported
+    QVERIFY(budget.charge(1, 1000, "Pass3"));
+    QVERIFY(!budget.charge(1, 1000, "Pass4"));
+
+    QVERIFY(budget.isExceeded());
+    QCOMPARE(budget.getExceededIn(), QString("Pass3"));
+    QCOMPARE(budget.getTimeSpent(), qint64(102));
+}
+
+
+void ProcBudgetTest::testWorkLimit()
+{
+    ProcBudget budget;
+    budget.setLimits(0, 500);
+
+    QVERIFY(!budget.charge(1000, 500, "Pass1"));
+    QVERIFY(budget.charge(0, 1, "Pass2"));
+    QVERIFY(budget.isExceeded());
+    QCOMPARE(budget.getExceededIn(), QString("Pass2"));
+    QCOMPARE(budget.getWorkSpent(), qint64(501));
+}
+
+
+QTEST_GUILESS_MAIN(ProcBudgetTest)
@@ -0,0 +1,90 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCacheTest.h"
+
+
+#include "boomerang/db/proc/ProofCache.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+void ProofCacheTest::testLookup()
+{
+    ProofCache cache;
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    const SharedExp esp  = Location::regOf(REG_X86_ESP);
+    const SharedExp esp4 = Binary::get(opPlus, Location::regOf(REG_X86_ESP), Const::get(4));
+    bool result          = false;
+
+    QVERIFY(!cache.lookup(&proc, esp, esp, result));
+
+    cache.insert(&proc, esp, esp4, true);
+    QVERIFY(!cache.lookup(&proc, esp, esp, result));
+    QVERIFY(cache.lookup(&proc, esp, esp4, result));
+    QVERIFY(result == true);
+
+    // the query is compared by value
+    QVERIFY(cache.lookup(&proc, esp->clone(), esp4->clone(), result));
+    QVERIFY(result == true);
+
+    cache.insert(&proc, esp, esp, false);
+    QVERIFY(cache.lookup(&proc, esp, esp, result));
+    QVERIFY(result == false);
+
+    QCOMPARE(cache.getNumHits(), 3);
+    QCOMPARE(cache.getNumMisses(), 2);
+}
+
+
+void ProofCacheTest::testInvalidate()
+{
+    ProofCache cache;
+    UserProc proc1(Address(0x1000), "test1", nullptr);
+    UserProc proc2(Address(0x2000), "test2", nullptr);
+
+    const SharedExp ebx = Location::regOf(REG_X86_EBX);
+    bool result         = false;
+
+    cache.insert(&proc1, ebx, ebx, true);
+    cache.insert(&proc2, ebx, ebx, true);
+
+    cache.invalidate(&proc1);
+    QVERIFY(!cache.lookup(&proc1, ebx, ebx, result));
+    QVERIFY(cache.lookup(&proc2, ebx, ebx, result));
+
+    cache.clear();
+    QVERIFY(!cache.lookup(&proc2, ebx, ebx, result));
+}
+
+
+void ProofCacheTest::testAddedFact()
+{
+    ProofCache cache;
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    const SharedExp eax = Location::regOf(REG_X86_EAX);
+    const SharedExp ebx = Location::regOf(REG_X86_EBX);
+    bool result         = false;
+
+    cache.insert(&proc, eax, eax, false);
+    cache.insert(&proc, ebx, ebx, true);
+
+    // new facts might make failed proofs succeed, but do not affect successful proofs
+    cache.addedFact();
+    QVERIFY(!cache.lookup(&proc, eax, eax, result));
+    QVERIFY(cache.lookup(&proc, ebx, ebx, result));
+    QVERIFY(result == true);
+}
+
+
+QTEST_GUILESS_MAIN(ProofCacheTest)
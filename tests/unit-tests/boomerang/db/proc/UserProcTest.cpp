@@ -908,4 +908,39 @@ void UserProcTest::testAllPhisHaveDefs()
     QVERIFY(proc.allPhisHaveDefs());
 }
 
+
+void UserProcTest::testDecompileOverBudget()
+{
+    const QString statementInit = PassManager::get()->getPass(PassID::StatementInit)->getName();
+
+    // decompile with an ample budget first to measure the work needed for the full pipeline
+    m_project.getSettings()->procWorkLimit = 1000000000;
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/fib")));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.decompileBinaryFile());
+
+    UserProc *fib = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("fib"));
+    QVERIFY(fib && !fib->isLib());
+    QVERIFY(!fib->getBudget()->isExceeded());
+    const qint64 fullWork = fib->getBudget()->getWorkSpent();
+
+    // the budget is already exceeded by lifting the procedure
+    m_project.getSettings()->procWorkLimit = 1;
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/fib")));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.decompileBinaryFile());
+    m_project.getSettings()->procWorkLimit = 0;
+
+    fib = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("fib"));
+    QVERIFY(fib && !fib->isLib());
+    QVERIFY(fib->getBudget()->isExceeded());
+    QCOMPARE(fib->getBudget()->getExceededIn(), statementInit);
+
+    // optional passes were skipped and the fixed-point loops stopped early,
+    // but the procedure is still decompiled (as low-level code)
+    QVERIFY(fib->getBudget()->getWorkSpent() < fullWork);
+    QVERIFY(fib->isDecompiled());
+}
+
+
 QTEST_GUILESS_MAIN(UserProcTest)
@@ -55,4 +55,7 @@ private slots:
     void testFindFirstSymbol();
     void testSearchAndReplace();
     void testAllPhisHaveDefs();
+
+    /// Test that a procedure exceeding its budget is decompiled with the degraded pipeline
+    void testDecompileOverBudget();
 };
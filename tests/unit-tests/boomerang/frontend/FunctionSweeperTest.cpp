@@ -0,0 +1,91 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FunctionSweeperTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/frontend/FunctionSweeper.h"
+
+#include <QByteArray>
+
+
+// clang-format off
+static const unsigned char g_code[0x40] = {
+    0x55, 0x89, 0xE5,                   // 1000: push ebp; mov ebp, esp
+    0xE8, 0x18, 0x00, 0x00, 0x00,       // 1003: call 0x1020
+    0xE8, 0x13, 0x00, 0x00, 0x00,       // 1008: call 0x1020
+    0xC3,                               // 100D: ret
+    0xCC, 0xCC,                         // 100E: padding
+    0x55, 0x8B, 0xEC,                   // 1010: push ebp; mov ebp, esp
+    0xC3,                               // 1013: ret
+    0x90, 0x90, 0x90, 0x90, 0x90, 0x90, // 1014: padding
+    0x90, 0x90, 0x90, 0x90, 0x90, 0x90,
+    0x31, 0xC0,                         // 1020: xor eax, eax
+    0xC3,                               // 1022: ret
+    0xE8, 0x08, 0x00, 0x00, 0x00,       // 1023: call 0x1030
+    0xC3,                               // 1028: ret
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x40,                               // 1030: inc eax
+    0xC3                                // 1031: ret
+};
+// clang-format on
+
+
+static BinarySection *createCodeSection(BinaryImage &img)
+{
+    BinarySection *sect = img.createSection(".text", Address(0x1000),
+                                            Address(0x1000) + sizeof(g_code));
+    sect->setHostAddr(HostAddress(g_code));
+    sect->setCode(true);
+    sect->setReadOnly(true);
+    return sect;
+}
+
+
+void FunctionSweeperTest::testFindFunctionStarts()
+{
+    BinaryImage img(QByteArray{});
+    createCodeSection(img);
+
+    const FunctionSweeper sweeper(&img, Machine::X86);
+    QVERIFY(sweeper.isSupported());
+
+    // 0x1000 only has a prologue, 0x1030 is only called once
+    const std::vector<Address> expected = { Address(0x1010), Address(0x1020) };
+    QCOMPARE(sweeper.findFunctionStarts(1), expected);
+    QCOMPARE(sweeper.findFunctionStarts(4), expected);
+}
+
+
+void FunctionSweeperTest::testImportThunks()
+{
+    BinaryImage img(QByteArray{});
+    BinarySection *sect = createCodeSection(img);
+    sect->setFlagForRange(SectionFlag::ImportThunk, Address(0x1020), Address(0x1023));
+
+    const FunctionSweeper sweeper(&img, Machine::X86);
+    const std::vector<Address> expected = { Address(0x1010) };
+    QCOMPARE(sweeper.findFunctionStarts(), expected);
+}
+
+
+void FunctionSweeperTest::testUnsupported()
+{
+    BinaryImage img(QByteArray{});
+    createCodeSection(img);
+
+    const FunctionSweeper sweeper(&img, Machine::ST20);
+    QVERIFY(!sweeper.isSupported());
+    QVERIFY(sweeper.findFunctionStarts().empty());
+}
+
+
+QTEST_GUILESS_MAIN(FunctionSweeperTest)
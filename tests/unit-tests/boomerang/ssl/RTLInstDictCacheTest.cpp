@@ -0,0 +1,89 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RTLInstDictCacheTest.h"
+
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/RTLInstDictCache.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+#include <QTemporaryDir>
+
+
+void RTLInstDictCacheTest::testReadWrite()
+{
+    RTLInstDict parsed;
+    QVERIFY(parsed.readSSLFile(BOOMERANG_TEST_BASE "share/boomerang/ssl/x86.ssl"));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray key    = RTLInstDictCache::getCacheKey("x86");
+    const QString cachePath = dir.filePath("x86.sslcache");
+    QVERIFY(RTLInstDictCache::write(cachePath, key, parsed));
+
+    RTLInstDict cached;
+    QVERIFY(RTLInstDictCache::read(cachePath, key, cached));
+
+    // registers and their relations
+    for (RegNum regNum = 0; regNum < 100; regNum++) {
+        QCOMPARE(cached.getRegDB()->getRegNameByNum(regNum),
+                 parsed.getRegDB()->getRegNameByNum(regNum));
+        QCOMPARE(cached.getRegDB()->getRegSizeByNum(regNum),
+                 parsed.getRegDB()->getRegSizeByNum(regNum));
+    }
+
+    QCOMPARE(cached.getRegDB()->getRegNumByName("%al"), REG_X86_AL);
+
+    std::shared_ptr<Assign> asgn = std::make_shared<Assign>(Location::regOf(REG_X86_AL),
+                                                            Const::get(0));
+    const std::set<RegNum> usedRegs = { REG_X86_EAX, REG_X86_AL };
+    QCOMPARE(cached.getRegDB()->processOverlappedRegs(asgn, usedRegs)->toString(),
+             parsed.getRegDB()->processOverlappedRegs(asgn, usedRegs)->toString());
+
+    // instructions (assignments, flag calls, branches, calls and returns)
+    const std::vector<SharedExp> regImm = { Location::regOf(REG_X86_EAX), Const::get(5) };
+    const std::vector<SharedExp> imm    = { Const::get(0x1000) };
+
+    QCOMPARE(cached.instantiateRTL("ADCREG32IMM32", Address(0x1000), regImm)->toString(),
+             parsed.instantiateRTL("ADCREG32IMM32", Address(0x1000), regImm)->toString());
+    QCOMPARE(cached.instantiateRTL("JAIMM32", Address(0x1000), imm)->toString(),
+             parsed.instantiateRTL("JAIMM32", Address(0x1000), imm)->toString());
+    QCOMPARE(cached.instantiateRTL("JMPIMM32", Address(0x1000), imm)->toString(),
+             parsed.instantiateRTL("JMPIMM32", Address(0x1000), imm)->toString());
+    QCOMPARE(cached.instantiateRTL("CALLIMM32", Address(0x1000), imm)->toString(),
+             parsed.instantiateRTL("CALLIMM32", Address(0x1000), imm)->toString());
+    QCOMPARE(cached.instantiateRTL("RET", Address(0x1000), {})->toString(),
+             parsed.instantiateRTL("RET", Address(0x1000), {})->toString());
+}
+
+
+void RTLInstDictCacheTest::testWrongKey()
+{
+    RTLInstDict parsed;
+    QVERIFY(parsed.readSSLFile(BOOMERANG_TEST_BASE "share/boomerang/ssl/st20.ssl"));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString cachePath = dir.filePath("st20.sslcache");
+    QVERIFY(RTLInstDictCache::write(cachePath, RTLInstDictCache::getCacheKey("st20"), parsed));
+
+    RTLInstDict cached;
+    QVERIFY(!RTLInstDictCache::read(cachePath, RTLInstDictCache::getCacheKey("st21"), cached));
+    QVERIFY(!RTLInstDictCache::read(dir.filePath("nonexistent"),
+                                    RTLInstDictCache::getCacheKey("st20"), cached));
+    QVERIFY(cached.getRegDB()->getRegByName("%pc") == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(RTLInstDictCacheTest)
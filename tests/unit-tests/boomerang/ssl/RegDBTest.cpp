@@ -21,9 +21,16 @@ void RegDBTest::testClear()
     db.clear(); // Verify it does not crash
 
     QVERIFY(db.createReg(RegType::Int, REG_X86_AX, "%ax", 16));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AL, "%al", 8));
+    QVERIFY(db.createRegRelation("%ax", "%al", 0));
     db.clear();
     QVERIFY(!db.isRegDefined("%ax"));
     QVERIFY(!db.isRegNumDefined(REG_X86_AX));
+
+    // relations are removed as well
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AX, "%ax", 16));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AL, "%al", 8));
+    QVERIFY(db.createRegRelation("%ax", "%al", 0));
 }
 
 
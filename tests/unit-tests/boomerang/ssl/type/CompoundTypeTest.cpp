@@ -206,6 +206,64 @@ void CompoundTypeTest::testGetOffsetRemainder()
 }
 
 
+void CompoundTypeTest::testNestedLayout()
+{
+    auto inner = CompoundType::get();
+    inner->addMember(IntegerType::get(32, Sign::Signed), "a");
+
+    auto arr = ArrayType::get(IntegerType::get(16, Sign::Signed), 2);
+
+    CompoundType outer;
+    outer.addMember(inner, "in");
+    outer.addMember(arr, "arr");
+    outer.addMember(FloatType::get(32), "f");
+
+    QCOMPARE(outer.getSize(), 96);
+    QCOMPARE(outer.getMemberNameByOffset(40), "arr");
+    QCOMPARE(outer.getMemberNameByOffset(64), "f");
+
+    // growing a member moves all following members
+    inner->addMember(IntegerType::get(32, Sign::Signed), "b");
+    QCOMPARE(outer.getSize(), 128);
+    QCOMPARE(outer.getMemberNameByOffset(40), "in");
+    QCOMPARE(outer.getMemberOffsetByName("f"), 96);
+
+    arr->setLength(4);
+    QCOMPARE(outer.getSize(), 160);
+    QCOMPARE(outer.getMemberNameByOffset(96), "arr");
+    QCOMPARE(outer.getMemberNameByOffset(128), "f");
+    QCOMPARE(outer.getOffsetRemainder(100), 36);
+}
+
+
+void CompoundTypeTest::testLayoutVersion()
+{
+    auto inner = CompoundType::get();
+    inner->addMember(IntegerType::get(32, Sign::Signed), "a");
+
+    auto outer = CompoundType::get();
+    outer->addMember(inner, "in");
+    outer->addMember(FloatType::get(32), "f");
+
+    auto other = CompoundType::get();
+    other->addMember(IntegerType::get(32, Sign::Signed), "x");
+
+    QCOMPARE(outer->getSize(), 64);
+    const uint64 version = outer->getLayoutVersion();
+
+    // changing an unrelated struct keeps the cached layout
+    other->addMember(IntegerType::get(32, Sign::Signed), "y");
+    QCOMPARE(outer->getLayoutVersion(), version);
+    QCOMPARE(outer->getMemberOffsetByName("f"), 32);
+
+    // changing a nested member does not
+    inner->addMember(IntegerType::get(16, Sign::Signed), "b");
+    QVERIFY(outer->getLayoutVersion() > version);
+    QCOMPARE(outer->getMemberOffsetByName("f"), 48);
+    QCOMPARE(outer->getSize(), 80);
+}
+
+
 void CompoundTypeTest::testIsCompatibleWith()
 {
     auto ct1 = CompoundType::get();
@@ -27,5 +27,7 @@ private slots:
     void testMemberName();
     void testMemberOffset();
     void testGetOffsetRemainder();
+    void testNestedLayout();
+    void testLayoutVersion();
     void testIsCompatibleWith();
 };
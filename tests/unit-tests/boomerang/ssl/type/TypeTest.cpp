@@ -53,5 +53,44 @@ void TypeTest::testNewIntegerLikeType()
 }
 
 
+void TypeTest::testSharedScalars()
+{
+    QVERIFY(VoidType::get() == VoidType::get());
+    QVERIFY(CharType::get() == CharType::get());
+    QVERIFY(IntegerType::get(32, Sign::Signed) == IntegerType::get(32, Sign::Signed));
+    QVERIFY(IntegerType::get(32, Sign::Signed) != IntegerType::get(32, Sign::Unsigned));
+    QVERIFY(FloatType::get(64) != FloatType::get(32));
+    QVERIFY(IntegerType::get(16)->isShared());
+    QVERIFY(!ArrayType::get(CharType::get(), 10)->isShared());
+
+    // clones of shared types can be modified
+    SharedType ty = IntegerType::get(32, Sign::Signed)->clone();
+    QVERIFY(!ty->isShared());
+    ty->setSize(16);
+    QCOMPARE(IntegerType::get(32, Sign::Signed)->getSize(), Type::Size(32));
+}
+
+
+void TypeTest::testMeetShared()
+{
+    bool changed    = false;
+    SharedType res1 = IntegerType::get(32)->meetWith(IntegerType::get(32, Sign::Signed), changed);
+    QVERIFY(changed);
+    QVERIFY(res1->isShared());
+    QVERIFY(*res1 == *IntegerType::get(32, Sign::Signed));
+
+    // memoized result
+    changed         = false;
+    SharedType res2 = IntegerType::get(32)->meetWith(IntegerType::get(32, Sign::Signed), changed);
+    QVERIFY(changed);
+    QVERIFY(res1 == res2);
+
+    changed         = false;
+    SharedType res3 = res1->meetWith(VoidType::get(), changed);
+    QVERIFY(!changed);
+    QVERIFY(res3 == res1);
+}
+
+
 
 QTEST_GUILESS_MAIN(TypeTest)
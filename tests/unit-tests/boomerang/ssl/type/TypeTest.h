@@ -21,4 +21,6 @@ private slots:
     void testNotEqual();
     void testIsCString();
     void testNewIntegerLikeType();
+    void testSharedScalars();
+    void testMeetShared();
 };
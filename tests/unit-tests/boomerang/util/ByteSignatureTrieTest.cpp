@@ -0,0 +1,84 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ByteSignatureTrieTest.h"
+
+
+#include "boomerang/util/ByteSignatureTrie.h"
+
+
+void ByteSignatureTrieTest::testAddPattern()
+{
+    ByteSignatureTrie trie;
+    QVERIFY(trie.empty());
+
+    QVERIFY(trie.addPattern("5589E5", "foo"));
+    QVERIFY(trie.addPattern("55..E5C3", "bar"));
+    QCOMPARE(trie.getNumPatterns(), 2);
+
+    QVERIFY(!trie.addPattern("", "empty"));
+    QVERIFY(!trie.addPattern("5589E", "odd"));
+    QVERIFY(!trie.addPattern("55XX", "nonhex"));
+    QVERIFY(!trie.addPattern("5589", ""));
+    QCOMPARE(trie.getNumPatterns(), 2);
+}
+
+
+void ByteSignatureTrieTest::testMatch()
+{
+    ByteSignatureTrie trie;
+    QVERIFY(trie.addPattern("5589E5", "foo"));
+    QVERIFY(trie.addPattern("5589E583EC08", "bar"));
+
+    const Byte code1[] = { 0x55, 0x89, 0xE5, 0xC3 };
+    const Byte code2[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x08, 0xC3 };
+    const Byte code3[] = { 0x55, 0x8B, 0xEC, 0xC3 };
+
+    QCOMPARE(trie.match(code1, sizeof(code1)), QString("foo"));
+    QCOMPARE(trie.match(code2, sizeof(code2)), QString("bar")); // longest match wins
+    QCOMPARE(trie.match(code3, sizeof(code3)), QString(""));
+
+    // patterns must not exceed the available bytes
+    QCOMPARE(trie.match(code2, 5), QString("foo"));
+    QCOMPARE(trie.match(code2, 2), QString(""));
+}
+
+
+void ByteSignatureTrieTest::testMatchWildcard()
+{
+    ByteSignatureTrie trie;
+    QVERIFY(trie.addPattern("E8........C3", "callret"));
+    QVERIFY(trie.addPattern("E800000000", "callnext"));
+
+    const Byte code1[] = { 0xE8, 0x12, 0x34, 0x56, 0x78, 0xC3 };
+    const Byte code2[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0xC3 };
+    const Byte code3[] = { 0xE8, 0x00, 0x00, 0x00, 0x00, 0x90 };
+
+    QCOMPARE(trie.match(code1, sizeof(code1)), QString("callret"));
+    QCOMPARE(trie.match(code2, sizeof(code2)), QString("callret"));
+    QCOMPARE(trie.match(code3, sizeof(code3)), QString("callnext"));
+}
+
+
+void ByteSignatureTrieTest::testMatchAmbiguous()
+{
+    ByteSignatureTrie trie;
+    QVERIFY(trie.addPattern("5589E5", "foo"));
+    QVERIFY(trie.addPattern("5589E5", "foo"));
+    QVERIFY(trie.addPattern("5589E5C3", "bar"));
+    QVERIFY(trie.addPattern("5589E5C3", "baz"));
+
+    const Byte code[] = { 0x55, 0x89, 0xE5, 0xC3 };
+
+    // "bar" and "baz" are ambiguous, so the shorter "foo" wins
+    QCOMPARE(trie.match(code, sizeof(code)), QString("foo"));
+}
+
+
+QTEST_GUILESS_MAIN(ByteSignatureTrieTest)
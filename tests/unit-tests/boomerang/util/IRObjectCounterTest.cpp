@@ -0,0 +1,93 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "IRObjectCounterTest.h"
+
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/util/IRMemoryReport.h"
+#include "boomerang/util/IRObjectCounter.h"
+
+
+void IRObjectCounterTest::testExpCount()
+{
+    const int64_t numBinary    = IRObjectCounter::getLiveCount(IRObjectKind::Binary);
+    const int64_t numUnary     = IRObjectCounter::getLiveCount(IRObjectKind::Unary);
+    const int64_t numConst     = IRObjectCounter::getLiveCount(IRObjectKind::Const);
+    const int64_t numUnaryExcl = IRObjectCounter::getExclusiveCount(IRObjectKind::Unary);
+
+    {
+        SharedExp exp = Binary::get(opPlus, Const::get(1), Const::get(2));
+
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Binary), numBinary + 1);
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Unary), numUnary + 1);
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Const), numConst + 2);
+        QCOMPARE(IRObjectCounter::getExclusiveCount(IRObjectKind::Unary), numUnaryExcl);
+
+        SharedExp clone = exp->clone();
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Binary), numBinary + 2);
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Const), numConst + 4);
+    }
+
+    QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Binary), numBinary);
+    QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Unary), numUnary);
+    QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::Const), numConst);
+}
+
+
+void IRObjectCounterTest::testStatementCount()
+{
+    const int64_t numGoto     = IRObjectCounter::getLiveCount(IRObjectKind::GotoStatement);
+    const int64_t numBranch   = IRObjectCounter::getLiveCount(IRObjectKind::BranchStatement);
+    const int64_t numGotoExcl = IRObjectCounter::getExclusiveCount(IRObjectKind::GotoStatement);
+
+    {
+        std::shared_ptr<BranchStatement> branch(new BranchStatement(Address(0x1000)));
+
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::GotoStatement), numGoto + 1);
+        QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::BranchStatement), numBranch + 1);
+        QCOMPARE(IRObjectCounter::getExclusiveCount(IRObjectKind::GotoStatement), numGotoExcl);
+    }
+
+    QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::GotoStatement), numGoto);
+    QCOMPARE(IRObjectCounter::getLiveCount(IRObjectKind::BranchStatement), numBranch);
+}
+
+
+void IRObjectCounterTest::testCollectProcStats()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb = prog.getCFG()->createBB(BBType::Fall, createInsns(Address(0x1000), 2));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    proc.getCFG()->createFragment(FragType::Fall, createRTLs(Address(0x1000), 2, 3), bb);
+
+    const IRMemoryReport::ProcStats stats = IRMemoryReport::collectProcStats(&proc);
+
+    QVERIFY(stats.proc == &proc);
+    QCOMPARE(stats.numObjects[static_cast<int>(IRObjectKind::IRFragment)], int64_t(1));
+    QCOMPARE(stats.numObjects[static_cast<int>(IRObjectKind::RTL)], int64_t(2));
+    QCOMPARE(stats.numObjects[static_cast<int>(IRObjectKind::Assign)], int64_t(6));
+    QCOMPARE(stats.numObjects[static_cast<int>(IRObjectKind::Terminal)], int64_t(12));
+    QCOMPARE(stats.numObjects[static_cast<int>(IRObjectKind::MachineInstruction)], int64_t(0));
+    QCOMPARE(stats.numCollectorEntries, int64_t(0));
+
+    QVERIFY(stats.getEstimatedSize() >= 6 * sizeof(Assign) + 2 * sizeof(RTL));
+}
+
+
+QTEST_GUILESS_MAIN(IRObjectCounterTest)
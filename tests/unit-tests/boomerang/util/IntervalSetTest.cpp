@@ -144,6 +144,13 @@ void IntervalSetTest::testIsContained()
     set.insert(Address(0x2000), Address(0x2020));
     QVERIFY(!set.isContained(Address(0x1080)));
     QVERIFY(!set.isContained(Address(0x2040)));
+
+    // intervals
+    QVERIFY( set.isContained(Interval<Address>(Address(0x1000), Address(0x1010))));
+    QVERIFY( set.isContained(Interval<Address>(Address(0x2008), Address(0x2010))));
+    QVERIFY(!set.isContained(Interval<Address>(Address(0x1008), Address(0x1018))));
+    QVERIFY(!set.isContained(Interval<Address>(Address(0x1000), Address(0x2020))));
+    QVERIFY(!set.isContained(Interval<Address>(Address(0x3000), Address(0x3010))));
 }
 
 
@@ -0,0 +1,69 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ParallelForTest.h"
+
+
+#include "boomerang/util/ParallelFor.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+void ParallelForTest::testGetNumThreads()
+{
+    QCOMPARE(Util::getNumThreads(1), 1);
+    QCOMPARE(Util::getNumThreads(4), 4);
+    QVERIFY(Util::getNumThreads(0) >= 1);
+    QVERIFY(Util::getNumThreads(-1) >= 1);
+}
+
+
+void ParallelForTest::testSingleThread()
+{
+    const std::thread::id caller = std::this_thread::get_id();
+    std::vector<std::size_t> visited;
+    bool sameThread = true;
+
+    Util::parallelFor(10, 1, [&](std::size_t i) {
+        visited.push_back(i);
+        sameThread = sameThread && std::this_thread::get_id() == caller;
+    });
+
+    QVERIFY(sameThread);
+    QCOMPARE(visited.size(), std::size_t(10));
+
+    for (std::size_t i = 0; i < visited.size(); i++) {
+        QCOMPARE(visited[i], i);
+    }
+
+    // nothing to do
+    Util::parallelFor(0, 4, [&](std::size_t) { QFAIL("Called for empty range"); });
+}
+
+
+void ParallelForTest::testMultipleThreads()
+{
+    const std::size_t count = 1000;
+    std::vector<std::atomic<int>> numVisits(count);
+
+    for (std::atomic<int> &n : numVisits) {
+        n = 0;
+    }
+
+    Util::parallelFor(count, 4, [&](std::size_t i) { numVisits[i]++; });
+
+    for (std::size_t i = 0; i < count; i++) {
+        QCOMPARE(numVisits[i].load(), 1);
+    }
+}
+
+
+QTEST_GUILESS_MAIN(ParallelForTest)